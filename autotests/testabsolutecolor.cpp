@@ -6,15 +6,20 @@
 #include "absolutecolor.h"
 
 #include "blackhole.h"
+#include "colorspaceinfo.h"
 #include "genericcolor.h"
+#include "helperconstants.h"
 #include "helpermath.h"
 #include "perceptualcolornamespace.h"
 #include "vec3.h"
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <optional>
 #include <qbenchmark.h>
-#include <qhash.h>
+#include <qglobal.h>
+#include <qlist.h>
 #include <qmetatype.h>
 #include <qobject.h>
 #include <qrgb.h>
@@ -22,6 +27,8 @@
 #include <qtestcase.h>
 #include <qtestdata.h>
 #include <qtmetamacros.h>
+#include <span>
+#include <utility>
 
 namespace PerceptualColor
 {
@@ -36,6 +43,48 @@ public:
     }
 
 private:
+    // Values of the same color in different color models.
+    using ReferenceValues = QList<std::pair<ColorModel, GenericColor>>;
+
+    // The bisection algorithm that AbsoluteColor::reduceChromaToFitIntoGamut()
+    // has used before it solved the gamut boundary directly. It serves as
+    // an oracle for the unit tests.
+    static GenericColor reduceChromaByBisection(const GenericColor &lch, const LchSpace lchSpace)
+    {
+        GenericColor referenceColor = lch;
+        normalizePolar360(referenceColor.second, referenceColor.third);
+        const auto maxChroma = (lchSpace == LchSpace::CielchD50) //
+            ? ColorSpaceInfo::maxCielchD50Chroma() //
+            : ColorSpaceInfo::maxOklchChroma();
+        referenceColor.second = qMin<double>(referenceColor.second, maxChroma);
+        const auto minLightness = (lchSpace == LchSpace::CielchD50) //
+            ? ColorSpaceInfo::cielabD50BlackpointL() //
+            : ColorSpaceInfo::oklabBlackpointL();
+        const auto maxLightness = (lchSpace == LchSpace::CielchD50) //
+            ? ColorSpaceInfo::cielabD50WhitepointL() //
+            : ColorSpaceInfo::oklabWhitepointL();
+        referenceColor.first = qBound<double>(minLightness, referenceColor.first, maxLightness);
+        if (AbsoluteColor::isLchInSRgbGamut(referenceColor, lchSpace)) {
+            return referenceColor;
+        }
+        GenericColor lowerChroma{referenceColor.first, 0, referenceColor.third};
+        if (!AbsoluteColor::isLchInSRgbGamut(lowerChroma, lchSpace)) {
+            referenceColor.first = 0;
+            lowerChroma.first = 0;
+        }
+        GenericColor upperChroma{referenceColor};
+        GenericColor temp = upperChroma;
+        while (upperChroma.second - lowerChroma.second > gamutPrecisionOklab) {
+            temp.second = ((lowerChroma.second + upperChroma.second) / 2);
+            if (AbsoluteColor::isLchInSRgbGamut(temp, lchSpace)) {
+                lowerChroma = temp;
+            } else {
+                upperChroma = temp;
+            }
+        }
+        return lowerChroma;
+    }
+
     void generateDataXyzd65Oklab()
     {
         qRegisterMetaType<Vec3d>();
@@ -354,6 +403,110 @@ private Q_SLOTS:
         QCOMPARE(myLchResult.third, 1);
     }
 
+    void testConvertReferenceValues_data()
+    {
+        QTest::addColumn<ReferenceValues>("references");
+
+        // The following reference values have been calculated independently
+        // from this library, with a Python script that applies the formulas
+        // step by step. It uses the same constants as this library: The
+        // rounded sRGB matrix from IEC 61966-2-1, the rounded Bradford
+        // matrix and D50 white point from helperconversion.h, and the
+        // Oklab matrices by Björn Ottosson.
+        QTest::newRow("red") << ReferenceValues{ //
+            {ColorModel::SRgb_1, GenericColor(1, 0, 0)},
+            {ColorModel::LinearSRgb_1, GenericColor(1, 0, 0)},
+            {ColorModel::XyzD65_1, GenericColor(0.4124, 0.2126, 0.0193)},
+            {ColorModel::XyzD50_1, GenericColor(0.436051597, 0.2224468905, 0.0138963804)},
+            {ColorModel::CielabD50, GenericColor(54.285666743494076, 80.83448199687882, 69.91216731385772)},
+            {ColorModel::CielchD50, GenericColor(54.285666743494076, 106.87340463475729, 40.855888787940025)},
+            {ColorModel::OklabD65, GenericColor(0.6279259006618564, 0.22488760383292605, 0.12580493324047437)},
+            {ColorModel::OklchD65, GenericColor(0.6279259006618564, 0.25768452725252117, 29.22319404546898)}};
+        QTest::newRow("orange") << ReferenceValues{ //
+            {ColorModel::SRgb_1, GenericColor(0.8, 0.4, 0.2)},
+            {ColorModel::LinearSRgb_1, GenericColor(0.6038273388553378, 0.13286832155381798, 0.033104766570885055)},
+            {ColorModel::XyzD65_1, GenericColor(0.3025075166976314, 0.22579127996235332, 0.05895785219474937)},
+            {ColorModel::XyzD50_1, GenericColor(0.3192076744818598, 0.2315844863435468, 0.04492187284043087)},
+            {ColorModel::CielabD50, GenericColor(55.23517193976906, 38.842426775269615, 47.01117931802522)},
+            {ColorModel::CielchD50, GenericColor(55.23517193976906, 60.9818423685584, 50.43518564331742)},
+            {ColorModel::OklabD65, GenericColor(0.622759582845303, 0.10210035459522343, 0.10229101956837727)},
+            {ColorModel::OklchD65, GenericColor(0.622759582845303, 0.1445265895702535, 45.05344792625735)}};
+    }
+
+    void testConvertReferenceValues()
+    {
+        QFETCH(ReferenceValues, references);
+        constexpr double epsilon = 0.000001;
+        for (const auto &from : std::as_const(references)) {
+            for (const auto &to : std::as_const(references)) {
+                const auto actual = AbsoluteColor::convert(from.first, //
+                                                           from.second,
+                                                           to.first);
+                QVERIFY(actual.has_value());
+                QVERIFY(qAbs(actual.value().first - to.second.first) < epsilon);
+                QVERIFY(qAbs(actual.value().second - to.second.second) < epsilon);
+                QVERIFY(qAbs(actual.value().third - to.second.third) < epsilon);
+            }
+            // Color models that are not connected by any conversion:
+            for (const auto unconnected : {ColorModel::Hsl_360_1_1, //
+                                           ColorModel::Hwb_360_1_1,
+                                           ColorModel::Rgb_1,
+                                           ColorModel::Invalid}) {
+                QVERIFY(!AbsoluteColor::convert(from.first, from.second, unconnected).has_value());
+                QVERIFY(!AbsoluteColor::convert(unconnected, from.second, from.first).has_value());
+            }
+        }
+    }
+
+    void testConvertUnavailable()
+    {
+        const GenericColor value(120, 0.5, 0.5);
+        QVERIFY(!AbsoluteColor::convert(ColorModel::Hsl_360_1_1, //
+                                        value,
+                                        ColorModel::SRgb_1)
+                     .has_value());
+        QVERIFY(!AbsoluteColor::convert(ColorModel::SRgb_1, //
+                                        value,
+                                        ColorModel::Hsv_360_1_1)
+                     .has_value());
+        QCOMPARE(AbsoluteColor::convert(ColorModel::Hsl_360_1_1, //
+                                        value,
+                                        ColorModel::Hsl_360_1_1)
+                     .value(),
+                 value);
+    }
+
+    void testMakeConversionPlan()
+    {
+        constexpr auto plan = AbsoluteColor::makeConversionPlan();
+        constexpr auto xyzD50 = static_cast<std::size_t>(ColorModel::XyzD50_1);
+        constexpr auto cielchD50 = static_cast<std::size_t>(ColorModel::CielchD50);
+        constexpr auto oklchD65 = static_cast<std::size_t>(ColorModel::OklchD65);
+        static_assert(plan[xyzD50][xyzD50].isReachable);
+        static_assert(plan[xyzD50][xyzD50].length == 0);
+        // XyzD50 → CielabD50 → CielchD50
+        static_assert(plan[xyzD50][cielchD50].length == 2);
+        // CielchD50 → CielabD50 → XyzD50 → XyzD65 → OklabD65 → OklchD65
+        static_assert(plan[cielchD50][oklchD65].length == 5);
+        for (std::size_t from = 0; from < AbsoluteColor::conversionModelCount; ++from) {
+            for (std::size_t to = 0; to < AbsoluteColor::conversionModelCount; ++to) {
+                const auto &path = plan[from][to];
+                if (!path.isReachable) {
+                    QCOMPARE(path.length, static_cast<std::size_t>(0));
+                    continue;
+                }
+                // The path must be a connected chain from “from” to “to”.
+                std::size_t current = from;
+                for (std::size_t i = 0; i < path.length; ++i) {
+                    const auto &conversion = AbsoluteColor::conversionList.at(path.steps.at(i));
+                    QCOMPARE(static_cast<std::size_t>(conversion.from), current);
+                    current = static_cast<std::size_t>(conversion.to);
+                }
+                QCOMPARE(current, to);
+            }
+        }
+    }
+
     void testFromXyzd65ToOklab_data()
     {
         generateDataXyzd65Oklab();
@@ -460,6 +613,49 @@ private Q_SLOTS:
         QCOMPARE(AbsoluteColor::channelFromLinearSRgbToSRgb(linearsrgb), srgb);
     }
 
+    void testChannelFromLinearSRgbToSRgbByte()
+    {
+        constexpr int sampleCount = 1000000;
+        int maximumError = 0;
+        for (int i = 0; i <= sampleCount; ++i) {
+            const float linear = static_cast<float>(i) / sampleCount;
+            const int actual = AbsoluteColor::channelFromLinearSRgbToSRgbByte(linear);
+            // The lookup table must reproduce the float calculation exactly…
+            QCOMPARE(actual, //
+                     AbsoluteColor::toByte(AbsoluteColor::channelFromLinearSRgbToSRgb(linear)));
+            // …and stay within one 8-bit step of the exact curve.
+            const double exact = //
+                AbsoluteColor::channelFromLinearSRgbToSRgb(static_cast<double>(linear)) * 255;
+            maximumError = std::max(maximumError, qAbs(actual - qRound(exact)));
+        }
+        QVERIFY(maximumError <= 1);
+    }
+
+    void testChannelFromLinearSRgbToSRgbByteOutOfRange()
+    {
+        QCOMPARE(AbsoluteColor::channelFromLinearSRgbToSRgbByte(-1.f), 0);
+        QCOMPARE(AbsoluteColor::channelFromLinearSRgbToSRgbByte(-0.f), 0);
+        QCOMPARE(AbsoluteColor::channelFromLinearSRgbToSRgbByte(0.f), 0);
+        QCOMPARE(AbsoluteColor::channelFromLinearSRgbToSRgbByte(1.f), 255);
+        QCOMPARE(AbsoluteColor::channelFromLinearSRgbToSRgbByte(2.f), 255);
+        QCOMPARE( //
+            AbsoluteColor::channelFromLinearSRgbToSRgbByte(std::numeric_limits<float>::infinity()),
+            255);
+        QCOMPARE( //
+            AbsoluteColor::channelFromLinearSRgbToSRgbByte(std::numeric_limits<float>::quiet_NaN()),
+            0);
+    }
+
+    void benchmarkChannelFromLinearSRgbToSRgbByte()
+    {
+        QBENCHMARK {
+            for (int i = 0; i < 1000000; ++i) {
+                blackhole(AbsoluteColor::channelFromLinearSRgbToSRgbByte( //
+                    static_cast<float>(i) / 1000000));
+            }
+        }
+    }
+
     void testChannelFromSRgbToLinearSRgb_data()
     {
         generateDataSRgbLinearSRgb();
@@ -591,6 +787,104 @@ private Q_SLOTS:
         QCOMPARE(actualResult, 0);
     }
 
+    void testFastFromOklabToSRgbOrTransparentBatch()
+    {
+        // Sample a grid that contains in-gamut and out-of-gamut colors. The
+        // number of samples is deliberately not a multiple of any SIMD
+        // width, so the scalar remainder is tested, too.
+        QList<float> lightness;
+        QList<float> a;
+        QList<float> b;
+        for (int l = 0; l <= 10; ++l) {
+            for (int i = -20; i <= 20; ++i) {
+                for (int j = -20; j <= 20; ++j) {
+                    lightness.append(l * 0.1f);
+                    a.append(i * 0.025f);
+                    b.append(j * 0.025f);
+                }
+            }
+        }
+        const auto size = static_cast<std::size_t>(lightness.size());
+        QList<QRgb> result(lightness.size());
+        AbsoluteColor::fastFromOklabToSRgbOrTransparent( //
+            std::span<const float>(lightness.constData(), size),
+            std::span<const float>(a.constData(), size),
+            std::span<const float>(b.constData(), size),
+            std::span<QRgb>(result.data(), size));
+        for (qsizetype i = 0; i < lightness.size(); ++i) {
+            const GenericColor oklab(lightness.at(i), a.at(i), b.at(i));
+            QCOMPARE(result.at(i), AbsoluteColor::fastFromOklabToSRgbOrTransparent(oklab));
+        }
+    }
+
+    void testFastFromCielabD50ToSRgbOrTransparentBatch()
+    {
+        // Sample a grid that contains in-gamut and out-of-gamut colors. The
+        // number of samples is deliberately not a multiple of any SIMD
+        // width, so the scalar remainder is tested, too.
+        QList<float> lightness;
+        QList<float> a;
+        QList<float> b;
+        for (int l = 0; l <= 10; ++l) {
+            for (int i = -20; i <= 20; ++i) {
+                for (int j = -20; j <= 20; ++j) {
+                    lightness.append(l * 10.f);
+                    a.append(i * 6.5f);
+                    b.append(j * 6.5f);
+                }
+            }
+        }
+        const auto size = static_cast<std::size_t>(lightness.size());
+        QList<QRgb> result(lightness.size());
+        AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent( //
+            std::span<const float>(lightness.constData(), size),
+            std::span<const float>(a.constData(), size),
+            std::span<const float>(b.constData(), size),
+            std::span<QRgb>(result.data(), size));
+        for (qsizetype i = 0; i < lightness.size(); ++i) {
+            const GenericColor cielabD50(lightness.at(i), a.at(i), b.at(i));
+            QCOMPARE(result.at(i), AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(cielabD50));
+        }
+    }
+
+    void testFastFromOklabToSRgbOrTransparentBatchSizeMismatch()
+    {
+        // Only as many elements as the shortest span contains are processed.
+        const QList<float> lightness{0.5f, 0.5f, 0.5f};
+        const QList<float> a{0.f, 0.f, 0.f};
+        const QList<float> b{0.f, 0.f};
+        constexpr QRgb untouched = 0x12345678;
+        QList<QRgb> result(5, untouched);
+        AbsoluteColor::fastFromOklabToSRgbOrTransparent( //
+            std::span<const float>(lightness.constData(), 3),
+            std::span<const float>(a.constData(), 3),
+            std::span<const float>(b.constData(), 2),
+            std::span<QRgb>(result.data(), 5));
+        QCOMPARE(qAlpha(result.at(0)), 255);
+        QCOMPARE(qAlpha(result.at(1)), 255);
+        QCOMPARE(result.at(2), untouched);
+        QCOMPARE(result.at(3), untouched);
+        QCOMPARE(result.at(4), untouched);
+    }
+
+    void benchmarkFastFromOklabToSRgbOrTransparentBatchInGamut()
+    {
+        constexpr qsizetype count = 1000000;
+        const QList<float> lightness(count, 0.5f);
+        const QList<float> a(count, 0.1f);
+        const QList<float> b(count, 0.1f);
+        QList<QRgb> result(count);
+        const auto size = static_cast<std::size_t>(count);
+        QBENCHMARK {
+            AbsoluteColor::fastFromOklabToSRgbOrTransparent( //
+                std::span<const float>(lightness.constData(), size),
+                std::span<const float>(a.constData(), size),
+                std::span<const float>(b.constData(), size),
+                std::span<QRgb>(result.data(), size));
+            blackhole(result.constFirst());
+        }
+    }
+
     void benchmarkFastFromOklabToSRgbOrTransparentInGamut()
     {
         GenericColor lab;
@@ -757,6 +1051,225 @@ private Q_SLOTS:
         QVERIFY(!AbsoluteColor::isOklabInSRgbGamut(oklabOutOfGamut));
     }
 
+    void testInGamutChromaIntervals_data()
+    {
+        QTest::addColumn<double>("lightness");
+        QTest::addColumn<double>("hue");
+        QTest::addColumn<double>("maximumChroma");
+        QTest::addColumn<LchSpace>("lchSpace");
+        for (int hue = 0; hue < 360; hue += 15) {
+            for (int lightness = 5; lightness < 100; lightness += 15) {
+                QTest::addRow("CielchD50 L%i h%i", lightness, hue) //
+                    << static_cast<double>(lightness) //
+                    << static_cast<double>(hue) //
+                    << 200. //
+                    << LchSpace::CielchD50;
+                QTest::addRow("Oklch L%i h%i", lightness, hue) //
+                    << lightness / 100. //
+                    << static_cast<double>(hue) //
+                    << 0.5 //
+                    << LchSpace::Oklch;
+            }
+        }
+        // Unusual shapes, see ColorSpaceInfo::isUnusualShapeAtHue()
+        QTest::newRow("CielchD50 unusual") << 96. << 98. << 200. << LchSpace::CielchD50;
+        QTest::newRow("Oklch unusual") << 0.3 << 264.1 << 0.5 << LchSpace::Oklch;
+    }
+
+    void testInGamutChromaIntervals()
+    {
+        QFETCH(double, lightness);
+        QFETCH(double, hue);
+        QFETCH(double, maximumChroma);
+        QFETCH(LchSpace, lchSpace);
+        const auto intervals = AbsoluteColor::inGamutChromaIntervals( //
+            lightness,
+            hue,
+            maximumChroma,
+            lchSpace);
+        for (qsizetype i = 0; i < intervals.size(); ++i) {
+            QVERIFY(intervals.at(i).first <= intervals.at(i).second);
+            QVERIFY(intervals.at(i).first >= 0);
+            QVERIFY(intervals.at(i).second <= maximumChroma);
+            if (i > 0) {
+                QVERIFY(intervals.at(i - 1).second < intervals.at(i).first);
+            }
+        }
+        // Compare with sampling
+        constexpr int sampleCount = 2000;
+        for (int i = 0; i <= sampleCount; ++i) {
+            const double chroma = maximumChroma * i / sampleCount;
+            const bool expected = AbsoluteColor::isLchInSRgbGamut( //
+                GenericColor(lightness, chroma, hue),
+                lchSpace);
+            const bool actual = std::any_of(intervals.cbegin(), //
+                                            intervals.cend(),
+                                            [chroma](const auto &interval) {
+                                                return isInRange(interval.first, chroma, interval.second);
+                                            });
+            QCOMPARE(actual, expected);
+        }
+    }
+
+    void testInGamutChromaIntervalsUnusualShape()
+    {
+        // At these lightness and hue values, the gamut has two separate
+        // in-gamut chroma intervals.
+        QCOMPARE(AbsoluteColor::inGamutChromaIntervals(0.3, 264.1, 0.5, LchSpace::Oklch).size(), //
+                 qsizetype{2});
+        QCOMPARE(AbsoluteColor::inGamutChromaIntervals(96, 98, 200, LchSpace::CielchD50).size(), //
+                 qsizetype{2});
+    }
+
+    void testInGamutChromaIntervalsEdgeCases()
+    {
+        // Out-of-range lightness
+        QVERIFY(AbsoluteColor::inGamutChromaIntervals(-1, 0, 0.5, LchSpace::Oklch).isEmpty());
+        QVERIFY(AbsoluteColor::inGamutChromaIntervals(2, 0, 0.5, LchSpace::Oklch).isEmpty());
+        QVERIFY(AbsoluteColor::inGamutChromaIntervals(101, 0, 200, LchSpace::CielchD50).isEmpty());
+        // Negative maximum chroma
+        QVERIFY(AbsoluteColor::inGamutChromaIntervals(0.5, 0, -1, LchSpace::Oklch).isEmpty());
+        // The black point is in-gamut only on the gray axis.
+        const auto blackPoint = AbsoluteColor::inGamutChromaIntervals(0, 0, 0.5, LchSpace::Oklch);
+        QCOMPARE(blackPoint.size(), qsizetype{1});
+        QCOMPARE(blackPoint.at(0).first, 0.);
+        QCOMPARE(blackPoint.at(0).second, 0.);
+        // Zero chroma range
+        const auto gray = AbsoluteColor::inGamutChromaIntervals(0.5, 0, 0, LchSpace::Oklch);
+        QCOMPARE(gray.size(), qsizetype{1});
+        QCOMPARE(gray.at(0).second, 0.);
+    }
+
+    void testReduceChromaToFitIntoGamut_data()
+    {
+        QTest::addColumn<GenericColor>("color");
+        QTest::addColumn<LchSpace>("lchSpace");
+        for (int hue = 0; hue < 360; hue += 10) {
+            for (int lightness = 0; lightness <= 100; lightness += 10) {
+                QTest::addRow("CielchD50 L%i h%i", lightness, hue) //
+                    << GenericColor(lightness, 150, hue) //
+                    << LchSpace::CielchD50;
+                QTest::addRow("Oklch L%i h%i", lightness, hue) //
+                    << GenericColor(lightness / 100., 0.4, hue) //
+                    << LchSpace::Oklch;
+            }
+        }
+        // Unusual shapes, see ColorSpaceInfo::isUnusualShapeAtHue()
+        QTest::newRow("CielchD50 unusual") << GenericColor(96, 150, 98) << LchSpace::CielchD50;
+        QTest::newRow("Oklch unusual") << GenericColor(0.3, 0.4, 264.1) << LchSpace::Oklch;
+        QTest::newRow("Oklch unusual gap") << GenericColor(0.3, 0.2, 264.1) << LchSpace::Oklch;
+        // Out-of-range values
+        QTest::newRow("negative chroma") << GenericColor(50, -150, 30) << LchSpace::CielchD50;
+        QTest::newRow("lightness too high") << GenericColor(120, 20, 30) << LchSpace::CielchD50;
+        QTest::newRow("lightness too low") << GenericColor(-0.5, 0.1, 30) << LchSpace::Oklch;
+    }
+
+    void testReduceChromaToFitIntoGamut()
+    {
+        QFETCH(GenericColor, color);
+        QFETCH(LchSpace, lchSpace);
+        const auto actual = AbsoluteColor::reduceChromaToFitIntoGamut(color, lchSpace);
+        const auto expected = reduceChromaByBisection(color, lchSpace);
+        QVERIFY(AbsoluteColor::isLchInSRgbGamut(actual, lchSpace));
+        QCOMPARE(actual.first, expected.first);
+        QCOMPARE(actual.third, expected.third);
+        constexpr double epsilon = gamutPrecisionOklab + 1e-9;
+        // The result has at least the chroma the bisection finds…
+        QVERIFY(actual.second >= expected.second - epsilon);
+        // …and is exactly at the boundary unless there are several
+        // in-gamut intervals, in which case the bisection might find an
+        // arbitrary one of them.
+        if (!ColorSpaceInfo::isUnusualShapeAtHue(lchSpace, expected.third)) {
+            QVERIFY(actual.second <= expected.second + epsilon);
+        }
+    }
+
+    void testReduceChromaToFitIntoGamutInGamut()
+    {
+        const GenericColor inGamut{50, 10, 30};
+        const auto actual = AbsoluteColor::reduceChromaToFitIntoGamut( //
+            inGamut,
+            LchSpace::CielchD50);
+        QCOMPARE(actual.first, inGamut.first);
+        QCOMPARE(actual.second, inGamut.second);
+        QCOMPARE(actual.third, inGamut.third);
+    }
+
+    void testReduceChromaToFitIntoGamutAlwaysInGamut()
+    {
+        for (const auto lchSpace : {LchSpace::CielchD50, LchSpace::Oklch}) {
+            const double maximumLightness = (lchSpace == LchSpace::CielchD50) ? 100 : 1;
+            const double maximumChroma = (lchSpace == LchSpace::CielchD50) ? 200 : 0.5;
+            for (double hue = 0.7; hue < 360; hue += 7.3) {
+                for (int i = 0; i <= 20; ++i) {
+                    const GenericColor color{maximumLightness * i / 20, maximumChroma, hue};
+                    const auto actual = AbsoluteColor::reduceChromaToFitIntoGamut(color, lchSpace);
+                    QVERIFY(AbsoluteColor::isLchInSRgbGamut(actual, lchSpace));
+                }
+            }
+        }
+    }
+
+    void testStepChromaIntoGamut()
+    {
+        // Already in-gamut:
+        const GenericColor inGamut{50, 10, 30};
+        QCOMPARE(AbsoluteColor::stepChromaIntoGamut(inGamut, 0, LchSpace::CielchD50).value().second, //
+                 inGamut.second);
+        // A degenerate interval whose only chroma is out-of-gamut:
+        const GenericColor outOfGamut{50, 150, 30};
+        QVERIFY(!AbsoluteColor::stepChromaIntoGamut(outOfGamut, 150, LchSpace::CielchD50).has_value());
+        // Far away from the gamut: Only a few steps are tried.
+        QVERIFY(!AbsoluteColor::stepChromaIntoGamut(outOfGamut, 0, LchSpace::CielchD50).has_value());
+        // Slightly out-of-gamut: The step size matches the color space.
+        const auto boundary = AbsoluteColor::reduceChromaToFitIntoGamut(outOfGamut, LchSpace::CielchD50);
+        GenericColor slightlyOutOfGamut = boundary;
+        slightlyOutOfGamut.second += 2 * gamutPrecisionCielab;
+        QVERIFY(!AbsoluteColor::isLchInSRgbGamut(slightlyOutOfGamut, LchSpace::CielchD50));
+        const auto stepped = AbsoluteColor::stepChromaIntoGamut(slightlyOutOfGamut, 0, LchSpace::CielchD50);
+        QVERIFY(stepped.has_value());
+        QVERIFY(AbsoluteColor::isLchInSRgbGamut(stepped.value(), LchSpace::CielchD50));
+        QVERIFY(stepped.value().second >= boundary.second - 2 * gamutPrecisionCielab);
+    }
+
+    void testReduceChromaToFitIntoGamutBatch()
+    {
+        const QList<GenericColor> colors{GenericColor(50, 10, 30), //
+                                         GenericColor(50, 150, 30),
+                                         GenericColor(96, 150, 98),
+                                         GenericColor(120, 20, 30)};
+        QList<GenericColor> result(colors.size());
+        AbsoluteColor::reduceChromaToFitIntoGamut(colors, LchSpace::CielchD50, result);
+        for (qsizetype i = 0; i < colors.size(); ++i) {
+            const auto expected = AbsoluteColor::reduceChromaToFitIntoGamut( //
+                colors.at(i),
+                LchSpace::CielchD50);
+            QCOMPARE(result.at(i).first, expected.first);
+            QCOMPARE(result.at(i).second, expected.second);
+            QCOMPARE(result.at(i).third, expected.third);
+        }
+
+        // In-place
+        QList<GenericColor> inPlace = colors;
+        AbsoluteColor::reduceChromaToFitIntoGamut(inPlace, LchSpace::CielchD50, inPlace);
+        for (qsizetype i = 0; i < colors.size(); ++i) {
+            QCOMPARE(inPlace.at(i).second, result.at(i).second);
+        }
+    }
+
+    void testReduceChromaToFitIntoGamutBatchSizeMismatch()
+    {
+        // Only as many elements as the shortest span contains are processed.
+        const QList<GenericColor> colors{GenericColor(50, 150, 30), //
+                                         GenericColor(50, 150, 30)};
+        const GenericColor untouched{1, 2, 3};
+        QList<GenericColor> result(3, untouched);
+        AbsoluteColor::reduceChromaToFitIntoGamut(colors, LchSpace::CielchD50, result);
+        QVERIFY(result.at(0).second < 150);
+        QVERIFY(result.at(1).second < 150);
+        QCOMPARE(result.at(2).second, untouched.second);
+    }
+
     void testFromXyzD50ToCielabD50()
     {
         // The following reference values have been calculated with the
@@ -11,9 +11,13 @@
 #include <qcolor.h>
 #include <qglobal.h>
 #include <qimage.h>
+#include <qline.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qpainter.h>
+#include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qsize.h>
 #include <qtest.h>
 #include <qtestcase.h>
@@ -157,6 +161,84 @@ private Q_SLOTS:
                  "(Otherwise, there would be no hole in the middle.)");
     }
 
+    void testHandleBoundingRect()
+    {
+        AbstractDiagram temp;
+        const QPointF center(20.5, 30.25);
+        const QRect rect = temp.handleBoundingRect(center);
+        const qreal extent = temp.handleRadius() + temp.handleOutlineThickness() / 2.0;
+        QVERIFY(rect.contains((center + QPointF(-extent, -extent)).toPoint()));
+        QVERIFY(rect.contains((center + QPointF(extent, extent)).toPoint()));
+        QVERIFY(rect.width() < 2 * extent + 4);
+    }
+
+    void testLineBoundingRect()
+    {
+        const QRect rect = AbstractDiagram::lineBoundingRect( //
+            QLineF(QPointF(10, 40), QPointF(30, 20)),
+            4);
+        QVERIFY(rect.contains(QRect(8, 18, 24, 24)));
+        QVERIFY(rect.width() < 30);
+        QVERIFY(rect.height() < 30);
+    }
+
+    void testPhysicalRegion()
+    {
+        AbstractDiagram temp;
+        const QRegion region = QRegion(QRect(1, 2, 3, 4)) + QRect(10, 10, 5, 5);
+        const QRegion physical = temp.physicalRegion(region);
+        const qreal scaleFactor = temp.devicePixelRatioF();
+        QVERIFY(physical.contains( //
+            QRectF(1 * scaleFactor, 2 * scaleFactor, 3 * scaleFactor, 4 * scaleFactor).toAlignedRect()));
+        QVERIFY(physical.contains( //
+            QRectF(10 * scaleFactor, 10 * scaleFactor, 5 * scaleFactor, 5 * scaleFactor).toAlignedRect()));
+        QVERIFY(temp.physicalRegion(QRegion()).isEmpty());
+    }
+
+    void testReusablePaintBuffer()
+    {
+        AbstractDiagram temp;
+        const QSize size(30, 20);
+        const uchar *firstBits = temp.reusablePaintBuffer(size, 2).constBits();
+        QCOMPARE(temp.reusablePaintBuffer(size, 2).size(), size);
+        QCOMPARE(temp.reusablePaintBuffer(size, 2).format(), //
+                 QImage::Format_ARGB32_Premultiplied);
+        QCOMPARE(temp.reusablePaintBuffer(size, 2).devicePixelRatio(), 2);
+        // No re-allocation as long as the size does not change:
+        QCOMPARE(temp.reusablePaintBuffer(size, 2).constBits(), firstBits);
+        // Re-allocation when the size changes:
+        const QSize newSize(40, 20);
+        QCOMPARE(temp.reusablePaintBuffer(newSize, 2).size(), newSize);
+        // Changing the device pixel ratio does not re-allocate:
+        const uchar *newBits = temp.reusablePaintBuffer(newSize, 2).constBits();
+        QCOMPARE(temp.reusablePaintBuffer(newSize, 1).devicePixelRatio(), 1);
+        QCOMPARE(temp.reusablePaintBuffer(newSize, 1).constBits(), newBits);
+    }
+
+    void testClearPaintBufferRegion()
+    {
+        QImage image(10, 10, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        QPainter painter(&image);
+        AbstractDiagram::clearPaintBufferRegion(painter, QRect(0, 0, 5, 10));
+        // Painting is clipped to the region:
+        painter.fillRect(QRect(0, 0, 10, 10), Qt::blue);
+        painter.end();
+        QCOMPARE(image.pixelColor(2, 2), QColor(Qt::blue));
+        QCOMPARE(image.pixelColor(7, 2), QColor(Qt::red));
+    }
+
+    void testClearPaintBufferRegionClears()
+    {
+        QImage image(10, 10, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        QPainter painter(&image);
+        AbstractDiagram::clearPaintBufferRegion(painter, QRect(0, 0, 5, 10));
+        painter.end();
+        QCOMPARE(image.pixelColor(2, 2).alpha(), 0);
+        QCOMPARE(image.pixelColor(7, 2), QColor(Qt::red));
+    }
+
     void testGradientThickness()
     {
         AbstractDiagram temp;
@@ -0,0 +1,268 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// First included header is the public header of the class we are testing;
+// this forces the header to be self-contained.
+#include "asyncimagediskcache.h"
+
+#include "asyncimageprovider.h"
+#include "asyncimagerendercallback.h"
+#include "colorwheelimageparameters.h"
+#include <limits>
+#include <qbytearray.h>
+#include <qcolor.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qglobal.h>
+#include <qimage.h>
+#include <qiodevice.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qstringliteral.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+namespace PerceptualColor
+{
+
+class Mockup : public AsyncImageRenderCallback
+{
+public:
+    virtual bool shouldAbort() const override
+    {
+        return false;
+    }
+    virtual void deliverInterlacingPass(const QImage &image, const QImage &mask, const QVariant &parameters, const InterlacingState state) override
+    {
+        Q_UNUSED(mask)
+        Q_UNUSED(parameters)
+        if (state == InterlacingState::Final) {
+            finalImage = image;
+        }
+    }
+    QImage finalImage;
+};
+
+class TestAsyncImageDiskCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestAsyncImageDiskCache(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private:
+    static QImage testImage()
+    {
+        QImage result(7, 3, QImage::Format_ARGB32_Premultiplied);
+        result.fill(Qt::transparent);
+        result.setPixelColor(2, 1, Qt::red);
+        result.setDevicePixelRatio(1.5);
+        return result;
+    }
+
+    static QImage testMask()
+    {
+        QImage result(7, 3, QImage::Format_MonoLSB);
+        result.setColorTable({qRgb(255, 255, 255), qRgb(0, 0, 0)});
+        result.fill(0);
+        result.setPixel(2, 1, 1);
+        return result;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Called before the first test function is executed
+    }
+
+    void cleanupTestCase()
+    {
+        // Called after the last test function was executed
+    }
+
+    void init()
+    {
+        // Called before each test function is executed
+    }
+
+    void cleanup()
+    {
+        // Called after every test function
+        AsyncImageDiskCache::setDirectory(QString());
+    }
+
+    void testDisabledByDefault()
+    {
+        QVERIFY(AsyncImageDiskCache::directory().isEmpty());
+        QVERIFY(!AsyncImageDiskCache::save("key", testImage(), QImage()));
+        QVERIFY(!AsyncImageDiskCache::load("key").has_value());
+    }
+
+    void testRoundTrip()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        AsyncImageDiskCache::setDirectory(directory.path());
+        QCOMPARE(AsyncImageDiskCache::directory(), directory.path());
+        QVERIFY(AsyncImageDiskCache::save("key", testImage(), testMask()));
+        const auto entry = AsyncImageDiskCache::load("key");
+        QVERIFY(entry.has_value());
+        QCOMPARE(entry.value().image, testImage());
+        QCOMPARE(entry.value().image.devicePixelRatio(), 1.5);
+        QCOMPARE(entry.value().mask.colorTable(), testMask().colorTable());
+        QCOMPARE(entry.value().mask.pixelIndex(2, 1), 1);
+        QCOMPARE(entry.value().mask.pixelIndex(0, 0), 0);
+        // Other keys are not found:
+        QVERIFY(!AsyncImageDiskCache::load("otherKey").has_value());
+    }
+
+    void testWithoutMask()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        AsyncImageDiskCache::setDirectory(directory.path());
+        QVERIFY(AsyncImageDiskCache::save("key", testImage(), QImage()));
+        const auto entry = AsyncImageDiskCache::load("key");
+        QVERIFY(entry.has_value());
+        QCOMPARE(entry.value().image, testImage());
+        QVERIFY(entry.value().mask.isNull());
+    }
+
+    void testCorruptFileIsIgnored()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        AsyncImageDiskCache::setDirectory(directory.path());
+        QVERIFY(AsyncImageDiskCache::save("key", testImage(), testMask()));
+        QFile file(AsyncImageDiskCache::filePath(directory.path(), "key"));
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        // Truncate the pixel data:
+        QVERIFY(file.resize(file.size() - 1));
+        file.close();
+        QVERIFY(!AsyncImageDiskCache::load("key").has_value());
+        // Garbage:
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QByteArray(100, 'x'));
+        file.close();
+        QVERIFY(!AsyncImageDiskCache::load("key").has_value());
+    }
+
+    void testInvalidHeaderIsIgnored()
+    {
+        const QByteArray fileData(1000, '\0');
+        const auto fileBytes = reinterpret_cast<const uchar *>(fileData.constData());
+        AsyncImageDiskCache::ImageHeader header;
+        header.width = 10;
+        header.height = 10;
+        header.format = QImage::Format_ARGB32_Premultiplied;
+        header.bytesPerLine = 40;
+        header.dataOffset = 64;
+        QVERIFY(!AsyncImageDiskCache::imageFromFileData(header, fileBytes, fileData.size()).isNull());
+        // The pixel data exceeds the file:
+        header.dataOffset = 640;
+        QVERIFY(AsyncImageDiskCache::imageFromFileData(header, fileBytes, fileData.size()).isNull());
+        // The offset overflows:
+        header.dataOffset = std::numeric_limits<qint64>::max() - 100;
+        QVERIFY(AsyncImageDiskCache::imageFromFileData(header, fileBytes, fileData.size()).isNull());
+        // The data size overflows:
+        header.dataOffset = 64;
+        header.height = std::numeric_limits<qint32>::max();
+        header.bytesPerLine = std::numeric_limits<qint64>::max() / 2;
+        QVERIFY(!AsyncImageDiskCache::dataSize(header).has_value());
+        QVERIFY(AsyncImageDiskCache::imageFromFileData(header, fileBytes, fileData.size()).isNull());
+    }
+
+    void testLoadOrRender()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        AsyncImageDiskCache::setDirectory(directory.path());
+        int renderCount = 0;
+        const auto renderFunction = [&renderCount](const QVariant &parameters, AsyncImageRenderCallback &callbackObject) {
+            ++renderCount;
+            callbackObject.deliverInterlacingPass(testImage(), //
+                                                  testMask(),
+                                                  parameters,
+                                                  AsyncImageRenderCallback::InterlacingState::Final);
+        };
+        Mockup firstCallback;
+        AsyncImageDiskCache::loadOrRender("key", QVariant(), renderFunction, firstCallback);
+        QCOMPARE(renderCount, 1);
+        QCOMPARE(firstCallback.finalImage, testImage());
+        QVERIFY(AsyncImageDiskCache::load("key").has_value());
+        // The second call loads the image instead of rendering it:
+        Mockup secondCallback;
+        AsyncImageDiskCache::loadOrRender("key", QVariant(), renderFunction, secondCallback);
+        QCOMPARE(renderCount, 1);
+        QCOMPARE(secondCallback.finalImage, testImage());
+    }
+
+    void testPrune()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        AsyncImageDiskCache::setDirectory(directory.path());
+        const int count = AsyncImageDiskCache::maximumFileCount + 5;
+        for (int i = 0; i < count; ++i) {
+            QVERIFY(AsyncImageDiskCache::save(QByteArray::number(i), //
+                                              testImage(),
+                                              QImage()));
+        }
+        const auto files = QDir(directory.path()).entryList(QDir::Files);
+        QCOMPARE(files.count(), AsyncImageDiskCache::maximumFileCount);
+    }
+
+#ifndef MSVC_DLL
+    // The automatic export of otherwise private symbols on MSVC
+    // shared libraries via CMake's WINDOWS_EXPORT_ALL_SYMBOLS property
+    // does not work well for Qt meta objects. AsyncImageProvider inherits
+    // from AsyncImageProviderBase, which relies on Qt meta object
+    // functionality and whose API is private. Therefore, instantiation of
+    // AsyncImageProvider is not possible, so the following unit tests cannot
+    // be built for MSVC shared libraries.
+
+    void testProviderUsesDiskCache()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        AsyncImageDiskCache::setDirectory(directory.path());
+        ColorWheelImageParameters parameters;
+        parameters.imageSizePhysical = 50;
+        const QByteArray key = parameters.diskCacheKey();
+        QVERIFY(!key.isEmpty());
+        QImage renderedImage;
+        {
+            AsyncImageProvider<ColorWheelImageParameters> provider;
+            provider.setImageParameters(parameters);
+            provider.refreshAsync();
+            QVERIFY(!provider.isCacheUpToDate());
+            QTRY_VERIFY(provider.isCacheUpToDate());
+            renderedImage = provider.getCache();
+        }
+        // The final image has been saved in the background:
+        QTRY_VERIFY(AsyncImageDiskCache::load(key).has_value());
+        {
+            // A new provider loads the saved image before the first paint:
+            AsyncImageProvider<ColorWheelImageParameters> provider;
+            provider.setImageParameters(parameters);
+            provider.refreshAsync();
+            QVERIFY(provider.isCacheUpToDate());
+            QCOMPARE(provider.getCache(), renderedImage);
+        }
+    }
+#endif
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::TestAsyncImageDiskCache)
+
+// The following “include” is necessary because we do not use a header file:
+#include "testasyncimagediskcache.moc"
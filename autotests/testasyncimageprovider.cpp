@@ -6,10 +6,18 @@
 #include "asyncimageprovider.h"
 
 #include "asyncimagerendercallback.h"
+#include "helperconstants.h"
+#include "nearestfeaturemap.h"
+#include <atomic>
+#include <qcolor.h>
 #include <qglobal.h>
 #include <qimage.h>
+#include <qlist.h>
 #include <qmetatype.h>
 #include <qobject.h>
+#include <qpoint.h>
+#include <qrgb.h>
+#include <qsize.h>
 #include <qtest.h>
 #include <qtestcase.h>
 #include <qtmetamacros.h>
@@ -98,6 +106,31 @@ public:
 };
 Q_DECLARE_METATYPE(MockupParameters)
 
+struct CountingParameters {
+public:
+    int imageWidth = 1;
+    [[nodiscard]] bool operator==(const CountingParameters other) const
+    {
+        return (imageWidth == other.imageWidth);
+    }
+    static inline std::atomic_int renderCount = 0;
+    static void render( //
+        const QVariant &variantParameters, //
+        PerceptualColor::AsyncImageRenderCallback &callbackObject)
+    {
+        ++renderCount;
+        const auto parameters = variantParameters.value<CountingParameters>();
+        QImage image(parameters.imageWidth, 1, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        callbackObject.deliverInterlacingPass( //
+            image,
+            QImage(),
+            variantParameters,
+            PerceptualColor::AsyncImageRenderCallback::InterlacingState::Final);
+    }
+};
+Q_DECLARE_METATYPE(CountingParameters)
+
 namespace PerceptualColor
 {
 class TestAsyncImageProvider : public QObject
@@ -201,7 +234,16 @@ private Q_SLOTS:
     void testOnExampleImplementationNoCrashProcessInterlacingPassResult()
     {
         AsyncImageProvider<MockupParameters> image;
-        image.processInterlacingPassResult(QImage{}, QImage{});
+        image.processInterlacingPassResult(QImage{}, //
+                                           QImage{}, //
+                                           NearestFeatureMap(), //
+                                           QVariant::fromValue(MockupParameters()), //
+                                           AsyncImageRenderCallback::InterlacingState::Intermediate);
+        image.processInterlacingPassResult(QImage{}, //
+                                           QImage{}, //
+                                           NearestFeatureMap(), //
+                                           QVariant::fromValue(MockupParameters()), //
+                                           AsyncImageRenderCallback::InterlacingState::Final);
     }
 
     void testImageParameters()
@@ -229,6 +271,303 @@ private Q_SLOTS:
         Q_UNUSED(test.getCache())
     }
 
+    void testRenderCacheCapacity()
+    {
+        AsyncImageProvider<MockupParameters> test;
+        // Disabled by default:
+        QCOMPARE(test.renderCacheCapacity(), qsizetype{0});
+        test.setRenderCacheCapacity(1000);
+        QCOMPARE(test.renderCacheCapacity(), qsizetype{1000});
+        test.setRenderCacheCapacity(-5);
+        QCOMPARE(test.renderCacheCapacity(), qsizetype{0});
+    }
+
+    void testRenderCacheMinimumEntryCount()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        // Zero by default:
+        QCOMPARE(test.renderCacheMinimumEntryCount(), qsizetype{0});
+        test.setRenderCacheMinimumEntryCount(-5);
+        QCOMPARE(test.renderCacheMinimumEntryCount(), qsizetype{0});
+
+        const QImage image(10, 1, QImage::Format_ARGB32_Premultiplied);
+        // The capacity alone is too small even for a single image:
+        test.setRenderCacheCapacity(image.sizeInBytes() - 1);
+        test.setRenderCacheMinimumEntryCount(2);
+        QCOMPARE(test.renderCacheMinimumEntryCount(), qsizetype{2});
+        for (int i = 1; i <= 3; ++i) {
+            CountingParameters parameters;
+            parameters.imageWidth = i;
+            test.processInterlacingPassResult(image, //
+                                              QImage(), //
+                                              NearestFeatureMap(), //
+                                              QVariant::fromValue(parameters), //
+                                              AsyncImageRenderCallback::InterlacingState::Final);
+        }
+        QCOMPARE(test.m_renderCache.count(), qsizetype{2});
+        QCOMPARE(test.m_renderCache.at(0).parameters.imageWidth, 3);
+        QCOMPARE(test.m_renderCache.at(1).parameters.imageWidth, 2);
+
+        // Reducing the minimum entry count trims the cache:
+        test.setRenderCacheMinimumEntryCount(0);
+        QCOMPARE(test.m_renderCache.count(), qsizetype{0});
+        QCOMPARE(test.m_renderCacheSize, qsizetype{0});
+    }
+
+    void testRenderCacheHighDpiEntry()
+    {
+        // A typical chroma-lightness image on a high-DPI screen: 800 × 800
+        // device-independent pixels with a scale factor of 2.
+        const QSize size(1600, 1600);
+        const QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        QImage mask(size, QImage::Format_MonoLSB);
+        mask.setColorTable({qRgb(255, 255, 255), qRgb(0, 0, 0)});
+        mask.fill(0);
+        const NearestFeatureMap map = NearestFeatureMap::fromMask(mask);
+        const qsizetype entrySize = //
+            image.sizeInBytes() + mask.sizeInBytes() + map.sizeInBytes();
+        // This is the situation that makes the minimum entry count necessary:
+        QVERIFY(entrySize > renderCacheCapacity);
+
+        AsyncImageProvider<CountingParameters> test;
+        test.setRenderCacheCapacity(renderCacheCapacity);
+        test.setRenderCacheMinimumEntryCount(renderCacheMinimumEntryCount);
+        for (int i = 1; i <= renderCacheMinimumEntryCount; ++i) {
+            CountingParameters parameters;
+            parameters.imageWidth = i;
+            test.processInterlacingPassResult(image, //
+                                              mask, //
+                                              map, //
+                                              QVariant::fromValue(parameters), //
+                                              AsyncImageRenderCallback::InterlacingState::Final);
+        }
+        QCOMPARE(test.m_renderCache.count(), renderCacheMinimumEntryCount);
+    }
+
+    void testRenderCacheDisabled()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        QImage image(10, 1, QImage::Format_ARGB32_Premultiplied);
+        test.processInterlacingPassResult(image, //
+                                          QImage(), //
+                                          NearestFeatureMap(), //
+                                          QVariant::fromValue(CountingParameters()), //
+                                          AsyncImageRenderCallback::InterlacingState::Final);
+        QCOMPARE(test.m_renderCache.count(), qsizetype{0});
+    }
+
+    void testRenderCacheOnlyFinalImages()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        test.setRenderCacheCapacity(1000000);
+        QImage image(10, 1, QImage::Format_ARGB32_Premultiplied);
+        test.processInterlacingPassResult(image, //
+                                          QImage(), //
+                                          NearestFeatureMap(), //
+                                          QVariant::fromValue(CountingParameters()), //
+                                          AsyncImageRenderCallback::InterlacingState::Intermediate);
+        QCOMPARE(test.m_renderCache.count(), qsizetype{0});
+        test.processInterlacingPassResult(image, //
+                                          QImage(), //
+                                          NearestFeatureMap(), //
+                                          QVariant::fromValue(CountingParameters()), //
+                                          AsyncImageRenderCallback::InterlacingState::Final);
+        QCOMPARE(test.m_renderCache.count(), qsizetype{1});
+        // Equal parameters replace the existing entry:
+        test.processInterlacingPassResult(image, //
+                                          QImage(), //
+                                          NearestFeatureMap(), //
+                                          QVariant::fromValue(CountingParameters()), //
+                                          AsyncImageRenderCallback::InterlacingState::Final);
+        QCOMPARE(test.m_renderCache.count(), qsizetype{1});
+        QCOMPARE(test.m_renderCacheSize, image.sizeInBytes());
+    }
+
+    void testRenderCacheEviction()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        const QImage image(10, 1, QImage::Format_ARGB32_Premultiplied);
+        // Room for exactly two images:
+        test.setRenderCacheCapacity(image.sizeInBytes() * 2);
+        for (int i = 1; i <= 3; ++i) {
+            CountingParameters parameters;
+            parameters.imageWidth = i;
+            test.processInterlacingPassResult(image, //
+                                              QImage(), //
+                                              NearestFeatureMap(), //
+                                              QVariant::fromValue(parameters), //
+                                              AsyncImageRenderCallback::InterlacingState::Final);
+        }
+        QCOMPARE(test.m_renderCache.count(), qsizetype{2});
+        // Most recently used first, least recently used was discarded:
+        QCOMPARE(test.m_renderCache.at(0).parameters.imageWidth, 3);
+        QCOMPARE(test.m_renderCache.at(1).parameters.imageWidth, 2);
+        // Images larger than the capacity are not cached:
+        test.setRenderCacheCapacity(image.sizeInBytes() - 1);
+        QCOMPARE(test.m_renderCache.count(), qsizetype{0});
+        QCOMPARE(test.m_renderCacheSize, qsizetype{0});
+    }
+
+    void testNearestFeatureMapCache()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        test.setRenderCacheCapacity(1000000);
+        QVERIFY(test.getNearestFeatureMapCache().isNull());
+        const QImage image(3, 2, QImage::Format_ARGB32_Premultiplied);
+        QImage mask(3, 2, QImage::Format_MonoLSB);
+        mask.setColorTable({qRgb(255, 255, 255), qRgb(0, 0, 0)});
+        mask.fill(0);
+        mask.setPixel(2, 1, 1);
+        const NearestFeatureMap map = NearestFeatureMap::fromMask(mask);
+        CountingParameters first;
+        first.imageWidth = 3;
+        test.processInterlacingPassResult(image, //
+                                          mask, //
+                                          map, //
+                                          QVariant::fromValue(first), //
+                                          AsyncImageRenderCallback::InterlacingState::Final);
+        QCOMPARE(test.getNearestFeatureMapCache().nearestFeature(QPoint(0, 0)), //
+                 QPoint(2, 1));
+        QCOMPARE(test.m_renderCacheSize, //
+                 image.sizeInBytes() + mask.sizeInBytes() + map.sizeInBytes());
+
+        // Deliveries without mask keep the previous mask and map:
+        CountingParameters second;
+        second.imageWidth = 4;
+        test.processInterlacingPassResult(image, //
+                                          QImage(), //
+                                          NearestFeatureMap(), //
+                                          QVariant::fromValue(second), //
+                                          AsyncImageRenderCallback::InterlacingState::Final);
+        QCOMPARE(test.getNearestFeatureMapCache().nearestFeature(QPoint(0, 0)), //
+                 QPoint(2, 1));
+    }
+
+    void testIsCacheUpToDate()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        QVERIFY(!test.isCacheUpToDate());
+        CountingParameters parameters;
+        parameters.imageWidth = 6;
+        test.setImageParameters(parameters);
+        test.refreshAsync();
+        QTRY_VERIFY(test.isCacheUpToDate());
+        QCOMPARE(test.getCache().width(), 6);
+        parameters.imageWidth = 9;
+        test.setImageParameters(parameters);
+        // The cache is out-of-date until the new image is delivered:
+        QVERIFY(!test.isCacheUpToDate());
+        test.refreshAsync();
+        QTRY_VERIFY(test.isCacheUpToDate());
+        QCOMPARE(test.getCache().width(), 9);
+    }
+
+    void testRenderCacheHitSkipsRendering()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        test.setRenderCacheCapacity(1000000);
+        CountingParameters first;
+        first.imageWidth = 5;
+        CountingParameters second;
+        second.imageWidth = 7;
+
+        test.setImageParameters(first);
+        test.refreshAsync();
+        QTRY_COMPARE(test.getCache().width(), 5);
+        test.setImageParameters(second);
+        test.refreshAsync();
+        QTRY_COMPARE(test.getCache().width(), 7);
+
+        const int renderCount = CountingParameters::renderCount;
+        test.setImageParameters(first);
+        test.refreshAsync();
+        // Served immediately from the render cache:
+        QCOMPARE(test.getCache().width(), 5);
+        test.refreshSync();
+        QCOMPARE(CountingParameters::renderCount.load(), renderCount);
+    }
+
+    void testPrefetchDisabledWithoutRenderCache()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        CountingParameters parameters;
+        parameters.imageWidth = 3;
+        test.prefetchAsync(QList<CountingParameters>{parameters});
+        QVERIFY(test.m_prefetchQueue.isEmpty());
+        QVERIFY(!test.m_prefetchInProgress.has_value());
+    }
+
+    void testPrefetch()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        test.setRenderCacheCapacity(1000000);
+        CountingParameters first;
+        first.imageWidth = 3;
+        CountingParameters second;
+        second.imageWidth = 4;
+        test.prefetchAsync(QList<CountingParameters>{first, second});
+        QTRY_COMPARE(test.m_renderCache.count(), qsizetype{2});
+        QVERIFY(!test.m_prefetchInProgress.has_value());
+        // Prefetching does not change the current image:
+        QVERIFY(test.getCache().isNull());
+
+        const int renderCount = CountingParameters::renderCount;
+        test.setImageParameters(second);
+        test.refreshAsync();
+        // Served immediately from the render cache:
+        QCOMPARE(test.getCache().width(), 4);
+        QCOMPARE(CountingParameters::renderCount.load(), renderCount);
+    }
+
+    void testPrefetchKeepsCurrentImage()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        const QImage image(10, 1, QImage::Format_ARGB32_Premultiplied);
+        // Room for two images:
+        test.setRenderCacheCapacity(image.sizeInBytes() * 2);
+        CountingParameters current;
+        current.imageWidth = 10;
+        test.setImageParameters(current);
+        test.refreshAsync();
+        QTRY_VERIFY(test.isCacheUpToDate());
+        QCOMPARE(test.renderCacheIndexOf(current), 0);
+
+        // A burst of prefetched images, each of them the same size as
+        // the current image:
+        QList<CountingParameters> prefetchList;
+        for (int i = 1; i <= 3; ++i) {
+            CountingParameters parameters;
+            parameters.imageWidth = 10 - i;
+            prefetchList.append(parameters);
+        }
+        test.prefetchAsync(prefetchList);
+        QTRY_VERIFY(!test.m_prefetchInProgress.has_value() //
+                    && test.m_prefetchQueue.isEmpty());
+
+        // The current image is still cached, together with the most
+        // recently prefetched image:
+        QCOMPARE(test.m_renderCache.count(), qsizetype{2});
+        QVERIFY(test.renderCacheIndexOf(current) >= 0);
+        QVERIFY(test.renderCacheIndexOf(prefetchList.constLast()) >= 0);
+        QVERIFY(test.m_renderCacheSize <= test.renderCacheCapacity());
+    }
+
+    void testPrefetchYieldsToRealRequests()
+    {
+        AsyncImageProvider<CountingParameters> test;
+        test.setRenderCacheCapacity(1000000);
+        CountingParameters prefetched;
+        prefetched.imageWidth = 3;
+        CountingParameters requested;
+        requested.imageWidth = 8;
+        test.prefetchAsync(QList<CountingParameters>{prefetched});
+        test.setImageParameters(requested);
+        test.refreshAsync();
+        // Both images will finally be available:
+        QTRY_COMPARE(test.getCache().width(), 8);
+        QTRY_COMPARE(test.m_renderCache.count(), qsizetype{2});
+    }
+
 #endif
 };
 
@@ -0,0 +1,180 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// First included header is the public header of the class we are testing;
+// this forces the header to be self-contained.
+#include "asyncimagerenderscheduler.h"
+
+#include <atomic>
+#include <qglobal.h>
+#include <qobject.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qtest.h>
+#include <qtmetamacros.h>
+
+namespace PerceptualColor
+{
+class TestAsyncImageRenderScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestAsyncImageRenderScheduler(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Called before the first test function is executed
+    }
+
+    void cleanupTestCase()
+    {
+        // Called after the last test function was executed
+    }
+
+    void init()
+    {
+        // Called before each test function is executed
+    }
+
+    void cleanup()
+    {
+        // Called after every test function
+    }
+
+    void testInstance()
+    {
+        AsyncImageRenderScheduler &first = AsyncImageRenderScheduler::instance();
+        AsyncImageRenderScheduler &second = AsyncImageRenderScheduler::instance();
+        QCOMPARE(&first, &second);
+    }
+
+    void testMaxThreadCount()
+    {
+        QVERIFY(AsyncImageRenderScheduler::instance().maxThreadCount() >= 2);
+    }
+
+    void testSchedule()
+    {
+        QSemaphore semaphore(0);
+        AsyncImageRenderScheduler::instance().schedule( //
+            QRunnable::create([&semaphore]() {
+                semaphore.release();
+            }),
+            AsyncImageRenderScheduler::Priority::Normal);
+        QVERIFY(semaphore.tryAcquire(1, 10000));
+    }
+
+    void testPriority()
+    {
+        auto &scheduler = AsyncImageRenderScheduler::instance();
+        // Block all worker threads, so that the following jobs are queued.
+        const int threadCount = scheduler.maxThreadCount();
+        QSemaphore blockerStarted(0);
+        QSemaphore blockerRelease(0);
+        for (int i = 0; i < threadCount; ++i) {
+            scheduler.schedule( //
+                QRunnable::create([&blockerStarted, &blockerRelease]() {
+                    blockerStarted.release();
+                    blockerRelease.acquire();
+                }),
+                AsyncImageRenderScheduler::Priority::Normal);
+        }
+        QVERIFY(blockerStarted.tryAcquire(threadCount, 10000));
+
+        std::atomic_int counter = 0;
+        std::atomic_int prefetchPosition = -1;
+        std::atomic_int normalPosition = -1;
+        QSemaphore done(0);
+        scheduler.schedule( //
+            QRunnable::create([&counter, &prefetchPosition, &done]() {
+                prefetchPosition = counter++;
+                done.release();
+            }),
+            AsyncImageRenderScheduler::Priority::Prefetch);
+        scheduler.schedule( //
+            QRunnable::create([&counter, &normalPosition, &done]() {
+                normalPosition = counter++;
+                done.release();
+            }),
+            AsyncImageRenderScheduler::Priority::Normal);
+
+        // Release only one worker thread, so that the waiting jobs
+        // run one after the other.
+        blockerRelease.release(1);
+        QVERIFY(done.tryAcquire(2, 10000));
+        blockerRelease.release(threadCount - 1);
+        QCOMPARE(normalPosition.load(), 0);
+        QCOMPARE(prefetchPosition.load(), 1);
+    }
+
+    void testUnschedule()
+    {
+        auto &scheduler = AsyncImageRenderScheduler::instance();
+        // Block all worker threads, so that the following job is queued.
+        const int threadCount = scheduler.maxThreadCount();
+        QSemaphore blockerStarted(0);
+        QSemaphore blockerRelease(0);
+        for (int i = 0; i < threadCount; ++i) {
+            scheduler.schedule( //
+                QRunnable::create([&blockerStarted, &blockerRelease]() {
+                    blockerStarted.release();
+                    blockerRelease.acquire();
+                }),
+                AsyncImageRenderScheduler::Priority::Normal);
+        }
+        QVERIFY(blockerStarted.tryAcquire(threadCount, 10000));
+
+        std::atomic_bool hasRun = false;
+        QRunnable *job = QRunnable::create([&hasRun]() {
+            hasRun = true;
+        });
+        scheduler.schedule(job, AsyncImageRenderScheduler::Priority::Normal);
+        const bool removed = scheduler.unschedule(job);
+        blockerRelease.release(threadCount);
+        QVERIFY(removed);
+        delete job;
+
+        // Make sure all blockers have finished before checking.
+        QSemaphore done(0);
+        for (int i = 0; i < threadCount; ++i) {
+            scheduler.schedule( //
+                QRunnable::create([&done]() {
+                    done.release();
+                }),
+                AsyncImageRenderScheduler::Priority::Normal);
+        }
+        QVERIFY(done.tryAcquire(threadCount, 10000));
+        QVERIFY(!hasRun);
+    }
+
+    void testSynchronousWaitStatistics()
+    {
+        auto &scheduler = AsyncImageRenderScheduler::instance();
+        scheduler.resetSynchronousWaitStatistics();
+        QCOMPARE(scheduler.synchronousWaitStatistics().count, quint64{0});
+        scheduler.recordSynchronousWait(10);
+        scheduler.recordSynchronousWait(30);
+        scheduler.recordSynchronousWait(20);
+        const auto statistics = scheduler.synchronousWaitStatistics();
+        QCOMPARE(statistics.count, quint64{3});
+        QCOMPARE(statistics.totalNanoseconds, qint64{60});
+        QCOMPARE(statistics.longestNanoseconds, qint64{30});
+        scheduler.resetSynchronousWaitStatistics();
+        const auto resetStatistics = scheduler.synchronousWaitStatistics();
+        QCOMPARE(resetStatistics.count, quint64{0});
+        QCOMPARE(resetStatistics.totalNanoseconds, qint64{0});
+        QCOMPARE(resetStatistics.longestNanoseconds, qint64{0});
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::TestAsyncImageRenderScheduler)
+
+// The following “include” is necessary because we do not use a header file:
+#include "testasyncimagerenderscheduler.moc"
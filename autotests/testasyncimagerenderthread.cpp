@@ -6,10 +6,14 @@
 #include "asyncimagerenderthread.h"
 
 #include "asyncimagerendercallback.h"
+#include "asyncimagerenderscheduler.h"
 #include <qglobal.h>
 #include <qimage.h>
+#include <qlist.h>
 #include <qobject.h>
+#include <qsignalspy.h>
 #include <qtest.h>
+#include <qthread.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
 
@@ -42,6 +46,21 @@ public:
         return;
     }
 
+    static void renderSlowly(const QVariant &variantParameters, AsyncImageRenderCallback &callbackObject)
+    {
+        for (int i = 0; i < 20; ++i) {
+            if (callbackObject.shouldAbort()) {
+                return;
+            }
+            QThread::msleep(5);
+        }
+        callbackObject.deliverInterlacingPass( //
+            QImage(),
+            QImage(),
+            variantParameters,
+            AsyncImageRenderCallback::InterlacingState::Final);
+    }
+
 private Q_SLOTS:
     void initTestCase()
     {
@@ -108,6 +127,80 @@ private Q_SLOTS:
         test.startRenderingAsync(QVariant());
         test.waitForIdle();
     }
+
+    void testCoalescing()
+    {
+        AsyncImageRenderThread test( //
+            &TestAsyncImageRenderThread::renderSlowly);
+        QSignalSpy spy(&test, &AsyncImageRenderThread::interlacingPassCompleted);
+        for (int i = 1; i <= 10; ++i) {
+            test.startRenderingAsync(QVariant(i));
+        }
+        test.waitForIdle();
+        // Superseded requests are either never started or aborted,
+        // so the last request is the only one that can be delivered.
+        QTRY_COMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(3), QVariant(10));
+        QVERIFY(!test.shouldAbort());
+    }
+
+    void testCancelRendering()
+    {
+        AsyncImageRenderThread test( //
+            &TestAsyncImageRenderThread::renderSlowly);
+        QSignalSpy spy(&test, &AsyncImageRenderThread::interlacingPassCompleted);
+        test.startRenderingAsync(QVariant(1));
+        test.cancelRendering();
+        test.waitForIdle();
+        QTest::qWait(50);
+        QCOMPARE(spy.count(), 0);
+        // After cancelling, identical parameters start a new rendering:
+        test.startRenderingAsync(QVariant(1));
+        test.waitForIdle();
+        QTRY_COMPARE(spy.count(), 1);
+    }
+
+    void testWaitForIdleIsRecorded()
+    {
+        auto &scheduler = AsyncImageRenderScheduler::instance();
+        AsyncImageRenderThread test( //
+            &TestAsyncImageRenderThread::renderSlowly);
+        scheduler.resetSynchronousWaitStatistics();
+        // Waiting while nothing is rendered does not count:
+        test.waitForIdle();
+        QCOMPARE(scheduler.synchronousWaitStatistics().count, quint64{0});
+        test.startRenderingAsync(QVariant(1));
+        test.waitForIdle();
+        const auto statistics = scheduler.synchronousWaitStatistics();
+        QCOMPARE(statistics.count, quint64{1});
+        QVERIFY(statistics.totalNanoseconds > 0);
+        QCOMPARE(statistics.longestNanoseconds, statistics.totalNanoseconds);
+    }
+
+    void testPriority()
+    {
+        AsyncImageRenderThread test( //
+            &TestAsyncImageRenderThread::renderSlowly);
+        test.setPriority(AsyncImageRenderScheduler::Priority::Prefetch);
+        QSignalSpy spy(&test, &AsyncImageRenderThread::interlacingPassCompleted);
+        test.startRenderingAsync(QVariant(1));
+        test.waitForIdle();
+        QTRY_COMPARE(spy.count(), 1);
+    }
+
+    void testDestructorWhileRendering()
+    {
+        QList<AsyncImageRenderThread *> list;
+        // More objects than worker threads, so that some
+        // jobs are still queued on destruction.
+        const int count = AsyncImageRenderScheduler::instance().maxThreadCount() * 2;
+        for (int i = 0; i < count; ++i) {
+            list.append(new AsyncImageRenderThread(&TestAsyncImageRenderThread::renderSlowly));
+            list.last()->startRenderingAsync(QVariant(i));
+        }
+        // Should not crash nor hang.
+        qDeleteAll(list);
+    }
 };
 
 } // namespace PerceptualColor
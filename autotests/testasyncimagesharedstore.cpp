@@ -0,0 +1,211 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// First included header is the public header of the class we are testing;
+// this forces the header to be self-contained.
+#include "asyncimagesharedstore.h"
+
+#include "asyncimageprovider.h"
+#include "asyncimagerendercallback.h"
+#include <atomic>
+#include <qcolor.h>
+#include <qglobal.h>
+#include <qimage.h>
+#include <qmetatype.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qscopedpointer.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+struct SharedParameters {
+public:
+    int imageWidth = 1;
+    [[nodiscard]] bool operator==(const SharedParameters other) const
+    {
+        return (imageWidth == other.imageWidth);
+    }
+    static inline std::atomic_int renderCount = 0;
+    static void render( //
+        const QVariant &variantParameters, //
+        PerceptualColor::AsyncImageRenderCallback &callbackObject)
+    {
+        ++renderCount;
+        const auto parameters = variantParameters.value<SharedParameters>();
+        QImage image(parameters.imageWidth, 1, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::red);
+        callbackObject.deliverInterlacingPass( //
+            image,
+            QImage(),
+            variantParameters,
+            PerceptualColor::AsyncImageRenderCallback::InterlacingState::Final);
+    }
+};
+Q_DECLARE_METATYPE(SharedParameters)
+
+namespace PerceptualColor
+{
+class TestAsyncImageSharedStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestAsyncImageSharedStore(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Called before the first test function is executed
+    }
+
+    void cleanupTestCase()
+    {
+        // Called after the last test function was executed
+    }
+
+    void init()
+    {
+        // Called before each test function is executed
+    }
+
+    void cleanup()
+    {
+        // Called after every test function
+    }
+
+#ifndef MSVC_DLL
+    // The automatic export of otherwise private symbols on MSVC
+    // shared libraries via CMake's WINDOWS_EXPORT_ALL_SYMBOLS property
+    // does not work well for Qt meta objects. AsyncImageProvider inherits
+    // from AsyncImageProviderBase, which relies on Qt meta object
+    // functionality and whose API is private. Therefore, instantiation of
+    // AsyncImageProvider is not possible, so the following unit tests cannot
+    // be built for MSVC shared libraries.
+
+    void testIdenticalParametersAreRenderedOnce()
+    {
+        SharedParameters parameters;
+        parameters.imageWidth = 5;
+        AsyncImageProvider<SharedParameters> first;
+        AsyncImageProvider<SharedParameters> second;
+        first.setImageParameters(parameters);
+        second.setImageParameters(parameters);
+        const int renderCount = SharedParameters::renderCount;
+        first.refreshAsync();
+        second.refreshAsync();
+        const auto &store = AsyncImageSharedStore<SharedParameters>::instance();
+        QCOMPARE(store.subscriberCount(parameters), qsizetype{2});
+        QCOMPARE(store.renderer(parameters), &first);
+        QTRY_VERIFY(first.isCacheUpToDate());
+        QVERIFY(second.isCacheUpToDate());
+        QCOMPARE(SharedParameters::renderCount.load(), renderCount + 1);
+        QCOMPARE(second.getCache().width(), 5);
+        // Both providers share the very same image data:
+        QCOMPARE(second.getCache().constBits(), first.getCache().constBits());
+        QCOMPARE(store.renderer(parameters), nullptr);
+    }
+
+    void testLateSubscriberGetsFinalImage()
+    {
+        SharedParameters parameters;
+        parameters.imageWidth = 6;
+        AsyncImageProvider<SharedParameters> first;
+        first.setImageParameters(parameters);
+        first.refreshAsync();
+        QTRY_VERIFY(first.isCacheUpToDate());
+        const int renderCount = SharedParameters::renderCount;
+        AsyncImageProvider<SharedParameters> second;
+        second.setImageParameters(parameters);
+        second.refreshAsync();
+        // Served immediately without rendering:
+        QVERIFY(second.isCacheUpToDate());
+        QCOMPARE(second.getCache().width(), 6);
+        QCOMPARE(SharedParameters::renderCount.load(), renderCount);
+    }
+
+    void testReferenceCounting()
+    {
+        SharedParameters parameters;
+        parameters.imageWidth = 7;
+        const auto &store = AsyncImageSharedStore<SharedParameters>::instance();
+        {
+            AsyncImageProvider<SharedParameters> first;
+            first.setImageParameters(parameters);
+            first.refreshAsync();
+            {
+                AsyncImageProvider<SharedParameters> second;
+                second.setImageParameters(parameters);
+                second.refreshAsync();
+                QCOMPARE(store.subscriberCount(parameters), qsizetype{2});
+            }
+            QCOMPARE(store.subscriberCount(parameters), qsizetype{1});
+            SharedParameters otherParameters;
+            otherParameters.imageWidth = 8;
+            first.setImageParameters(otherParameters);
+            first.refreshAsync();
+            QCOMPARE(store.subscriberCount(parameters), qsizetype{0});
+            QCOMPARE(store.subscriberCount(otherParameters), qsizetype{1});
+        }
+        QVERIFY(store.m_entries.isEmpty());
+    }
+
+    void testRendererHandsOver()
+    {
+        SharedParameters parameters;
+        parameters.imageWidth = 9;
+        QScopedPointer<AsyncImageProvider<SharedParameters>> first( //
+            new AsyncImageProvider<SharedParameters>);
+        AsyncImageProvider<SharedParameters> second;
+        first->setImageParameters(parameters);
+        second.setImageParameters(parameters);
+        first->refreshAsync();
+        second.refreshAsync();
+        const auto &store = AsyncImageSharedStore<SharedParameters>::instance();
+        QCOMPARE(store.renderer(parameters), first.data());
+        // The renderer goes away before delivering the final image:
+        first.reset();
+        QCOMPARE(store.renderer(parameters), &second);
+        QTRY_VERIFY(second.isCacheUpToDate());
+        QCOMPARE(second.getCache().width(), 9);
+    }
+
+    void testRenderCacheHitIsShared()
+    {
+        SharedParameters parameters;
+        parameters.imageWidth = 10;
+        AsyncImageProvider<SharedParameters> first;
+        first.setRenderCacheCapacity(1000000);
+        first.setImageParameters(parameters);
+        first.refreshAsync();
+        QTRY_VERIFY(first.isCacheUpToDate());
+        SharedParameters otherParameters;
+        otherParameters.imageWidth = 11;
+        first.setImageParameters(otherParameters);
+        first.refreshAsync();
+        QTRY_VERIFY(first.isCacheUpToDate());
+
+        // Now, “second” starts waiting for an image that only
+        // exists in the render cache of “first”.
+        AsyncImageProvider<SharedParameters> second;
+        second.setImageParameters(parameters);
+        second.refreshAsync();
+        first.setImageParameters(parameters);
+        first.refreshAsync();
+        QVERIFY(second.isCacheUpToDate());
+        QCOMPARE(second.getCache().width(), 10);
+    }
+
+#endif
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::TestAsyncImageSharedStore)
+
+// The following “include” is necessary because we do not use a header file:
+#include "testasyncimagesharedstore.moc"
@@ -14,9 +14,14 @@
 #include <qcoreevent.h>
 #include <qevent.h>
 #include <qglobal.h>
+#include <qimage.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpainter.h>
+#include <qpixmap.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qscopedpointer.h>
 #include <qsignalspy.h>
 #include <qsize.h>
@@ -197,6 +202,65 @@ private Q_SLOTS:
                  "Verify that the color is equal to the reference color.");
     }
 
+    void testHandleRegion()
+    {
+        ChromaHueDiagram myDiagram(LchSpace::CielchD50);
+        myDiagram.resize(200, 200);
+        GenericColor color;
+        color.first = 50;
+        color.second = 30;
+        color.third = 45;
+        myDiagram.setCurrentColorLch(color);
+        const QRegion region = myDiagram.d_pointer->handleRegion();
+        const QPointF handleCenter = //
+            myDiagram.d_pointer->widgetCoordinatesFromCurrentColorLch();
+        QVERIFY(region.contains(myDiagram.handleBoundingRect(handleCenter)));
+        QVERIFY(myDiagram.d_pointer->guideLine().has_value());
+        QVERIFY(region.contains(myDiagram.d_pointer->diagramCenter().toPoint()));
+        // The wheel handle is only part of the region while a mouse
+        // event is active:
+        const QPoint wheelHandlePoint = //
+            myDiagram.d_pointer->wheelHandleLine().center().toPoint();
+        QVERIFY(!region.contains(wheelHandlePoint));
+        myDiagram.d_pointer->m_isMouseEventActive = true;
+        QVERIFY(myDiagram.d_pointer->handleRegion().contains(wheelHandlePoint));
+        myDiagram.d_pointer->m_isMouseEventActive = false;
+        // The handle region does not cover the whole widget:
+        QVERIFY(!region.contains(myDiagram.rect()));
+    }
+
+    void testPartialRepaint()
+    {
+        ChromaHueDiagram myDiagram(LchSpace::CielchD50);
+        myDiagram.resize(QSize(200, 200));
+        myDiagram.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&myDiagram));
+        // Wait for the final image, so that the diagram itself does not
+        // change anymore:
+        myDiagram.repaint();
+        QTRY_VERIFY(myDiagram.d_pointer->m_chromaHueImage.isCacheUpToDate());
+        QImage screen = myDiagram.grab().toImage();
+
+        // Changing only the hue schedules a partial repaint of the old and
+        // the new handle region.
+        const QRegion oldHandleRegion = myDiagram.d_pointer->handleRegion();
+        GenericColor color = myDiagram.currentColorLch();
+        color.third += 10;
+        myDiagram.setCurrentColorLch(color);
+        const QRegion dirtyRegion = //
+            oldHandleRegion + myDiagram.d_pointer->handleRegion();
+
+        // Applying the partial repaint to the old pixels must give the
+        // same result as a full repaint.
+        QPainter painter(&screen);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect &rect : dirtyRegion) {
+            painter.drawImage(rect.topLeft(), myDiagram.grab(rect).toImage());
+        }
+        painter.end();
+        QCOMPARE(screen, myDiagram.grab().toImage());
+    }
+
     void testDiagramOffset()
     {
         PerceptualColor::ChromaHueDiagram myDiagram(LchSpace::CielchD50);
@@ -7,19 +7,23 @@
 // Second, the private implementation.
 #include "chromalightnessdiagram_p.h" // IWYU pragma: keep
 
+#include "asyncimagerenderscheduler.h"
 #include "constpropagatinguniquepointer.h"
 #include "genericcolor.h"
 #include "helper.h"
-#include "helpermath.h"
 #include "perceptualcolornamespace.h"
 #include <cmath>
 #include <limits>
 #include <qglobal.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpainter.h>
+#include <qpixmap.h>
 #include <qpoint.h>
 #include <qrect.h>
+#include <qregion.h>
 #include <qsignalspy.h>
 #include <qsize.h>
 #include <qtest.h>
@@ -373,6 +377,36 @@ private Q_SLOTS:
         QVERIFY(color.second > 25);
     }
 
+    void testMouseSupportDoesNotWaitForRendering()
+    {
+        ChromaLightnessDiagram myWidget{LchSpace::CielchD50};
+        myWidget.show();
+        constexpr int size = 100;
+        myWidget.resize(size, size);
+        auto &scheduler = AsyncImageRenderScheduler::instance();
+        scheduler.resetSynchronousWaitStatistics();
+        QTest::mousePress(&myWidget,
+                          Qt::MouseButton::LeftButton,
+                          Qt::KeyboardModifier::NoModifier,
+                          QPoint(size * 10 / 100, size * 50 / 100));
+        // Dragging out-of-gamut, while the hue changes between the
+        // mouse events, so that the image is never up-to-date.
+        for (int i = 0; i < 10; ++i) {
+            GenericColor color = myWidget.currentColorLch();
+            color.third = i * 30;
+            myWidget.setCurrentColorLch(color);
+            QTest::mouseMove(&myWidget, QPoint(size * 10, size * i / 10));
+        }
+        QTest::mouseRelease(&myWidget,
+                            Qt::MouseButton::LeftButton,
+                            Qt::KeyboardModifier::NoModifier,
+                            QPoint(size * 10, size * 50 / 100));
+        QCOMPARE(scheduler.synchronousWaitStatistics().count, quint64{0});
+        // Nevertheless, the result is in-gamut:
+        const GenericColor color = myWidget.currentColorLch();
+        QVERIFY(color.second > 25);
+    }
+
     void testPaintEventNormalSize()
     {
         ChromaLightnessDiagram myWidget{LchSpace::CielchD50};
@@ -568,6 +602,58 @@ private Q_SLOTS:
         QVERIFY(test.currentColorLch() == color);
     }
 
+    void testHandleWidgetRect()
+    {
+        ChromaLightnessDiagram test{LchSpace::CielchD50};
+        test.resize(200, 200);
+        GenericColor color;
+        color.first = 50;
+        color.second = 20;
+        color.third = 10;
+        test.setCurrentColorLch(color);
+        const QPointF center = //
+            test.d_pointer->handleCenterPhysical() / test.devicePixelRatioF();
+        const QRect handleRect = test.d_pointer->handleWidgetRect();
+        QVERIFY(handleRect.contains(center.toPoint()));
+        QVERIFY(handleRect.width() < test.width() / 2);
+        // Higher lightness moves the handle up:
+        color.first = 80;
+        test.setCurrentColorLch(color);
+        QVERIFY(test.d_pointer->handleWidgetRect().center().y() < handleRect.center().y());
+    }
+
+    void testPartialRepaint()
+    {
+        ChromaLightnessDiagram test{LchSpace::CielchD50};
+        test.resize(QSize(200, 200));
+        test.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&test));
+        // Wait for the final image, so that the diagram itself does not
+        // change anymore:
+        test.repaint();
+        QTRY_VERIFY(test.d_pointer->m_chromaLightnessImage.isCacheUpToDate());
+        QImage screen = test.grab().toImage();
+
+        // Changing only chroma schedules a partial repaint of the old and
+        // the new handle region.
+        const QRect oldHandleRect = test.d_pointer->handleWidgetRect();
+        GenericColor color = test.currentColorLch();
+        color.second += 5;
+        test.setCurrentColorLch(color);
+        const QRegion dirtyRegion = //
+            QRegion(oldHandleRect) + test.d_pointer->handleWidgetRect();
+
+        // Applying the partial repaint to the old pixels must give the
+        // same result as a full repaint.
+        QPainter painter(&screen);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect &rect : dirtyRegion) {
+            painter.drawImage(rect.topLeft(), test.grab(rect).toImage());
+        }
+        painter.end();
+        QCOMPARE(screen, test.grab().toImage());
+    }
+
     void testResizeEvent()
     {
         ChromaLightnessDiagram test{LchSpace::CielchD50};
@@ -768,64 +854,6 @@ private Q_SLOTS:
         static_assert(value == 0);
     }
 
-    void testNearestNeighborSearch()
-    {
-        // Setup
-        const auto doesExist = [](const QPoint point) -> bool {
-            // Our valid search rectangle is from (2, 2) to (8, 8).
-            if (isInRange(-2, point.x(), 8) && isInRange(-2, point.y(), 8)) {
-                QList<QPoint> existingPoints({//
-                                              QPoint(-2, -2),
-                                              QPoint(5, 5),
-                                              QPoint(8, 8)});
-                return existingPoints.contains(point);
-            }
-            // A correct implementation of nearestNeighborSearch should never
-            // call the callback function with values outside the valid range,
-            // so we should never get here:
-            return true;
-        };
-        constexpr auto boundingBox = QRect(QPoint(-2, -2), QSize(11, 11));
-        QVERIFY(boundingBox.contains(QPoint(-3, -3)) == false); // assert
-        QVERIFY(boundingBox.contains(QPoint(-2, -2))); // assert
-        QVERIFY(boundingBox.contains(QPoint(8, 8))); // assert
-        QVERIFY(boundingBox.contains(QPoint(9, 9)) == false); // assert
-
-        // Actual tests
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-2, -2), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-1, -2), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-2, -1), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-3, -2), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-2, -3), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-3, -3), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(1, 1), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(4, 4), boundingBox, doesExist), //
-                 QPoint(5, 5));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(5, 5), boundingBox, doesExist), //
-                 QPoint(5, 5));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-100, 5), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-100, -100), boundingBox, doesExist), //
-                 QPoint(-2, -2));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(100, 100), boundingBox, doesExist), //
-                 QPoint(8, 8));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(7, 100), boundingBox, doesExist), //
-                 QPoint(8, 8));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(100, 7), boundingBox, doesExist), //
-                 QPoint(8, 8));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(-2, 8), boundingBox, doesExist), //
-                 QPoint(5, 5));
-        QCOMPARE(ChromaLightnessDiagramPrivate::nearestNeighborSearch(QPoint(8, -2), boundingBox, doesExist), //
-                 QPoint(5, 5));
-    }
-
     void testInfoButtonCielchD50()
     {
         ChromaLightnessDiagram myWidget{LchSpace::CielchD50};
@@ -5,15 +5,21 @@
 // this forces the header to be self-contained.
 #include "chromalightnessimageparameters.h"
 
+#include "absolutecolor.h"
 #include "asyncimageprovider.h"
 #include "asyncimagerendercallback.h"
+#include "genericcolor.h"
 #include "helper.h"
+#include "nearestfeaturemap.h"
 #include "perceptualcolornamespace.h"
 #include <qbenchmark.h>
 #include <qcolor.h>
 #include <qglobal.h>
 #include <qimage.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qpoint.h>
+#include <qrgb.h>
 #include <qsize.h>
 #include <qtest.h>
 #include <qtestcase.h>
@@ -293,6 +299,118 @@ private Q_SLOTS:
         Q_UNUSED(m_imageProvider.getCache())
     }
 
+    void testRenderMatchesGamut_data()
+    {
+        QTest::addColumn<qreal>("hue");
+        QTest::addColumn<LchSpace>("projectionSpace");
+        QTest::newRow("CielchD50 0") << 0. << LchSpace::CielchD50;
+        QTest::newRow("CielchD50 98") << 98. << LchSpace::CielchD50;
+        QTest::newRow("CielchD50 250") << 250. << LchSpace::CielchD50;
+        QTest::newRow("Oklch 0") << 0. << LchSpace::Oklch;
+        QTest::newRow("Oklch 140") << 140. << LchSpace::Oklch;
+        QTest::newRow("Oklch 264.1") << 264.1 << LchSpace::Oklch;
+    }
+
+    void testRenderMatchesGamut()
+    {
+        QFETCH(qreal, hue);
+        QFETCH(LchSpace, projectionSpace);
+        ChromaLightnessImageParameters parameters;
+        parameters.hue = hue;
+        parameters.projectionSpace = projectionSpace;
+        parameters.imageSizePhysical = QSize(80, 60);
+        Mockup myMockup;
+        parameters.render(QVariant::fromValue(parameters), myMockup);
+        const QImage image = myMockup.lastDeliveredImage();
+        const QImage mask = myMockup.lastDeliveredMask();
+        QCOMPARE(image.size(), parameters.imageSizePhysical);
+        QCOMPARE(mask.size(), parameters.imageSizePhysical);
+
+        const double maximumLightness = (projectionSpace == LchSpace::Oklch) //
+            ? 1.
+            : 100.;
+        const double valuesPerPixel = //
+            maximumLightness / parameters.imageSizePhysical.height();
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                const GenericColor lch{maximumLightness - (y + 0.5) * valuesPerPixel, //
+                                       (x + 0.5) * valuesPerPixel,
+                                       hue};
+                const bool isInGamut = //
+                    AbsoluteColor::isLchInSRgbGamut(lch, projectionSpace);
+                // The mask contains exactly the pixels whose center
+                // is in-gamut.
+                QCOMPARE(mask.pixelColor(x, y) == Qt::black, isInGamut);
+                // Pixels that are entirely in-gamut are not touched by
+                // the anti-aliasing.
+                const auto coversPixel = [&](const double lightness) {
+                    const auto intervals = AbsoluteColor::inGamutChromaIntervals( //
+                        lightness,
+                        hue,
+                        image.width() * valuesPerPixel,
+                        projectionSpace);
+                    for (const auto &interval : intervals) {
+                        if (interval.first <= x * valuesPerPixel && (x + 1) * valuesPerPixel <= interval.second) {
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+                const bool neighboursInGamut = coversPixel(lch.first + valuesPerPixel / 2) //
+                    && coversPixel(lch.first) //
+                    && coversPixel(lch.first - valuesPerPixel / 2);
+                if (isInGamut && neighboursInGamut) {
+                    QCOMPARE(qAlpha(image.pixel(x, y)), 255);
+                }
+            }
+        }
+    }
+
+    void testNearestMaskPixel_data()
+    {
+        testRenderMatchesGamut_data();
+    }
+
+    void testNearestMaskPixel()
+    {
+        QFETCH(qreal, hue);
+        QFETCH(LchSpace, projectionSpace);
+        ChromaLightnessImageParameters parameters;
+        parameters.hue = hue;
+        parameters.projectionSpace = projectionSpace;
+        parameters.imageSizePhysical = QSize(40, 30);
+        Mockup myMockup;
+        parameters.render(QVariant::fromValue(parameters), myMockup);
+        const QImage mask = myMockup.lastDeliveredMask();
+        const auto map = NearestFeatureMap::fromMask(mask);
+        const auto distanceSquare = [](const QPoint a, const QPoint b) {
+            const QPoint difference = a - b;
+            return QPoint::dotProduct(difference, difference);
+        };
+        // The analytical result is as near as the one of the rendered mask.
+        for (int y = -2; y < mask.height() + 2; ++y) {
+            for (int x = -2; x < mask.width() + 2; ++x) {
+                const QPoint point(x, y);
+                const auto expected = map.nearestFeature(point);
+                const auto actual = parameters.nearestMaskPixel(point);
+                QVERIFY(expected.has_value());
+                QVERIFY(actual.has_value());
+                QCOMPARE(mask.pixelColor(actual.value()), QColor(Qt::black));
+                const QPoint clamped(qBound(0, x, mask.width() - 1), //
+                                     qBound(0, y, mask.height() - 1));
+                QCOMPARE(distanceSquare(actual.value(), clamped), //
+                         distanceSquare(expected.value(), clamped));
+            }
+        }
+    }
+
+    void testNearestMaskPixelEmptyImage()
+    {
+        ChromaLightnessImageParameters parameters;
+        parameters.imageSizePhysical = QSize(0, 0);
+        QVERIFY(!parameters.nearestMaskPixel(QPoint(0, 0)).has_value());
+    }
+
     void benchmarkRenderCielchD50()
     {
         ChromaLightnessImageParameters testProperties;
@@ -26,12 +26,12 @@
 #include <qbytearray.h>
 #include <qcolor.h>
 #include <qcolordialog.h>
+#include <qcombobox.h>
 #include <qcontainerfwd.h>
 #include <qcoreapplication.h>
 #include <qcoreevent.h>
 #include <qdebug.h>
 #include <qglobal.h>
-#include <qhash.h>
 #include <qlineedit.h>
 #include <qlist.h>
 #include <qlocale.h>
@@ -1063,6 +1063,9 @@ private Q_SLOTS:
         m_perceptualDialog.reset( //
             new ColorDialog(id.toString()));
         m_perceptualDialog->show();
+        // Wait until all pages have been created in idle time.
+        QTRY_VERIFY(!m_perceptualDialog->d_pointer->m_chromaHueDiagram.isNull());
+        QVERIFY(!m_perceptualDialog->d_pointer->m_wheelColorPicker.isNull());
         constexpr auto testColor = Qt::yellow;
         m_perceptualDialog->setCurrentColor(testColor);
 
@@ -1644,6 +1647,7 @@ private Q_SLOTS:
     {
         QScopedPointer<ColorDialog> myDialog( //
             new ColorDialog(id.toString()));
+        myDialog->d_pointer->initializeLightnessFirstPage();
         myDialog->d_pointer->m_lchLightnessSelector->setValue(0.6);
         myDialog->d_pointer->readLightnessValue();
         const auto &color = myDialog->d_pointer->m_currentOpaqueColorAbs;
@@ -1886,6 +1890,109 @@ private Q_SLOTS:
     }
 #endif
 
+    void testHiddenDialogUpdatesAllWidgets()
+    {
+        QScopedPointer<ColorDialog> myDialog( //
+            new ColorDialog(id.toString()));
+        myDialog->setCurrentColor(QColor(10, 20, 30));
+        QVERIFY(myDialog->d_pointer->m_outdatedWidgets.isEmpty());
+        QCOMPARE(myDialog->d_pointer->m_rgbLineEdit->text(), //
+                 QStringLiteral("#0a141e"));
+    }
+
+    void testDeferredUpdateOfHiddenWidgets()
+    {
+        QScopedPointer<ColorDialog> myDialog( //
+            new ColorDialog(id.toString()));
+        myDialog->setLayoutDimensions( //
+            ColorDialog::DialogLayoutDimensions::Collapsed);
+        myDialog->show();
+        myDialog->setCurrentColor(QColor(10, 20, 30));
+
+        // Visible widgets are updated immediately, hidden ones are deferred.
+        const QList<QWidget *> widgets = myDialog->d_pointer->colorWidgets();
+        for (QWidget *widget : widgets) {
+            QCOMPARE(myDialog->d_pointer->m_outdatedWidgets.contains(widget), //
+                     !widget->isVisible());
+        }
+        // In the collapsed layout, some widgets are always on hidden tabs:
+        QVERIFY(!myDialog->d_pointer->m_outdatedWidgets.isEmpty());
+
+        // Several changes are coalesced into a single update
+        // when the widget becomes visible.
+        myDialog->setCurrentColor(QColor(40, 50, 60));
+        myDialog->setCurrentColor(QColor(70, 80, 90));
+        const int tabCount = myDialog->d_pointer->m_tabWidget->count();
+        for (int i = 0; i < tabCount; ++i) {
+            myDialog->d_pointer->m_tabWidget->setCurrentIndex(i);
+            for (QWidget *widget : widgets) {
+                if (widget->isVisible()) {
+                    QVERIFY(!myDialog->d_pointer->m_outdatedWidgets.contains(widget));
+                }
+            }
+        }
+        const QList<double> expectedRgb{70, 80, 90};
+        QCOMPARE(myDialog->d_pointer->m_rgbSpinBox->values(), expectedRgb);
+        QCOMPARE(myDialog->d_pointer->m_rgbLineEdit->text(), //
+                 QStringLiteral("#46505a"));
+        // Updating outdated widgets does not change the current color.
+        QCOMPARE(myDialog->currentColor(), QColor(70, 80, 90));
+    }
+
+    void testLazyPages()
+    {
+        QScopedPointer<ColorDialog> myDialog( //
+            new ColorDialog(id.toString()));
+        myDialog->setLayoutDimensions( //
+            ColorDialog::DialogLayoutDimensions::Collapsed);
+        myDialog->setCurrentColor(QColor(10, 20, 30));
+
+        // Before the dialog is shown, the graphical pages are not created.
+        QVERIFY(myDialog->d_pointer->m_swatchBookBasicColors.isNull());
+        QVERIFY(myDialog->d_pointer->m_wheelColorPicker.isNull());
+        QVERIFY(myDialog->d_pointer->m_chromaHueDiagram.isNull());
+        QVERIFY(myDialog->d_pointer->m_lchLightnessSelector.isNull());
+        // The tabs are nevertheless available.
+        QVERIFY( //
+            myDialog->d_pointer->m_tabWidget->indexOf( //
+                myDialog->d_pointer->m_hueFirstWrapperWidget)
+            >= 0);
+
+        // Switching to a tab creates its page.
+        myDialog->d_pointer->m_tabWidget->setCurrentWidget( //
+            myDialog->d_pointer->m_hueFirstWrapperWidget);
+        QVERIFY(!myDialog->d_pointer->m_wheelColorPicker.isNull());
+        QVERIFY(myDialog->d_pointer->m_chromaHueDiagram.isNull());
+
+        // Newly created pages show the current color, without changing it.
+        const auto tmp = myDialog->d_pointer->m_currentOpaqueColorAbs;
+        const GenericColor expectedLch = //
+            (myDialog->d_pointer->m_projectionSpace == LchSpace::CielchD50) //
+            ? tmp.value(ColorModel::CielchD50) //
+            : tmp.value(ColorModel::OklchD65);
+        QVERIFY(myDialog->d_pointer->m_wheelColorPicker->currentColorLch() //
+                == expectedLch);
+        QCOMPARE(myDialog->currentColor(), QColor(10, 20, 30));
+
+        // Creating a page twice has no effect.
+        const QPointer<WheelColorPicker> picker = //
+            myDialog->d_pointer->m_wheelColorPicker;
+        myDialog->d_pointer->initializeHueFirstPage();
+        QCOMPARE(myDialog->d_pointer->m_wheelColorPicker, picker);
+
+        // After showing the dialog, the remaining pages are created when
+        // the event loop is idle.
+        myDialog->show();
+        QTRY_VERIFY(!myDialog->d_pointer->m_chromaHueDiagram.isNull());
+        QVERIFY(!myDialog->d_pointer->m_swatchBookBasicColors.isNull());
+        QVERIFY(!myDialog->d_pointer->m_lchLightnessSelector.isNull());
+        QVERIFY(myDialog->d_pointer->m_chromaHueDiagram->currentColorLch() //
+                == expectedLch);
+        QCOMPARE(myDialog->d_pointer->m_swatchBookSelector->count(), 3);
+        QVERIFY(!myDialog->d_pointer->m_swatchBookSelector->itemText(0).isEmpty());
+        QCOMPARE(myDialog->currentColor(), QColor(10, 20, 30));
+    }
+
     void testUpdateColorPatch()
     {
         QScopedPointer<ColorDialog> myDialog( //
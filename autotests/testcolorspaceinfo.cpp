@@ -5,8 +5,13 @@
 // this forces the header to be self-contained.
 #include "colorspaceinfo.h"
 
+#include "blackhole.h"
 #include "helpermath.h"
+#include "perceptualcolornamespace.h"
+#include <qbenchmark.h>
 #include <qglobal.h>
+#include <qnumeric.h>
+#include <qrgb.h>
 #include <qobject.h>
 #include <qstring.h>
 #include <qtest.h>
@@ -82,6 +87,54 @@ private Q_SLOTS:
         Q_UNUSED(temp);
     }
 
+    void testMaxChromaRgbByHue360()
+    {
+        // At the sample points of the table, the fast lookup must match the
+        // exact lookup.
+        for (const auto type : {LchSpace::CielchD50, LchSpace::Oklch}) {
+            for (int i = 0; i <= 360 * ColorSpaceInfo::quantizedHueResolution; ++i) {
+                const double hue = static_cast<double>(i) / ColorSpaceInfo::quantizedHueResolution;
+                QCOMPARE(ColorSpaceInfo::maxChromaRgbByHue360(hue, type), //
+                         ColorSpaceInfo::maxChromaColorByHue360(hue, type).rgb());
+            }
+        }
+    }
+
+    void testMaxChromaRgbByHue360OutOfRange()
+    {
+        for (const auto type : {LchSpace::CielchD50, LchSpace::Oklch}) {
+            QCOMPARE(ColorSpaceInfo::maxChromaRgbByHue360(-10, type), //
+                     ColorSpaceInfo::maxChromaRgbByHue360(0, type));
+            QCOMPARE(ColorSpaceInfo::maxChromaRgbByHue360(370, type), //
+                     ColorSpaceInfo::maxChromaRgbByHue360(360, type));
+            QCOMPARE(qAlpha(ColorSpaceInfo::maxChromaRgbByHue360(qQNaN(), type)), 255);
+        }
+    }
+
+    void testChromaticityBoundarySorted()
+    {
+        for (const auto type : {LchSpace::CielchD50, LchSpace::Oklch}) {
+            const auto &boundary = (type == LchSpace::CielchD50) //
+                ? ColorSpaceInfo::instance().m_chromaticityBoundaryByCielchD50Hue360
+                : ColorSpaceInfo::instance().m_chromaticityBoundaryByOklabHue360;
+            QCOMPARE(boundary.hues.size(), boundary.rgb.size());
+            QVERIFY(boundary.hues.constFirst() < 0);
+            QVERIFY(boundary.hues.constLast() > 360);
+            for (qsizetype i = 1; i < boundary.hues.size(); ++i) {
+                QVERIFY(boundary.hues.at(i - 1) < boundary.hues.at(i));
+            }
+        }
+    }
+
+    void benchmarkMaxChromaRgbByHue360()
+    {
+        QBENCHMARK {
+            for (int i = 0; i < 360000; ++i) {
+                blackhole(ColorSpaceInfo::maxChromaRgbByHue360(i / 1000.0, LchSpace::Oklch));
+            }
+        }
+    }
+
     void testCielabD50BlackpointL()
     {
         QVERIFY(isInRange<double>(0, ColorSpaceInfo::cielabD50BlackpointL(), 1));
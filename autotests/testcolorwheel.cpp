@@ -13,10 +13,16 @@
 #include <qapplication.h>
 #include <qboxlayout.h>
 #include <qglobal.h>
+#include <qimage.h>
+#include <qline.h>
 #include <qlineedit.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpainter.h>
+#include <qpixmap.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qsignalspy.h>
 #include <qsize.h>
 #include <qtest.h>
@@ -124,6 +130,53 @@ private Q_SLOTS:
         QCOMPARE(myWheel.hue(), referenceHue);
     }
 
+    void testHandleLine()
+    {
+        ColorWheel myWheel(LchSpace::CielchD50);
+        myWheel.resize(200, 200);
+        myWheel.setHue(0);
+        const QLineF line = myWheel.d_pointer->handleLine();
+        // Hue 0 is on the right side of the wheel:
+        QVERIFY(line.p1().x() > 100);
+        QVERIFY(line.p2().x() > line.p1().x());
+        QCOMPARE(line.p1().y(), line.p2().y());
+        QVERIFY(line.length() > 0);
+        // The handle does not cover the whole widget:
+        const QRect handleRect = myWheel.lineBoundingRect( //
+            line,
+            myWheel.handleOutlineThickness());
+        QVERIFY(handleRect.width() < myWheel.width() / 2);
+    }
+
+    void testPartialRepaint()
+    {
+        ColorWheel myWheel(LchSpace::CielchD50);
+        myWheel.resize(QSize(200, 200));
+        myWheel.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&myWheel));
+        QImage screen = myWheel.grab().toImage();
+
+        // Changing the hue schedules a partial repaint of the old and
+        // the new handle region.
+        const QRect oldHandleRect = myWheel.lineBoundingRect( //
+            myWheel.d_pointer->handleLine(),
+            myWheel.handleOutlineThickness());
+        myWheel.setHue(123);
+        const QRegion dirtyRegion = QRegion(oldHandleRect) //
+            + myWheel.lineBoundingRect(myWheel.d_pointer->handleLine(), //
+                                       myWheel.handleOutlineThickness());
+
+        // Applying the partial repaint to the old pixels must give the
+        // same result as a full repaint.
+        QPainter painter(&screen);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect &rect : dirtyRegion) {
+            painter.drawImage(rect.topLeft(), myWheel.grab(rect).toImage());
+        }
+        painter.end();
+        QCOMPARE(screen, myWheel.grab().toImage());
+    }
+
     void testMinimumSizeHint()
     {
         ColorWheel myColorWheel(LchSpace::CielchD50);
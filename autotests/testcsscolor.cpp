@@ -6,12 +6,12 @@
 #include "csscolor.h"
 
 #include "genericcolor.h"
+#include "multimodelcolor.h"
 #include "perceptualcolornamespace.h"
 #include <numbers>
 #include <optional>
 #include <qcontainerfwd.h>
 #include <qdebug.h>
-#include <qhash.h>
 #include <qlist.h>
 #include <qobject.h>
 #include <qrgb.h>
@@ -1100,14 +1100,16 @@ private Q_SLOTS:
 #ifndef MSVC_DLL
     void testGenerateCss()
     {
-        QHash<ColorModel, GenericColor> hash;
-        hash.insert(ColorModel::OklchD65, GenericColor(0.5, 0.2, 10));
-        QCOMPARE(CssColor::generateCss(hash, 1, 3).value(0), //
+        const MultiModelColor color(ColorModel::OklchD65, GenericColor(0.5, 0.2, 10));
+        QCOMPARE(CssColor::generateCss(color, 1, 3).value(0), //
                  QStringLiteral("oklch(0.50 0.20 10)"));
-        QCOMPARE(CssColor::generateCss(hash, 0.5, 3).value(0), //
+        QCOMPARE(CssColor::generateCss(color, 0.5, 3).value(0), //
                  QStringLiteral("oklch(0.50 0.20 10 / 50%)"));
+        QCOMPARE(CssColor::generateCss(color, 1, 3).count(), 6);
+        QVERIFY(CssColor::generateCss(color, 1, 3).value(1).startsWith( //
+            QStringLiteral("oklab(")));
         const auto roundtrip = CssColor::parse( //
-            CssColor::generateCss(hash, 0.5, 3).value(0));
+            CssColor::generateCss(color, 0.5, 3).value(0));
         QCOMPARE(roundtrip.alpha1, 0.5);
         QCOMPARE(roundtrip.model, ColorModel::OklchD65);
         QCOMPARE(roundtrip.rgbColorSpace, //
@@ -11,9 +11,14 @@
 #include "genericcolor.h"
 #include "perceptualcolornamespace.h"
 #include <qglobal.h>
+#include <qimage.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpainter.h>
+#include <qpixmap.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qsignalspy.h>
 #include <qsize.h>
 #include <qsizepolicy.h>
@@ -309,6 +314,59 @@ private Q_SLOTS:
         testSlider.repaint();
     }
 
+    void testHandleWidgetRect()
+    {
+        GradientSlider testSlider(LchSpace::CielchD50, Qt::Horizontal);
+        testSlider.resize(200, 20);
+        testSlider.setValue(0.5);
+        QRect handleRect = testSlider.d_pointer->handleWidgetRect();
+        QVERIFY(handleRect.contains(QPoint(100, 5)));
+        QVERIFY(handleRect.width() < 50);
+        testSlider.setLayoutDirection(Qt::RightToLeft);
+        testSlider.setValue(0.25);
+        handleRect = testSlider.d_pointer->handleWidgetRect();
+        QVERIFY(handleRect.contains(QPoint(150, 5)));
+        QVERIFY(!handleRect.contains(QPoint(50, 5)));
+
+        testSlider.setOrientation(Qt::Vertical);
+        testSlider.setLayoutDirection(Qt::LeftToRight);
+        testSlider.resize(20, 200);
+        handleRect = testSlider.d_pointer->handleWidgetRect();
+        // Vertical sliders have the first color at the bottom:
+        QVERIFY(handleRect.contains(QPoint(5, 150)));
+        QVERIFY(handleRect.height() < 50);
+    }
+
+    void testPartialRepaint()
+    {
+        GradientSlider testSlider(LchSpace::CielchD50, Qt::Horizontal);
+        testSlider.resize(QSize(200, 30));
+        testSlider.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&testSlider));
+        // Wait for the final image, so that the gradient itself does not
+        // change anymore:
+        testSlider.repaint();
+        QTRY_VERIFY(testSlider.d_pointer->m_gradientImage.isCacheUpToDate());
+        QImage screen = testSlider.grab().toImage();
+
+        // Changing the value schedules a partial repaint of the old and
+        // the new handle region.
+        const QRect oldHandleRect = testSlider.d_pointer->handleWidgetRect();
+        testSlider.setValue(0.1);
+        const QRegion dirtyRegion = //
+            QRegion(oldHandleRect) + testSlider.d_pointer->handleWidgetRect();
+
+        // Applying the partial repaint to the old pixels must give the
+        // same result as a full repaint.
+        QPainter painter(&screen);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect &rect : dirtyRegion) {
+            painter.drawImage(rect.topLeft(), testSlider.grab(rect).toImage());
+        }
+        painter.end();
+        QCOMPARE(screen, testSlider.grab().toImage());
+    }
+
     void testVerySmallWidgetSizes()
     {
         // Also very small widget sizes should not crash the widget.
@@ -5,10 +5,12 @@
 // this forces the header to be self-contained.
 #include "helperimage.h"
 
+#include <functional>
 #include <qcolor.h>
 #include <qglobal.h>
 #include <qimage.h>
 #include <qlist.h>
+#include <qmath.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qpoint.h>
@@ -69,6 +71,80 @@ private Q_SLOTS:
         Q_UNUSED(boundary)
     }
 
+    void testFindBoundarySquare()
+    {
+        // An opaque 2 × 2 square within a transparent 6 × 5 image.
+        QImage image{QSize(6, 5), QImage::Format_ARGB32_Premultiplied};
+        image.fill(Qt::transparent);
+        image.setPixelColor(2, 1, Qt::red);
+        image.setPixelColor(3, 1, Qt::red);
+        image.setPixelColor(2, 2, Qt::red);
+        image.setPixelColor(3, 2, Qt::red);
+        // All pixels of the square and all pixels of its 4 × 4 neighborhood,
+        // in row order.
+        QList<QPoint> expected;
+        for (int y = 0; y <= 3; ++y) {
+            for (int x = 1; x <= 4; ++x) {
+                expected.append(QPoint(x, y));
+            }
+        }
+        QCOMPARE(findBoundary(image), expected);
+
+        const auto mask = findBoundaryMask(image);
+        QCOMPARE(mask.width, 6);
+        QCOMPARE(mask.height, 5);
+        QCOMPARE(mask.count(), expected.size());
+        QCOMPARE(mask.coordinates(), expected);
+        QVERIFY(mask.isBoundary(1, 0));
+        QVERIFY(!mask.isBoundary(0, 0));
+        QVERIFY(!mask.isBoundary(5, 4));
+        QVERIFY(!mask.isBoundary(-1, 0));
+        QVERIFY(!mask.isBoundary(6, 0));
+    }
+
+    void testFindBoundaryOtherFormat()
+    {
+        // Images without alpha channel have no boundary.
+        QImage image{QSize(4, 4), QImage::Format_RGB888};
+        image.fill(Qt::red);
+        QCOMPARE(findBoundaryMask(image).count(), 0);
+        // Non-premultiplied images work, too.
+        QImage argb{QSize(3, 1), QImage::Format_ARGB32};
+        argb.fill(Qt::transparent);
+        argb.setPixelColor(2, 0, Qt::red);
+        QCOMPARE(findBoundary(argb), QList<QPoint>({QPoint(1, 0), QPoint(2, 0)}));
+    }
+
+    void testFindBoundaryLarge()
+    {
+        // A large image, to make sure that the row bands processed by
+        // different threads fit together.
+        constexpr int size = 301;
+        QImage image{QSize(size, size), QImage::Format_ARGB32_Premultiplied};
+        image.fill(Qt::transparent);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (qPow(x - 150, 2) + qPow(y - 150, 2) <= 100 * 100) {
+                    image.setPixelColor(x, y, Qt::red);
+                }
+            }
+        }
+        const auto coordinates = findBoundary(image);
+        QVERIFY(!coordinates.isEmpty());
+        for (qsizetype i = 1; i < coordinates.size(); ++i) {
+            const auto previous = coordinates.at(i - 1);
+            const auto current = coordinates.at(i);
+            // Row order
+            QVERIFY((previous.y() < current.y()) //
+                    || ((previous.y() == current.y()) && (previous.x() < current.x())));
+        }
+        for (const auto &point : coordinates) {
+            // Each boundary pixel is close to the circle line.
+            const auto distance = qSqrt(qPow(point.x() - 150, 2) + qPow(point.y() - 150, 2));
+            QVERIFY(qAbs(distance - 100) < 2);
+        }
+    }
+
     void testDoAntialias()
     {
         const auto myColorFunction = [](const double, const double) -> QRgb {
@@ -78,6 +154,117 @@ private Q_SLOTS:
         QImage myImage;
         // Does not crash on empty image
         doAntialias(myImage, QList<QPoint>(), myColorFunction);
+        doAntialias(myImage, BoundaryMask(), myColorFunction);
+    }
+
+    void testDoAntialiasAdaptive()
+    {
+        // A disk that is in-gamut, everything else is out-of-gamut.
+        const auto myColorFunction = [](const double x, const double y) -> QRgb {
+            if (qPow(x - 50.2, 2) + qPow(y - 50.2, 2) <= qPow(40.3, 2)) {
+                return qRgb(255, qBound(0, qRound(x * 2), 255), 0);
+            }
+            return qRgbTransparent;
+        };
+        QImage image{QSize(101, 101), QImage::Format_ARGB32_Premultiplied};
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                image.setPixel(x, y, myColorFunction(x, y));
+            }
+        }
+        const auto boundary = findBoundaryMask(image);
+        QImage uniformImage = image;
+        doAntialias(uniformImage, boundary, myColorFunction, AntialiasMode::Uniform);
+        QImage adaptiveImage = image;
+        doAntialias(adaptiveImage, boundary, myColorFunction, AntialiasMode::Adaptive);
+        int maximumAlphaDifference = 0;
+        int maximumRedDifference = 0;
+        for (const QPoint &point : boundary.coordinates()) {
+            const auto uniformColor = uniformImage.pixel(point);
+            const auto adaptiveColor = adaptiveImage.pixel(point);
+            maximumAlphaDifference = qMax( //
+                maximumAlphaDifference,
+                qAbs(qAlpha(uniformColor) - qAlpha(adaptiveColor)));
+            maximumRedDifference = qMax( //
+                maximumRedDifference,
+                qAbs(qRed(uniformColor) - qRed(adaptiveColor)));
+        }
+        // The boundary of the disk is locally nearly straight, so the
+        // results are (nearly) identical.
+        QVERIFY(maximumAlphaDifference <= 2);
+        QVERIFY(maximumRedDifference <= 2);
+    }
+
+    void testDoAntialiasAdaptiveCorner()
+    {
+        // A square rotated by 45°. At its tips, the boundary is not
+        // straight, so the analytic coverage must not be used there.
+        const auto myColorFunction = [](const double x, const double y) -> QRgb {
+            if (qAbs(x - 20.2) + qAbs(y - 20.3) <= 12.7) {
+                return qRgb(0, 0, 255);
+            }
+            return qRgbTransparent;
+        };
+        QImage image{QSize(41, 41), QImage::Format_ARGB32_Premultiplied};
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                image.setPixel(x, y, myColorFunction(x, y));
+            }
+        }
+        const auto boundary = findBoundaryMask(image);
+        QImage uniformImage = image;
+        doAntialias(uniformImage, boundary, myColorFunction, AntialiasMode::Uniform);
+        QImage adaptiveImage = image;
+        doAntialias(adaptiveImage, boundary, myColorFunction, AntialiasMode::Adaptive);
+        for (const QPoint &point : boundary.coordinates()) {
+            QVERIFY(qAbs(qAlpha(uniformImage.pixel(point)) - qAlpha(adaptiveImage.pixel(point))) <= 2);
+        }
+    }
+
+    void testDoAntialiasStraightEdge()
+    {
+        // A straight vertical edge at x = 4.3 crosses the pixel at x = 4.
+        const auto myColorFunction = [](const double x, const double) -> QRgb {
+            return (x < 4.3) ? qRgb(0, 0, 255) : qRgbTransparent;
+        };
+        for (const auto mode : {AntialiasMode::Uniform, AntialiasMode::Adaptive}) {
+            QImage image{QSize(8, 3), QImage::Format_ARGB32_Premultiplied};
+            for (int y = 0; y < image.height(); ++y) {
+                for (int x = 0; x < image.width(); ++x) {
+                    image.setPixel(x, y, myColorFunction(x, y));
+                }
+            }
+            doAntialias(image, findBoundaryMask(image), myColorFunction, mode);
+            // 13 of 16 columns of data points are in-gamut.
+            QCOMPARE(qAlpha(image.pixel(4, 1)), qRound(13.0 / 16 * 255));
+            QCOMPARE(qAlpha(image.pixel(3, 1)), 255);
+            QCOMPARE(qAlpha(image.pixel(5, 1)), 0);
+        }
+    }
+
+    void testDoAntialiasStdFunction()
+    {
+        // The std::function overload and the template overload give
+        // identical results.
+        const auto myLambda = [](const double x, const double y) -> QRgb {
+            return (x + y < 7.3) ? qRgb(0, 255, 0) : qRgbTransparent;
+        };
+        const std::function<QRgb(const double x, const double y)> myFunction = myLambda;
+        QImage image{QSize(8, 8), QImage::Format_ARGB32_Premultiplied};
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                image.setPixel(x, y, myLambda(x, y));
+            }
+        }
+        const auto boundary = findBoundaryMask(image);
+        QImage templateImage = image;
+        doAntialias(templateImage, boundary, myLambda);
+        QImage functionImage = image;
+        doAntialias(functionImage, boundary, myFunction);
+        QCOMPARE(templateImage, functionImage);
+        QImage listImage = image;
+        doAntialias(listImage, boundary.coordinates(), myLambda);
+        QCOMPARE(listImage, functionImage);
     }
 
     void testSnippet01()
@@ -0,0 +1,160 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// First included header is the public header of the class we are testing;
+// this forces the header to be self-contained.
+#include "multimodelcolor.h"
+
+#include "absolutecolor.h"
+#include "genericcolor.h"
+#include "perceptualcolornamespace.h"
+#include <cstddef>
+#include <qdebug.h>
+#include <qglobal.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtmetamacros.h>
+#include <type_traits>
+
+namespace PerceptualColor
+{
+
+class TestMultiModelColor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestMultiModelColor(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private:
+    static constexpr auto lastModel = static_cast<int>(ColorModel::XyzD65_1);
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Called before the first test function is executed
+    }
+
+    void cleanupTestCase()
+    {
+        // Called after the last test function was executed
+    }
+
+    void init()
+    {
+        // Called before each test function is executed
+    }
+
+    void cleanup()
+    {
+        // Called after every test function
+    }
+
+    void testTraits()
+    {
+        static_assert(std::is_trivially_copyable_v<MultiModelColor>);
+        static_assert(std::is_standard_layout_v<MultiModelColor>);
+        static_assert(std::is_nothrow_default_constructible_v<MultiModelColor>);
+        static_assert(std::is_trivially_destructible_v<MultiModelColor>);
+    }
+
+    void testSlotCount()
+    {
+        QCOMPARE(MultiModelColor::slotCount, //
+                 static_cast<std::size_t>(lastModel + 1));
+    }
+
+    void testDefaultConstructor()
+    {
+        const MultiModelColor myColor;
+        QCOMPARE(myColor.sourceModel(), ColorModel::Invalid);
+        for (int i = 0; i <= lastModel; ++i) {
+            const auto model = static_cast<ColorModel>(i);
+            QVERIFY(!myColor.contains(model));
+            QCOMPARE(myColor.value(model), GenericColor());
+        }
+    }
+
+    void testConstructor()
+    {
+        const GenericColor oklch(0.5, 0.1, 30);
+        const MultiModelColor myColor(ColorModel::OklchD65, oklch);
+        QCOMPARE(myColor.sourceModel(), ColorModel::OklchD65);
+        QVERIFY(myColor.contains(ColorModel::OklchD65));
+        QCOMPARE(myColor.value(ColorModel::OklchD65), oklch);
+    }
+
+    void testNotAvailable()
+    {
+        const MultiModelColor myColor(ColorModel::OklchD65, GenericColor(0.5, 0.1, 30));
+        QVERIFY(!myColor.contains(ColorModel::Hsl_360_1_1));
+        QCOMPARE(myColor.value(ColorModel::Hsl_360_1_1), GenericColor());
+        const auto index = static_cast<std::size_t>(ColorModel::Hsl_360_1_1);
+        QVERIFY(!myColor.m_isAvailable[index]);
+    }
+
+    void testConstructorCalculatesAllModels()
+    {
+        const GenericColor srgb(0.2, 0.4, 0.6);
+        const MultiModelColor myColor(ColorModel::SRgb_1, srgb);
+        for (int i = 0; i <= lastModel; ++i) {
+            const auto model = static_cast<ColorModel>(i);
+            const auto expected = AbsoluteColor::convert(ColorModel::SRgb_1, //
+                                                         srgb,
+                                                         model);
+            QCOMPARE(myColor.contains(model), expected.has_value());
+            if (expected.has_value()) {
+                QCOMPARE(myColor.value(model), expected.value());
+            }
+        }
+    }
+
+    void testCopy()
+    {
+        const MultiModelColor myColor1(ColorModel::SRgb_1, GenericColor(0.2, 0.4, 0.6));
+        const MultiModelColor myColor2 = myColor1;
+        const auto index = static_cast<std::size_t>(ColorModel::OklabD65);
+        QVERIFY(myColor2.m_isAvailable[index]);
+        QCOMPARE(myColor2.value(ColorModel::OklabD65), //
+                 myColor1.value(ColorModel::OklabD65));
+    }
+
+    void testEquality()
+    {
+        const MultiModelColor empty1;
+        const MultiModelColor empty2;
+        QVERIFY(empty1 == empty2);
+        const MultiModelColor color1(ColorModel::SRgb_1, GenericColor(0.2, 0.4, 0.6));
+        const MultiModelColor color2(ColorModel::SRgb_1, GenericColor(0.2, 0.4, 0.6));
+        const MultiModelColor color3(ColorModel::SRgb_1, GenericColor(0.2, 0.4, 0.7));
+        QVERIFY(color1 == color2);
+        QVERIFY(!(color1 != color2));
+        QVERIFY(color1 != color3);
+        QVERIFY(color1 != empty1);
+        QVERIFY(empty1 != color1);
+        // Same values, but in color models without conversion between them.
+        const MultiModelColor hsl(ColorModel::Hsl_360_1_1, GenericColor(0.2, 0.4, 0.6));
+        QVERIFY(color1 != hsl);
+        QVERIFY(hsl != color1);
+    }
+
+    void testDebug()
+    {
+        const MultiModelColor myColor(ColorModel::SRgb_1, GenericColor(0.2, 0.4, 0.6));
+        QString output;
+        QDebug(&output) << myColor;
+        QVERIFY(output.startsWith(QStringLiteral("MultiModelColor(")));
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::TestMultiModelColor)
+
+// The following “include” is necessary because we do not use a header file:
+#include "testmultimodelcolor.moc"
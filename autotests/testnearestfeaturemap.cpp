@@ -0,0 +1,224 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// First included header is the public header of the class we are testing;
+// this forces the header to be self-contained.
+#include "nearestfeaturemap.h"
+
+#include <optional>
+#include <qcolor.h>
+#include <qglobal.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qpoint.h>
+#include <qrandom.h>
+#include <qsize.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtmetamacros.h>
+
+namespace PerceptualColor
+{
+class TestNearestFeatureMap : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestNearestFeatureMap(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private:
+    // A fully transparent mask with the same color table
+    // as QImage::createAlphaMask() produces.
+    [[nodiscard]] static QImage transparentMask(const QSize size)
+    {
+        QImage mask(size, QImage::Format_MonoLSB);
+        mask.setColorTable({qRgb(255, 255, 255), qRgb(0, 0, 0)});
+        mask.fill(0);
+        return mask;
+    }
+
+    // Squared distance to the nearest opaque pixel, found by brute force,
+    // or -1 if there is no opaque pixel.
+    [[nodiscard]] static int bruteForceDistanceSquare(const QImage &mask, const QPoint point)
+    {
+        int result = -1;
+        for (int y = 0; y < mask.height(); ++y) {
+            for (int x = 0; x < mask.width(); ++x) {
+                if (mask.pixelIndex(x, y) == 1) {
+                    const int dx = x - point.x();
+                    const int dy = y - point.y();
+                    const int distanceSquare = dx * dx + dy * dy;
+                    if ((result < 0) || (distanceSquare < result)) {
+                        result = distanceSquare;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Called before the first test function is executed
+    }
+
+    void cleanupTestCase()
+    {
+        // Called after the last test function was executed
+    }
+
+    void init()
+    {
+        // Called before each test function is executed
+    }
+
+    void cleanup()
+    {
+        // Called after every test function
+    }
+
+    void testConstructorDestructor()
+    {
+        NearestFeatureMap test;
+        QVERIFY(test.isNull());
+        QCOMPARE(test.sizeInBytes(), qsizetype{0});
+        QVERIFY(!test.nearestFeature(QPoint(0, 0)).has_value());
+    }
+
+    void testFromNullMask()
+    {
+        const auto test = NearestFeatureMap::fromMask(QImage());
+        QVERIFY(test.isNull());
+        QVERIFY(!test.nearestFeature(QPoint(0, 0)).has_value());
+    }
+
+    void testFromTransparentMask()
+    {
+        const auto test = NearestFeatureMap::fromMask( //
+            transparentMask(QSize(5, 4)));
+        QVERIFY(!test.isNull());
+        QCOMPARE(test.size(), QSize(5, 4));
+        QCOMPARE(test.sizeInBytes(), qsizetype{5 * 4 * 4});
+        QVERIFY(!test.nearestFeature(QPoint(0, 0)).has_value());
+        QVERIFY(!test.nearestFeature(QPoint(4, 3)).has_value());
+    }
+
+    void testFromOpaqueMask()
+    {
+        QImage mask = transparentMask(QSize(5, 4));
+        mask.fill(1);
+        const auto test = NearestFeatureMap::fromMask(mask);
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 5; ++x) {
+                QCOMPARE(test.nearestFeature(QPoint(x, y)), QPoint(x, y));
+            }
+        }
+    }
+
+    void testNearestFeature()
+    {
+        QImage mask = transparentMask(QSize(11, 11));
+        mask.setPixel(0, 0, 1);
+        mask.setPixel(7, 7, 1);
+        mask.setPixel(10, 10, 1);
+        const auto test = NearestFeatureMap::fromMask(mask);
+        QCOMPARE(test.nearestFeature(QPoint(0, 0)), QPoint(0, 0));
+        QCOMPARE(test.nearestFeature(QPoint(1, 0)), QPoint(0, 0));
+        QCOMPARE(test.nearestFeature(QPoint(0, 1)), QPoint(0, 0));
+        QCOMPARE(test.nearestFeature(QPoint(3, 3)), QPoint(0, 0));
+        QCOMPARE(test.nearestFeature(QPoint(6, 6)), QPoint(7, 7));
+        QCOMPARE(test.nearestFeature(QPoint(7, 7)), QPoint(7, 7));
+        QCOMPARE(test.nearestFeature(QPoint(0, 10)), QPoint(7, 7));
+        QCOMPARE(test.nearestFeature(QPoint(10, 0)), QPoint(7, 7));
+        QCOMPARE(test.nearestFeature(QPoint(9, 10)), QPoint(10, 10));
+        QCOMPARE(test.nearestFeature(QPoint(10, 9)), QPoint(10, 10));
+    }
+
+    void testNearestFeatureOutsideTheMap()
+    {
+        QImage mask = transparentMask(QSize(11, 11));
+        mask.setPixel(0, 0, 1);
+        mask.setPixel(7, 7, 1);
+        mask.setPixel(10, 10, 1);
+        const auto test = NearestFeatureMap::fromMask(mask);
+        QCOMPARE(test.nearestFeature(QPoint(-1, 0)), QPoint(0, 0));
+        QCOMPARE(test.nearestFeature(QPoint(-100, -100)), QPoint(0, 0));
+        QCOMPARE(test.nearestFeature(QPoint(100, 100)), QPoint(10, 10));
+        QCOMPARE(test.nearestFeature(QPoint(9, 100)), QPoint(10, 10));
+        QCOMPARE(test.nearestFeature(QPoint(100, 9)), QPoint(10, 10));
+    }
+
+    void testColorTable()
+    {
+        // Black represents opacity, regardless of the color table order
+        // and of the image format.
+        QImage mask(QSize(3, 1), QImage::Format_Mono);
+        mask.setColorTable({qRgb(0, 0, 0), qRgb(255, 255, 255)});
+        mask.fill(1);
+        mask.setPixel(2, 0, 0);
+        const auto test = NearestFeatureMap::fromMask(mask);
+        QCOMPARE(test.nearestFeature(QPoint(0, 0)), QPoint(2, 0));
+    }
+
+    void testAgainstBruteForce()
+    {
+        QRandomGenerator generator(42);
+        for (int i = 0; i < 50; ++i) {
+            const QSize size(generator.bounded(1, 30), //
+                             generator.bounded(1, 30));
+            QImage mask = transparentMask(size);
+            // Sparse and dense masks:
+            const int density = (i % 2 == 0) ? 3 : 50;
+            for (int y = 0; y < size.height(); ++y) {
+                for (int x = 0; x < size.width(); ++x) {
+                    if (generator.bounded(100) < density) {
+                        mask.setPixel(x, y, 1);
+                    }
+                }
+            }
+            const auto test = NearestFeatureMap::fromMask(mask);
+            for (int y = 0; y < size.height(); ++y) {
+                for (int x = 0; x < size.width(); ++x) {
+                    const QPoint point(x, y);
+                    const int expected = bruteForceDistanceSquare(mask, point);
+                    const auto feature = test.nearestFeature(point);
+                    QCOMPARE(feature.has_value(), expected >= 0);
+                    if (feature.has_value()) {
+                        QCOMPARE(mask.pixelIndex(feature.value()), 1);
+                        const QPoint difference = feature.value() - point;
+                        QCOMPARE(QPoint::dotProduct(difference, difference), //
+                                 expected);
+                    }
+                }
+            }
+        }
+    }
+
+    void benchmarkFromMask()
+    {
+        // A mask similar to the gamut of a chroma-lightness diagram.
+        QImage mask = transparentMask(QSize(500, 500));
+        for (int y = 0; y < mask.height(); ++y) {
+            const int width = (y < 250) ? y : (500 - y) / 2;
+            for (int x = 0; x <= width; ++x) {
+                mask.setPixel(x, y, 1);
+            }
+        }
+        QBENCHMARK {
+            const auto test = NearestFeatureMap::fromMask(mask);
+            Q_UNUSED(test)
+        }
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::TestNearestFeatureMap)
+
+// The following “include” is necessary because we do not use a header file:
+#include "testnearestfeaturemap.moc"
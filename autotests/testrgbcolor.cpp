@@ -8,12 +8,14 @@
 #include "genericcolor.h"
 #include <qcolor.h>
 #include <qglobal.h>
+#include <qlist.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qscopedpointer.h>
 #include <qstringliteral.h>
 #include <qtest.h>
 #include <qtestcase.h>
+#include <qtestdata.h>
 #include <qtmetamacros.h>
 #include <type_traits>
 #include <utility>
@@ -513,6 +515,68 @@ private Q_SLOTS:
         RgbColor myColor8 = RgbColor::fromRgbQColor( //
             QColor::fromRgbF(-1, -1, -1));
         QCOMPARE(myColor8.rgbHex6, QStringLiteral("#000000"));
+
+        // Test all hexadecimal digits
+        RgbColor myColor9 = RgbColor::fromRgb255(GenericColor{0x1A, 0x2B, 0xC3});
+        QCOMPARE(myColor9.rgbHex6, QStringLiteral("#1A2BC3"));
+        RgbColor myColor10 = RgbColor::fromRgb255(GenericColor{0x4D, 0x5E, 0x6F});
+        QCOMPARE(myColor10.rgbHex6, QStringLiteral("#4D5E6F"));
+        RgbColor myColor11 = RgbColor::fromRgb255(GenericColor{0x78, 0x90, 0xFF});
+        QCOMPARE(myColor11.rgbHex6, QStringLiteral("#7890FF"));
+
+        // Test rounding
+        RgbColor myColor12 = RgbColor::fromRgb255(GenericColor{9.6, 10.4, 0});
+        QCOMPARE(myColor12.rgbHex6, QStringLiteral("#0A0A00"));
+    }
+
+    void testFromRgbQColorMatchesQColor_data()
+    {
+        QTest::addColumn<QColor>("color");
+        QTest::newRow("red") << QColor(Qt::red);
+        QTest::newRow("yellow") << QColor(Qt::yellow);
+        QTest::newRow("cyan") << QColor(Qt::cyan);
+        QTest::newRow("magenta") << QColor(Qt::magenta);
+        QTest::newRow("dark green") << QColor::fromRgb(20, 100, 40);
+        QTest::newRow("light blue") << QColor::fromRgb(180, 200, 250);
+        QTest::newRow("brown") << QColor::fromRgb(113, 53, 23);
+        QTest::newRow("pink") << QColor::fromRgb(250, 20, 120);
+        QTest::newRow("hsv") << QColor::fromHsvF(0.7f, 0.3f, 0.6f);
+    }
+
+    void testFromRgbQColorMatchesQColor()
+    {
+        // The own single-pass derivation should give the same results
+        // as QColor (within the precision of QColor).
+        QFETCH(QColor, color);
+        const RgbColor value = RgbColor::fromRgbQColor(color);
+        constexpr double tolerance = 0.1;
+
+        const double hue = color.hueF() * 360;
+        QVERIFY(isAlmostEqual<double>(value.hsl.first, hue, tolerance));
+        QVERIFY(isAlmostEqual<double>(value.hsv.first, hue, tolerance));
+        QVERIFY(isAlmostEqual<double>(value.hwb.first, hue, tolerance));
+
+        QVERIFY(isAlmostEqual<double>(value.hsl.second, color.hslSaturationF() * 100, tolerance));
+        QVERIFY(isAlmostEqual<double>(value.hsl.third, color.lightnessF() * 100, tolerance));
+
+        QVERIFY(isAlmostEqual<double>(value.hsv.second, color.hsvSaturationF() * 100, tolerance));
+        QVERIFY(isAlmostEqual<double>(value.hsv.third, color.valueF() * 100, tolerance));
+
+        QVERIFY(isAlmostEqual<double>(value.hwb.second, //
+                                      (1 - color.hsvSaturationF()) * color.valueF() * 100,
+                                      tolerance));
+        QVERIFY(isAlmostEqual<double>(value.hwb.third, (1 - color.valueF()) * 100, tolerance));
+    }
+
+    void testFromRgbQColors()
+    {
+        const QList<QColor> colors{Qt::red, QColor::fromRgb(1, 2, 3), Qt::white};
+        const QList<RgbColor> values = RgbColor::fromRgbQColors(colors);
+        QCOMPARE(values.count(), colors.count());
+        for (qsizetype i = 0; i < colors.count(); ++i) {
+            QCOMPARE(values.at(i), RgbColor::fromRgbQColor(colors.at(i)));
+        }
+        QVERIFY(RgbColor::fromRgbQColors(QList<QColor>()).isEmpty());
     }
 };
 
@@ -0,0 +1,66 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// First included header is the public header of the class we are testing;
+// this forces the header to be self-contained.
+#include "setdiskcachedirectory.h"
+
+#include "asyncimagediskcache.h"
+#include <qobject.h>
+#include <qstring.h>
+#include <qstringliteral.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtmetamacros.h>
+
+namespace PerceptualColor
+{
+
+class TestSetDiskCacheDirectory : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestSetDiskCacheDirectory(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // Called before the first test function is executed
+    }
+
+    void cleanupTestCase()
+    {
+        // Called after the last test function was executed
+    }
+
+    void init()
+    {
+        // Called before each test function is executed
+    }
+
+    void cleanup()
+    {
+        // Called after every test function
+    }
+
+    void testSetDiskCacheDirectory()
+    {
+        const QString directory = QStringLiteral("/tmp/perceptualcolortest");
+        PerceptualColor::setDiskCacheDirectory(directory);
+        QCOMPARE(AsyncImageDiskCache::directory(), directory);
+        // Disable the disk cache again:
+        PerceptualColor::setDiskCacheDirectory(QString());
+        QVERIFY(AsyncImageDiskCache::directory().isEmpty());
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::TestSetDiskCacheDirectory)
+
+// The following “include” is necessary because we do not use a header file:
+#include "testsetdiskcachedirectory.moc"
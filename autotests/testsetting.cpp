@@ -10,6 +10,7 @@
 #include <limits>
 #include <qdebug.h>
 #include <qfile.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qpointer.h>
 #include <qsettings.h>
@@ -227,6 +228,87 @@ private Q_SLOTS:
         QCOMPARE(someEnum.m_value, MyEnum::negative);
         QCOMPARE(someEnum.value(), MyEnum::negative);
     }
+
+    void testListRoundTrip()
+    {
+        Settings mySettings(QSettings::UserScope, //
+                            organization.toString(), //
+                            application.toString());
+
+        const QString key = QStringLiteral("group/testlistroundtrip");
+        Setting<QList<int>> writer(key, &mySettings);
+        const QList<int> list{1, 2, 3};
+        writer.setValue(list);
+
+        Setting<QList<int>> reader(key, &mySettings);
+        QCOMPARE(reader.value(), list);
+
+        writer.setValue(QList<int>());
+        reader.updateFromQSettings();
+        QCOMPARE(reader.value(), QList<int>());
+    }
+
+    void testListPrependKeepsKeys()
+    {
+        Settings mySettings(QSettings::UserScope, //
+                            organization.toString(), //
+                            application.toString());
+
+        const QString key = QStringLiteral("group/testlistprepend");
+        Setting<QList<int>> history(key, &mySettings);
+        QSettings *const qSettings = history.underlyingQSettings();
+        history.setValue(QList<int>{3, 2, 1});
+
+        // Mark the stored elements. If setValue() would write them again,
+        // the marks would get lost.
+        const QString oldestKey = history.listElementKey(history.m_listFirst);
+        qSettings->setValue(oldestKey, 10);
+        const QString middleKey = history.listElementKey(history.m_listFirst + 1);
+        qSettings->setValue(middleKey, 20);
+
+        // Prepend an element and drop the last one, like a history does.
+        history.setValue(QList<int>{4, 3, 2});
+        QVERIFY(!qSettings->contains(oldestKey));
+        QCOMPARE(qSettings->value(middleKey).toInt(), 20);
+
+        history.updateFromQSettings();
+        QCOMPARE(history.value(), (QList<int>{4, 3, 20}));
+
+        // Appending must not rewrite the existing elements either.
+        history.setValue(QList<int>{4, 3, 20, 5});
+        QCOMPARE(qSettings->value(middleKey).toInt(), 20);
+        history.updateFromQSettings();
+        QCOMPARE(history.value(), (QList<int>{4, 3, 20, 5}));
+    }
+
+    void testListLegacyFormat()
+    {
+        Settings mySettings(QSettings::UserScope, //
+                            organization.toString(), //
+                            application.toString());
+
+        const QString key = QStringLiteral("group/testlistlegacy");
+        const QList<int> legacyList{7, 8};
+        {
+            Setting<int> other(QStringLiteral("group/other"), &mySettings);
+            other.underlyingQSettings()->setValue( //
+                key, //
+                QVariant::fromValue(legacyList));
+        }
+
+        Setting<QList<int>> list(key, &mySettings);
+        QCOMPARE(list.value(), legacyList);
+        QVERIFY(list.m_isLegacyList);
+
+        const QList<int> newList{9, 7, 8};
+        list.setValue(newList);
+        QVERIFY(!list.m_isLegacyList);
+        QVERIFY(list.underlyingQSettings()->contains(key + QStringLiteral("/size")));
+
+        Setting<QList<int>> reader(key, &mySettings);
+        QCOMPARE(reader.value(), newList);
+        QVERIFY(!reader.m_isLegacyList);
+    }
 #endif
 };
 
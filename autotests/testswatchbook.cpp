@@ -9,6 +9,7 @@
 
 #include "constpropagatinguniquepointer.h"
 #include "helper.h"
+#include "helperimage.h"
 #include <qboxlayout.h>
 #include <qbytearray.h>
 #include <qcolor.h>
@@ -17,7 +18,10 @@
 #include <qlist.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpixmap.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qrgba64.h>
 #include <qsize.h>
 #include <qstring.h>
 #include <qstyle.h>
@@ -992,6 +996,227 @@ private Q_SLOTS:
         QCOMPARE(testWidget.swatchGrid().value(0, 0).alphaF(), 1);
     }
 
+    void testSwatchPixmapCache()
+    {
+        SwatchBook testWidget(wcsBasicColors(), {});
+        testWidget.resize(testWidget.sizeHint());
+        QStyleOptionFrame option;
+        testWidget.d_pointer->initStyleOption(&option);
+        const auto key1 = testWidget.d_pointer->swatchPixmap(option).cacheKey();
+        QVERIFY(!testWidget.d_pointer->m_swatchPixmap.isNull());
+        QCOMPARE(testWidget.d_pointer->m_swatchPixmap.deviceIndependentSize(), //
+                 QSizeF(testWidget.size()));
+
+        // Unchanged parameters: Reuse the cache.
+        const auto key2 = testWidget.d_pointer->swatchPixmap(option).cacheKey();
+        QCOMPARE(key2, key1);
+
+        // Changed layout direction: Render again.
+        testWidget.setLayoutDirection(Qt::RightToLeft);
+        const auto key3 = testWidget.d_pointer->swatchPixmap(option).cacheKey();
+        QVERIFY(key3 != key2);
+
+        // Changed swatch grid: Render again.
+        QColorArray2D array(1, 1);
+        array.setValue(0, 0, Qt::red);
+        testWidget.setSwatchGrid(array);
+        const auto key4 = testWidget.d_pointer->swatchPixmap(option).cacheKey();
+        QVERIFY(key4 != key3);
+    }
+
+    void testDisabledSwatchGrid()
+    {
+        SwatchBook testWidget(wcsBasicColors(), {});
+        testWidget.resize(testWidget.sizeHint());
+        QStyleOptionFrame option;
+        testWidget.d_pointer->initStyleOption(&option);
+        QVERIFY(!testWidget.d_pointer->m_disabledSwatchGrid.has_value());
+
+        // The disabled colors are only calculated when actually needed.
+        Q_UNUSED(testWidget.d_pointer->swatchPixmap(option));
+        QVERIFY(!testWidget.d_pointer->m_disabledSwatchGrid.has_value());
+        testWidget.setEnabled(false);
+        Q_UNUSED(testWidget.d_pointer->swatchPixmap(option));
+        QVERIFY(testWidget.d_pointer->m_disabledSwatchGrid.has_value());
+        const auto disabledGrid = testWidget.d_pointer->disabledSwatchGrid();
+        QCOMPARE(disabledGrid.iCount(), wcsBasicColors().iCount());
+        QCOMPARE(disabledGrid.jCount(), wcsBasicColors().jCount());
+        QCOMPARE(static_cast<quint64>(disabledGrid.value(0, 0)), //
+                 static_cast<quint64>( //
+                     disabledAppearance(wcsBasicColors().value(0, 0)).rgba64()));
+
+        // A new swatch grid discards the disabled colors.
+        testWidget.setSwatchGrid(QColorArray2D(1, 1));
+        QVERIFY(!testWidget.d_pointer->m_disabledSwatchGrid.has_value());
+    }
+
+    void testPackSwatch()
+    {
+        QCOMPARE(SwatchBookPrivate::packSwatch(QColor()).alpha(), 0);
+        QVERIFY(!SwatchBookPrivate::unpackSwatch( //
+                     SwatchBookPrivate::packSwatch(QColor()))
+                     .isValid());
+        const QColor opaque = QColor::fromRgb(10, 20, 30);
+        QCOMPARE(SwatchBookPrivate::unpackSwatch( //
+                     SwatchBookPrivate::packSwatch(opaque)),
+                 opaque);
+        // 16 bit per channel are preserved.
+        const QColor precise = QColor::fromRgba64(1234, 23456, 65000);
+        QCOMPARE(SwatchBookPrivate::unpackSwatch( //
+                     SwatchBookPrivate::packSwatch(precise)),
+                 precise);
+        // Transparency is removed.
+        const QColor transparent = QColor::fromRgb(10, 20, 30, 40);
+        QCOMPARE(SwatchBookPrivate::unpackSwatch( //
+                     SwatchBookPrivate::packSwatch(transparent)),
+                 opaque);
+    }
+
+    void testSelectSwatchFromCurrentColorLargePalette()
+    {
+        constexpr qsizetype columnCount = 10;
+        constexpr qsizetype rowCount = 1000;
+        QColorArray2D array(columnCount, rowCount);
+        for (qsizetype i = 0; i < columnCount; ++i) {
+            for (qsizetype j = 0; j < rowCount; ++j) {
+                array.setValue(i, j, QColor::fromRgb(static_cast<int>(i), j % 256, j / 256));
+            }
+        }
+        // A duplicate. A search column by column finds first (1, 999).
+        array.setValue(2, 5, QColor::fromRgb(1, 999 % 256, 999 / 256));
+        SwatchBook testWidget(array, {});
+        testWidget.setCurrentColor(QColor::fromRgb(7, 900 % 256, 900 / 256));
+        QCOMPARE(testWidget.d_pointer->m_selectedColumn, 7);
+        QCOMPARE(testWidget.d_pointer->m_selectedRow, 900);
+        testWidget.setCurrentColor(QColor::fromRgb(1, 999 % 256, 999 / 256));
+        QCOMPARE(testWidget.d_pointer->m_selectedColumn, 1);
+        QCOMPARE(testWidget.d_pointer->m_selectedRow, 999);
+        // No match for colors with transparency.
+        testWidget.setCurrentColor(QColor::fromRgb(7, 900 % 256, 900 / 256, 100));
+        QCOMPARE(testWidget.d_pointer->m_selectedColumn, -1);
+        QCOMPARE(testWidget.d_pointer->m_selectedRow, -1);
+        // The index follows changes of single swatches.
+        testWidget.d_pointer->setSwatch(0, 0, QColor(Qt::white));
+        testWidget.setCurrentColor(Qt::white);
+        QCOMPARE(testWidget.d_pointer->m_selectedColumn, 0);
+        QCOMPARE(testWidget.d_pointer->m_selectedRow, 0);
+    }
+
+    void testPatchRect()
+    {
+        SwatchBook testWidget(wcsBasicColors(), {});
+        QStyleOptionFrame option;
+        testWidget.d_pointer->initStyleOption(&option);
+        const QPoint offset = testWidget.d_pointer->contentOffset(option);
+        const auto columnCount = wcsBasicColors().iCount();
+        const auto rowCount = wcsBasicColors().jCount();
+        for (auto direction : {Qt::LeftToRight, Qt::RightToLeft}) {
+            testWidget.setLayoutDirection(direction);
+            for (qsizetype i = 0; i < columnCount; ++i) {
+                for (qsizetype j = 0; j < rowCount; ++j) {
+                    const QRect rect = testWidget.d_pointer->patchRect(offset, i, j);
+                    const auto columnRow = //
+                        testWidget.d_pointer->logicalColumnRowFromPosition(rect.center());
+                    QCOMPARE(columnRow.first, i);
+                    QCOMPARE(columnRow.second, j);
+                }
+            }
+        }
+    }
+
+    void testRowRangeInRect()
+    {
+        SwatchBook testWidget(wcsBasicColors(), {});
+        testWidget.resize(testWidget.sizeHint());
+        QStyleOptionFrame option;
+        testWidget.d_pointer->initStyleOption(&option);
+        const QPoint offset = testWidget.d_pointer->contentOffset(option);
+        const auto lastRow = wcsBasicColors().jCount() - 1;
+        auto range = testWidget.d_pointer->rowRangeInRect(offset, testWidget.rect());
+        QCOMPARE(range.first, 0);
+        QCOMPARE(range.second, lastRow);
+        const QRect secondRow = testWidget.d_pointer->patchRect(offset, 0, 1);
+        range = testWidget.d_pointer->rowRangeInRect(offset, secondRow);
+        QCOMPARE(range.first, 1);
+        QCOMPARE(range.second, 1);
+        range = testWidget.d_pointer->rowRangeInRect(offset, QRect());
+        QVERIFY(range.second < range.first);
+    }
+
+    void testVirtualizedPainting()
+    {
+        constexpr qsizetype columnCount = 10;
+        constexpr qsizetype rowCount = 500;
+        QColorArray2D array(columnCount, rowCount);
+        for (qsizetype i = 0; i < columnCount; ++i) {
+            for (qsizetype j = 0; j < rowCount; ++j) {
+                array.setValue(i, j, QColor::fromRgb(static_cast<int>(i), j % 256, j / 256));
+            }
+        }
+        SwatchBook testWidget(array, {});
+        testWidget.setMaximumVisibleRowCount(5);
+        testWidget.resize(testWidget.sizeHint());
+        testWidget.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&testWidget));
+        QVERIFY(testWidget.d_pointer->maximumScrollValue() > 0);
+        QVERIFY(!testWidget.d_pointer->m_scrollBar->isHidden());
+
+        // Only the visible part is rendered.
+        QStyleOptionFrame option;
+        testWidget.d_pointer->initStyleOption(&option);
+        const auto &pixmap = testWidget.d_pointer->swatchPixmap(option);
+        QVERIFY(pixmap.deviceIndependentSize().height() <= testWidget.height());
+        QVERIFY(testWidget.d_pointer->pageStep() < rowCount - 1);
+        QVERIFY(testWidget.d_pointer->pageStep() > 0);
+
+        // Selecting a swatch scrolls it into view.
+        testWidget.d_pointer->selectSwatchByLogicalCoordinates(3, 400);
+        QVERIFY(testWidget.d_pointer->scrollValue() > 0);
+        const QRect rect = testWidget.d_pointer->patchRect( //
+            testWidget.d_pointer->contentOffset(option),
+            3,
+            400);
+        QVERIFY(testWidget.d_pointer->viewportRect().contains(rect));
+        const auto columnRow = //
+            testWidget.d_pointer->logicalColumnRowFromPosition(rect.center());
+        QCOMPARE(columnRow.first, 3);
+        QCOMPARE(columnRow.second, 400);
+
+        // Rows that are scrolled out of view cannot be clicked.
+        const QRect firstRow = testWidget.d_pointer->patchRect( //
+            testWidget.d_pointer->contentOffset(option),
+            3,
+            0);
+        QVERIFY(!testWidget.d_pointer->viewportRect().contains(firstRow.center()));
+        QCOMPARE(testWidget.d_pointer->logicalColumnRowFromPosition(firstRow.center()).first, -1);
+    }
+
+    void testMaximumVisibleRowCount()
+    {
+        SwatchBook testWidget(wcsBasicColors(), {});
+        const QSize fullSize = testWidget.sizeHint();
+        testWidget.resize(fullSize);
+        QCOMPARE(testWidget.d_pointer->maximumScrollValue(), 0);
+        QCOMPARE(testWidget.d_pointer->scrollValue(), 0);
+
+        // Values that are not smaller than the row count do not change
+        // the size hint.
+        testWidget.setMaximumVisibleRowCount(wcsBasicColors().jCount());
+        QCOMPARE(testWidget.sizeHint(), fullSize);
+
+        testWidget.setMaximumVisibleRowCount(2);
+        QCOMPARE(testWidget.maximumVisibleRowCount(), 2);
+        QVERIFY(testWidget.sizeHint().height() < fullSize.height());
+        QVERIFY(testWidget.sizeHint().width() > fullSize.width());
+        QCOMPARE(testWidget.minimumSizeHint(), testWidget.sizeHint());
+        testWidget.resize(testWidget.sizeHint());
+        QVERIFY(testWidget.d_pointer->maximumScrollValue() > 0);
+
+        testWidget.setMaximumVisibleRowCount(-1);
+        QCOMPARE(testWidget.maximumVisibleRowCount(), 0);
+        QCOMPARE(testWidget.sizeHint(), fullSize);
+    }
+
     void testSetSwatchGridInvalid()
     {
         // An invalid color in the grid should be preserved and
@@ -1001,6 +1226,28 @@ private Q_SLOTS:
         SwatchBook testWidget(array, {});
         QVERIFY(!testWidget.swatchGrid().value(0, 0).isValid());
     }
+
+    void testPackedSwatchGrid()
+    {
+        SwatchBook testWidget(wcsBasicColors(), {});
+        QCOMPARE(testWidget.packedSwatchGrid().iCount(), wcsBasicColors().iCount());
+        QCOMPARE(testWidget.packedSwatchGrid().jCount(), wcsBasicColors().jCount());
+        QCOMPARE(testWidget.packedSwatchGrid().value(0, 0), //
+                 wcsBasicColors().value(0, 0).rgba64());
+
+        QRgba64Array2D array(2, 1);
+        array.setValue(0, 0, QRgba64::fromRgba64(1000, 2000, 3000, 4000));
+        // Alpha 0 means empty, regardless of the other channels.
+        array.setValue(1, 0, QRgba64::fromRgba64(1000, 2000, 3000, 0));
+        testWidget.setPackedSwatchGrid(array);
+        QCOMPARE(testWidget.packedSwatchGrid().value(0, 0), //
+                 QRgba64::fromRgba64(1000, 2000, 3000, 0xffff));
+        QCOMPARE(testWidget.packedSwatchGrid().value(1, 0), //
+                 QRgba64::fromRgba64(0));
+        QCOMPARE(testWidget.swatchGrid().value(0, 0), //
+                 QColor::fromRgba64(1000, 2000, 3000));
+        QVERIFY(!testWidget.swatchGrid().value(1, 0).isValid());
+    }
 };
 
 } // namespace PerceptualColor
@@ -0,0 +1,236 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#include "absolutecolor.h"
+#include "blackhole.h"
+#include "colorspaceinfo.h"
+#include "genericcolor.h"
+#include "helperconstants.h"
+#include "helpermath.h"
+#include "perceptualcolornamespace.h"
+#include <qbenchmark.h>
+#include <qglobal.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qrgb.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtestdata.h>
+#include <qtmetamacros.h>
+
+namespace PerceptualColor
+{
+class BenchmarkAbsoluteColor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BenchmarkAbsoluteColor(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private:
+    // The bisection algorithm that AbsoluteColor::reduceChromaToFitIntoGamut()
+    // has used before it solved the gamut boundary directly. The unit tests
+    // use it as oracle; here it is the baseline for the timings.
+    static GenericColor reduceChromaByBisection(const GenericColor &lch, const LchSpace lchSpace)
+    {
+        GenericColor referenceColor = lch;
+        normalizePolar360(referenceColor.second, referenceColor.third);
+        const auto maxChroma = (lchSpace == LchSpace::CielchD50) //
+            ? ColorSpaceInfo::maxCielchD50Chroma() //
+            : ColorSpaceInfo::maxOklchChroma();
+        referenceColor.second = qMin<double>(referenceColor.second, maxChroma);
+        const auto minLightness = (lchSpace == LchSpace::CielchD50) //
+            ? ColorSpaceInfo::cielabD50BlackpointL() //
+            : ColorSpaceInfo::oklabBlackpointL();
+        const auto maxLightness = (lchSpace == LchSpace::CielchD50) //
+            ? ColorSpaceInfo::cielabD50WhitepointL() //
+            : ColorSpaceInfo::oklabWhitepointL();
+        referenceColor.first = qBound<double>(minLightness, referenceColor.first, maxLightness);
+        if (AbsoluteColor::isLchInSRgbGamut(referenceColor, lchSpace)) {
+            return referenceColor;
+        }
+        GenericColor lowerChroma{referenceColor.first, 0, referenceColor.third};
+        if (!AbsoluteColor::isLchInSRgbGamut(lowerChroma, lchSpace)) {
+            referenceColor.first = 0;
+            lowerChroma.first = 0;
+        }
+        GenericColor upperChroma{referenceColor};
+        GenericColor temp = upperChroma;
+        while (upperChroma.second - lowerChroma.second > gamutPrecisionOklab) {
+            temp.second = ((lowerChroma.second + upperChroma.second) / 2);
+            if (AbsoluteColor::isLchInSRgbGamut(temp, lchSpace)) {
+                lowerChroma = temp;
+            } else {
+                upperChroma = temp;
+            }
+        }
+        return lowerChroma;
+    }
+
+private Q_SLOTS:
+    void benchmarkConvert_data()
+    {
+        QTest::addColumn<ColorModel>("from");
+        QTest::addColumn<ColorModel>("to");
+        QTest::newRow("CielchD50→SRgb") << ColorModel::CielchD50 << ColorModel::SRgb_1;
+        QTest::newRow("OklchD65→SRgb") << ColorModel::OklchD65 << ColorModel::SRgb_1;
+        QTest::newRow("SRgb→CielchD50") << ColorModel::SRgb_1 << ColorModel::CielchD50;
+        QTest::newRow("SRgb→OklchD65") << ColorModel::SRgb_1 << ColorModel::OklchD65;
+        QTest::newRow("CielchD50→OklchD65") << ColorModel::CielchD50 << ColorModel::OklchD65;
+    }
+
+    void benchmarkConvert()
+    {
+        QFETCH(ColorModel, from);
+        QFETCH(ColorModel, to);
+        const GenericColor color{0.5, 0.1, 0.2};
+        QBENCHMARK {
+            blackhole(AbsoluteColor::convert(from, color, to));
+        }
+    }
+
+    void benchmarkAllConversions()
+    {
+        const GenericColor color{50, 20, 30};
+        QBENCHMARK {
+            blackhole(AbsoluteColor::allConversions(ColorModel::CielchD50, color));
+        }
+    }
+
+    void benchmarkFastFromCielabD50ToSRgbOrTransparent()
+    {
+        const GenericColor color{50, 20, 30};
+        QBENCHMARK {
+            blackhole(AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(color));
+        }
+    }
+
+    void benchmarkFastFromOklabToSRgbOrTransparent()
+    {
+        const GenericColor color{0.5, 0.05, 0.05};
+        QBENCHMARK {
+            blackhole(AbsoluteColor::fastFromOklabToSRgbOrTransparent(color));
+        }
+    }
+
+    void benchmarkFastFromCielabD50ToSRgbOrTransparentBatch_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("64") << 64;
+        QTest::newRow("1024") << 1024;
+        QTest::newRow("16384") << 16384;
+    }
+
+    void benchmarkFastFromCielabD50ToSRgbOrTransparentBatch()
+    {
+        QFETCH(int, count);
+        QList<float> lightness(count);
+        QList<float> a(count);
+        QList<float> b(count);
+        QList<QRgb> result(count);
+        for (int i = 0; i < count; ++i) {
+            lightness[i] = 50;
+            a[i] = static_cast<float>(i % 200) - 100;
+            b[i] = static_cast<float>(i % 100) - 50;
+        }
+        QBENCHMARK {
+            AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(lightness, a, b, result);
+        }
+        blackhole(result.constFirst());
+    }
+
+    void benchmarkIsLchInSRgbGamut()
+    {
+        const GenericColor color{50, 20, 30};
+        QBENCHMARK {
+            blackhole(AbsoluteColor::isLchInSRgbGamut(color, LchSpace::CielchD50));
+        }
+    }
+
+    void benchmarkReduceChromaToFitIntoGamut_data()
+    {
+        QTest::addColumn<LchSpace>("lchSpace");
+        QTest::addColumn<GenericColor>("color");
+        QTest::newRow("CielchD50 in gamut") << LchSpace::CielchD50 << GenericColor{50, 10, 30};
+        QTest::newRow("CielchD50 out of gamut") << LchSpace::CielchD50 << GenericColor{50, 150, 30};
+        QTest::newRow("Oklch in gamut") << LchSpace::Oklch << GenericColor{0.5, 0.02, 30};
+        QTest::newRow("Oklch out of gamut") << LchSpace::Oklch << GenericColor{0.5, 0.4, 30};
+    }
+
+    void benchmarkReduceChromaToFitIntoGamut()
+    {
+        QFETCH(LchSpace, lchSpace);
+        QFETCH(GenericColor, color);
+        QBENCHMARK {
+            blackhole(AbsoluteColor::reduceChromaToFitIntoGamut(color, lchSpace));
+        }
+    }
+
+    void benchmarkReduceChromaByBisection_data()
+    {
+        benchmarkReduceChromaToFitIntoGamut_data();
+    }
+
+    void benchmarkReduceChromaByBisection()
+    {
+        QFETCH(LchSpace, lchSpace);
+        QFETCH(GenericColor, color);
+        QBENCHMARK {
+            blackhole(reduceChromaByBisection(color, lchSpace));
+        }
+    }
+
+    void benchmarkInGamutChromaIntervals_data()
+    {
+        QTest::addColumn<LchSpace>("lchSpace");
+        QTest::addColumn<GenericColor>("color");
+        QTest::newRow("CielchD50") << LchSpace::CielchD50 << GenericColor{50, 150, 30};
+        QTest::newRow("Oklch") << LchSpace::Oklch << GenericColor{0.5, 0.4, 30};
+    }
+
+    void benchmarkInGamutChromaIntervals()
+    {
+        QFETCH(LchSpace, lchSpace);
+        QFETCH(GenericColor, color);
+        QBENCHMARK {
+            blackhole(AbsoluteColor::inGamutChromaIntervals(color.first, color.third, color.second, lchSpace));
+        }
+    }
+
+    void benchmarkReduceChromaToFitIntoGamutBatch_data()
+    {
+        QTest::addColumn<LchSpace>("lchSpace");
+        QTest::newRow("CielchD50") << LchSpace::CielchD50;
+        QTest::newRow("Oklch") << LchSpace::Oklch;
+    }
+
+    void benchmarkReduceChromaToFitIntoGamutBatch()
+    {
+        QFETCH(LchSpace, lchSpace);
+        // A palette-sized list of colors, most of them out-of-gamut.
+        constexpr int count = 1024;
+        const double maximumLightness = (lchSpace == LchSpace::CielchD50) ? 100 : 1;
+        const double maximumChroma = (lchSpace == LchSpace::CielchD50) ? 150 : 0.4;
+        QList<GenericColor> colors(count);
+        QList<GenericColor> result(count);
+        for (int i = 0; i < count; ++i) {
+            colors[i] = GenericColor{maximumLightness * (i % 32 + 0.5) / 32, //
+                                     maximumChroma * (i % 7 + 1) / 7,
+                                     static_cast<double>(i % 360)};
+        }
+        QBENCHMARK {
+            AbsoluteColor::reduceChromaToFitIntoGamut(colors, lchSpace, result);
+        }
+        blackhole(result.constFirst());
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::BenchmarkAbsoluteColor)
+
+// The following “include” is necessary because we do not use a header file:
+#include "benchmarkabsolutecolor.moc"
@@ -0,0 +1,62 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#include "colordialog.h"
+#include <qbenchmark.h>
+#include <qcolor.h>
+#include <qglobal.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qscopedpointer.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtmetamacros.h>
+
+namespace PerceptualColor
+{
+class BenchmarkColorDialog : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BenchmarkColorDialog(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+    void benchmarkConstruct()
+    {
+        QBENCHMARK {
+            QScopedPointer<ColorDialog> dialog(new ColorDialog);
+        }
+    }
+
+    void benchmarkConstructAndShow()
+    {
+        QBENCHMARK {
+            QScopedPointer<ColorDialog> dialog(new ColorDialog);
+            dialog->show();
+            dialog->repaint();
+        }
+    }
+
+    void benchmarkSetCurrentColor()
+    {
+        ColorDialog dialog;
+        dialog.show();
+        QBENCHMARK {
+            dialog.setCurrentColor(Qt::green);
+            dialog.repaint();
+            dialog.setCurrentColor(Qt::blue);
+            dialog.repaint();
+        }
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::BenchmarkColorDialog)
+
+// The following “include” is necessary because we do not use a header file:
+#include "benchmarkcolordialog.moc"
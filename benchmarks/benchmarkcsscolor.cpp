@@ -0,0 +1,56 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#include "blackhole.h"
+#include "csscolor.h"
+#include <qbenchmark.h>
+#include <qglobal.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qstringliteral.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtestdata.h>
+#include <qtmetamacros.h>
+
+namespace PerceptualColor
+{
+class BenchmarkCssColor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BenchmarkCssColor(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+    void benchmarkParse_data()
+    {
+        QTest::addColumn<QString>("string");
+        QTest::newRow("hex") << QStringLiteral("#7f3a9c");
+        QTest::newRow("named") << QStringLiteral("rebeccapurple");
+        QTest::newRow("rgb") << QStringLiteral("rgb(127 58 156 / 50%)");
+        QTest::newRow("hsl") << QStringLiteral("hsl(280deg 46% 42%)");
+        QTest::newRow("lch") << QStringLiteral("lch(40% 60 310)");
+        QTest::newRow("oklch") << QStringLiteral("oklch(0.5 0.15 310)");
+        QTest::newRow("color()") << QStringLiteral("color(srgb 0.5 0.2 0.6)");
+        QTest::newRow("invalid") << QStringLiteral("notacolor(1 2 3)");
+    }
+
+    void benchmarkParse()
+    {
+        QFETCH(QString, string);
+        QBENCHMARK {
+            blackhole(CssColor::parse(string).model);
+        }
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::BenchmarkCssColor)
+
+// The following “include” is necessary because we do not use a header file:
+#include "benchmarkcsscolor.moc"
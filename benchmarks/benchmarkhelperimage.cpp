@@ -0,0 +1,130 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#include "blackhole.h"
+#include "helperimage.h"
+#include <qbenchmark.h>
+#include <qcolor.h>
+#include <qglobal.h>
+#include <qimage.h>
+#include <qmetatype.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qpainter.h>
+#include <qrgb.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtestdata.h>
+#include <qtmetamacros.h>
+
+Q_DECLARE_METATYPE(PerceptualColor::AntialiasMode)
+
+namespace PerceptualColor
+{
+class BenchmarkHelperImage : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BenchmarkHelperImage(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private:
+    /** @brief A disk without anti-aliasing, centered in a square image. */
+    [[nodiscard]] static QImage disk(const int size)
+    {
+        QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(Qt::red));
+        painter.drawEllipse(0, 0, size, size);
+        return image;
+    }
+
+    /** @brief The color function that corresponds to @ref disk(). */
+    [[nodiscard]] static QRgb diskColor(const int size, const double x, const double y)
+    {
+        const double radius = size / 2.0;
+        const double dx = x - radius;
+        const double dy = y - radius;
+        return (dx * dx + dy * dy <= radius * radius) //
+            ? qRgba(255, 0, 0, 255)
+            : qRgba(0, 0, 0, 0);
+    }
+
+private Q_SLOTS:
+    void sizes_data()
+    {
+        QTest::addColumn<int>("size");
+        QTest::newRow("256") << 256;
+        QTest::newRow("1024") << 1024;
+        QTest::newRow("2048") << 2048;
+    }
+
+    void benchmarkFindBoundary_data()
+    {
+        sizes_data();
+    }
+
+    void benchmarkFindBoundary()
+    {
+        QFETCH(int, size);
+        const QImage image = disk(size);
+        QBENCHMARK {
+            blackhole(findBoundary(image).count());
+        }
+    }
+
+    void benchmarkFindBoundaryMask_data()
+    {
+        sizes_data();
+    }
+
+    void benchmarkFindBoundaryMask()
+    {
+        QFETCH(int, size);
+        const QImage image = disk(size);
+        QBENCHMARK {
+            blackhole(findBoundaryMask(image).count());
+        }
+    }
+
+    void benchmarkDoAntialias_data()
+    {
+        QTest::addColumn<int>("size");
+        QTest::addColumn<AntialiasMode>("mode");
+        QTest::newRow("256 Uniform") << 256 << AntialiasMode::Uniform;
+        QTest::newRow("256 Adaptive") << 256 << AntialiasMode::Adaptive;
+        QTest::newRow("1024 Uniform") << 1024 << AntialiasMode::Uniform;
+        QTest::newRow("1024 Adaptive") << 1024 << AntialiasMode::Adaptive;
+        QTest::newRow("2048 Uniform") << 2048 << AntialiasMode::Uniform;
+        QTest::newRow("2048 Adaptive") << 2048 << AntialiasMode::Adaptive;
+    }
+
+    void benchmarkDoAntialias()
+    {
+        QFETCH(int, size);
+        QFETCH(AntialiasMode, mode);
+        const QImage original = disk(size);
+        const BoundaryMask boundary = findBoundaryMask(original);
+        const auto colorFunction = [size](const double x, const double y) {
+            return diskColor(size, x, y);
+        };
+        QBENCHMARK {
+            QImage image = original;
+            doAntialias(image, boundary, colorFunction, mode);
+            blackhole(image.pixel(0, 0));
+        }
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::BenchmarkHelperImage)
+
+// The following “include” is necessary because we do not use a header file:
+#include "benchmarkhelperimage.moc"
@@ -0,0 +1,159 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#include "asyncimagerendercallback.h"
+#include "blackhole.h"
+#include "chromahueimageparameters.h"
+#include "chromalightnessimageparameters.h"
+#include "colorwheelimageparameters.h"
+#include "genericcolor.h"
+#include "gradientimageparameters.h"
+#include "perceptualcolornamespace.h"
+#include <qbenchmark.h>
+#include <qglobal.h>
+#include <qimage.h>
+#include <qobject.h>
+#include <qsize.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtestdata.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+namespace PerceptualColor
+{
+
+/** @brief Callback that keeps only the final image. */
+class FinalImageCallback : public AsyncImageRenderCallback
+{
+public:
+    virtual bool shouldAbort() const override
+    {
+        return false;
+    }
+    virtual void deliverInterlacingPass(const QImage &image, const QImage &mask, const QVariant &parameters, const InterlacingState state) override
+    {
+        Q_UNUSED(mask)
+        Q_UNUSED(parameters)
+        if (state == InterlacingState::Final) {
+            m_finalImage = image;
+        }
+    }
+    QImage m_finalImage;
+};
+
+class BenchmarkImageParameters : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BenchmarkImageParameters(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private:
+    static void addRows()
+    {
+        QTest::addColumn<LchSpace>("projectionSpace");
+        QTest::addColumn<int>("size");
+        for (const int size : {256, 512, 1024}) {
+            QTest::addRow("CielchD50 %d", size) << LchSpace::CielchD50 << size;
+            QTest::addRow("Oklch %d", size) << LchSpace::Oklch << size;
+        }
+    }
+
+private Q_SLOTS:
+    void benchmarkChromaHueRender_data()
+    {
+        addRows();
+    }
+
+    void benchmarkChromaHueRender()
+    {
+        QFETCH(LchSpace, projectionSpace);
+        QFETCH(int, size);
+        ChromaHueImageParameters parameters;
+        parameters.projectionSpace = projectionSpace;
+        parameters.imageSizePhysical = size;
+        parameters.lightness = (projectionSpace == LchSpace::Oklch) ? 0.5 : 50;
+        FinalImageCallback callback;
+        QBENCHMARK {
+            ChromaHueImageParameters::render(QVariant::fromValue(parameters), callback);
+        }
+        blackhole(callback.m_finalImage.width());
+    }
+
+    void benchmarkChromaLightnessRender_data()
+    {
+        addRows();
+    }
+
+    void benchmarkChromaLightnessRender()
+    {
+        QFETCH(LchSpace, projectionSpace);
+        QFETCH(int, size);
+        ChromaLightnessImageParameters parameters;
+        parameters.projectionSpace = projectionSpace;
+        parameters.imageSizePhysical = QSize(size, size);
+        parameters.hue = 30;
+        FinalImageCallback callback;
+        QBENCHMARK {
+            ChromaLightnessImageParameters::render(QVariant::fromValue(parameters), callback);
+        }
+        blackhole(callback.m_finalImage.width());
+    }
+
+    void benchmarkColorWheelRender_data()
+    {
+        addRows();
+    }
+
+    void benchmarkColorWheelRender()
+    {
+        QFETCH(LchSpace, projectionSpace);
+        QFETCH(int, size);
+        ColorWheelImageParameters parameters;
+        parameters.projectionSpace = projectionSpace;
+        parameters.imageSizePhysical = size;
+        FinalImageCallback callback;
+        QBENCHMARK {
+            ColorWheelImageParameters::render(QVariant::fromValue(parameters), callback);
+        }
+        blackhole(callback.m_finalImage.width());
+    }
+
+    void benchmarkGradientRender_data()
+    {
+        addRows();
+    }
+
+    void benchmarkGradientRender()
+    {
+        QFETCH(LchSpace, projectionSpace);
+        QFETCH(int, size);
+        GradientImageParameters parameters;
+        parameters.setProjectionSpace(projectionSpace);
+        parameters.setGradientLength(size);
+        parameters.setGradientThickness(20);
+        if (projectionSpace == LchSpace::Oklch) {
+            parameters.setFirstColorLchA(GenericColor{0.75, 0.1, 90}, 1);
+            parameters.setSecondColorLchA(GenericColor{0.5, 0.15, 45}, 0.5);
+        } else {
+            parameters.setFirstColorLchA(GenericColor{75, 65, 90}, 1);
+            parameters.setSecondColorLchA(GenericColor{50, 75, 45}, 0.5);
+        }
+        FinalImageCallback callback;
+        QBENCHMARK {
+            GradientImageParameters::render(QVariant::fromValue(parameters), callback);
+        }
+        blackhole(callback.m_finalImage.width());
+    }
+};
+
+} // namespace PerceptualColor
+
+QTEST_MAIN(PerceptualColor::BenchmarkImageParameters)
+
+// The following “include” is necessary because we do not use a header file:
+#include "benchmarkimageparameters.moc"
@@ -28,6 +28,7 @@ PUBLIC_HEADERS="
     src/multispinbox.h
     src/multispinboxsection.h
     src/portaleyedropper.h
+    src/setdiskcachedirectory.h
     src/settranslation.h
     src/version.in.hpp
     "
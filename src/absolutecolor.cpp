@@ -12,68 +12,60 @@
 #include "mat3.h"
 #include "vec3.h"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <numbers>
 #include <optional>
 #include <qglobal.h>
 #include <qmath.h>
+#include <utility>
+
+// SIMD support for the batch conversions. SSE2 is part of the x86-64 base
+// line and NEON is part of the AArch64 base line, so both are available at
+// compile time without any further checks. AVX is only available on some
+// x86 CPUs; it is detected at run time, which requires compiler support
+// for function-level target attributes (GCC and Clang).
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PERCEPTUALCOLOR_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define PERCEPTUALCOLOR_SIMD_AVX
+#include <immintrin.h>
+#endif
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define PERCEPTUALCOLOR_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// The batch conversions promise results that are bit-identical to the
+// per-color conversions. This holds only if the compiler does not contract
+// multiplications and additions into fused multiply-add instructions in
+// one code path but not in the other. GCC does not contract in ISO C++ mode
+// and MSVC does not contract by default, but Clang does.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#endif
 
 namespace PerceptualColor
 {
 
-/** @brief List of all available conversions from this color model.
- *
- * @param model The color model from which to convert.
- *
- * @returns List of all available conversions from this color model. */
-QList<AbsoluteColor::Conversion> AbsoluteColor::conversionsFrom(const ColorModel model)
-{
-    QList<AbsoluteColor::Conversion> result;
-    for (const auto &item : conversionList) {
-        if (item.from == model) {
-            result.append(item);
-        }
-    }
-    return result;
-}
-
-/** @brief Adds some @ref GenericColor to an existing hash table.
- *
- * @param values A hash table with color values.
- * @param model The color model from which to perform conversions.
- *
- * @pre <em>values</em> contains the key <em>model</em>.
- *
- * @post For all available direct conversions from <em>model</em>, it is
- * checked whether a value for the destination color model is already
- * available in <em>values</em>. If not, this value is calculated and added
- * to <em>values</em>, and this function is called recursively again for this
- * destination color model. */
-void AbsoluteColor::addDirectConversionsRecursivly(QHash<ColorModel, GenericColor> *values, ColorModel model)
-{
-    const auto availableConversions = conversionsFrom(model);
-    const auto currentValue = values->value(model);
-    for (const auto &conversion : availableConversions) {
-        if (!values->contains(conversion.to)) {
-            values->insert(conversion.to, conversion.conversionFunction(currentValue));
-            addDirectConversionsRecursivly(values, conversion.to);
-        }
-    }
-}
-
 /** @brief Calculate conversions to all color models.
  *
  * @param model The original color model
  * @param value The original color value
  *
- * @returns A list containing the original value and containing conversions
- * to all other @ref ColorModel. */
-QHash<ColorModel, GenericColor> AbsoluteColor::allConversions(const ColorModel model, const GenericColor &value)
+ * @returns An object containing the original value and the conversions
+ * to all other @ref ColorModel.
+ *
+ * @sa @ref MultiModelColor */
+MultiModelColor AbsoluteColor::allConversions(const ColorModel model, const GenericColor &value)
 {
-    QHash<ColorModel, GenericColor> result;
-    result.insert(model, value);
-    addDirectConversionsRecursivly(&result, model);
-    return result;
+    return MultiModelColor(model, value);
 }
 
 /** @internal
@@ -400,16 +392,33 @@ GenericColor AbsoluteColor::fromLinearSRgbToXyzD65(const GenericColor &value)
  * @param value The value being converted.
  * @param to The color model to which the conversion is made.
  *
- * @returns The value converted into the new color model.
+ * @returns The value converted into the new color model, or
+ * <tt>std::nullopt</tt> if no conversion is available.
  *
- * @note This function is <em>not</em> speed-optimized. */
+ * This function applies the shortest chain of conversions, which is
+ * calculated at compile time by @ref makeConversionPlan(). It does not
+ * allocate memory. Use @ref allConversions() if you need the value in
+ * all color models. */
 std::optional<GenericColor> AbsoluteColor::convert(const ColorModel from, const GenericColor &value, const ColorModel to)
 {
-    const auto temp = allConversions(from, value);
-    if (temp.contains(to)) {
-        return temp.value(to);
+    static constexpr ConversionPlan plan = makeConversionPlan();
+    if (from == to) {
+        return value;
     }
-    return std::nullopt;
+    const auto fromIndex = static_cast<std::size_t>(from);
+    const auto toIndex = static_cast<std::size_t>(to);
+    if ((fromIndex >= conversionModelCount) || (toIndex >= conversionModelCount)) {
+        return std::nullopt;
+    }
+    const auto &path = plan[fromIndex][toIndex];
+    if (!path.isReachable) {
+        return std::nullopt;
+    }
+    GenericColor result = value;
+    for (std::size_t i = 0; i < path.length; ++i) {
+        result = conversionList[path.steps[i]].conversionFunction(result);
+    }
+    return result;
 }
 
 /** @brief Conversion to QRgb.
@@ -437,7 +446,8 @@ std::optional<GenericColor> AbsoluteColor::convert(const ColorModel from, const
  * original Oklab code</a>.
  *
  * @note Unfortunately, it cannot be <tt>constexpr</tt>, because it
- * calls @ref channelFromLinearSRgbToSRgb() which is not <tt>constexpr</tt>.
+ * calls @ref channelFromLinearSRgbToSRgbByte() which is not
+ * <tt>constexpr</tt>.
  */
 // GenericColor might be an alternative, but it has double precision, while here
 // float precision would be appropriate.
@@ -460,17 +470,7 @@ std::optional<GenericColor> AbsoluteColor::convert(const ColorModel from, const
     const float g = -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s;
     const float b = -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s;
 
-    // Check for in-range yet now to avoid unnecessary calls of toByte() and
-    // linearToSRgb(). Furthermore, linearToSRgb() has undefined behaviour
-    // for parameters < 0.
-    if (r < 0.f || r > 1.f || g < 0.f || g > 1.f || b < 0.f || b > 1.f) {
-        return qRgbTransparent;
-    }
-
-    return qRgba(toByte(channelFromLinearSRgbToSRgb(r)), //
-                 toByte(channelFromLinearSRgbToSRgb(g)), //
-                 toByte(channelFromLinearSRgbToSRgb(b)),
-                 255);
+    return fastFromLinearSRgbToSRgbOrTransparent(r, g, b);
 }
 
 /**
@@ -567,7 +567,8 @@ bool AbsoluteColor::isLchInSRgbGamut(const GenericColor &lch, const LchSpace lch
  * original Oklab code</a>.
  *
  * @note Unfortunately, it cannot be <tt>constexpr</tt>, because it
- * calls @ref channelFromLinearSRgbToSRgb() which is not <tt>constexpr</tt>.
+ * calls @ref channelFromLinearSRgbToSRgbByte() which is not
+ * <tt>constexpr</tt>.
  */
 [[nodiscard]] QRgb AbsoluteColor::fastFromOklchToSRgbClamped(const GenericColor &oklch)
 {
@@ -590,11 +591,10 @@ bool AbsoluteColor::isLchInSRgbGamut(const GenericColor &lch, const LchSpace lch
     const float g = -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s;
     const float b = -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s;
 
-    return qRgba( //
-        toByte(std::clamp<float>(channelFromLinearSRgbToSRgb(r), 0, 1)), //
-        toByte(std::clamp<float>(channelFromLinearSRgbToSRgb(g), 0, 1)), //
-        toByte(std::clamp<float>(channelFromLinearSRgbToSRgb(b), 0, 1)),
-        255);
+    return qRgba(channelFromLinearSRgbToSRgbByte(r), //
+                 channelFromLinearSRgbToSRgbByte(g), //
+                 channelFromLinearSRgbToSRgbByte(b),
+                 255);
 }
 
 /**
@@ -680,6 +680,113 @@ QRgb AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(const GenericColor &cie
     const auto &g = linearSRgb(1);
     const auto &b = linearSRgb(2);
 
+    return fastFromLinearSRgbToSRgbOrTransparent(r, g, b);
+}
+
+/**
+ * @internal
+ *
+ * @brief Lookup table for @ref channelFromLinearSRgbToSRgbByte().
+ *
+ * The composition <tt>toByte(channelFromLinearSRgbToSRgb(x))</tt> is a
+ * monotonic step function with 256 steps. The table stores for each step
+ * the smallest <tt>float</tt> that reaches it (found by bisection over the
+ * bit patterns of <tt>float</tt>, so the table reproduces the original
+ * function exactly). To avoid searching through all steps, the range
+ * [0, 1] is divided into equally spaced buckets which store the step at
+ * their lower bound. As the buckets are narrower than the steps, each
+ * lookup needs at most one more comparison.
+ */
+struct AbsoluteColor::SRgbEncodingTable {
+public:
+    /** @brief Number of buckets. */
+    static constexpr int bucketCount = 4096;
+    /** @brief The smallest input value that reaches the step at the
+     * given index. */
+    std::array<float, 256> thresholds;
+    /** @brief The step at the lower bound of the given bucket. */
+    std::array<quint8, bucketCount> buckets;
+
+    /** @brief Constructor that calculates the table. */
+    SRgbEncodingTable()
+    {
+        const auto exactByte = [](const float x) {
+            return toByte(channelFromLinearSRgbToSRgb(x));
+        };
+        thresholds[0] = 0.f;
+        for (int step = 1; step < static_cast<int>(thresholds.size()); ++step) {
+            // For non-negative floats, the order of the bit patterns is the
+            // order of the values.
+            quint32 low = 0;
+            quint32 high = std::bit_cast<quint32>(1.f);
+            while (low < high) {
+                const quint32 middle = low + (high - low) / 2;
+                if (exactByte(std::bit_cast<float>(middle)) >= step) {
+                    high = middle;
+                } else {
+                    low = middle + 1;
+                }
+            }
+            thresholds[step] = std::bit_cast<float>(low);
+        }
+        int step = 0;
+        for (int i = 0; i < bucketCount; ++i) {
+            const float lowerBound = static_cast<float>(i) / bucketCount;
+            while (step < 255 && thresholds[step + 1] <= lowerBound) {
+                ++step;
+            }
+            buckets[i] = static_cast<quint8>(step);
+        }
+    }
+};
+
+/**
+ * @internal
+ *
+ * @brief Convert a channel from linear sRGB to (gamma-encoded) 8-bit sRGB.
+ *
+ * Produces exactly the same result as
+ * <tt>toByte(channelFromLinearSRgbToSRgb(x))</tt>, but uses a lookup
+ * table instead of <tt>std::pow</tt>.
+ *
+ * @param x An linear sRGB channel. Values outside the range [0..1] are
+ *        clamped.
+ *
+ * @returns The corresponding gamma-encoded sRGB channel
+ * in the range [0..255].
+ */
+quint8 AbsoluteColor::channelFromLinearSRgbToSRgbByte(const float x)
+{
+    // Thread-safe initialization on first use.
+    static const SRgbEncodingTable table;
+    // This also maps NaN to 0.
+    const float clamped = (x > 0.f) ? ((x < 1.f) ? x : 1.f) : 0.f;
+    const int bucket = qMin( //
+        static_cast<int>(clamped * SRgbEncodingTable::bucketCount),
+        SRgbEncodingTable::bucketCount - 1);
+    int step = table.buckets[static_cast<std::size_t>(bucket)];
+    while (step < 255 && clamped >= table.thresholds[static_cast<std::size_t>(step + 1)]) {
+        ++step;
+    }
+    return static_cast<quint8>(step);
+}
+
+/**
+ * @internal
+ *
+ * @brief Conversion from linear sRGB to QRgb.
+ *
+ * Shared final step of the “fast” Lab-like conversions.
+ *
+ * @param r Linear sRGB red
+ * @param g Linear sRGB green
+ * @param b Linear sRGB blue
+ *
+ * @returns An opaque color if the linear sRGB value is in-range.
+ *          Otherwise, returns a fully transparent color.
+ */
+QRgb AbsoluteColor::fastFromLinearSRgbToSRgbOrTransparent(const float r, const float g, const float b)
+{
     // Check for in-range yet now to avoid unnecessary calls of toByte() and
     // linearToSRgb(). Furthermore, linearToSRgb() has undefined behaviour
     // for parameters < 0.
@@ -687,12 +794,491 @@ QRgb AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(const GenericColor &cie
         return qRgbTransparent;
     }
 
-    return qRgba(toByte(channelFromLinearSRgbToSRgb(r)), //
-                 toByte(channelFromLinearSRgbToSRgb(g)), //
-                 toByte(channelFromLinearSRgbToSRgb(b)),
+    return qRgba(channelFromLinearSRgbToSRgbByte(r), //
+                 channelFromLinearSRgbToSRgbByte(g), //
+                 channelFromLinearSRgbToSRgbByte(b),
                  255);
 }
 
+#if defined(PERCEPTUALCOLOR_SIMD_SSE2)
+/**
+ * @internal
+ *
+ * @brief SIMD kernel for @ref AbsoluteColor::fastFromOklabToSRgbOrTransparent()
+ *
+ * Converts 4 Oklab values to linear sRGB. The operations are done in the
+ * very same order as in the per-color function to get bit-identical results.
+ *
+ * @param first Pointer to 4 Oklab L values.
+ * @param second Pointer to 4 Oklab a values.
+ * @param third Pointer to 4 Oklab b values.
+ * @param red Pointer to a buffer for 4 linear sRGB red values.
+ * @param green Pointer to a buffer for 4 linear sRGB green values.
+ * @param blue Pointer to a buffer for 4 linear sRGB blue values.
+ */
+static void fromOklabToLinearSRgbSse2(const float *first, const float *second, const float *third, float *red, float *green, float *blue)
+{
+    const __m128 oLabL = _mm_loadu_ps(first);
+    const __m128 oLabA = _mm_loadu_ps(second);
+    const __m128 oLabB = _mm_loadu_ps(third);
+
+    const __m128 l_ = _mm_add_ps(_mm_add_ps(oLabL, _mm_mul_ps(_mm_set1_ps(0.3963377774f), oLabA)), //
+                                 _mm_mul_ps(_mm_set1_ps(0.2158037573f), oLabB));
+    const __m128 m_ = _mm_sub_ps(_mm_sub_ps(oLabL, _mm_mul_ps(_mm_set1_ps(0.1055613458f), oLabA)), //
+                                 _mm_mul_ps(_mm_set1_ps(0.0638541728f), oLabB));
+    const __m128 s_ = _mm_sub_ps(_mm_sub_ps(oLabL, _mm_mul_ps(_mm_set1_ps(0.0894841775f), oLabA)), //
+                                 _mm_mul_ps(_mm_set1_ps(1.2914855480f), oLabB));
+
+    const __m128 l = _mm_mul_ps(_mm_mul_ps(l_, l_), l_);
+    const __m128 m = _mm_mul_ps(_mm_mul_ps(m_, m_), m_);
+    const __m128 s = _mm_mul_ps(_mm_mul_ps(s_, s_), s_);
+
+    _mm_storeu_ps(red,
+                  _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(+4.0767416621f), l), //
+                                        _mm_mul_ps(_mm_set1_ps(3.3077115913f), m)),
+                             _mm_mul_ps(_mm_set1_ps(0.2309699292f), s)));
+    _mm_storeu_ps(green,
+                  _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.2684380046f), l), //
+                                        _mm_mul_ps(_mm_set1_ps(2.6097574011f), m)),
+                             _mm_mul_ps(_mm_set1_ps(0.3413193965f), s)));
+    _mm_storeu_ps(blue,
+                  _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(-0.0041960863f), l), //
+                                        _mm_mul_ps(_mm_set1_ps(0.7034186147f), m)),
+                             _mm_mul_ps(_mm_set1_ps(1.7076147010f), s)));
+}
+
+/**
+ * @internal
+ *
+ * @brief Inverse of the CIELab companding function for 4 values.
+ *
+ * @param f The values.
+ *
+ * @returns The values after applying the inverse companding function.
+ */
+static __m128 cielabInverseCompandingSse2(const __m128 f)
+{
+    constexpr float delta = 6.0f / 29.0f;
+    constexpr float delta2 = delta * delta;
+    const __m128 cube = _mm_mul_ps(_mm_mul_ps(f, f), f);
+    const __m128 linear = _mm_mul_ps(_mm_set1_ps(3.0f * delta2), //
+                                     _mm_sub_ps(f, _mm_set1_ps(4.0f / 29.0f)));
+    const __m128 isCube = _mm_cmpgt_ps(f, _mm_set1_ps(delta));
+    return _mm_or_ps(_mm_and_ps(isCube, cube), _mm_andnot_ps(isCube, linear));
+}
+
+/**
+ * @internal
+ *
+ * @brief SIMD kernel for
+ * @ref AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent()
+ *
+ * Converts 4 CIELab-D50 values to linear sRGB. The operations are done in
+ * the very same order as in the per-color function to get bit-identical
+ * results.
+ *
+ * @param first Pointer to 4 CIELab-D50 L values.
+ * @param second Pointer to 4 CIELab-D50 a values.
+ * @param third Pointer to 4 CIELab-D50 b values.
+ * @param red Pointer to a buffer for 4 linear sRGB red values.
+ * @param green Pointer to a buffer for 4 linear sRGB green values.
+ * @param blue Pointer to a buffer for 4 linear sRGB blue values.
+ */
+static void fromCielabD50ToLinearSRgbSse2(const float *first, const float *second, const float *third, float *red, float *green, float *blue)
+{
+    constexpr Vec3f whitepoint = static_cast<Vec3f>(whitePointD50TwoDegree);
+    constexpr Mat3f matrix = static_cast<Mat3f>( //
+        xyzD65ToLinearSRgbMatrix * xyzD50ToXyzD65Matrix);
+
+    const __m128 fy = _mm_div_ps(_mm_add_ps(_mm_loadu_ps(first), _mm_set1_ps(16.0f)), //
+                                 _mm_set1_ps(116.0f));
+    const __m128 fz = _mm_sub_ps(fy, _mm_div_ps(_mm_loadu_ps(third), _mm_set1_ps(200.0f)));
+    const __m128 fx = _mm_add_ps(_mm_div_ps(_mm_loadu_ps(second), _mm_set1_ps(500.0f)), fy);
+
+    const __m128 x = _mm_mul_ps(_mm_set1_ps(whitepoint(0)), cielabInverseCompandingSse2(fx));
+    const __m128 y = _mm_mul_ps(_mm_set1_ps(whitepoint(1)), cielabInverseCompandingSse2(fy));
+    const __m128 z = _mm_mul_ps(_mm_set1_ps(whitepoint(2)), cielabInverseCompandingSse2(fz));
+
+    _mm_storeu_ps(red,
+                  _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(matrix.m[0]), x), //
+                                        _mm_mul_ps(_mm_set1_ps(matrix.m[1]), y)),
+                             _mm_mul_ps(_mm_set1_ps(matrix.m[2]), z)));
+    _mm_storeu_ps(green,
+                  _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(matrix.m[3]), x), //
+                                        _mm_mul_ps(_mm_set1_ps(matrix.m[4]), y)),
+                             _mm_mul_ps(_mm_set1_ps(matrix.m[5]), z)));
+    _mm_storeu_ps(blue,
+                  _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(matrix.m[6]), x), //
+                                        _mm_mul_ps(_mm_set1_ps(matrix.m[7]), y)),
+                             _mm_mul_ps(_mm_set1_ps(matrix.m[8]), z)));
+}
+#endif
+
+#if defined(PERCEPTUALCOLOR_SIMD_AVX)
+/**
+ * @internal
+ *
+ * @brief SIMD kernel for @ref AbsoluteColor::fastFromOklabToSRgbOrTransparent()
+ *
+ * Like @ref fromOklabToLinearSRgbSse2(), but for 8 values.
+ *
+ * @pre The CPU supports AVX.
+ *
+ * @param first Pointer to 8 Oklab L values.
+ * @param second Pointer to 8 Oklab a values.
+ * @param third Pointer to 8 Oklab b values.
+ * @param red Pointer to a buffer for 8 linear sRGB red values.
+ * @param green Pointer to a buffer for 8 linear sRGB green values.
+ * @param blue Pointer to a buffer for 8 linear sRGB blue values.
+ */
+__attribute__((target("avx"))) static void
+fromOklabToLinearSRgbAvx(const float *first, const float *second, const float *third, float *red, float *green, float *blue)
+{
+    const __m256 oLabL = _mm256_loadu_ps(first);
+    const __m256 oLabA = _mm256_loadu_ps(second);
+    const __m256 oLabB = _mm256_loadu_ps(third);
+
+    const __m256 l_ = _mm256_add_ps(_mm256_add_ps(oLabL, _mm256_mul_ps(_mm256_set1_ps(0.3963377774f), oLabA)), //
+                                    _mm256_mul_ps(_mm256_set1_ps(0.2158037573f), oLabB));
+    const __m256 m_ = _mm256_sub_ps(_mm256_sub_ps(oLabL, _mm256_mul_ps(_mm256_set1_ps(0.1055613458f), oLabA)), //
+                                    _mm256_mul_ps(_mm256_set1_ps(0.0638541728f), oLabB));
+    const __m256 s_ = _mm256_sub_ps(_mm256_sub_ps(oLabL, _mm256_mul_ps(_mm256_set1_ps(0.0894841775f), oLabA)), //
+                                    _mm256_mul_ps(_mm256_set1_ps(1.2914855480f), oLabB));
+
+    const __m256 l = _mm256_mul_ps(_mm256_mul_ps(l_, l_), l_);
+    const __m256 m = _mm256_mul_ps(_mm256_mul_ps(m_, m_), m_);
+    const __m256 s = _mm256_mul_ps(_mm256_mul_ps(s_, s_), s_);
+
+    _mm256_storeu_ps(red,
+                     _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(+4.0767416621f), l), //
+                                                 _mm256_mul_ps(_mm256_set1_ps(3.3077115913f), m)),
+                                   _mm256_mul_ps(_mm256_set1_ps(0.2309699292f), s)));
+    _mm256_storeu_ps(green,
+                     _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.2684380046f), l), //
+                                                 _mm256_mul_ps(_mm256_set1_ps(2.6097574011f), m)),
+                                   _mm256_mul_ps(_mm256_set1_ps(0.3413193965f), s)));
+    _mm256_storeu_ps(blue,
+                     _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(-0.0041960863f), l), //
+                                                 _mm256_mul_ps(_mm256_set1_ps(0.7034186147f), m)),
+                                   _mm256_mul_ps(_mm256_set1_ps(1.7076147010f), s)));
+}
+
+/**
+ * @internal
+ *
+ * @brief Inverse of the CIELab companding function for 8 values.
+ *
+ * @pre The CPU supports AVX.
+ *
+ * @param f The values.
+ *
+ * @returns The values after applying the inverse companding function.
+ */
+__attribute__((target("avx"))) static __m256 cielabInverseCompandingAvx(const __m256 f)
+{
+    constexpr float delta = 6.0f / 29.0f;
+    constexpr float delta2 = delta * delta;
+    const __m256 cube = _mm256_mul_ps(_mm256_mul_ps(f, f), f);
+    const __m256 linear = _mm256_mul_ps(_mm256_set1_ps(3.0f * delta2), //
+                                        _mm256_sub_ps(f, _mm256_set1_ps(4.0f / 29.0f)));
+    const __m256 isCube = _mm256_cmp_ps(f, _mm256_set1_ps(delta), _CMP_GT_OQ);
+    return _mm256_blendv_ps(linear, cube, isCube);
+}
+
+/**
+ * @internal
+ *
+ * @brief SIMD kernel for
+ * @ref AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent()
+ *
+ * Like @ref fromCielabD50ToLinearSRgbSse2(), but for 8 values.
+ *
+ * @pre The CPU supports AVX.
+ *
+ * @param first Pointer to 8 CIELab-D50 L values.
+ * @param second Pointer to 8 CIELab-D50 a values.
+ * @param third Pointer to 8 CIELab-D50 b values.
+ * @param red Pointer to a buffer for 8 linear sRGB red values.
+ * @param green Pointer to a buffer for 8 linear sRGB green values.
+ * @param blue Pointer to a buffer for 8 linear sRGB blue values.
+ */
+__attribute__((target("avx"))) static void
+fromCielabD50ToLinearSRgbAvx(const float *first, const float *second, const float *third, float *red, float *green, float *blue)
+{
+    constexpr Vec3f whitepoint = static_cast<Vec3f>(whitePointD50TwoDegree);
+    constexpr Mat3f matrix = static_cast<Mat3f>( //
+        xyzD65ToLinearSRgbMatrix * xyzD50ToXyzD65Matrix);
+
+    const __m256 fy = _mm256_div_ps(_mm256_add_ps(_mm256_loadu_ps(first), _mm256_set1_ps(16.0f)), //
+                                    _mm256_set1_ps(116.0f));
+    const __m256 fz = _mm256_sub_ps(fy, _mm256_div_ps(_mm256_loadu_ps(third), _mm256_set1_ps(200.0f)));
+    const __m256 fx = _mm256_add_ps(_mm256_div_ps(_mm256_loadu_ps(second), _mm256_set1_ps(500.0f)), fy);
+
+    const __m256 x = _mm256_mul_ps(_mm256_set1_ps(whitepoint(0)), cielabInverseCompandingAvx(fx));
+    const __m256 y = _mm256_mul_ps(_mm256_set1_ps(whitepoint(1)), cielabInverseCompandingAvx(fy));
+    const __m256 z = _mm256_mul_ps(_mm256_set1_ps(whitepoint(2)), cielabInverseCompandingAvx(fz));
+
+    _mm256_storeu_ps(red,
+                     _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(matrix.m[0]), x), //
+                                                 _mm256_mul_ps(_mm256_set1_ps(matrix.m[1]), y)),
+                                   _mm256_mul_ps(_mm256_set1_ps(matrix.m[2]), z)));
+    _mm256_storeu_ps(green,
+                     _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(matrix.m[3]), x), //
+                                                 _mm256_mul_ps(_mm256_set1_ps(matrix.m[4]), y)),
+                                   _mm256_mul_ps(_mm256_set1_ps(matrix.m[5]), z)));
+    _mm256_storeu_ps(blue,
+                     _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(matrix.m[6]), x), //
+                                                 _mm256_mul_ps(_mm256_set1_ps(matrix.m[7]), y)),
+                                   _mm256_mul_ps(_mm256_set1_ps(matrix.m[8]), z)));
+}
+#endif
+
+#if defined(PERCEPTUALCOLOR_SIMD_NEON)
+/**
+ * @internal
+ *
+ * @brief SIMD kernel for @ref AbsoluteColor::fastFromOklabToSRgbOrTransparent()
+ *
+ * Like @ref fromOklabToLinearSRgbSse2(), but for NEON.
+ *
+ * @param first Pointer to 4 Oklab L values.
+ * @param second Pointer to 4 Oklab a values.
+ * @param third Pointer to 4 Oklab b values.
+ * @param red Pointer to a buffer for 4 linear sRGB red values.
+ * @param green Pointer to a buffer for 4 linear sRGB green values.
+ * @param blue Pointer to a buffer for 4 linear sRGB blue values.
+ */
+static void fromOklabToLinearSRgbNeon(const float *first, const float *second, const float *third, float *red, float *green, float *blue)
+{
+    const float32x4_t oLabL = vld1q_f32(first);
+    const float32x4_t oLabA = vld1q_f32(second);
+    const float32x4_t oLabB = vld1q_f32(third);
+
+    const float32x4_t l_ = vaddq_f32(vaddq_f32(oLabL, vmulq_f32(vdupq_n_f32(0.3963377774f), oLabA)), //
+                                     vmulq_f32(vdupq_n_f32(0.2158037573f), oLabB));
+    const float32x4_t m_ = vsubq_f32(vsubq_f32(oLabL, vmulq_f32(vdupq_n_f32(0.1055613458f), oLabA)), //
+                                     vmulq_f32(vdupq_n_f32(0.0638541728f), oLabB));
+    const float32x4_t s_ = vsubq_f32(vsubq_f32(oLabL, vmulq_f32(vdupq_n_f32(0.0894841775f), oLabA)), //
+                                     vmulq_f32(vdupq_n_f32(1.2914855480f), oLabB));
+
+    const float32x4_t l = vmulq_f32(vmulq_f32(l_, l_), l_);
+    const float32x4_t m = vmulq_f32(vmulq_f32(m_, m_), m_);
+    const float32x4_t s = vmulq_f32(vmulq_f32(s_, s_), s_);
+
+    vst1q_f32(red,
+              vaddq_f32(vsubq_f32(vmulq_f32(vdupq_n_f32(+4.0767416621f), l), //
+                                  vmulq_f32(vdupq_n_f32(3.3077115913f), m)),
+                        vmulq_f32(vdupq_n_f32(0.2309699292f), s)));
+    vst1q_f32(green,
+              vsubq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(-1.2684380046f), l), //
+                                  vmulq_f32(vdupq_n_f32(2.6097574011f), m)),
+                        vmulq_f32(vdupq_n_f32(0.3413193965f), s)));
+    vst1q_f32(blue,
+              vaddq_f32(vsubq_f32(vmulq_f32(vdupq_n_f32(-0.0041960863f), l), //
+                                  vmulq_f32(vdupq_n_f32(0.7034186147f), m)),
+                        vmulq_f32(vdupq_n_f32(1.7076147010f), s)));
+}
+
+/**
+ * @internal
+ *
+ * @brief Inverse of the CIELab companding function for 4 values.
+ *
+ * @param f The values.
+ *
+ * @returns The values after applying the inverse companding function.
+ */
+static float32x4_t cielabInverseCompandingNeon(const float32x4_t f)
+{
+    constexpr float delta = 6.0f / 29.0f;
+    constexpr float delta2 = delta * delta;
+    const float32x4_t cube = vmulq_f32(vmulq_f32(f, f), f);
+    const float32x4_t linear = vmulq_f32(vdupq_n_f32(3.0f * delta2), //
+                                         vsubq_f32(f, vdupq_n_f32(4.0f / 29.0f)));
+    const uint32x4_t isCube = vcgtq_f32(f, vdupq_n_f32(delta));
+    return vbslq_f32(isCube, cube, linear);
+}
+
+/**
+ * @internal
+ *
+ * @brief SIMD kernel for
+ * @ref AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent()
+ *
+ * Like @ref fromCielabD50ToLinearSRgbSse2(), but for NEON.
+ *
+ * @param first Pointer to 4 CIELab-D50 L values.
+ * @param second Pointer to 4 CIELab-D50 a values.
+ * @param third Pointer to 4 CIELab-D50 b values.
+ * @param red Pointer to a buffer for 4 linear sRGB red values.
+ * @param green Pointer to a buffer for 4 linear sRGB green values.
+ * @param blue Pointer to a buffer for 4 linear sRGB blue values.
+ */
+static void fromCielabD50ToLinearSRgbNeon(const float *first, const float *second, const float *third, float *red, float *green, float *blue)
+{
+    constexpr Vec3f whitepoint = static_cast<Vec3f>(whitePointD50TwoDegree);
+    constexpr Mat3f matrix = static_cast<Mat3f>( //
+        xyzD65ToLinearSRgbMatrix * xyzD50ToXyzD65Matrix);
+
+    const float32x4_t fy = vdivq_f32(vaddq_f32(vld1q_f32(first), vdupq_n_f32(16.0f)), //
+                                     vdupq_n_f32(116.0f));
+    const float32x4_t fz = vsubq_f32(fy, vdivq_f32(vld1q_f32(third), vdupq_n_f32(200.0f)));
+    const float32x4_t fx = vaddq_f32(vdivq_f32(vld1q_f32(second), vdupq_n_f32(500.0f)), fy);
+
+    const float32x4_t x = vmulq_f32(vdupq_n_f32(whitepoint(0)), cielabInverseCompandingNeon(fx));
+    const float32x4_t y = vmulq_f32(vdupq_n_f32(whitepoint(1)), cielabInverseCompandingNeon(fy));
+    const float32x4_t z = vmulq_f32(vdupq_n_f32(whitepoint(2)), cielabInverseCompandingNeon(fz));
+
+    vst1q_f32(red,
+              vaddq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(matrix.m[0]), x), //
+                                  vmulq_f32(vdupq_n_f32(matrix.m[1]), y)),
+                        vmulq_f32(vdupq_n_f32(matrix.m[2]), z)));
+    vst1q_f32(green,
+              vaddq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(matrix.m[3]), x), //
+                                  vmulq_f32(vdupq_n_f32(matrix.m[4]), y)),
+                        vmulq_f32(vdupq_n_f32(matrix.m[5]), z)));
+    vst1q_f32(blue,
+              vaddq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(matrix.m[6]), x), //
+                                  vmulq_f32(vdupq_n_f32(matrix.m[7]), y)),
+                        vmulq_f32(vdupq_n_f32(matrix.m[8]), z)));
+}
+#endif
+
+/**
+ * @internal
+ *
+ * @brief Shared implementation of the batch conversions to QRgb.
+ *
+ * Processes as many elements as possible with the SIMD kernel and
+ * the remaining elements with the per-color function.
+ *
+ * @param simdKernel The SIMD kernel. If its kernel is <tt>nullptr</tt>,
+ *        all elements are processed with the per-color function.
+ * @param scalarFunction The per-color function. It must produce
+ *        bit-identical results to the SIMD kernel.
+ * @param first The first channel of the original colors.
+ * @param second The second channel of the original colors.
+ * @param third The third channel of the original colors.
+ * @param result Buffer for the result. The number of processed elements
+ *        is the minimum of the sizes of all four spans.
+ */
+void AbsoluteColor::fastFromLabToSRgbOrTransparent(const SimdKernel simdKernel,
+                                                   QRgb (*scalarFunction)(const GenericColor &),
+                                                   std::span<const float> first,
+                                                   std::span<const float> second,
+                                                   std::span<const float> third,
+                                                   std::span<QRgb> result)
+{
+    const std::size_t count = std::min({first.size(), second.size(), third.size(), result.size()});
+    std::size_t i = 0;
+
+    if (simdKernel.kernel != nullptr) {
+        constexpr std::size_t maxKernelWidth = 8;
+        std::array<float, maxKernelWidth> red;
+        std::array<float, maxKernelWidth> green;
+        std::array<float, maxKernelWidth> blue;
+        for (; i + simdKernel.width <= count; i += simdKernel.width) {
+            simdKernel.kernel(first.data() + i, //
+                              second.data() + i,
+                              third.data() + i,
+                              red.data(),
+                              green.data(),
+                              blue.data());
+            for (std::size_t j = 0; j < simdKernel.width; ++j) {
+                result[i + j] = fastFromLinearSRgbToSRgbOrTransparent( //
+                    red[j],
+                    green[j],
+                    blue[j]);
+            }
+        }
+    }
+
+    // Conversion from float to double and back is lossless, so the
+    // per-color function sees exactly the same values.
+    for (; i < count; ++i) {
+        result[i] = scalarFunction(GenericColor(first[i], second[i], third[i]));
+    }
+}
+
+/** @brief Batch conversion to QRgb.
+ *
+ * Same as the per-color overload, but for a whole span of colors given
+ * as structure of arrays. The results are bit-identical to the
+ * per-color overload.
+ *
+ * @pre
+ * - Input Lightness: 0 ≤ lightness ≤ 100
+ *
+ * @param lightness CIELab-D50 lightness of the original colors
+ * @param a CIELab-D50 a of the original colors
+ * @param b CIELab-D50 b of the original colors
+ * @param result Buffer for the result. For each original color, the
+ *        opaque matching color if it is within the gamut; otherwise
+ *        a fully transparent color. Only the first <em>n</em> elements
+ *        are written, where <em>n</em> is the minimum of the sizes of
+ *        all four spans. */
+void AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(std::span<const float> lightness,
+                                                         std::span<const float> a,
+                                                         std::span<const float> b,
+                                                         std::span<QRgb> result)
+{
+    static const SimdKernel simdKernel = []() -> SimdKernel {
+#if defined(PERCEPTUALCOLOR_SIMD_AVX)
+        if (__builtin_cpu_supports("avx")) {
+            return SimdKernel{&fromCielabD50ToLinearSRgbAvx, 8};
+        }
+#endif
+#if defined(PERCEPTUALCOLOR_SIMD_SSE2)
+        return SimdKernel{&fromCielabD50ToLinearSRgbSse2, 4};
+#elif defined(PERCEPTUALCOLOR_SIMD_NEON)
+        return SimdKernel{&fromCielabD50ToLinearSRgbNeon, 4};
+#else
+        return SimdKernel();
+#endif
+    }();
+    const auto scalarFunction = static_cast<QRgb (*)(const GenericColor &)>( //
+        &AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent);
+    fastFromLabToSRgbOrTransparent(simdKernel, scalarFunction, lightness, a, b, result);
+}
+
+/** @brief Batch conversion to QRgb.
+ *
+ * Same as the per-color overload, but for a whole span of colors given
+ * as structure of arrays. The results are bit-identical to the
+ * per-color overload.
+ *
+ * @param lightness Oklab lightness of the original colors
+ * @param a Oklab a of the original colors
+ * @param b Oklab b of the original colors
+ * @param result Buffer for the result. For each original color, the
+ *        opaque matching color if it is within the gamut; otherwise
+ *        a fully transparent color. Only the first <em>n</em> elements
+ *        are written, where <em>n</em> is the minimum of the sizes of
+ *        all four spans. */
+void AbsoluteColor::fastFromOklabToSRgbOrTransparent(std::span<const float> lightness, //
+                                                     std::span<const float> a,
+                                                     std::span<const float> b,
+                                                     std::span<QRgb> result)
+{
+    static const SimdKernel simdKernel = []() -> SimdKernel {
+#if defined(PERCEPTUALCOLOR_SIMD_AVX)
+        if (__builtin_cpu_supports("avx")) {
+            return SimdKernel{&fromOklabToLinearSRgbAvx, 8};
+        }
+#endif
+#if defined(PERCEPTUALCOLOR_SIMD_SSE2)
+        return SimdKernel{&fromOklabToLinearSRgbSse2, 4};
+#elif defined(PERCEPTUALCOLOR_SIMD_NEON)
+        return SimdKernel{&fromOklabToLinearSRgbNeon, 4};
+#else
+        return SimdKernel();
+#endif
+    }();
+    const auto scalarFunction = static_cast<QRgb (*)(const GenericColor &)>( //
+        &AbsoluteColor::fastFromOklabToSRgbOrTransparent);
+    fastFromLabToSRgbOrTransparent(simdKernel, scalarFunction, lightness, a, b, result);
+}
+
 /** @brief Conversion to QRgb.
  *
  * @param cielchD50 The original color.
@@ -747,11 +1333,431 @@ QRgb AbsoluteColor::fastFromCielchD50ToSRgbClamped(const GenericColor &cielchD50
     const auto &g = linearSRgb(1);
     const auto &b = linearSRgb(2);
 
-    return qRgba( //
-        toByte(std::clamp<float>(channelFromLinearSRgbToSRgb(r), 0.f, 1.f)), //
-        toByte(std::clamp<float>(channelFromLinearSRgbToSRgb(g), 0.f, 1.f)), //
-        toByte(std::clamp<float>(channelFromLinearSRgbToSRgb(b), 0.f, 1.f)),
-        255);
+    return qRgba(channelFromLinearSRgbToSRgbByte(r), //
+                 channelFromLinearSRgbToSRgbByte(g), //
+                 channelFromLinearSRgbToSRgbByte(b),
+                 255);
+}
+
+/**
+ * @internal
+ *
+ * @brief A ray of constant lightness and constant hue, with the linear sRGB
+ * channels as functions of the chroma.
+ *
+ * Along such a ray, the Lab coordinates are linear functions of the chroma.
+ * The transfer function of the color space (a cube for Oklab; a cube or a
+ * linear segment for CIELab) is applied to three linear combinations of
+ * them, and the linear sRGB channels are again linear combinations of the
+ * results. So each linear sRGB channel is a piecewise polynomial of the
+ * chroma, of degree three or lower, and the gamut boundary is where one of
+ * these polynomials crosses one of the constraint planes 0 and 1.
+ */
+struct AbsoluteColor::GamutRay {
+public:
+    /** @brief A polynomial, with the coefficients in ascending order of
+     * the power. */
+    using Polynomial = std::array<double, 4>;
+
+    /**
+     * @brief A list of chroma values with fixed capacity.
+     *
+     * The gamut solver runs on each color change, so it avoids heap
+     * allocations.
+     *
+     * @tparam capacity The maximum number of elements. Further elements
+     * are ignored.
+     */
+    template<std::size_t capacity>
+    struct ChromaList {
+    public:
+        /** @brief The storage. Only the first @ref size elements are
+         * valid. */
+        std::array<double, capacity> values{};
+        /** @brief The number of valid elements. */
+        std::size_t size = 0;
+        /** @param value The value to append. */
+        void append(const double value)
+        {
+            if (size < capacity) {
+                values[size] = value;
+                ++size;
+            }
+        }
+        /** @returns Iterator to the first element. */
+        [[nodiscard]] double *begin()
+        {
+            return values.data();
+        }
+        /** @returns Iterator behind the last valid element. */
+        [[nodiscard]] double *end()
+        {
+            return values.data() + size;
+        }
+    };
+
+    /** @brief The maximum number of pieces of the piecewise polynomials:
+     * Each of the three transfer function arguments might switch its
+     * segment once. */
+    static constexpr std::size_t maximumPieceCount = 4;
+    /** @brief The maximum number of crossings of the three channel
+     * polynomials of a single piece with the constraint planes 0 and 1:
+     * A cubic polynomial crosses each plane at most three times. */
+    static constexpr std::size_t maximumRootsPerPiece = 3 * 2 * 3;
+
+    /** @brief Whether the ray is in CIELab (otherwise, it is in Oklab). */
+    bool isCielab;
+    /** @brief The arguments of the transfer function are
+     * <tt>offset + slope * chroma</tt>. */
+    Vec3d offset;
+    /** @brief The arguments of the transfer function are
+     * <tt>offset + slope * chroma</tt>. */
+    Vec3d slope;
+    /** @brief Matrix from the transfer function results to linear sRGB. */
+    Mat3d mix;
+
+    /** @brief Threshold of the linear segment of the CIELab transfer
+     * function. */
+    static constexpr double delta = 6.0 / 29.0;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param lightness The lightness of the ray.
+     * @param hue The hue of the ray, measured in degree.
+     * @param lchSpace The color space.
+     */
+    GamutRay(const double lightness, const double hue, const LchSpace lchSpace)
+        : isCielab(lchSpace == LchSpace::CielchD50)
+    {
+        const double hueRadians = qDegreesToRadians(hue);
+        const double cosHue = std::cos(hueRadians);
+        const double sinHue = std::sin(hueRadians);
+        if (isCielab) {
+            // As in fromCielabD50ToXyzD50(), with the white point
+            // folded into the matrix.
+            const double fy = (lightness + 16.0) / 116.0;
+            offset = Vec3d(fy, fy, fy);
+            slope = Vec3d(cosHue / 500.0, 0, -sinHue / 200.0);
+            constexpr Mat3d cielabMix = [] {
+                Mat3ld result = xyzD65ToLinearSRgbMatrix * xyzD50ToXyzD65Matrix;
+                for (std::size_t row = 0; row < 3; ++row) {
+                    for (std::size_t column = 0; column < 3; ++column) {
+                        result(row, column) *= whitePointD50TwoDegree(column);
+                    }
+                }
+                return static_cast<Mat3d>(result);
+            }();
+            mix = cielabMix;
+        } else {
+            // As in fromOklabToXyzD65().
+            constexpr Mat3d m2 = static_cast<Mat3d>(oklabM2inverse);
+            for (std::size_t i = 0; i < 3; ++i) {
+                offset(i) = m2(i, 0) * lightness;
+                slope(i) = m2(i, 1) * cosHue + m2(i, 2) * sinHue;
+            }
+            constexpr Mat3d oklabMix = static_cast<Mat3d>( //
+                xyzD65ToLinearSRgbMatrix * oklabM1inverse);
+            mix = oklabMix;
+        }
+    }
+
+    /**
+     * @param chroma The chroma
+     * @returns Whether the color at this chroma is within the sRGB gamut.
+     */
+    [[nodiscard]] bool isInGamut(const double chroma) const
+    {
+        Vec3d transferred;
+        for (std::size_t i = 0; i < 3; ++i) {
+            const double t = offset(i) + slope(i) * chroma;
+            transferred(i) = (isCielab && !(t > delta)) //
+                ? 3.0 * delta * delta * (t - 4.0 / 29.0) //
+                : t * t * t;
+        }
+        const Vec3d linearSRgb = mix * transferred;
+        for (std::size_t i = 0; i < 3; ++i) {
+            if (linearSRgb(i) < 0. || linearSRgb(i) > 1.) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param maximumChroma The upper end of the chroma range.
+     * @returns The bounds of the pieces of the piecewise polynomials within
+     * [0, maximumChroma], in ascending order: 0, the chroma values where one
+     * of the transfer function arguments switches to another segment, and
+     * maximumChroma.
+     */
+    [[nodiscard]] ChromaList<maximumPieceCount + 1> pieces(const double maximumChroma) const
+    {
+        ChromaList<maximumPieceCount + 1> result;
+        result.append(0);
+        if (isCielab) {
+            for (std::size_t i = 0; i < 3; ++i) {
+                if (slope(i) != 0) {
+                    const double chroma = (delta - offset(i)) / slope(i);
+                    if (chroma > 0 && chroma < maximumChroma) {
+                        result.append(chroma);
+                    }
+                }
+            }
+        }
+        result.append(maximumChroma);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * @param chroma A chroma value that is not a breakpoint.
+     * @returns The polynomials of the three linear sRGB channels, valid
+     * within the piece between the breakpoints that contains the chroma.
+     */
+    [[nodiscard]] std::array<Polynomial, 3> channelPolynomials(const double chroma) const
+    {
+        std::array<Polynomial, 3> transferred;
+        for (std::size_t i = 0; i < 3; ++i) {
+            const double p = offset(i);
+            const double q = slope(i);
+            if (isCielab && !(p + q * chroma > delta)) {
+                constexpr double factor = 3.0 * delta * delta;
+                transferred[i] = {factor * (p - 4.0 / 29.0), factor * q, 0, 0};
+            } else {
+                transferred[i] = {p * p * p, 3 * p * p * q, 3 * p * q * q, q * q * q};
+            }
+        }
+        std::array<Polynomial, 3> result{};
+        for (std::size_t channel = 0; channel < 3; ++channel) {
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t power = 0; power < 4; ++power) {
+                    result[channel][power] += mix(channel, i) * transferred[i][power];
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Finds where a polynomial crosses a target value.
+     *
+     * The range is split at the extrema of the polynomial (the closed-form
+     * roots of its quadratic derivative) into monotonic parts. In each
+     * part that crosses the target, the root is found by Newton’s method,
+     * safeguarded by bisection: Steps that leave the bracket are replaced
+     * by bisection steps. This converges quadratically in the typical
+     * case and needs only a few iterations to reach floating point
+     * precision.
+     *
+     * @param polynomial The polynomial
+     * @param target The target value
+     * @param lower The lower end of the range
+     * @param upper The upper end of the range
+     * @param roots The roots found within [lower, upper] are appended here.
+     * At most three roots are appended.
+     */
+    template<std::size_t capacity>
+    static void appendRoots(const Polynomial &polynomial, const double target, const double lower, const double upper, ChromaList<capacity> &roots)
+    {
+        const auto value = [&polynomial, target](const double x) {
+            return ((polynomial[3] * x + polynomial[2]) * x + polynomial[1]) * x + polynomial[0] - target;
+        };
+        // Extrema are the roots of the derivative.
+        const double a = 3 * polynomial[3];
+        const double b = 2 * polynomial[2];
+        const double c = polynomial[1];
+        const auto derivative = [a, b, c](const double x) {
+            return (a * x + b) * x + c;
+        };
+        ChromaList<4> splits;
+        splits.append(lower);
+        if (a != 0) {
+            const double discriminant = b * b - 4 * a * c;
+            if (discriminant > 0) {
+                const double root = std::sqrt(discriminant);
+                splits.append(qBound(lower, (-b - root) / (2 * a), upper));
+                splits.append(qBound(lower, (-b + root) / (2 * a), upper));
+            }
+        } else if (b != 0) {
+            splits.append(qBound(lower, -c / b, upper));
+        }
+        splits.append(upper);
+        std::sort(splits.begin(), splits.end());
+        // Enough for bisection alone to reach floating point precision
+        // within the chroma ranges used here.
+        constexpr int maximumIterations = 64;
+        for (std::size_t i = 0; i + 1 < splits.size; ++i) {
+            double low = splits.values[i];
+            double high = splits.values[i + 1];
+            if (!(high > low)) {
+                continue;
+            }
+            const double lowValue = value(low);
+            const double highValue = value(high);
+            if (lowValue == 0) {
+                roots.append(low);
+                continue;
+            }
+            if (highValue == 0) {
+                roots.append(high);
+                continue;
+            }
+            if ((lowValue < 0) == (highValue < 0)) {
+                continue;
+            }
+            // Start with the secant, which is close to the root if the
+            // polynomial is nearly linear within the bracket.
+            double x = low - lowValue * (high - low) / (highValue - lowValue);
+            for (int iteration = 0; iteration < maximumIterations; ++iteration) {
+                if (!(x > low && x < high)) {
+                    x = low + (high - low) / 2;
+                }
+                const double xValue = value(x);
+                if (xValue == 0) {
+                    break;
+                }
+                if ((xValue < 0) == (lowValue < 0)) {
+                    low = x;
+                } else {
+                    high = x;
+                }
+                const double next = x - xValue / derivative(x);
+                if (std::abs(next - x) <= std::numeric_limits<double>::epsilon() * std::abs(x) //
+                    || !(high - low > std::numeric_limits<double>::epsilon() * std::abs(high))) {
+                    x = next;
+                    break;
+                }
+                x = next;
+            }
+            roots.append(qBound(low, x, high));
+        }
+    }
+
+    /**
+     * @brief The highest in-gamut chroma.
+     *
+     * Examines the pieces of the piecewise polynomials from the highest
+     * chroma downwards, and within each piece the crossings with the
+     * constraint planes from the highest downwards. It stops at the first
+     * in-gamut part, so usually only the highest piece is examined.
+     *
+     * @param maximumChroma The highest chroma to examine.
+     *
+     * @returns The highest chroma within [0, maximumChroma] that is
+     * in-gamut, exact up to floating point precision, or
+     * <tt>std::nullopt</tt> if not even the gray axis is in-gamut.
+     */
+    [[nodiscard]] std::optional<double> highestInGamutChroma(const double maximumChroma) const
+    {
+        auto pieceBounds = pieces(maximumChroma);
+        for (std::size_t i = pieceBounds.size - 1; i > 0; --i) {
+            const double lower = pieceBounds.values[i - 1];
+            const double upper = pieceBounds.values[i];
+            if (!(upper > lower)) {
+                continue;
+            }
+            ChromaList<maximumRootsPerPiece + 2> bounds;
+            bounds.append(lower);
+            bounds.append(upper);
+            const auto polynomials = channelPolynomials(lower + (upper - lower) / 2);
+            for (const auto &polynomial : polynomials) {
+                appendRoots(polynomial, 0, lower, upper, bounds);
+                appendRoots(polynomial, 1, lower, upper, bounds);
+            }
+            std::sort(bounds.begin(), bounds.end(), std::greater<double>());
+            // Between two subsequent bounds, the color is either always
+            // in-gamut or always out-of-gamut, so testing a single sample
+            // is enough.
+            for (std::size_t j = 0; j + 1 < bounds.size; ++j) {
+                const double high = bounds.values[j];
+                const double low = bounds.values[j + 1];
+                if (high > low && isInGamut(low + (high - low) / 2)) {
+                    return high;
+                }
+            }
+        }
+        if (isInGamut(0)) {
+            return 0.;
+        }
+        return std::nullopt;
+    }
+};
+
+/**
+ * @brief The in-gamut chroma intervals of a ray of constant lightness and
+ * constant hue.
+ *
+ * Along such a ray, each linear sRGB channel is a piecewise polynomial of
+ * the chroma. This function finds all crossings of these polynomials with
+ * the constraint planes 0 and 1 of the sRGB gamut. Unlike a search that
+ * starts at the gray axis and stops at the first out-of-gamut color, it
+ * also finds all intervals of the unusual gamut shapes (see
+ * @ref ColorSpaceInfo::isUnusualShapeAtHue()).
+ *
+ * @param lightness The lightness of the ray.
+ * @param hue The hue of the ray, measured in degree.
+ * @param maximumChroma The upper end of the chroma range to examine.
+ * @param lchSpace The color space.
+ *
+ * @returns The in-gamut intervals of the chroma range [0, maximumChroma],
+ * as sorted and disjoint pairs of lower and upper bound. The bounds are
+ * exact up to floating point precision. If only the gray axis itself is
+ * in-gamut (like at the black point of Oklch), the result is the single
+ * interval [0, 0]. Empty if no color in this range is in-gamut.
+ */
+QList<std::pair<double, double>>
+AbsoluteColor::inGamutChromaIntervals(const double lightness, const double hue, const double maximumChroma, const LchSpace lchSpace)
+{
+    QList<std::pair<double, double>> result;
+    const double maximumLightness = (lchSpace == LchSpace::CielchD50) //
+        ? 100.
+        : 1.;
+    if (!isInRange<double>(0, lightness, maximumLightness) || !(maximumChroma >= 0)) {
+        return result;
+    }
+
+    const GamutRay ray(lightness, hue, lchSpace);
+
+    auto pieces = ray.pieces(maximumChroma);
+    GamutRay::ChromaList<(GamutRay::maximumPieceCount + 1) //
+                         + GamutRay::maximumPieceCount * GamutRay::maximumRootsPerPiece>
+        bounds;
+    for (const double piece : pieces) {
+        bounds.append(piece);
+    }
+    for (std::size_t i = 0; i + 1 < pieces.size; ++i) {
+        const double lower = pieces.values[i];
+        const double upper = pieces.values[i + 1];
+        if (!(upper > lower)) {
+            continue;
+        }
+        const auto polynomials = ray.channelPolynomials(lower + (upper - lower) / 2);
+        for (const auto &polynomial : polynomials) {
+            GamutRay::appendRoots(polynomial, 0, lower, upper, bounds);
+            GamutRay::appendRoots(polynomial, 1, lower, upper, bounds);
+        }
+    }
+    std::sort(bounds.begin(), bounds.end());
+
+    // Between two subsequent bounds, the color is either always in-gamut
+    // or always out-of-gamut, so testing a single sample is enough.
+    for (std::size_t i = 0; i + 1 < bounds.size; ++i) {
+        const double lower = bounds.values[i];
+        const double upper = bounds.values[i + 1];
+        if (!(upper > lower) || !ray.isInGamut(lower + (upper - lower) / 2)) {
+            continue;
+        }
+        if (!result.isEmpty() && result.last().second == lower) {
+            result.last().second = upper;
+        } else {
+            result.append({lower, upper});
+        }
+    }
+    if (result.isEmpty() && ray.isInGamut(0)) {
+        result.append({0., 0.});
+    }
+    return result;
 }
 
 /** @brief Reduces the chroma until the color fits into the gamut.
@@ -759,10 +1765,19 @@ QRgb AbsoluteColor::fastFromCielchD50ToSRgbClamped(const GenericColor &cielchD50
  * It always preserves the hue. It preservers the lightness whenever
  * possible.
  *
- * @note In some cases with very curvy color spaces, the nearest in-gamut
- * color (with the same lightness and hue) might be at <em>higher</em>
- * chroma. As this function always <em>reduces</em> the chroma,
- * in this case the result is not the nearest in-gamut color.
+ * The result is the in-gamut color with the highest chroma that is not
+ * higher than the original chroma. It is calculated directly by solving
+ * the gamut boundary along the ray of constant lightness and hue, starting
+ * at the original chroma and stopping at the first in-gamut part below.
+ * In some cases with very curvy color spaces, there might be more than one
+ * in-gamut chroma interval along the ray (see
+ * @ref inGamutChromaIntervals()); then the nearest one below the original
+ * chroma is used.
+ *
+ * @note In these cases, the nearest in-gamut color (with the same lightness
+ * and hue) might be at <em>higher</em> chroma. As this function always
+ * <em>reduces</em> the chroma, in this case the result is not the nearest
+ * in-gamut color.
  *
  * @param lch The color that will be adapted.
  * @param lchSpace The color space
@@ -796,36 +1811,98 @@ GenericColor AbsoluteColor::reduceChromaToFitIntoGamut(const GenericColor &lch,
     }
 
     // Now we know: We are out-of-gamut.
-    GenericColor temp;
-
-    // Create an in-gamut point on the gray axis:
-    GenericColor lowerChroma{referenceColor.first, 0, referenceColor.third};
-    if (!AbsoluteColor::isLchInSRgbGamut(lowerChroma, lchSpace)) {
-        // This is quite strange because every point between the blackpoint
-        // and the whitepoint on the gray axis should be in-gamut on
-        // normally shaped gamuts. But as we never know, we need a fallback,
-        // which is guaranteed to be in-gamut. The blackpoint is 0 and it
-        // is in-gamut for sRGB both in CielchD50 projection as in Oklab
-        // projection.
-        referenceColor.first = 0;
-        lowerChroma.first = 0;
-    }
-    // Do a quick-approximate search:
-    GenericColor upperChroma{referenceColor};
-    // Now we know for sure that lowerChroma is in-gamut
-    // and upperChroma is out-of-gamut…
-    temp = upperChroma;
-    while (upperChroma.second - lowerChroma.second > gamutPrecisionOklab) {
-        // Our test candidate is half the way between lowerChroma
-        // and upperChroma:
-        temp.second = ((lowerChroma.second + upperChroma.second) / 2);
-        if (isLchInSRgbGamut(temp, lchSpace)) {
-            lowerChroma = temp;
-        } else {
-            upperChroma = temp;
+    const GamutRay ray(referenceColor.first, referenceColor.third, lchSpace);
+    const auto highestChroma = ray.highestInGamutChroma(referenceColor.second);
+    if (highestChroma.has_value()) {
+        GenericColor candidate = referenceColor;
+        candidate.second = highestChroma.value();
+        const auto result = stepChromaIntoGamut(candidate, 0, lchSpace);
+        if (result.has_value()) {
+            return result.value();
+        }
+    }
+
+    // The solver and isLchInSRgbGamut() disagree. Fall back to all
+    // in-gamut intervals, from the nearest one downwards.
+    const auto intervals = inGamutChromaIntervals(referenceColor.first, //
+                                                  referenceColor.third,
+                                                  referenceColor.second,
+                                                  lchSpace);
+    for (auto it = intervals.crbegin(); it != intervals.crend(); ++it) {
+        GenericColor candidate = referenceColor;
+        candidate.second = it->second;
+        const auto result = stepChromaIntoGamut(candidate, it->first, lchSpace);
+        if (result.has_value()) {
+            return result.value();
+        }
+    }
+
+    // At the very boundary of the lightness range, the interval solver
+    // and isLchInSRgbGamut() might disagree due to rounding.
+    const GenericColor gray{referenceColor.first, 0, referenceColor.third};
+    if (AbsoluteColor::isLchInSRgbGamut(gray, lchSpace)) {
+        return gray;
+    }
+    // This is quite strange because every point between the blackpoint
+    // and the whitepoint on the gray axis should be in-gamut on
+    // normally shaped gamuts. But as we never know, we need a fallback,
+    // which is guaranteed to be in-gamut. The blackpoint is 0 and it
+    // is in-gamut for sRGB both in CielchD50 projection as in Oklab
+    // projection.
+    return GenericColor(0, 0, referenceColor.third);
+}
+
+/** @brief Reduces the chroma in small steps until
+ * @ref isLchInSRgbGamut() agrees that the color is in-gamut.
+ *
+ * The gamut solver is exact up to floating point precision, but
+ * @ref isLchInSRgbGamut() rounds differently, so at the very boundary
+ * both might disagree.
+ *
+ * @param lch The color. Its chroma is a result of the gamut solver.
+ * @param lowestChroma The chroma is never reduced below this value.
+ * @param lchSpace The color space
+ *
+ * @returns The first color that is in-gamut according to
+ * @ref isLchInSRgbGamut(), or <tt>std::nullopt</tt> if there is none within
+ * a few steps of the precision of the color space (@ref gamutPrecisionCielab
+ * or @ref gamutPrecisionOklab). */
+std::optional<GenericColor> AbsoluteColor::stepChromaIntoGamut(const GenericColor &lch, const double lowestChroma, const LchSpace lchSpace)
+{
+    const double step = (lchSpace == LchSpace::CielchD50) //
+        ? gamutPrecisionCielab
+        : gamutPrecisionOklab;
+    // Disagreements are limited to rounding errors, so a few steps
+    // are enough.
+    constexpr int maximumStepCount = 16;
+    GenericColor result = lch;
+    for (int i = 0; i <= maximumStepCount; ++i) {
+        if (AbsoluteColor::isLchInSRgbGamut(result, lchSpace)) {
+            return result;
         }
+        if (!(result.second > lowestChroma)) {
+            break;
+        }
+        result.second = qMax(lowestChroma, result.second - step);
+    }
+    return std::nullopt;
+}
+
+/** @brief Batch variant of
+ * @ref reduceChromaToFitIntoGamut(const GenericColor &, const LchSpace).
+ *
+ * @param lch The colors that will be adapted.
+ * @param lchSpace The color space
+ * @param result Buffer for the result. For each original color, the
+ *        adapted color. Only the first <em>n</em> elements are written,
+ *        where <em>n</em> is the minimum of the sizes of both spans.
+ *        It may be the same buffer as <tt>lch</tt>. */
+void AbsoluteColor::reduceChromaToFitIntoGamut(std::span<const GenericColor> lch, const LchSpace lchSpace, std::span<GenericColor> result)
+{
+    const std::size_t count = std::min(lch.size(), result.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        result[i] = reduceChromaToFitIntoGamut(lch[i], lchSpace);
     }
-    return lowerChroma;
 }
 
 } // namespace PerceptualColor
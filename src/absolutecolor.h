@@ -5,15 +5,20 @@
 #define PERCEPTUALCOLOR_ABSOLUTECOLOR_H
 
 #include "genericcolor.h"
+#include "multimodelcolor.h"
 #include "perceptualcolornamespace.h"
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <math.h>
 #include <optional>
 #include <qglobal.h>
-#include <qhash.h>
 #include <qlist.h>
 #include <qrgb.h>
+#include <span>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace PerceptualColor
 {
@@ -36,6 +41,12 @@ namespace PerceptualColor
  * between specific data formats and are created when more than one
  * widget uses them and code can be shared.
  *
+ * Some of the “fast” functions are also available as batch overloads that
+ * convert a whole span of colors at once, given as structure of arrays
+ * (one array per channel). These overloads use SIMD instructions where
+ * available and produce exactly the same results as the per-color
+ * overloads.
+ *
  * @sa @ref RgbColor
  *
  * @internal
@@ -50,7 +61,7 @@ class AbsoluteColor
 public:
     AbsoluteColor() = delete;
 
-    [[nodiscard]] static QHash<ColorModel, GenericColor> allConversions(const ColorModel model, const GenericColor &value);
+    [[nodiscard]] static MultiModelColor allConversions(const ColorModel model, const GenericColor &value);
     [[nodiscard]] static std::optional<GenericColor> convert(const ColorModel from, const GenericColor &value, const ColorModel to);
     [[nodiscard]] static GenericColor fromXyzD50ToXyzD65(const GenericColor &value);
     [[nodiscard]] static GenericColor fromXyzD65ToXyzD50(const GenericColor &value);
@@ -67,12 +78,23 @@ public:
 
     [[nodiscard]] static QRgb fastFromCielchD50ToSRgbClamped(const GenericColor &cielchD50);
     [[nodiscard]] static QRgb fastFromCielabD50ToSRgbOrTransparent(const GenericColor &cielabD50);
+    static void fastFromCielabD50ToSRgbOrTransparent(std::span<const float> lightness,
+                                                     std::span<const float> a,
+                                                     std::span<const float> b,
+                                                     std::span<QRgb> result);
     [[nodiscard]] static QRgb fastFromOklchToSRgbClamped(const GenericColor &oklch);
     [[nodiscard]] static QRgb fastFromOklabToSRgbOrTransparent(const GenericColor &oklab);
+    static void fastFromOklabToSRgbOrTransparent(std::span<const float> lightness, //
+                                                 std::span<const float> a,
+                                                 std::span<const float> b,
+                                                 std::span<QRgb> result);
     [[nodiscard]] static bool isLabInSRgbGamut(const GenericColor &lab, const LchSpace lchSpace);
     [[nodiscard]] static bool isLchInSRgbGamut(const GenericColor &lch, const LchSpace lchSpace);
 
+    [[nodiscard]] static QList<std::pair<double, double>>
+    inGamutChromaIntervals(const double lightness, const double hue, const double maximumChroma, const LchSpace lchSpace);
     [[nodiscard]] static GenericColor reduceChromaToFitIntoGamut(const GenericColor &lch, const LchSpace lchSpace);
+    static void reduceChromaToFitIntoGamut(std::span<const GenericColor> lch, const LchSpace lchSpace, std::span<GenericColor> result);
 
 private:
     /**
@@ -115,14 +137,138 @@ private:
           {ColorModel::CielabD50, ColorModel::CielchD50, fromCartesianToPolar},
           {ColorModel::OklabD65, ColorModel::OklchD65, fromCartesianToPolar}}};
 
-    [[nodiscard]] static QList<AbsoluteColor::Conversion> conversionsFrom(const ColorModel model);
+    /** @brief Number of @ref ColorModel values that can be used as index
+     * into a @ref ConversionPlan.
+     *
+     * This is one more than the highest enum value that occurs in
+     * @ref conversionList. Color models with higher values have no
+     * conversions at all. */
+    static constexpr std::size_t conversionModelCount = []() {
+        std::size_t result = 0;
+        for (const auto &item : conversionList) {
+            result = std::max(result, static_cast<std::size_t>(item.from) + 1);
+            result = std::max(result, static_cast<std::size_t>(item.to) + 1);
+        }
+        return result;
+    }();
+
+    /** @brief The shortest chain of conversions from one color model to
+     * another. */
+    struct ConversionPath {
+    public:
+        /** @brief Indices into @ref conversionList, in the order in which
+         * the conversions have to be applied.
+         *
+         * Only the first @ref length entries are valid. A path never uses
+         * an edge twice, so the size of @ref conversionList is enough. */
+        std::array<std::size_t, std::tuple_size_v<decltype(conversionList)>> steps{};
+        /** @brief Number of valid entries in @ref steps. */
+        std::size_t length = 0;
+        /** @brief Whether the destination can be reached at all. */
+        bool isReachable = false;
+    };
+
+    /** @brief Table of the shortest conversion paths, indexed first by the
+     * source and then by the destination @ref ColorModel. */
+    using ConversionPlan = std::array<std::array<ConversionPath, conversionModelCount>, conversionModelCount>;
+
+    /** @brief Calculates the shortest conversion paths between all color
+     * models.
+     *
+     * This function is meant to be evaluated at compile time. It does a
+     * breadth-first search on @ref conversionList for each source color
+     * model. If several shortest paths exist, the one whose edges come
+     * first in @ref conversionList wins.
+     *
+     * @returns The shortest conversion paths between all color models. */
+    [[nodiscard]] static constexpr ConversionPlan makeConversionPlan()
+    {
+        ConversionPlan result{};
+        for (std::size_t from = 0; from < conversionModelCount; ++from) {
+            // For every reached color model, the index of the edge in
+            // conversionList through which it was reached first.
+            std::array<std::size_t, conversionModelCount> previousEdge{};
+            std::array<bool, conversionModelCount> isVisited{};
+            std::array<std::size_t, conversionModelCount> queue{};
+            std::size_t queueBegin = 0;
+            std::size_t queueEnd = 0;
+            isVisited[from] = true;
+            queue[queueEnd++] = from;
+            while (queueBegin < queueEnd) {
+                const std::size_t current = queue[queueBegin++];
+                for (std::size_t edge = 0; edge < conversionList.size(); ++edge) {
+                    const auto edgeFrom = static_cast<std::size_t>(conversionList[edge].from);
+                    const auto edgeTo = static_cast<std::size_t>(conversionList[edge].to);
+                    if ((edgeFrom == current) && !isVisited[edgeTo]) {
+                        isVisited[edgeTo] = true;
+                        previousEdge[edgeTo] = edge;
+                        queue[queueEnd++] = edgeTo;
+                    }
+                }
+            }
+            for (std::size_t to = 0; to < conversionModelCount; ++to) {
+                auto &path = result[from][to];
+                path.isReachable = isVisited[to];
+                if (!path.isReachable) {
+                    continue;
+                }
+                // Walk backwards from the destination to the source…
+                std::size_t current = to;
+                while (current != from) {
+                    const std::size_t edge = previousEdge[current];
+                    path.steps[path.length++] = edge;
+                    current = static_cast<std::size_t>(conversionList[edge].from);
+                }
+                // …and reverse to get the order of application.
+                for (std::size_t i = 0; i < path.length / 2; ++i) {
+                    std::swap(path.steps[i], path.steps[path.length - 1 - i]);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Function pointer type for SIMD kernels that convert
+     * Lab-like values to linear sRGB.
+     *
+     * The kernel reads a fixed number of elements (the kernel width) from
+     * each of the three input arrays and writes the same number of
+     * elements to each of the three output arrays.
+     */
+    using LinearSRgbKernel = void (*)(const float *first, //
+                                      const float *second,
+                                      const float *third,
+                                      float *red,
+                                      float *green,
+                                      float *blue);
+
+    /** @brief A SIMD kernel together with its width. */
+    struct SimdKernel {
+    public:
+        /** @brief The kernel, or <tt>nullptr</tt> if no SIMD kernel is
+         * available on this CPU. */
+        LinearSRgbKernel kernel = nullptr;
+        /** @brief The number of elements the kernel processes per call. */
+        std::size_t width = 0;
+    };
 
-    static void addDirectConversionsRecursivly(QHash<ColorModel, GenericColor> *values, const ColorModel model);
+    static void fastFromLabToSRgbOrTransparent(const SimdKernel simdKernel,
+                                               QRgb (*scalarFunction)(const GenericColor &),
+                                               std::span<const float> first,
+                                               std::span<const float> second,
+                                               std::span<const float> third,
+                                               std::span<QRgb> result);
+    [[nodiscard]] static QRgb fastFromLinearSRgbToSRgbOrTransparent(const float r, const float g, const float b);
+    [[nodiscard]] static quint8 channelFromLinearSRgbToSRgbByte(const float x);
+    struct SRgbEncodingTable;
+    struct GamutRay;
 
     [[nodiscard]] static bool isCielchD50InSRgbGamut(const GenericColor &cielchD50);
     [[nodiscard]] static bool isCielabD50InSRgbGamut(const GenericColor &cielabD50);
     [[nodiscard]] static bool isOklabInSRgbGamut(const GenericColor &oklab);
     [[nodiscard]] static bool isOklchInSRgbGamut(const GenericColor &oklch);
+    [[nodiscard]] static std::optional<GenericColor> stepChromaIntoGamut(const GenericColor &lch, const double lowestChroma, const LchSpace lchSpace);
 
     /**
      * @internal
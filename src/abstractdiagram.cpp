@@ -15,8 +15,13 @@
 #include <qevent.h>
 #include <qglobal.h>
 #include <qimage.h>
+#include <qline.h>
 #include <qnamespace.h>
+#include <qpainter.h>
 #include <qpalette.h>
+#include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qsize.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
@@ -99,6 +104,90 @@ QSize AbstractDiagram::physicalPixelSize() const
     return QSize(qMax(width, 0), qMax(height, 0));
 }
 
+/** @brief Converts a region from widget coordinates to physical pixels.
+ *
+ * @param region A region, measured in <em>device-independent pixels</em>,
+ * for example <tt>QPaintEvent::region()</tt>.
+ *
+ * @returns The corresponding region measured in <em>physical pixels</em>,
+ * based on <tt>QPaintDevice::devicePixelRatioF()</tt>. If the scale factor
+ * is not an integer, each rectangle is rounded outward, so the result
+ * covers at least all physical pixels that are touched by the original
+ * region. */
+QRegion AbstractDiagram::physicalRegion(const QRegion &region) const
+{
+    const qreal scaleFactor = devicePixelRatioF();
+    QRegion result;
+    for (const QRect &rectangle : region) {
+        const QRectF scaledRectangle(rectangle.x() * scaleFactor, //
+                                     rectangle.y() * scaleFactor, //
+                                     rectangle.width() * scaleFactor, //
+                                     rectangle.height() * scaleFactor);
+        result += scaledRectangle.toAlignedRect();
+    }
+    return result;
+}
+
+/** @brief A paint buffer that is reused between paint events.
+ *
+ * Widgets that do not paint directly on the widget, but on a
+ * <tt>QImage</tt> first, can use this function instead of allocating
+ * a new image within each paint event. The image is re-allocated only
+ * when its size changes.
+ *
+ * @param physicalSize The requested size, measured in
+ * <em>physical pixels</em>.
+ * @param devicePixelRatio The requested device pixel ratio of the buffer.
+ * Widgets that paint in <em>device-independent pixels</em> pass
+ * <tt>QPaintDevice::devicePixelRatioF()</tt>. Widgets that paint in
+ * <em>physical pixels</em> pass <tt>1</tt> and draw the buffer into the
+ * corresponding rectangle in <em>device-independent pixels</em>.
+ *
+ * @returns A reference to the paint buffer. It has the requested size,
+ * the format <tt>QImage::Format_ARGB32_Premultiplied</tt> and the
+ * requested device pixel ratio. Its
+ * content is undefined: It might still contain what the last paint event
+ * has painted, or it might be uninitialized. Use
+ * @ref clearPaintBufferRegion() to clear the part that you are going
+ * to paint. The reference stays valid until the next call of this function.
+ *
+ * @note Do not keep shallow copies of the buffer beyond the paint
+ * event. QImage is implicitly shared, so the next paint event would
+ * trigger a deep copy, which defeats the purpose of this function. */
+QImage &AbstractDiagram::reusablePaintBuffer(const QSize physicalSize, const qreal devicePixelRatio)
+{
+    QImage &buffer = d_pointer->m_paintBuffer;
+    if (buffer.size() != physicalSize) {
+        buffer = QImage(physicalSize, QImage::Format_ARGB32_Premultiplied);
+    }
+    if (buffer.devicePixelRatio() != devicePixelRatio) {
+        buffer.setDevicePixelRatio(devicePixelRatio);
+    }
+    return buffer;
+}
+
+/** @brief Prepares a painter for a partial repaint of a paint buffer.
+ *
+ * Clips the painter to the given region and clears the region to
+ * <tt>Qt::transparent</tt>. Everything that is painted afterwards
+ * with this painter stays within the region.
+ *
+ * @param painter A painter that is active on the paint buffer.
+ * @param region The region that has to be repainted, measured in the
+ * current coordinates of the painter. Typically this
+ * is <tt>QPaintEvent::region()</tt> (or its @ref physicalRegion() when the
+ * painter operates in physical pixels).
+ *
+ * @sa @ref reusablePaintBuffer() */
+void AbstractDiagram::clearPaintBufferRegion(QPainter &painter, const QRegion &region)
+{
+    painter.setClipRegion(region);
+    const QPainter::CompositionMode oldMode = painter.compositionMode();
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(region.boundingRect(), Qt::transparent);
+    painter.setCompositionMode(oldMode);
+}
+
 /** @brief The maximum possible size of a square within the widget, measured
  * in <em>physical pixels</em>.
  *
@@ -183,6 +272,53 @@ qreal AbstractDiagram::handleRadius() const
     return handleOutlineThickness() * 2.5;
 }
 
+/** @brief The bounding rectangle of a circular handle.
+ *
+ * @param center The center of the handle, measured in
+ * <em>device-independent pixels</em> in widget coordinates.
+ *
+ * @returns The rectangle (in widget coordinates) that contains everything
+ * that is painted for a circular handle with the given center, including
+ * its outline and the anti-aliasing. This is the region that has to be
+ * repainted when the handle moves away from or to this position.
+ *
+ * @sa @ref handleRadius()
+ * @sa @ref handleOutlineThickness() */
+QRect AbstractDiagram::handleBoundingRect(const QPointF center) const
+{
+    // The outline is centered on the circle line. One additional pixel
+    // covers anti-aliasing and rounding.
+    const qreal extent = handleRadius() + handleOutlineThickness() / 2.0 + 1;
+    return QRectF(center.x() - extent, //
+                  center.y() - extent, //
+                  2 * extent, //
+                  2 * extent)
+        .toAlignedRect();
+}
+
+/** @brief The bounding rectangle of a line.
+ *
+ * @param line The line, measured in <em>device-independent pixels</em>
+ * in widget coordinates.
+ * @param penWidth The width of the pen that paints the line, measured
+ * in <em>device-independent pixels</em>.
+ *
+ * @returns The rectangle (in widget coordinates) that contains everything
+ * that is painted for the line with a pen of the given width (regardless
+ * of the cap style), including the anti-aliasing. This is the region that
+ * has to be repainted when a line-shaped handle moves away from or to
+ * this position. */
+QRect AbstractDiagram::lineBoundingRect(const QLineF &line, const qreal penWidth)
+{
+    // Round caps and square caps extend the line by half of the pen width.
+    // One additional pixel covers anti-aliasing and rounding.
+    const qreal extent = penWidth / 2.0 + 1;
+    return QRectF(line.p1(), line.p2())
+        .normalized()
+        .adjusted(-extent, -extent, extent, extent)
+        .toAlignedRect();
+}
+
 /** @brief The thickness of a color gradient.
  *
  * This is the thickness of a one-dimensional gradient, for example in
@@ -15,6 +15,11 @@
 #include <qwidget.h>
 
 class QHideEvent;
+class QLineF;
+class QPainter;
+class QPointF;
+class QRect;
+class QRegion;
 class QShowEvent;
 
 namespace PerceptualColor
@@ -62,6 +67,7 @@ protected:
     virtual void actualVisibilityToggledEvent();
     void callUpdate();
     virtual void changeEvent(QEvent *eventParameter) override;
+    static void clearPaintBufferRegion(QPainter &painter, const QRegion &region);
     virtual bool event(QEvent *eventParameter) override;
     virtual void execDrag(QPoint startPosition);
     [[nodiscard]] QColor focusIndicatorColor() const;
@@ -69,11 +75,15 @@ protected:
     [[nodiscard]] int gradientThickness() const;
     virtual void hideEvent(QHideEvent *eventParameter) override;
     [[nodiscard]] bool isActuallyVisible() const;
+    [[nodiscard]] static QRect lineBoundingRect(const QLineF &line, const qreal penWidth);
     virtual void mouseMoveEvent(QMouseEvent *eventParameter) override;
     virtual void mousePressEvent(QMouseEvent *eventParameter) override;
     [[nodiscard]] int maximumPhysicalSquareSize() const;
     [[nodiscard]] qreal maximumWidgetSquareSize() const;
     [[nodiscard]] QSize physicalPixelSize() const;
+    [[nodiscard]] QRegion physicalRegion(const QRegion &region) const;
+    [[nodiscard]] QImage &reusablePaintBuffer(const QSize physicalSize, const qreal devicePixelRatio);
+    [[nodiscard]] QRect handleBoundingRect(const QPointF center) const;
     [[nodiscard]] static QColor handleColorFromBackgroundLightness(qreal lightness, PerceptualColor::LchSpace projectionSpace);
     [[nodiscard]] int handleOutlineThickness() const;
     [[nodiscard]] qreal handleRadius() const;
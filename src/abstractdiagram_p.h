@@ -8,6 +8,7 @@
 // #include "abstractdiagram.h"
 
 #include <qglobal.h>
+#include <qimage.h>
 
 namespace PerceptualColor
 {
@@ -32,6 +33,11 @@ public:
     /** @brief Internal storage for @ref AbstractDiagram::isActuallyVisible. */
     bool m_isActuallyVisible = false;
 
+    /** @brief The paint buffer that is shared between the paint events.
+     *
+     * @sa @ref AbstractDiagram::reusablePaintBuffer() */
+    QImage m_paintBuffer;
+
 private:
     Q_DISABLE_COPY(AbstractDiagramPrivate)
 };
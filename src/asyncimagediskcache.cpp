@@ -0,0 +1,469 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// Own headers
+// First the interface, which forces the header to be self-contained.
+#include "asyncimagediskcache.h"
+
+#include "logging.h"
+#include "version.h"
+#include <qcolor.h>
+#include <qcryptographichash.h>
+#include <qdatastream.h>
+#include <qdebug.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qiodevice.h>
+#include <qlist.h>
+#include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qnumeric.h>
+#include <qsavefile.h>
+#include <qvariant.h>
+#include <qversionnumber.h>
+
+namespace PerceptualColor
+{
+
+/** @brief Mutex protection for @ref directoryStorage().
+ *
+ * @returns Mutex protection for @ref directoryStorage(). */
+QMutex &AsyncImageDiskCache::directoryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+/** @brief Storage for @ref directory().
+ *
+ * @returns Storage for @ref directory().
+ *
+ * @note Read and write access is protected by @ref directoryMutex(). */
+QString &AsyncImageDiskCache::directoryStorage()
+{
+    static QString directory;
+    return directory;
+}
+
+/** @brief Writes an @ref ImageHeader.
+ *
+ * @param stream The stream.
+ * @param header The header. */
+void AsyncImageDiskCache::writeImageHeader(QDataStream &stream, const ImageHeader &header)
+{
+    stream << header.width //
+           << header.height //
+           << header.format //
+           << header.bytesPerLine //
+           << header.devicePixelRatio //
+           << header.colorTable //
+           << header.dataOffset;
+}
+
+/** @brief Reads an @ref ImageHeader.
+ *
+ * @param stream The stream.
+ *
+ * @returns The header. */
+AsyncImageDiskCache::ImageHeader AsyncImageDiskCache::readImageHeader(QDataStream &stream)
+{
+    ImageHeader header;
+    stream >> header.width //
+        >> header.height //
+        >> header.format //
+        >> header.bytesPerLine //
+        >> header.devicePixelRatio //
+        >> header.colorTable //
+        >> header.dataOffset;
+    return header;
+}
+
+/** @brief Describes an image.
+ *
+ * @param image The image. Might be a null image.
+ *
+ * @returns The description. The data offset is <tt>0</tt>. */
+AsyncImageDiskCache::ImageHeader AsyncImageDiskCache::imageHeader(const QImage &image)
+{
+    ImageHeader result;
+    result.width = image.width();
+    result.height = image.height();
+    result.format = image.format();
+    result.bytesPerLine = image.bytesPerLine();
+    result.devicePixelRatio = image.devicePixelRatio();
+    result.colorTable = image.colorTable();
+    return result;
+}
+
+/** @brief Size of the pixel data of an image.
+ *
+ * @param header The description of the image.
+ *
+ * @returns Size of the pixel data, measured in bytes.
+ * <tt>std::nullopt</tt> if the header contains negative values or if
+ * the size does not fit into <tt>qint64</tt>. */
+std::optional<qint64> AsyncImageDiskCache::dataSize(const ImageHeader &header)
+{
+    if ((header.bytesPerLine < 0) || (header.height < 0)) {
+        return std::nullopt;
+    }
+    qint64 result = 0;
+    if (qMulOverflow(header.bytesPerLine, static_cast<qint64>(header.height), &result)) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+/** @brief Rounds up to the next multiple of an alignment.
+ *
+ * @param value The value.
+ * @param alignment The alignment.
+ *
+ * @returns The smallest multiple of the alignment that is not smaller than
+ * the value. */
+qint64 AsyncImageDiskCache::aligned(const qint64 value, const qint64 alignment)
+{
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+/** @brief Prepares a stream for the cache files.
+ *
+ * @param stream The stream.
+ *
+ * @post The stream uses a fixed version and byte order, so that the file
+ * format does not depend on the platform or the Qt version. */
+void AsyncImageDiskCache::setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+}
+
+/** @brief Creates an image from the pixel data of a file.
+ *
+ * @param header The description of the image. It is read from the file
+ * and therefore not trusted: The pixel data must fit completely into
+ * the file.
+ * @param fileData The content of the file.
+ * @param fileSize The size of the file, measured in bytes.
+ *
+ * @returns An image with a copy of the pixel data, or a null image if
+ * the header is not valid. */
+QImage AsyncImageDiskCache::imageFromFileData(const ImageHeader &header, const uchar *const fileData, const qint64 fileSize)
+{
+    const bool isFormatValid = (header.format > QImage::Format_Invalid) //
+        && (header.format < QImage::NImageFormats);
+    const bool isValid = isFormatValid //
+        && (header.width > 0) //
+        && (header.height > 0) //
+        && (header.bytesPerLine > 0) //
+        && (header.devicePixelRatio > 0) //
+        && (header.dataOffset > 0);
+    if (!isValid) {
+        return QImage();
+    }
+    const std::optional<qint64> size = dataSize(header);
+    qint64 dataEnd = 0;
+    if (!size.has_value() //
+        || qAddOverflow(header.dataOffset, size.value(), &dataEnd) //
+        || (dataEnd > fileSize)) {
+        return QImage();
+    }
+    const QImage mapped(fileData + header.dataOffset, //
+                        header.width,
+                        header.height,
+                        header.bytesPerLine,
+                        static_cast<QImage::Format>(header.format));
+    if (mapped.bytesPerLine() != header.bytesPerLine) {
+        return QImage();
+    }
+    // Make a deep copy, because the file data is released after loading.
+    QImage result = mapped.copy();
+    if (!header.colorTable.isEmpty()) {
+        result.setColorTable(header.colorTable);
+    }
+    result.setDevicePixelRatio(header.devicePixelRatio);
+    return result;
+}
+
+/** @brief The cache directory.
+ *
+ * @returns The cache directory. An empty string means that the cache
+ * is disabled.
+ *
+ * @sa @ref setDirectory() */
+QString AsyncImageDiskCache::directory()
+{
+    QMutexLocker<QMutex> locker(&directoryMutex());
+    return directoryStorage();
+}
+
+/** @brief Sets the cache directory.
+ *
+ * @param newDirectory The new cache directory. It is created when the
+ * first image is saved. An empty string disables the cache (default).
+ *
+ * @sa @ref directory() */
+void AsyncImageDiskCache::setDirectory(const QString &newDirectory)
+{
+    QMutexLocker<QMutex> locker(&directoryMutex());
+    directoryStorage() = newDirectory;
+}
+
+/** @brief The path of the file for a given key.
+ *
+ * @param directory The cache directory.
+ * @param key The key.
+ *
+ * @returns The path of the file. The file name is a hash of the key. */
+QString AsyncImageDiskCache::filePath(const QString &directory, const QByteArray &key)
+{
+    const QByteArray hash = //
+        QCryptographicHash::hash(key, QCryptographicHash::Sha256).toHex();
+    return QDir(directory).filePath(QString::fromLatin1(hash) //
+                                    + QStringLiteral(".pcimage"));
+}
+
+/** @brief Loads an image from the cache.
+ *
+ * @param key The key. It must contain all information that influences
+ * the image, like the image parameters.
+ *
+ * @returns The image and its alpha mask, if the cache is enabled and
+ * contains a valid file for exactly this key. <tt>std::nullopt</tt>
+ * otherwise. */
+std::optional<AsyncImageDiskCache::Entry> AsyncImageDiskCache::load(const QByteArray &key)
+{
+    const QString directory = AsyncImageDiskCache::directory();
+    if (directory.isEmpty() || key.isEmpty()) {
+        return std::nullopt;
+    }
+    QFile file(filePath(directory, key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    // The images are copied out of the file data anyway, so a plain read
+    // is sufficient. (A memory mapping would only pay off if the images
+    // could use the mapped memory directly.)
+    const QByteArray fileBytes = file.readAll();
+    const auto fileData = reinterpret_cast<const uchar *>(fileBytes.constData());
+    const qint64 fileSize = fileBytes.size();
+    QDataStream stream(fileBytes);
+    setupStream(stream);
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    QString libraryVersion;
+    QByteArray storedKey;
+    stream >> magic //
+        >> formatVersion //
+        >> libraryVersion //
+        >> storedKey;
+    const ImageHeader imageDescription = readImageHeader(stream);
+    const ImageHeader maskDescription = readImageHeader(stream);
+    const bool isHeaderValid = (stream.status() == QDataStream::Ok) //
+        && (magic == fileMagic) //
+        && (formatVersion == fileFormatVersion) //
+        && (libraryVersion == perceptualColorRunTimeVersion().toString()) //
+        && (storedKey == key);
+    if (!isHeaderValid) {
+        return std::nullopt;
+    }
+    Entry result;
+    result.image = imageFromFileData(imageDescription, fileData, fileSize);
+    if (result.image.isNull()) {
+        qCDebug(logging) << "Ignoring invalid disk cache file" << file.fileName();
+        return std::nullopt;
+    }
+    if (maskDescription.width > 0) {
+        result.mask = imageFromFileData(maskDescription, fileData, fileSize);
+        if (result.mask.isNull()) {
+            qCDebug(logging) << "Ignoring invalid disk cache file" << file.fileName();
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
+/** @brief Serves a rendering request from the cache, or renders and
+ * caches the image.
+ *
+ * This function does file I/O and might render, so call it from a
+ * background thread, typically as part of the render function of
+ * @ref AsyncImageRenderThread.
+ *
+ * @param key The key. It must contain all information that influences
+ * the image, like the image parameters.
+ * @param variantParameters The image parameters.
+ * @param renderFunction The function that renders the image if the cache
+ * does not contain it.
+ * @param callbackObject Receives the image.
+ *
+ * @post If the cache contains the image, it is delivered as final
+ * interlacing pass. Otherwise, <tt>renderFunction</tt> is called, all its
+ * interlacing passes are delivered, and the final image is saved to the
+ * cache.
+ *
+ * @sa @ref renderAndSave() */
+void AsyncImageDiskCache::loadOrRender(const QByteArray &key,
+                                       const QVariant &variantParameters,
+                                       const std::function<void(const QVariant &, AsyncImageRenderCallback &)> &renderFunction,
+                                       AsyncImageRenderCallback &callbackObject)
+{
+    const auto entry = load(key);
+    if (entry.has_value()) {
+        callbackObject.deliverInterlacingPass(entry.value().image, //
+                                              entry.value().mask,
+                                              variantParameters,
+                                              AsyncImageRenderCallback::InterlacingState::Final);
+        return;
+    }
+    renderAndSave(key, variantParameters, renderFunction, callbackObject);
+}
+
+/** @brief Renders an image and saves it to the cache.
+ *
+ * Like @ref loadOrRender(), but without consulting the cache before.
+ * Useful if @ref load() has yet been called without success.
+ *
+ * This function does file I/O and renders, so call it from a background
+ * thread.
+ *
+ * @param key The key. It must contain all information that influences
+ * the image, like the image parameters.
+ * @param variantParameters The image parameters.
+ * @param renderFunction The function that renders the image.
+ * @param callbackObject Receives the image.
+ *
+ * @post <tt>renderFunction</tt> is called, all its interlacing passes are
+ * delivered, and the final image is saved to the cache. */
+void AsyncImageDiskCache::renderAndSave(const QByteArray &key,
+                                        const QVariant &variantParameters,
+                                        const std::function<void(const QVariant &, AsyncImageRenderCallback &)> &renderFunction,
+                                        AsyncImageRenderCallback &callbackObject)
+{
+    SavingCallback savingCallback(key, callbackObject);
+    renderFunction(variantParameters, savingCallback);
+}
+
+/** @brief Constructor
+ *
+ * @param key The key for the cache.
+ * @param target The callback object that receives all calls. */
+AsyncImageDiskCache::SavingCallback::SavingCallback(const QByteArray &key, AsyncImageRenderCallback &target)
+    : m_key(key)
+    , m_target(target)
+{
+}
+
+/** @brief Destructor */
+AsyncImageDiskCache::SavingCallback::~SavingCallback() noexcept
+{
+}
+
+// No documentation here (documentation of base class will be used).
+void AsyncImageDiskCache::SavingCallback::deliverInterlacingPass(const QImage &image,
+                                                                 const QImage &mask,
+                                                                 const QVariant &parameters,
+                                                                 const AsyncImageRenderCallback::InterlacingState state)
+{
+    m_target.deliverInterlacingPass(image, mask, parameters, state);
+    if (state == AsyncImageRenderCallback::InterlacingState::Final) {
+        save(m_key, image, mask);
+    }
+}
+
+// No documentation here (documentation of base class will be used).
+bool AsyncImageDiskCache::SavingCallback::shouldAbort() const
+{
+    return m_target.shouldAbort();
+}
+
+/** @brief Saves an image to the cache.
+ *
+ * @param key The key. It must contain all information that influences
+ * the image, like the image parameters.
+ * @param image The image.
+ * @param mask The alpha mask. Might be a null image.
+ *
+ * @returns <tt>true</tt> on success. <tt>false</tt> if the cache is
+ * disabled or the file could not be written.
+ *
+ * @post If the cache directory contains too many files, the least recently
+ * written files are removed. */
+bool AsyncImageDiskCache::save(const QByteArray &key, const QImage &image, const QImage &mask)
+{
+    const QString directory = AsyncImageDiskCache::directory();
+    if (directory.isEmpty() || key.isEmpty() || image.isNull()) {
+        return false;
+    }
+    if (!QDir().mkpath(directory)) {
+        return false;
+    }
+
+    ImageHeader imageDescription = imageHeader(image);
+    ImageHeader maskDescription = imageHeader(mask);
+    const auto serializeHeader = [&]() {
+        QByteArray result;
+        QDataStream stream(&result, QIODevice::WriteOnly);
+        setupStream(stream);
+        stream << fileMagic //
+               << fileFormatVersion //
+               << perceptualColorRunTimeVersion().toString() //
+               << key;
+        writeImageHeader(stream, imageDescription);
+        writeImageHeader(stream, maskDescription);
+        return result;
+    };
+    // The data offsets have a fixed size within the stream, so setting
+    // them does not change the size of the header.
+    const qint64 headerSize = serializeHeader().size();
+    imageDescription.dataOffset = aligned(headerSize, dataAlignment);
+    const qint64 imageEnd = imageDescription.dataOffset //
+        + dataSize(imageDescription).value_or(0);
+    if (!mask.isNull()) {
+        maskDescription.dataOffset = aligned(imageEnd, dataAlignment);
+    }
+    const QByteArray header = serializeHeader();
+
+    QSaveFile file(filePath(directory, key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const auto writePadding = [&file](const qint64 targetPosition) {
+        const qint64 paddingSize = targetPosition - file.pos();
+        file.write(QByteArray(paddingSize, '\0'));
+    };
+    file.write(header);
+    writePadding(imageDescription.dataOffset);
+    file.write(reinterpret_cast<const char *>(image.constBits()), //
+               dataSize(imageDescription).value_or(0));
+    if (!mask.isNull()) {
+        writePadding(maskDescription.dataOffset);
+        file.write(reinterpret_cast<const char *>(mask.constBits()), //
+                   dataSize(maskDescription).value_or(0));
+    }
+    if (!file.commit()) {
+        return false;
+    }
+    prune(directory);
+    return true;
+}
+
+/** @brief Removes the least recently written files if there are too many.
+ *
+ * @param directory The cache directory.
+ *
+ * @post At most @ref maximumFileCount files are left. */
+void AsyncImageDiskCache::prune(const QString &directory)
+{
+    const QFileInfoList files = QDir(directory).entryInfoList( //
+        QStringList{QStringLiteral("*.pcimage")},
+        QDir::Files,
+        QDir::Time); // Sorted: Most recently written first.
+    for (qsizetype i = maximumFileCount; i < files.count(); ++i) {
+        QFile::remove(files.at(i).absoluteFilePath());
+    }
+}
+
+} // namespace PerceptualColor
@@ -0,0 +1,149 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#ifndef PERCEPTUALCOLOR_ASYNCIMAGEDISKCACHE_H
+#define PERCEPTUALCOLOR_ASYNCIMAGEDISKCACHE_H
+
+#include "asyncimagerendercallback.h"
+#include <functional>
+#include <optional>
+#include <qbytearray.h>
+#include <qcolor.h>
+#include <qglobal.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qstring.h>
+class QDataStream;
+class QMutex;
+class QVariant;
+
+namespace PerceptualColor
+{
+/** @internal
+ *
+ * @brief Persistent cache of rendered images across sessions.
+ *
+ * Some images depend only on parameters that rarely change between two
+ * application starts, like the color wheel ring. Rendering them at each
+ * start is a waste of time. This cache stores final images on the disk,
+ * so that @ref AsyncImageProvider can use them before the first paint
+ * event.
+ *
+ * The cache is opt-in: It is disabled as long as no directory has been
+ * set with @ref setDirectory().
+ *
+ * Each image is stored in its own file. The file contains a header with
+ * a format version, the library version and the full key, followed by the
+ * raw pixel data. Files that do not match exactly are ignored on load.
+ * Loading reads the whole file and copies the pixel data into new images.
+ * Only a limited number of files is kept; the least recently written
+ * files are removed.
+ *
+ * Loading a single file is fast enough to be done before the first paint
+ * event. Saving and rendering are slow, so call them from a background
+ * thread: @ref loadOrRender() and @ref renderAndSave() are meant to be
+ * used as render function of @ref AsyncImageRenderThread.
+ *
+ * This class is thread-safe. */
+class AsyncImageDiskCache final
+{
+public:
+    /** @brief A cached image. */
+    struct Entry {
+    public:
+        /** @brief The image. */
+        QImage image;
+        /** @brief The alpha mask. Might be a null image. */
+        QImage mask;
+    };
+
+    [[nodiscard]] static QString directory();
+    [[nodiscard]] static std::optional<Entry> load(const QByteArray &key);
+    static void loadOrRender(const QByteArray &key,
+                             const QVariant &variantParameters,
+                             const std::function<void(const QVariant &, AsyncImageRenderCallback &)> &renderFunction,
+                             AsyncImageRenderCallback &callbackObject);
+    static void renderAndSave(const QByteArray &key,
+                              const QVariant &variantParameters,
+                              const std::function<void(const QVariant &, AsyncImageRenderCallback &)> &renderFunction,
+                              AsyncImageRenderCallback &callbackObject);
+    static bool save(const QByteArray &key, const QImage &image, const QImage &mask);
+    static void setDirectory(const QString &newDirectory);
+
+private:
+    /** @internal @brief Only for unit tests. */
+    friend class TestAsyncImageDiskCache;
+
+    AsyncImageDiskCache() = delete;
+
+    /** @brief Forwards all calls to another callback object, and saves
+     * the final image to the cache.
+     *
+     * @sa @ref loadOrRender() */
+    class SavingCallback final : public AsyncImageRenderCallback
+    {
+    public:
+        SavingCallback(const QByteArray &key, AsyncImageRenderCallback &target);
+        virtual ~SavingCallback() noexcept override;
+        virtual void deliverInterlacingPass(const QImage &image,
+                                            const QImage &mask,
+                                            const QVariant &parameters,
+                                            const AsyncImageRenderCallback::InterlacingState state) override;
+        [[nodiscard]] virtual bool shouldAbort() const override;
+
+    private:
+        Q_DISABLE_COPY(SavingCallback)
+        /** @brief The key for the cache. */
+        const QByteArray m_key;
+        /** @brief The callback object that receives all calls. */
+        AsyncImageRenderCallback &m_target;
+    };
+
+    /** @brief Description of an image within a cache file. */
+    struct ImageHeader {
+    public:
+        /** @brief Width of the image, measured in pixels. */
+        qint32 width = 0;
+        /** @brief Height of the image, measured in pixels. */
+        qint32 height = 0;
+        /** @brief The <tt>QImage::Format</tt> of the image. */
+        qint32 format = QImage::Format_Invalid;
+        /** @brief Bytes per line of the image. */
+        qint64 bytesPerLine = 0;
+        /** @brief Device pixel ratio of the image. */
+        double devicePixelRatio = 1;
+        /** @brief Color table of the image. Empty for formats without
+         * color table. */
+        QList<QRgb> colorTable;
+        /** @brief Position of the pixel data within the file, measured
+         * in bytes. */
+        qint64 dataOffset = 0;
+    };
+
+    [[nodiscard]] static qint64 aligned(const qint64 value, const qint64 alignment);
+    [[nodiscard]] static std::optional<qint64> dataSize(const ImageHeader &header);
+    [[nodiscard]] static QMutex &directoryMutex();
+    [[nodiscard]] static QString &directoryStorage();
+    [[nodiscard]] static QString filePath(const QString &directory, const QByteArray &key);
+    [[nodiscard]] static QImage imageFromFileData(const ImageHeader &header, const uchar *const fileData, const qint64 fileSize);
+    [[nodiscard]] static ImageHeader imageHeader(const QImage &image);
+    static void prune(const QString &directory);
+    [[nodiscard]] static ImageHeader readImageHeader(QDataStream &stream);
+    static void setupStream(QDataStream &stream);
+    static void writeImageHeader(QDataStream &stream, const ImageHeader &header);
+
+    /** @brief Identifies the file format. */
+    static constexpr quint32 fileMagic = 0x50434943; // “PCIC”
+    /** @brief Version of the file format. Increment it after each change
+     * of the file format. */
+    static constexpr quint32 fileFormatVersion = 1;
+    /** @brief Alignment of the pixel data within the file, measured
+     * in bytes. */
+    static constexpr qint64 dataAlignment = 64;
+    /** @brief Maximum number of files in the cache directory. */
+    static constexpr int maximumFileCount = 32;
+};
+
+} // namespace PerceptualColor
+
+#endif // PERCEPTUALCOLOR_ASYNCIMAGEDISKCACHE_H
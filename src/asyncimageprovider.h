@@ -4,11 +4,16 @@
 #ifndef PERCEPTUALCOLOR_ASYNCIMAGEPROVIDER_H
 #define PERCEPTUALCOLOR_ASYNCIMAGEPROVIDER_H
 
+#include "asyncimagediskcache.h"
 #include "asyncimageproviderbase.h"
 #include "asyncimagerenderthread.h"
+#include "asyncimagesharedstore.h"
+#include "nearestfeaturemap.h"
 #include <optional>
+#include <qbytearray.h>
 #include <qglobal.h>
 #include <qimage.h>
+#include <qlist.h>
 #include <qmetatype.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
@@ -44,6 +49,25 @@ namespace PerceptualColor
  *   helper class makes it easy to implement  Adam7-like interlacing.
  * - Cache: As the image calculation might be expensive, resulting image is
  *   cached for further usage.
+ * - Optional render cache: Final images of previous rendering requests
+ *   can be kept in a least-recently-used cache, see
+ *   @ref setRenderCacheCapacity(). Going back to previous image parameters
+ *   is then served immediately without rendering.
+ * - Optional prefetching: Images that will probably be needed soon can
+ *   be rendered speculatively into the render cache with low priority,
+ *   see @ref prefetchAsync().
+ * - Nearest feature map: For each alpha mask, the nearest opaque pixel of
+ *   each pixel is calculated in the background thread(s), see
+ *   @ref getNearestFeatureMapCache().
+ * - Sharing: Providers with identical image parameters render the image
+ *   only once and share the result, see @ref AsyncImageSharedStore.
+ * - Optional disk cache: If <tt>T</tt> provides a member function
+ *   <tt>QByteArray diskCacheKey() const</tt> and @ref AsyncImageDiskCache
+ *   is enabled, the image of the first rendering request is loaded from
+ *   the disk if available, and saved to the disk otherwise. Loading
+ *   happens synchronously within @ref refreshAsync(), so that the image is
+ *   available for the first paint after the application start. Rendering
+ *   and saving happen in the background thread.
  *
  * @section asyncimagecreate How to create an object
  *
@@ -83,23 +107,72 @@ public:
 
     [[nodiscard]] QImage getMaskCache() const;
     [[nodiscard]] QImage getCache() const;
+    [[nodiscard]] NearestFeatureMap getNearestFeatureMapCache() const;
     [[nodiscard]] T imageParameters() const;
+    [[nodiscard]] bool isCacheUpToDate() const;
+    void prefetchAsync(const QList<T> &parametersList);
     void refreshAsync();
     void refreshSync();
+    [[nodiscard]] qsizetype renderCacheCapacity() const;
+    [[nodiscard]] qsizetype renderCacheMinimumEntryCount() const;
     void setImageParameters(const T &newImageParameters);
+    void setRenderCacheCapacity(const qsizetype bytes);
+    void setRenderCacheMinimumEntryCount(const qsizetype count);
 
 private:
     Q_DISABLE_COPY(AsyncImageProvider)
 
     /** @internal @brief Only for unit tests. */
     friend class TestAsyncImageProvider;
+    /** @internal @brief Only for unit tests. */
+    friend class TestAsyncImageSharedStore;
+    /** @brief Delivers shared images and hands over the rendering. */
+    friend class AsyncImageSharedStore<T>;
+
+    /** @brief An entry of @ref m_renderCache. */
+    struct RenderCacheEntry {
+    public:
+        /** @brief The image parameters. */
+        T parameters;
+        /** @brief The final image. */
+        QImage image;
+        /** @brief The alpha mask. Might be a null image. */
+        QImage mask;
+        /** @brief The nearest feature map of the alpha mask. Might be
+         * a null map. */
+        NearestFeatureMap nearestFeatureMap;
+        /** @brief Memory usage of the images and the nearest feature map,
+         * measured in bytes. */
+        qsizetype sizeInBytes = 0;
+    };
 
-    void processInterlacingPassResult(const QImage &deliveredImage, const QImage &deliveredMask);
+    [[nodiscard]] static QByteArray diskCacheKey(const T &parameters);
+    [[nodiscard]] qsizetype effectiveRenderCacheCapacity(const qsizetype entrySize) const;
+    void insertIntoRenderCache(const T &parameters, const QImage &image, const QImage &mask, const NearestFeatureMap &nearestFeatureMap);
+    void processInterlacingPassResult(const QImage &deliveredImage,
+                                      const QImage &deliveredMask,
+                                      const NearestFeatureMap &deliveredNearestFeatureMap,
+                                      const QVariant &parameters,
+                                      const AsyncImageRenderCallback::InterlacingState state);
+    void processPrefetchResult(const QImage &deliveredImage,
+                               const QImage &deliveredMask,
+                               const NearestFeatureMap &deliveredNearestFeatureMap,
+                               const QVariant &parameters,
+                               const AsyncImageRenderCallback::InterlacingState state);
+    static void renderWithDiskCache(const QVariant &variantParameters, AsyncImageRenderCallback &callbackObject);
+    [[nodiscard]] bool startDiskCacheRendering();
+    [[nodiscard]] qsizetype renderCacheIndexOf(const T &parameters) const;
+    void startNextPrefetch();
+    void startSharedRendering();
+    void trimRenderCache();
+    void yieldPrefetch();
 
     /** @brief The mask cache. */
     QImage m_maskCache;
     /** @brief The image cache. */
     QImage m_cache;
+    /** @brief The cache of the nearest feature map of @ref m_maskCache. */
+    NearestFeatureMap m_nearestFeatureMapCache;
     /** @brief Internal storage for the image parameters.
      *
      * @sa @ref imageParameters()
@@ -116,8 +189,57 @@ private:
     /** @brief The parameters of the last rendering that has been started
      * (if any). */
     std::optional<T> m_lastRenderingRequestImageParameters;
-    /** @brief Provides a render thread. */
+    /** @brief Is <tt>true</tt> if @ref m_cache holds the final image for
+     * @ref m_lastRenderingRequestImageParameters.
+     *
+     * Further deliveries of the render thread are outdated then
+     * and are ignored. */
+    bool m_lastRenderingRequestIsComplete = false;
+    /** @brief Least-recently-used cache of final images.
+     *
+     * The most recently used entry comes first. The entries are found
+     * by linear search. This is fast enough because the number of entries
+     * is small: Each entry is a full image.
+     *
+     * @sa @ref setRenderCacheCapacity() */
+    QList<RenderCacheEntry> m_renderCache;
+    /** @brief Maximum memory usage of @ref m_renderCache, measured
+     * in bytes.
+     *
+     * @sa @ref renderCacheCapacity()
+     * @sa @ref setRenderCacheCapacity() */
+    qsizetype m_renderCacheCapacity = 0;
+    /** @brief Minimum number of entries of @ref m_renderCache.
+     *
+     * @sa @ref renderCacheMinimumEntryCount()
+     * @sa @ref setRenderCacheMinimumEntryCount() */
+    qsizetype m_renderCacheMinimumEntryCount = 0;
+    /** @brief Current memory usage of @ref m_renderCache, measured
+     * in bytes. */
+    qsizetype m_renderCacheSize = 0;
+    /** @brief Image parameters that are waiting to be prefetched.
+     *
+     * @sa @ref prefetchAsync() */
+    QList<T> m_prefetchQueue;
+    /** @brief The image parameters that are currently prefetched (if any). */
+    std::optional<T> m_prefetchInProgress;
+    /** @brief If @ref AsyncImageDiskCache has yet been consulted.
+     *
+     * Only the first rendering request that needs rendering consults the
+     * disk cache. Later requests usually come from user interaction and
+     * would only fill the disk with images that are never used again. */
+    bool m_isDiskCacheConsulted = false;
+    /** @brief Provides rendering on the shared
+     * @ref AsyncImageRenderScheduler. */
     AsyncImageRenderThread m_renderThread;
+    /** @brief Like @ref m_renderThread, but saves the final image to
+     * @ref AsyncImageDiskCache within the background job.
+     *
+     * @sa @ref renderWithDiskCache() */
+    AsyncImageRenderThread m_diskCacheThread;
+    /** @brief Provides prefetch rendering with
+     * @ref AsyncImageRenderScheduler::Priority::Prefetch. */
+    AsyncImageRenderThread m_prefetchThread;
 };
 
 /** @brief Constructor
@@ -127,6 +249,8 @@ template<typename T>
 AsyncImageProvider<T>::AsyncImageProvider(QObject *parent)
     : AsyncImageProviderBase(parent)
     , m_renderThread(&T::render)
+    , m_diskCacheThread(&AsyncImageProvider<T>::renderWithDiskCache)
+    , m_prefetchThread(&T::render)
 {
     // Calling qRegisterMetaType is safe even if a given type has yet
     // been registered before.
@@ -136,12 +260,28 @@ AsyncImageProvider<T>::AsyncImageProvider(QObject *parent)
         &AsyncImageRenderThread::interlacingPassCompleted, //
         this, //
         &AsyncImageProvider<T>::processInterlacingPassResult);
+    connect( //
+        &m_diskCacheThread, //
+        &AsyncImageRenderThread::interlacingPassCompleted, //
+        this, //
+        &AsyncImageProvider<T>::processInterlacingPassResult);
+    m_prefetchThread.setPriority(AsyncImageRenderScheduler::Priority::Prefetch);
+    connect( //
+        &m_prefetchThread, //
+        &AsyncImageRenderThread::interlacingPassCompleted, //
+        this, //
+        &AsyncImageProvider<T>::processPrefetchResult);
 }
 
 /** @brief Destructor */
 template<typename T>
 AsyncImageProvider<T>::~AsyncImageProvider() noexcept
 {
+    if (m_lastRenderingRequestImageParameters.has_value()) {
+        AsyncImageSharedStore<T>::instance().unsubscribe( //
+            this,
+            m_lastRenderingRequestImageParameters.value());
+    }
 }
 
 /** @brief Provides the content of the image cache.
@@ -168,6 +308,17 @@ QImage AsyncImageProvider<T>::getMaskCache() const
     return m_maskCache;
 }
 
+/** @brief Provides the content of the nearest feature map cache.
+ *
+ * @returns The @ref NearestFeatureMap of the content of the alpha mask
+ * cache. It is always in sync with @ref getMaskCache(). It might be a null
+ * map if the alpha mask cache is empty. */
+template<typename T>
+NearestFeatureMap AsyncImageProvider<T>::getNearestFeatureMapCache() const
+{
+    return m_nearestFeatureMapCache;
+}
+
 /** @brief Setter for the image parameters.
  *
  * @param newImageParameters The new image parameters.
@@ -207,6 +358,21 @@ T AsyncImageProvider<T>::imageParameters() const
     return m_imageParameters;
 }
 
+/** @brief If the caches hold the final result for the current
+ * image parameters.
+ *
+ * @returns <tt>true</tt> if @ref getCache(), @ref getMaskCache() and
+ * @ref getNearestFeatureMapCache() provide the final result of a rendering
+ * request for the current @ref imageParameters(). (The mask caches are
+ * only updated if the render function provides alpha masks.)
+ * <tt>false</tt> otherwise. */
+template<typename T>
+bool AsyncImageProvider<T>::isCacheUpToDate() const
+{
+    return m_lastRenderingRequestIsComplete //
+        && (m_lastRenderingRequestImageParameters == m_imageParameters);
+}
+
 /** @brief Receives and processes newly rendered images that are
  * delivered from the background render process.
  *
@@ -222,9 +388,17 @@ T AsyncImageProvider<T>::imageParameters() const
  * but in some cases, they may fall below this threshold. The alpha mask,
  * however, provides a clear and definitive indication of each pixel’s
  * validity.
+ * @param deliveredNearestFeatureMap The nearest feature map of the alpha
+ * mask. A null map if no alpha mask is provided.
+ * @param parameters The image parameters of the image.
+ * @param state The interlacing state of the image.
  *
- * @post The new image, and if available the alpha mask, will be put into the
- * cache and the signal @ref interlacingPassCompleted() is emitted.
+ * @post The new image, and if available the alpha mask and its nearest
+ * feature map, will be put into the cache and the signal @ref interlacingPassCompleted() is emitted. Final
+ * images are also put into the render cache (if enabled). If the cache
+ * holds yet the final image of the last rendering request, outdated
+ * deliveries are ignored. Deliveries for the last rendering request are
+ * shared with other providers by means of @ref AsyncImageSharedStore.
  *
  * This function is meant to be called by the background render process to
  * deliver more data. It <em>must</em> be called after each interlacing pass
@@ -238,33 +412,488 @@ T AsyncImageProvider<T>::imageParameters() const
  * the functor-based <tt>Qt::connect()</tt> syntax to connect to this function
  * as long as the connection type is not direct, but queued. */
 template<typename T>
-void AsyncImageProvider<T>::processInterlacingPassResult(const QImage &deliveredImage, const QImage &deliveredMask)
+void AsyncImageProvider<T>::processInterlacingPassResult(const QImage &deliveredImage,
+                                                         const QImage &deliveredMask,
+                                                         const NearestFeatureMap &deliveredNearestFeatureMap,
+                                                         const QVariant &parameters,
+                                                         const AsyncImageRenderCallback::InterlacingState state)
 {
+    const T deliveredParameters = parameters.value<T>();
+    if (state == AsyncImageRenderCallback::InterlacingState::Final) {
+        insertIntoRenderCache(deliveredParameters, //
+                              deliveredImage,
+                              deliveredMask,
+                              deliveredNearestFeatureMap);
+        if (m_lastRenderingRequestIsComplete) {
+            return;
+        }
+        if (deliveredParameters == m_lastRenderingRequestImageParameters) {
+            m_lastRenderingRequestIsComplete = true;
+            // The real request is done. Use the idle time for prefetching.
+            startNextPrefetch();
+        }
+    } else if (m_lastRenderingRequestIsComplete) {
+        return;
+    }
     m_cache = deliveredImage;
     if (!deliveredMask.isNull()) {
         m_maskCache = deliveredMask;
+        m_nearestFeatureMapCache = deliveredNearestFeatureMap;
+    }
+    if (deliveredParameters == m_lastRenderingRequestImageParameters) {
+        // Share before emitting the signal: Connected slots might start
+        // a new rendering request, which ends the subscription.
+        AsyncImageSharedStore<T>::instance().publish( //
+            this,
+            deliveredParameters,
+            deliveredImage,
+            deliveredMask,
+            deliveredNearestFeatureMap,
+            state);
     }
     Q_EMIT interlacingPassCompleted();
 }
 
 /** @brief Asynchronously triggers a refresh of the image cache (if
- * necessary). */
+ * necessary).
+ *
+ * If another provider is yet rendering an image with identical image
+ * parameters, no rendering is started. Instead, the images of the other
+ * provider are used. See @ref AsyncImageSharedStore for details. */
 template<typename T>
 void AsyncImageProvider<T>::refreshAsync()
 {
     if (imageParameters() == m_lastRenderingRequestImageParameters) {
         return;
     }
-    m_renderThread.startRenderingAsync(QVariant::fromValue(imageParameters()));
+    auto &store = AsyncImageSharedStore<T>::instance();
+    if (m_lastRenderingRequestImageParameters.has_value()) {
+        store.unsubscribe(this, m_lastRenderingRequestImageParameters.value());
+    }
     m_lastRenderingRequestImageParameters = imageParameters();
+    const qsizetype index = renderCacheIndexOf(imageParameters());
+    if (index >= 0) {
+        // Cache hit: Skip the rendering entirely.
+        m_renderCache.move(index, 0);
+        m_renderThread.cancelRendering();
+        m_diskCacheThread.cancelRendering();
+        const RenderCacheEntry entry = m_renderCache.constFirst();
+        m_cache = entry.image;
+        if (!entry.mask.isNull()) {
+            m_maskCache = entry.mask;
+            m_nearestFeatureMapCache = entry.nearestFeatureMap;
+        }
+        m_lastRenderingRequestIsComplete = true;
+        // Other providers that are waiting for this image can use it, too.
+        // No rendering is necessary, even if this provider becomes the
+        // renderer. (If the shared store yet has the final image, publish()
+        // ignores this call.)
+        Q_UNUSED(store.subscribe(this, entry.parameters))
+        store.publish(this, //
+                      entry.parameters,
+                      entry.image,
+                      entry.mask,
+                      entry.nearestFeatureMap,
+                      AsyncImageRenderCallback::InterlacingState::Final);
+        Q_EMIT interlacingPassCompleted();
+        startNextPrefetch();
+        return;
+    }
+    m_lastRenderingRequestIsComplete = false;
+    // Stop rendering outdated image parameters. If this provider becomes
+    // the renderer, the rendering is started again right afterwards.
+    m_renderThread.cancelRendering();
+    m_diskCacheThread.cancelRendering();
+    if (!store.subscribe(this, imageParameters())) {
+        return;
+    }
+    if (startDiskCacheRendering()) {
+        return;
+    }
+    startSharedRendering();
+}
+
+/** @brief Key for @ref AsyncImageDiskCache.
+ *
+ * @param parameters The image parameters.
+ *
+ * @returns The result of <tt>T::diskCacheKey()</tt> if <tt>T</tt> provides
+ * this member function. An empty byte array otherwise, which means that
+ * the images are never cached on the disk. */
+template<typename T>
+QByteArray AsyncImageProvider<T>::diskCacheKey(const T &parameters)
+{
+    if constexpr (requires { parameters.diskCacheKey(); }) {
+        return parameters.diskCacheKey();
+    } else {
+        return QByteArray();
+    }
+}
+
+/** @brief Render function for @ref m_diskCacheThread.
+ *
+ * Runs in the background. Renders the image with <tt>T::render()</tt> and
+ * saves it to @ref AsyncImageDiskCache.
+ *
+ * @param variantParameters The image parameters, of type <tt>T</tt>.
+ * @param callbackObject Receives the image. */
+template<typename T>
+void AsyncImageProvider<T>::renderWithDiskCache(const QVariant &variantParameters, AsyncImageRenderCallback &callbackObject)
+{
+    AsyncImageDiskCache::renderAndSave(diskCacheKey(variantParameters.value<T>()), //
+                                       variantParameters,
+                                       &T::render,
+                                       callbackObject);
+}
+
+/** @brief Serves the last rendering request with
+ * @ref AsyncImageDiskCache.
+ *
+ * Only the first call consults the disk cache. It loads the image
+ * synchronously, so that it is available before the first paint event.
+ * Loading a single file, including the validation of its header, is much
+ * faster than rendering. If the disk cache does not contain the image, it
+ * is rendered in the background and saved to the disk cache.
+ *
+ * @returns <tt>true</tt> if the image has been loaded or the rendering has
+ * been started. <tt>false</tt> if the disk cache is not used for this
+ * request. */
+template<typename T>
+bool AsyncImageProvider<T>::startDiskCacheRendering()
+{
+    if (m_isDiskCacheConsulted || AsyncImageDiskCache::directory().isEmpty()) {
+        return false;
+    }
+    m_isDiskCacheConsulted = true;
+    const T parameters = m_lastRenderingRequestImageParameters.value();
+    const QByteArray key = diskCacheKey(parameters);
+    if (key.isEmpty()) {
+        return false;
+    }
+    const auto entry = AsyncImageDiskCache::load(key);
+    if (entry.has_value()) {
+        processInterlacingPassResult(entry.value().image, //
+                                     entry.value().mask,
+                                     NearestFeatureMap::fromMask(entry.value().mask),
+                                     QVariant::fromValue(parameters),
+                                     AsyncImageRenderCallback::InterlacingState::Final);
+        return true;
+    }
+    // Real requests have precedence over prefetching.
+    yieldPrefetch();
+    m_diskCacheThread.startRenderingAsync(QVariant::fromValue(parameters));
+    return true;
+}
+
+/** @brief Starts the rendering of the image parameters of the last
+ * rendering request.
+ *
+ * Called when this provider has become the renderer within
+ * @ref AsyncImageSharedStore. */
+template<typename T>
+void AsyncImageProvider<T>::startSharedRendering()
+{
+    if (!m_lastRenderingRequestImageParameters.has_value()) {
+        return;
+    }
+    // Real requests have precedence over prefetching.
+    yieldPrefetch();
+    const T parameters = m_lastRenderingRequestImageParameters.value();
+    m_renderThread.startRenderingAsync(QVariant::fromValue(parameters));
 }
 
-/** @brief Synchronously refreshes the image cache (if necessary). */
+/** @brief Synchronously refreshes the image cache (if necessary).
+ *
+ * @warning This blocks the calling thread until the rendering has
+ * finished. Do not use it on the GUI thread while the user is interacting;
+ * use @ref isCacheUpToDate() and answer the query in a different way if
+ * the cache is not yet up-to-date. The waiting time is recorded, see
+ * @ref AsyncImageRenderScheduler::synchronousWaitStatistics(). */
 template<typename T>
 void AsyncImageProvider<T>::refreshSync()
 {
     refreshAsync();
+    const auto renderer = //
+        AsyncImageSharedStore<T>::instance().renderer(imageParameters());
+    if ((renderer != nullptr) && (renderer != this)) {
+        // The image is rendered by another provider.
+        renderer->m_renderThread.waitForIdle();
+        renderer->m_diskCacheThread.waitForIdle();
+    }
     m_renderThread.waitForIdle();
+    m_diskCacheThread.waitForIdle();
+}
+
+/** @brief Getter for the capacity of the render cache.
+ *
+ * @returns The maximum memory usage of the render cache, measured in
+ * bytes. <tt>0</tt> means that the render cache is disabled.
+ *
+ * @sa @ref setRenderCacheCapacity() */
+template<typename T>
+qsizetype AsyncImageProvider<T>::renderCacheCapacity() const
+{
+    return m_renderCacheCapacity;
+}
+
+/** @brief Setter for the capacity of the render cache.
+ *
+ * The render cache keeps the final images of previous rendering requests.
+ * When @ref refreshAsync() is called with image parameters that are
+ * equal to those of a cached image, this image is used immediately and
+ * no rendering is started. When the capacity is exceeded, the least
+ * recently used images are discarded.
+ *
+ * @param bytes The maximum memory usage of the render cache, measured in
+ * bytes. <tt>0</tt> (the default value) disables the render cache.
+ * Negative values are treated as <tt>0</tt>.
+ *
+ * @sa @ref renderCacheCapacity() */
+template<typename T>
+void AsyncImageProvider<T>::setRenderCacheCapacity(const qsizetype bytes)
+{
+    m_renderCacheCapacity = qMax<qsizetype>(0, bytes);
+    trimRenderCache();
+}
+
+/** @brief Getter for the minimum number of entries of the render cache.
+ *
+ * @returns The minimum number of entries of the render cache.
+ *
+ * @sa @ref setRenderCacheMinimumEntryCount() */
+template<typename T>
+qsizetype AsyncImageProvider<T>::renderCacheMinimumEntryCount() const
+{
+    return m_renderCacheMinimumEntryCount;
+}
+
+/** @brief Setter for the minimum number of entries of the render cache.
+ *
+ * The memory usage of an image depends on the screen size and the
+ * device pixel ratio. A fixed @ref renderCacheCapacity() that is
+ * reasonable on a normal screen might not even hold a single image on a
+ * large high-DPI screen. Therefore, the capacity grows if necessary so
+ * that it holds at least this number of entries of the size of the
+ * most recently used entry.
+ *
+ * @param count The minimum number of entries. <tt>0</tt> (the default
+ * value) means that only @ref renderCacheCapacity() is used. Negative
+ * values are treated as <tt>0</tt>.
+ *
+ * @note This has no effect while the render cache is disabled by means of
+ * @ref setRenderCacheCapacity().
+ *
+ * @sa @ref renderCacheMinimumEntryCount() */
+template<typename T>
+void AsyncImageProvider<T>::setRenderCacheMinimumEntryCount(const qsizetype count)
+{
+    m_renderCacheMinimumEntryCount = qMax<qsizetype>(0, count);
+    trimRenderCache();
+}
+
+/** @brief The actual capacity of the render cache.
+ *
+ * @param entrySize The size of a typical entry, measured in bytes.
+ *
+ * @returns @ref renderCacheCapacity(), but at least enough for
+ * @ref renderCacheMinimumEntryCount() entries of the given size.
+ * <tt>0</tt> if the render cache is disabled. */
+template<typename T>
+qsizetype AsyncImageProvider<T>::effectiveRenderCacheCapacity(const qsizetype entrySize) const
+{
+    if (m_renderCacheCapacity <= 0) {
+        return 0;
+    }
+    return qMax(m_renderCacheCapacity, m_renderCacheMinimumEntryCount * entrySize);
+}
+
+/** @brief Puts an image into the render cache.
+ *
+ * @param parameters The image parameters.
+ * @param image The final image.
+ * @param mask The alpha mask. Might be a null image.
+ * @param nearestFeatureMap The nearest feature map of the alpha mask.
+ * Might be a null map.
+ *
+ * @post If the render cache is enabled and the image fits into its
+ * capacity, it becomes the most recently used entry. An existing entry
+ * with equal parameters is replaced.
+ *
+ * @sa @ref effectiveRenderCacheCapacity() */
+template<typename T>
+void AsyncImageProvider<T>::insertIntoRenderCache(const T &parameters,
+                                                  const QImage &image,
+                                                  const QImage &mask,
+                                                  const NearestFeatureMap &nearestFeatureMap)
+{
+    const qsizetype size = //
+        image.sizeInBytes() + mask.sizeInBytes() + nearestFeatureMap.sizeInBytes();
+    if (size > effectiveRenderCacheCapacity(size)) {
+        return;
+    }
+    const qsizetype index = renderCacheIndexOf(parameters);
+    if (index >= 0) {
+        m_renderCacheSize -= m_renderCache.at(index).sizeInBytes;
+        m_renderCache.removeAt(index);
+    }
+    m_renderCache.prepend(RenderCacheEntry{parameters, image, mask, nearestFeatureMap, size});
+    m_renderCacheSize += size;
+    trimRenderCache();
+}
+
+/** @brief Position of given image parameters within the render cache.
+ *
+ * @param parameters The image parameters to search for.
+ *
+ * @returns The index within @ref m_renderCache, or <tt>-1</tt> if the
+ * parameters are not cached. */
+template<typename T>
+qsizetype AsyncImageProvider<T>::renderCacheIndexOf(const T &parameters) const
+{
+    for (qsizetype i = 0; i < m_renderCache.count(); ++i) {
+        if (m_renderCache.at(i).parameters == parameters) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/** @brief Speculatively renders images into the render cache.
+ *
+ * Use this for images that will probably be requested soon, like the
+ * neighbouring values in the direction of a drag operation.
+ *
+ * The rendering runs with @ref AsyncImageRenderScheduler::Priority::Prefetch
+ * and only while there is no real rendering request in progress. A
+ * following @ref refreshAsync() that needs rendering makes the prefetching
+ * yield immediately by means of @ref AsyncImageRenderCallback::shouldAbort().
+ * The prefetching continues once the real request is done.
+ *
+ * @param parametersList The image parameters to prefetch, most important
+ * first. Replaces the list of a previous call. Parameters that are yet
+ * cached are skipped.
+ *
+ * @note This function does nothing if the render cache is disabled.
+ * See @ref setRenderCacheCapacity(). */
+template<typename T>
+void AsyncImageProvider<T>::prefetchAsync(const QList<T> &parametersList)
+{
+    m_prefetchQueue.clear();
+    if (m_renderCacheCapacity <= 0) {
+        return;
+    }
+    m_prefetchQueue = parametersList;
+    if (m_prefetchInProgress.has_value() && m_prefetchQueue.contains(m_prefetchInProgress.value())) {
+        // Let the current prefetching continue.
+        m_prefetchQueue.removeAll(m_prefetchInProgress.value());
+        return;
+    }
+    m_prefetchThread.cancelRendering();
+    m_prefetchInProgress.reset();
+    const bool isRealRenderingInProgress = //
+        m_lastRenderingRequestImageParameters.has_value() //
+        && !m_lastRenderingRequestIsComplete;
+    if (!isRealRenderingInProgress) {
+        startNextPrefetch();
+    }
+}
+
+/** @brief Starts prefetching the next entry of @ref m_prefetchQueue
+ * that is not yet cached (if any). */
+template<typename T>
+void AsyncImageProvider<T>::startNextPrefetch()
+{
+    if (m_prefetchInProgress.has_value()) {
+        return;
+    }
+    while (!m_prefetchQueue.isEmpty()) {
+        const T parameters = m_prefetchQueue.takeFirst();
+        if (renderCacheIndexOf(parameters) >= 0) {
+            continue;
+        }
+        m_prefetchInProgress = parameters;
+        m_prefetchThread.startRenderingAsync(QVariant::fromValue(parameters));
+        return;
+    }
+}
+
+/** @brief Interrupts the prefetching in favour of a real rendering request.
+ *
+ * @post The interrupted image parameters are put back at the front
+ * of @ref m_prefetchQueue. */
+template<typename T>
+void AsyncImageProvider<T>::yieldPrefetch()
+{
+    if (!m_prefetchInProgress.has_value()) {
+        return;
+    }
+    m_prefetchThread.cancelRendering();
+    if (!(m_prefetchInProgress.value() == imageParameters())) {
+        m_prefetchQueue.prepend(m_prefetchInProgress.value());
+    }
+    m_prefetchInProgress.reset();
+}
+
+/** @brief Receives images that are delivered by the prefetching.
+ *
+ * @param deliveredImage The image
+ * @param deliveredMask The alpha mask, if provided.
+ * @param deliveredNearestFeatureMap The nearest feature map of the
+ * alpha mask, if provided.
+ * @param parameters The image parameters of the image.
+ * @param state The interlacing state of the image.
+ *
+ * @post Final images are put into the render cache, and the next
+ * prefetching is started. Intermediate images are ignored.
+ *
+ * @note Like @ref processInterlacingPassResult(), this function
+ * <em>must</em> be called from the thread within this object lives. */
+template<typename T>
+void AsyncImageProvider<T>::processPrefetchResult(const QImage &deliveredImage,
+                                                  const QImage &deliveredMask,
+                                                  const NearestFeatureMap &deliveredNearestFeatureMap,
+                                                  const QVariant &parameters,
+                                                  const AsyncImageRenderCallback::InterlacingState state)
+{
+    if (state != AsyncImageRenderCallback::InterlacingState::Final) {
+        return;
+    }
+    const T deliveredParameters = parameters.value<T>();
+    insertIntoRenderCache(deliveredParameters, //
+                          deliveredImage,
+                          deliveredMask,
+                          deliveredNearestFeatureMap);
+    if (deliveredParameters == m_prefetchInProgress) {
+        m_prefetchInProgress.reset();
+        startNextPrefetch();
+    }
+}
+
+/** @brief Discards the least recently used entries of the render cache
+ * until it fits into its capacity.
+ *
+ * The most recently used entry determines the entry size for
+ * @ref effectiveRenderCacheCapacity().
+ *
+ * The entry of the last rendering request, which is the image that is
+ * currently shown, is discarded only if it does not fit into the
+ * capacity alone. Otherwise, a burst of prefetched images could
+ * discard it and force a visible re-rendering. */
+template<typename T>
+void AsyncImageProvider<T>::trimRenderCache()
+{
+    const qsizetype entrySize = m_renderCache.isEmpty() //
+        ? 0
+        : m_renderCache.constFirst().sizeInBytes;
+    while (m_renderCacheSize > effectiveRenderCacheCapacity(entrySize)) {
+        qsizetype index = m_renderCache.count() - 1;
+        if ((index > 0) //
+            && (m_renderCache.at(index).parameters == m_lastRenderingRequestImageParameters)) {
+            --index;
+        }
+        m_renderCacheSize -= m_renderCache.at(index).sizeInBytes;
+        m_renderCache.removeAt(index);
+    }
 }
 
 } // namespace PerceptualColor
@@ -0,0 +1,153 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// Own headers
+// First the interface, which forces the header to be self-contained.
+#include "asyncimagerenderscheduler.h"
+
+#include "helperimage.h"
+#include <qrunnable.h>
+#include <qthread.h>
+
+namespace PerceptualColor
+{
+
+/**
+ * @brief Constructor.
+ */
+AsyncImageRenderScheduler::AsyncImageRenderScheduler()
+{
+    // Render jobs spend much of their time waiting for their sub-tasks
+    // in getLibraryQThreadPoolInstance(). Having at least two workers makes
+    // sure that a long-running job cannot delay all other renderers.
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+    // The scheduler should run the threads on a high-performance CPU core
+    // to get the images as fast as possible.
+    m_pool.setServiceLevel(QThread::QualityOfService::High);
+    // But avoid blocking other threads:
+    m_pool.setThreadPriority(imageThreadPriority);
+}
+
+/**
+ * @brief Destructor.
+ *
+ * Waits for all running jobs to finish.
+ */
+AsyncImageRenderScheduler::~AsyncImageRenderScheduler() noexcept
+{
+    m_pool.waitForDone();
+}
+
+/**
+ * @brief Meyer’s singleton: Provides the instance of this class as reference.
+ *
+ * @returns Meyer’s singleton: Provides the instance of this class as reference.
+ */
+AsyncImageRenderScheduler &AsyncImageRenderScheduler::instance()
+{
+    static AsyncImageRenderScheduler s;
+    return s;
+}
+
+/**
+ * @brief Maximum number of jobs that run at the same time.
+ *
+ * @returns Maximum number of jobs that run at the same time.
+ */
+int AsyncImageRenderScheduler::maxThreadCount() const
+{
+    return m_pool.maxThreadCount();
+}
+
+/**
+ * @brief Records a synchronous wait for a render job.
+ *
+ * This function is thread-safe.
+ *
+ * @param nanoseconds The time that has been spent waiting, measured
+ * in nanoseconds.
+ *
+ * @sa @ref synchronousWaitStatistics()
+ */
+void AsyncImageRenderScheduler::recordSynchronousWait(const qint64 nanoseconds)
+{
+    ++m_synchronousWaitCount;
+    m_synchronousWaitTotalNanoseconds += nanoseconds;
+    qint64 longest = m_synchronousWaitLongestNanoseconds;
+    while ((nanoseconds > longest) //
+           && !m_synchronousWaitLongestNanoseconds.compare_exchange_weak(longest, nanoseconds)) {
+        // compare_exchange_weak() has updated “longest”. Try again.
+    }
+}
+
+/**
+ * @brief Resets the statistics about synchronous waits to zero.
+ *
+ * This function is thread-safe.
+ *
+ * @sa @ref synchronousWaitStatistics()
+ */
+void AsyncImageRenderScheduler::resetSynchronousWaitStatistics()
+{
+    m_synchronousWaitCount = 0;
+    m_synchronousWaitTotalNanoseconds = 0;
+    m_synchronousWaitLongestNanoseconds = 0;
+}
+
+/**
+ * @brief Queue a job.
+ *
+ * This function is thread-safe.
+ *
+ * @param job The job. Ownership is transferred to the scheduler if
+ * <tt>QRunnable::autoDelete()</tt> is <tt>true</tt>.
+ * @param priority The priority. Waiting jobs with higher priority are
+ * started first. Jobs with the same priority are started in the order
+ * in which they have been queued.
+ */
+void AsyncImageRenderScheduler::schedule(QRunnable *job, const Priority priority)
+{
+    m_pool.start(job, static_cast<int>(priority));
+}
+
+/**
+ * @brief Statistics about synchronous waits for render jobs.
+ *
+ * This function is thread-safe.
+ *
+ * Synchronous waits block the calling thread, which is usually the GUI
+ * thread. Interaction code should never need them. These statistics make
+ * it possible to find out if there are nevertheless any.
+ *
+ * @returns Statistics about all synchronous waits of
+ * @ref AsyncImageRenderThread::waitForIdle() that actually had to wait,
+ * since the start of the process or since the last call
+ * of @ref resetSynchronousWaitStatistics().
+ */
+AsyncImageRenderScheduler::SynchronousWaitStatistics AsyncImageRenderScheduler::synchronousWaitStatistics() const
+{
+    SynchronousWaitStatistics result;
+    result.count = m_synchronousWaitCount;
+    result.totalNanoseconds = m_synchronousWaitTotalNanoseconds;
+    result.longestNanoseconds = m_synchronousWaitLongestNanoseconds;
+    return result;
+}
+
+/**
+ * @brief Remove a job that has not yet been started from the queue.
+ *
+ * This function is thread-safe.
+ *
+ * @param job The job.
+ *
+ * @returns <tt>true</tt> if the job has been removed from the queue. The
+ * ownership of the job is transferred back to the caller, also if
+ * <tt>QRunnable::autoDelete()</tt> is <tt>true</tt>. <tt>false</tt>
+ * if the job has already been started or is unknown.
+ */
+bool AsyncImageRenderScheduler::unschedule(QRunnable *job)
+{
+    return m_pool.tryTake(job);
+}
+
+} // namespace PerceptualColor
@@ -0,0 +1,98 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#ifndef PERCEPTUALCOLOR_ASYNCIMAGERENDERSCHEDULER_H
+#define PERCEPTUALCOLOR_ASYNCIMAGERENDERSCHEDULER_H
+
+#include <atomic>
+#include <qglobal.h>
+#include <qthreadpool.h>
+class QRunnable;
+
+namespace PerceptualColor
+{
+/**
+ * @internal
+ *
+ * @brief Process-wide scheduler for the render jobs
+ * of @ref AsyncImageRenderThread.
+ *
+ * All @ref AsyncImageRenderThread objects of the process share the worker
+ * threads of this scheduler instead of owning a thread of their own. A
+ * @ref ColorDialog with several diagrams and gradient sliders therefore
+ * does not keep one sleeping thread per widget. Worker threads that have
+ * been idle for a while are released by the underlying thread pool.
+ *
+ * The worker threads are separate from
+ * @ref getLibraryQThreadPoolInstance(). Render functions distribute their
+ * work to that pool and block until it is done. If render jobs and their
+ * sub-tasks shared the same pool, blocked render jobs could occupy all
+ * threads and the sub-tasks could never start.
+ *
+ * Cancellation and coalescing of superseded requests are implemented
+ * by @ref AsyncImageRenderThread: Each renderer has at most one job
+ * queued or running at any time.
+ *
+ * Waiting synchronously for a render job blocks the calling thread, which
+ * is usually the GUI thread. Therefore, such waits are counted and timed,
+ * see @ref synchronousWaitStatistics().
+ */
+class AsyncImageRenderScheduler final
+{
+public:
+    /** @brief Scheduling priority of a render job. */
+    enum class Priority {
+        Prefetch, /**< Speculative work, like images that are not
+            currently visible. Runs only when no @ref Normal job
+            is waiting. */
+        Normal /**< Images that are currently requested by a widget. */
+    };
+
+    /** @brief Statistics about synchronous waits for render jobs.
+     *
+     * @sa @ref synchronousWaitStatistics() */
+    struct SynchronousWaitStatistics {
+    public:
+        /** @brief Number of synchronous waits that actually had to wait. */
+        quint64 count = 0;
+        /** @brief Total time of all these waits, measured
+         * in nanoseconds. */
+        qint64 totalNanoseconds = 0;
+        /** @brief Time of the longest of these waits, measured
+         * in nanoseconds. */
+        qint64 longestNanoseconds = 0;
+    };
+
+    [[nodiscard]] static AsyncImageRenderScheduler &instance();
+    [[nodiscard]] int maxThreadCount() const;
+    void recordSynchronousWait(const qint64 nanoseconds);
+    void resetSynchronousWaitStatistics();
+    void schedule(QRunnable *job, const Priority priority);
+    [[nodiscard]] SynchronousWaitStatistics synchronousWaitStatistics() const;
+    [[nodiscard]] bool unschedule(QRunnable *job);
+
+private:
+    Q_DISABLE_COPY(AsyncImageRenderScheduler)
+
+    /** @internal @brief Only for unit tests. */
+    friend class TestAsyncImageRenderScheduler;
+
+    AsyncImageRenderScheduler();
+    ~AsyncImageRenderScheduler() noexcept;
+
+    /** @brief The worker threads. */
+    QThreadPool m_pool;
+    /** @brief Internal storage for
+     * @ref SynchronousWaitStatistics::count. */
+    std::atomic<quint64> m_synchronousWaitCount = 0;
+    /** @brief Internal storage for
+     * @ref SynchronousWaitStatistics::totalNanoseconds. */
+    std::atomic<qint64> m_synchronousWaitTotalNanoseconds = 0;
+    /** @brief Internal storage for
+     * @ref SynchronousWaitStatistics::longestNanoseconds. */
+    std::atomic<qint64> m_synchronousWaitLongestNanoseconds = 0;
+};
+
+} // namespace PerceptualColor
+
+#endif // PERCEPTUALCOLOR_ASYNCIMAGERENDERSCHEDULER_H
@@ -5,10 +5,12 @@
 // First the interface, which forces the header to be self-contained.
 #include "asyncimagerenderthread.h"
 
-#include "helperimage.h"
-
+#include "logging.h"
+#include "nearestfeaturemap.h"
+#include <qelapsedtimer.h>
 #include <qglobal.h>
 #include <qmetatype.h>
+#include <qrunnable.h>
 
 class QObject;
 
@@ -20,26 +22,38 @@ namespace PerceptualColor
  * @param parent The widget’s parent widget. This parameter will be passed
  * to the base class’s constructor. */
 AsyncImageRenderThread::AsyncImageRenderThread(const pointerToRenderFunction &renderFunction, QObject *parent)
-    : QThread(parent)
+    : QObject(parent)
     , m_renderFunction(renderFunction)
 {
     qRegisterMetaType<PerceptualColor::AsyncImageRenderCallback::InterlacingState>();
+    qRegisterMetaType<PerceptualColor::NearestFeatureMap>();
 }
 
 /** @brief The destructor.
  *
  * This destructor might takes a little while because he has to
- * stop the associated thread before destroying it: Possibly running
- * rendering operations are aborted. */
+ * wait until a running job has finished: Possibly running
+ * rendering operations are aborted. A job that is queued but not yet
+ * started is removed from the queue. */
 AsyncImageRenderThread::~AsyncImageRenderThread()
 {
     m_loopMutex.lock();
     m_loopAbort = true;
-    m_loopCondition.wakeOne();
+    if (m_queuedJob != nullptr) {
+        if (AsyncImageRenderScheduler::instance().unschedule(m_queuedJob)) {
+            // The job has never been started, so we own it now.
+            delete m_queuedJob;
+            m_queuedJob = nullptr;
+            m_jobActive = false;
+        }
+    }
+    while (m_jobActive) {
+        // Wait for the job to finish. The while loop protects against
+        // spurious wake-ups, see waitForIdle() for details.
+        m_loopCondition.wait(&m_loopMutex);
+    }
     m_loopMutex.unlock();
 
-    wait(); // Wait for the thread to terminate.
-
     // We make sure no thread will stay blocked when this object is
     // destroyed. However, given that this class itself is NOT thread-safe,
     // anyway it isn’t allowed to execute the destructor and waitForIdle()
@@ -71,92 +85,103 @@ void AsyncImageRenderThread::startRenderingAsync(const QVariant &parameters)
     }
 
     m_imageParameters = parameters;
+    // Cancels the rendering that might currently be in progress.
+    ++m_requestedGeneration;
 
     {
         QMutexLocker<QMutex> syncLocker(&m_syncMutex);
         m_syncIsIdle = false;
     }
-    if (!isRunning()) {
-        // The scheduler should run this thread to a high-performance CPU core
-        // to get the image as fast as possible.
-        setServiceLevel(QThread::QualityOfService::High);
-        // But avoid blocking other threads:
-        start(imageThreadPriority); // One priority level lower than normal priority.
-    } else {
-        m_loopRestart = true;
-        m_loopCondition.wakeOne();
+    if (!m_jobActive) {
+        m_jobActive = true;
+        enqueueJob();
     }
+    // Otherwise, the job that is already queued or running will
+    // pick up the new parameters.
 }
 
-/** @brief The code that will run within the thread.
+/** @brief Cancel the current rendering request.
  *
- * Reimplemented from base class.
+ * As this function is asynchronous, it will return very fast.
  *
- * This is a wrapper that provides the thread-control (loops and so on).
- * The actual rendering is done by calling @ref m_renderFunction. */
-void AsyncImageRenderThread::run()
+ * @post A rendering that is currently in progress is requested to
+ * stop as soon as possible, and a queued job will not render anything.
+ * A following call of @ref startRenderingAsync() will start a new
+ * rendering also if its parameters are identical to those before
+ * this call.
+ *
+ * @note Results that have already been delivered by
+ * @ref interlacingPassCompleted() but not yet been processed by a
+ * queued connection are not affected. */
+void AsyncImageRenderThread::cancelRendering()
 {
-    Q_FOREVER {
-        m_loopMutex.lock();
-        const QVariant parameters = m_imageParameters;
-        m_loopMutex.unlock();
+    QMutexLocker<QMutex> loopLocker(&m_loopMutex);
+    if (!m_imageParameters.isValid()) {
+        // Nothing to do here.
+        return;
+    }
+    m_imageParameters = QVariant();
+    ++m_requestedGeneration;
+}
 
-        if (m_loopAbort) {
-            return;
-        }
+/** @brief Set the scheduling priority.
+ *
+ * @param priority The priority for jobs that are queued after this call.
+ * A job that is already queued keeps its priority. */
+void AsyncImageRenderThread::setPriority(const AsyncImageRenderScheduler::Priority priority)
+{
+    QMutexLocker<QMutex> loopLocker(&m_loopMutex);
+    m_priority = priority;
+}
 
-        // From Qt Example’s documentation:
-        //
-        //     “If we discover inside […] [this function call] that restart
-        //      has been set to true (by render()), this function will return
-        //      immediately, so that the control quickly returns to the very
-        //      top of […] the forever loop […] and we fetch the new rendering
-        //      parameters. Similarly, if we discover that abort has been set
-        //      to true (by the RenderThread destructor), we return from the
-        //      function immediately, terminating the thread.”
-        //
-        // Here, this is done by passing m_abortRun and m_restart (in form of
-        // shouldAbort())to the render function, which is supposed to return
-        // as fast as possible if indicated.
+/** @brief Queue a new job in @ref AsyncImageRenderScheduler.
+ *
+ * @pre @ref m_loopMutex is locked by the caller. */
+void AsyncImageRenderThread::enqueueJob()
+{
+    m_queuedJob = QRunnable::create([this]() {
+        processJob();
+    });
+    AsyncImageRenderScheduler::instance().schedule(m_queuedJob, m_priority);
+}
+
+/** @brief The code that will run within the job.
+ *
+ * This is a wrapper that provides the job-control. The actual rendering
+ * is done by calling @ref m_renderFunction. */
+void AsyncImageRenderThread::processJob()
+{
+    QMutexLocker<QMutex> loopLocker(&m_loopMutex);
+    m_queuedJob = nullptr;
+
+    if (!m_loopAbort && m_imageParameters.isValid()) {
+        const QVariant parameters = m_imageParameters;
+        m_renderingGeneration = m_requestedGeneration.load();
+        loopLocker.unlock();
+
+        // The render function is supposed to check regularly shouldAbort()
+        // and to return as fast as possible if indicated, so that a
+        // superseded rendering does not occupy the worker thread.
         m_renderFunction(parameters, *this);
 
-        // cppcheck-suppress identicalConditionAfterEarlyExit // false positive
-        if (m_loopAbort) {
+        loopLocker.relock();
+        if (!m_loopAbort && (m_renderingGeneration != m_requestedGeneration)) {
+            // There are new parameters. Instead of rendering them right
+            // now, we queue a new job. This way, while the user is changing
+            // the parameters continuously, other renderers still get their
+            // share of the worker threads.
+            enqueueJob();
             return;
         }
+    }
 
-        // From Qt’s examples:
-        //     “Once we're done with all the iterations, we call
-        //      QWaitCondition::wait() to put the thread to sleep, unless
-        //      restart is true. There's no use in keeping a worker thread
-        //      looping indefinitely while there's nothing to do.”
-        m_loopMutex.lock();
-        // cppcheck-suppress knownConditionTrueFalse // false positive
-        if (!m_loopRestart && !m_loopAbort) {
-            QMutexLocker<QMutex> syncLocker(&m_syncMutex);
-            m_syncIsIdle = true;
-            m_syncCondition.wakeOne();
-        }
-        while (!m_loopRestart && !m_loopAbort) {
-            // QWaitCondition::wait() does the following things:
-            // 1.) Unlock mutex.
-            // 2.) Wait until another thread calls QWaitCondition::wakeOne()
-            //     or QWaitCondition::wakeAll().
-            // 3.) Lock mutex again.
-            //
-            // As explained on the StackOverflow webpage at
-            // https://stackoverflow.com/questions/40445629
-            // using QWaitCondition::wait() alone can do spurious
-            // wake-up (wake-up without a reason). To prevent the
-            // rendering from continuing in this case, we put the
-            // QWaitCondition::wait() call into a while loop. This way
-            // we can go back to sleep if the wake-up was without
-            // reason (this is checked by the condition in the while loop).
-            m_loopCondition.wait(&m_loopMutex);
-        }
-        m_loopRestart = false;
-        m_loopMutex.unlock();
+    {
+        QMutexLocker<QMutex> syncLocker(&m_syncMutex);
+        m_syncIsIdle = true;
+        m_syncCondition.wakeAll();
     }
+    m_jobActive = false;
+    m_loopCondition.wakeAll();
 }
 
 /** @brief Deliver the result of an interlacing pass of
@@ -180,7 +205,12 @@ void AsyncImageRenderThread::run()
  * @param state The interlacing state of the image. A render function
  * must first return zero or more images with intermediate state. After
  * that, it must return exactly one image with final state (unless it
- * was aborted). After that, it must not return any more images. */
+ * was aborted). After that, it must not return any more images.
+ *
+ * @post The signal @ref interlacingPassCompleted() is emitted. If an alpha
+ * mask is provided, its @ref NearestFeatureMap is calculated before, still
+ * within the thread of the render function, so that the thread that
+ * receives the signal gets it for free. */
 void AsyncImageRenderThread::deliverInterlacingPass(const QImage &image,
                                                     const QImage &mask,
                                                     const QVariant &parameters,
@@ -189,7 +219,11 @@ void AsyncImageRenderThread::deliverInterlacingPass(const QImage &image,
     // interlacingPassCompleted() is documented as being possibly emitted
     // by different threads, so this call is thread-safe within the
     // restrictions mentioned in the documentation.
-    Q_EMIT interlacingPassCompleted(image, mask, parameters, state);
+    Q_EMIT interlacingPassCompleted(image, //
+                                    mask,
+                                    NearestFeatureMap::fromMask(mask),
+                                    parameters,
+                                    state);
 }
 
 /** @brief If the render function should abort.
@@ -204,13 +238,23 @@ void AsyncImageRenderThread::deliverInterlacingPass(const QImage &image,
  * @sa @ref m_renderFunction */
 bool AsyncImageRenderThread::shouldAbort() const
 {
-    // m_abortRun and m_restart are atomic, so this call is thread-safe.
-    return (m_loopAbort || m_loopRestart);
+    // All these variables are atomic, so this call is thread-safe.
+    return (m_loopAbort || (m_renderingGeneration != m_requestedGeneration));
 }
 
-/** @brief Wait until the render thread is idle. */
+/** @brief Wait until no job of this object is queued or running.
+ *
+ * @warning This blocks the calling thread. Do not use it on the GUI thread
+ * while the user is interacting. Waits that actually have to wait are
+ * recorded by @ref AsyncImageRenderScheduler::recordSynchronousWait(),
+ * and waits that are longer than a frame are logged. */
 void AsyncImageRenderThread::waitForIdle()
 {
+    if (m_syncIsIdle) {
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
     m_syncMutex.lock();
     while (!m_syncIsIdle) {
         // QWaitCondition::wait() does the following things:
@@ -230,6 +274,16 @@ void AsyncImageRenderThread::waitForIdle()
         m_syncCondition.wait(&m_syncMutex);
     }
     m_syncMutex.unlock();
+    const qint64 nanoseconds = timer.nsecsElapsed();
+    AsyncImageRenderScheduler::instance().recordSynchronousWait(nanoseconds);
+    // At 60 frames per second, one frame takes about 16 ms.
+    constexpr qint64 frameNanoseconds = 16'000'000;
+    if (nanoseconds > frameNanoseconds) {
+        qCDebug(logging) //
+            << "Synchronous wait for rendering took" //
+            << nanoseconds / 1'000'000 //
+            << "ms.";
+    }
 }
 
 } // namespace PerceptualColor
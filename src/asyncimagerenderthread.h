@@ -5,23 +5,33 @@
 #define PERCEPTUALCOLOR_ASYNCIMAGERENDERTHREAD_H
 
 #include "asyncimagerendercallback.h"
+#include "asyncimagerenderscheduler.h"
+#include "nearestfeaturemap.h"
 #include <atomic>
 #include <functional>
 #include <qglobal.h>
 #include <qmutex.h>
-#include <qthread.h>
+#include <qobject.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
 #include <qwaitcondition.h>
 class QImage;
-class QObject;
+class QRunnable;
 
 namespace PerceptualColor
 {
 /** @internal
  *
- * @brief Provides threaded rendering for @ref AsyncImageProvider. */
-class AsyncImageRenderThread : public QThread, public AsyncImageRenderCallback
+ * @brief Provides threaded rendering for @ref AsyncImageProvider.
+ *
+ * Despite its name, this class does not own a thread. The rendering
+ * is done by jobs that run on the process-wide
+ * @ref AsyncImageRenderScheduler. Each object has at most one job queued
+ * or running at any time. Requests that arrive while a job is queued
+ * or running are coalesced: Only the parameters of the most recent
+ * request are rendered, and a running rendering of superseded
+ * parameters is asked to abort via @ref shouldAbort(). */
+class AsyncImageRenderThread : public QObject, public AsyncImageRenderCallback
 {
     Q_OBJECT
 
@@ -66,7 +76,9 @@ public:
                                         const QImage &mask,
                                         const QVariant &parameters,
                                         const AsyncImageRenderCallback::InterlacingState state) override;
+    void cancelRendering();
     void startRenderingAsync(const QVariant &parameters);
+    void setPriority(const AsyncImageRenderScheduler::Priority priority);
     [[nodiscard]] virtual bool shouldAbort() const override;
     void waitForIdle();
 
@@ -94,6 +106,8 @@ Q_SIGNALS:
      * but in some cases, they may fall below this threshold. The alpha mask,
      * however, provides a clear and definitive indication of each pixel’s
      * validity.
+     * @param nearestFeatureMap The nearest opaque pixel for each pixel of
+     * the alpha mask. It is a null map if no alpha mask is provided.
      * @param parameters The parameters of the image
      * @param state The interlacing state of the image. A render function
      * must first return zero or more images with intermediate state. After
@@ -106,45 +120,45 @@ Q_SIGNALS:
      * when connecting to this signal. */
     void interlacingPassCompleted(const QImage &image,
                                   const QImage &mask,
+                                  const PerceptualColor::NearestFeatureMap &nearestFeatureMap,
                                   const QVariant &parameters,
                                   const PerceptualColor::AsyncImageRenderCallback::InterlacingState state);
 
-protected:
-    virtual void run() override;
-
 private:
     Q_DISABLE_COPY(AsyncImageRenderThread)
 
     /** @internal @brief Only for unit tests. */
     friend class TestAsyncImageRenderThread;
 
-    /** @brief Provide parameters for the next re(start) of @ref run().
+    void enqueueJob();
+    void processJob();
+
+    /** @brief Parameters for the next job.
      *
-     * @ref run() is supposed to read these parameters on each round,
-     * and to render a corresponding image.
+     * @ref processJob() reads these parameters and renders a
+     * corresponding image. An invalid <tt>QVariant</tt> means that
+     * there is nothing to render.
      *
      * @note This data member has read and write access protected
      * by @ref m_loopMutex. */
     QVariant m_imageParameters;
-    /** @brief Request @ref run() to abort.
-     *
-     * @ref run() is supposed to control regularly if this value
-     * is <tt>true</tt>. If so, it should return as fast as possible.
-     * This variable is used by the destructor to make sure that the
-     * associated thread is stopped before destroying this object.
+    /** @brief Request the job to abort.
      *
-     * @warning This is used with @ref m_loopCondition. See there for details.
+     * The render function is supposed to control regularly
+     * via @ref shouldAbort() if this value is <tt>true</tt>. If so, it should
+     * return as fast as possible. This variable is used by the destructor to
+     * make sure that no job is queued or running anymore before destroying
+     * this object.
      *
      * @note This data member has write access protected
      * by @ref m_loopMutex. */
     std::atomic_bool m_loopAbort = false;
-    /** @brief Wait condition used between the rendering rounds.
+    /** @brief Wait condition used by the destructor to wait until
+     * the job has finished.
      *
-     * @warning @ref m_loopAbort and @ref m_loopRestart are used to control the
-     * waiting. Changing them requires locking @ref m_loopMutex (otherwise,
-     * this condition could become out-of-synchronization). Reading them
-     * during the rendering to stop more immediately should be okay, as
-     * both variables are atomic.
+     * @warning @ref m_jobActive is used to control the waiting. Changing it
+     * requires locking @ref m_loopMutex (otherwise, this condition could
+     * become out-of-synchronization).
      *
      * @note See
      * <a href="https://www.heise.de/developer/artikel/C-Core-Guidelines-Sei-dir-der-Fallen-von-Bedingungsvariablen-bewusst-4063822.html">
@@ -153,32 +167,49 @@ private:
      * this other in-depth explication</a>, both of Rainer Grimm, for
      * more details about this synchronization pattern. */
     QWaitCondition m_loopCondition;
-    /** @brief Mutex protection for @ref m_loopAbort and @ref m_loopRestart
-     * and @ref m_imageParameters.
+    /** @brief Mutex protection for @ref m_loopAbort, @ref m_jobActive,
+     * @ref m_queuedJob, @ref m_priority and @ref m_imageParameters.
      *
      * @warning This is used with @ref m_loopCondition. See there for details. */
     QMutex m_loopMutex;
-    /** @brief Request @ref run() to restart its outer loop.
+    /** @brief Is <tt>true</tt> while a job of this object is queued
+     * or running.
+     *
+     * @note This data member has read and write access protected
+     * by @ref m_loopMutex. */
+    bool m_jobActive = false;
+    /** @brief The job of this object, as long as it is queued but has not
+     * yet been started. <tt>nullptr</tt> otherwise.
+     *
+     * @note This data member has read and write access protected
+     * by @ref m_loopMutex. */
+    QRunnable *m_queuedJob = nullptr;
+    /** @brief Priority for the next job.
+     *
+     * @note This data member has read and write access protected
+     * by @ref m_loopMutex. */
+    AsyncImageRenderScheduler::Priority m_priority = //
+        AsyncImageRenderScheduler::Priority::Normal;
+    /** @brief Cancellation token of the job that is currently rendering.
      *
-     * @ref run() is supposed to control regularly if this value is
-     * <tt>true</tt>. If so, it should restart its outer loop as fast as
-     * possible. This variable is set by @ref startRenderingAsync() to
-     * <tt>true</tt> to make sure that the outer loop restarts, and it is set
-     * by @ref run() to <tt>false</tt> once the restart of the outer loop
-     * has happened.
+     * Copy of @ref m_requestedGeneration taken when the rendering
+     * has started.
      *
-     * @warning This is used with @ref m_loopCondition. See there for details.
+     * @sa @ref shouldAbort() */
+    std::atomic<quint64> m_renderingGeneration = 0;
+    /** @brief Counter that is incremented by each accepted request
+     * of @ref startRenderingAsync().
      *
      * @note This data member has write access protected
      * by @ref m_loopMutex. */
-    std::atomic_bool m_loopRestart = false;
+    std::atomic<quint64> m_requestedGeneration = 0;
     /** @brief Function pointer to the function that does the
      * actual rendering. */
     const pointerToRenderFunction m_renderFunction;
-    /** @brief Wait condition to wait until this thread goes to sleep. */
+    /** @brief Wait condition to wait until this object becomes idle. */
     QWaitCondition m_syncCondition;
-    /** @brief Is <tt>true</tt> if the render thread is either sleeping
-     * or not yet started at all. */
+    /** @brief Is <tt>true</tt> if no job of this object is queued
+     * or running. */
     std::atomic_bool m_syncIsIdle = true;
     /** @brief Mutex protection for @ref m_syncCondition */
     QMutex m_syncMutex;
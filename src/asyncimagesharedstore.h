@@ -0,0 +1,309 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#ifndef PERCEPTUALCOLOR_ASYNCIMAGESHAREDSTORE_H
+#define PERCEPTUALCOLOR_ASYNCIMAGESHAREDSTORE_H
+
+#include "asyncimagerendercallback.h"
+#include "nearestfeaturemap.h"
+#include <qglobal.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qvariant.h>
+
+namespace PerceptualColor
+{
+template<typename T>
+class AsyncImageProvider;
+
+/** @internal
+ *
+ * @brief Process-wide store that shares the images of
+ * @ref AsyncImageProvider objects with identical image parameters.
+ *
+ * Several widgets (for example the diagrams of two @ref ColorDialog
+ * objects that are shown side by side) often request images with
+ * identical image parameters. Each @ref AsyncImageProvider subscribes
+ * to the image parameters of its current rendering request. Only the
+ * first subscriber renders the image; it is called the <em>renderer</em>
+ * of these image parameters. All its interlacing passes are also delivered
+ * to the other subscribers. As <tt>QImage</tt> is implicitly shared, all
+ * subscribers share the very same image data.
+ *
+ * The entries are reference-counted: An entry exists as long as at least
+ * one provider subscribes to its image parameters. When the renderer
+ * unsubscribes before the final image is available, another subscriber
+ * takes over the rendering.
+ *
+ * @tparam T The data type which is used to parameterize the image. See
+ * @ref AsyncImageProvider for details.
+ *
+ * @note This class template is <em>not</em> thread-safe. All
+ * @ref AsyncImageProvider objects with the same template parameter must
+ * live in the same thread, which usually is the GUI thread. */
+template<typename T>
+class AsyncImageSharedStore final
+{
+public:
+    [[nodiscard]] static AsyncImageSharedStore &instance();
+    void publish(AsyncImageProvider<T> *source,
+                 const T &parameters,
+                 const QImage &image,
+                 const QImage &mask,
+                 const NearestFeatureMap &nearestFeatureMap,
+                 const AsyncImageRenderCallback::InterlacingState state);
+    [[nodiscard]] AsyncImageProvider<T> *renderer(const T &parameters) const;
+    [[nodiscard]] qsizetype subscriberCount(const T &parameters) const;
+    [[nodiscard]] bool subscribe(AsyncImageProvider<T> *provider, const T &parameters);
+    void unsubscribe(AsyncImageProvider<T> *provider, const T &parameters);
+
+private:
+    Q_DISABLE_COPY(AsyncImageSharedStore)
+
+    /** @internal @brief Only for unit tests. */
+    friend class TestAsyncImageSharedStore;
+
+    /** @brief Default constructor. */
+    AsyncImageSharedStore() = default;
+    /** @brief Destructor. */
+    ~AsyncImageSharedStore() noexcept = default;
+
+    /** @brief An entry of @ref m_entries. */
+    struct Entry {
+    public:
+        /** @brief The image parameters. */
+        T parameters;
+        /** @brief The providers that subscribe to @ref parameters. */
+        QList<AsyncImageProvider<T> *> subscribers;
+        /** @brief The subscriber that renders the image, or
+         * <tt>nullptr</tt> if there is none. */
+        AsyncImageProvider<T> *renderer = nullptr;
+        /** @brief The most recent image that has been delivered. Might be
+         * a null image. */
+        QImage image;
+        /** @brief The most recent alpha mask that has been delivered. Might
+         * be a null image. */
+        QImage mask;
+        /** @brief The nearest feature map of @ref mask. */
+        NearestFeatureMap nearestFeatureMap;
+        /** @brief If @ref image is the final image. */
+        bool isFinal = false;
+    };
+
+    [[nodiscard]] qsizetype indexOf(const T &parameters) const;
+
+    /** @brief The entries.
+     *
+     * The entries are found by linear search. This is fast enough because
+     * the number of entries is small: There is at most one entry for each
+     * existing @ref AsyncImageProvider object. */
+    QList<Entry> m_entries;
+};
+
+/** @brief Meyer’s singleton: Provides the instance of this class as reference.
+ *
+ * @returns Meyer’s singleton: Provides the instance of this class as
+ * reference. */
+template<typename T>
+AsyncImageSharedStore<T> &AsyncImageSharedStore<T>::instance()
+{
+    static AsyncImageSharedStore s;
+    return s;
+}
+
+/** @brief Position of given image parameters within @ref m_entries.
+ *
+ * @param parameters The image parameters to search for.
+ *
+ * @returns The index within @ref m_entries, or <tt>-1</tt> if there is
+ * no entry for these parameters. */
+template<typename T>
+qsizetype AsyncImageSharedStore<T>::indexOf(const T &parameters) const
+{
+    for (qsizetype i = 0; i < m_entries.count(); ++i) {
+        if (m_entries.at(i).parameters == parameters) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/** @brief Number of providers that subscribe to given image parameters.
+ *
+ * @param parameters The image parameters.
+ *
+ * @returns Number of providers that subscribe to these image parameters. */
+template<typename T>
+qsizetype AsyncImageSharedStore<T>::subscriberCount(const T &parameters) const
+{
+    const qsizetype index = indexOf(parameters);
+    if (index < 0) {
+        return 0;
+    }
+    return m_entries.at(index).subscribers.count();
+}
+
+/** @brief The renderer of given image parameters.
+ *
+ * @param parameters The image parameters.
+ *
+ * @returns The provider that renders the image for these image parameters,
+ * or <tt>nullptr</tt> if nobody is rendering. After the final image has been
+ * delivered, nobody is rendering anymore. */
+template<typename T>
+AsyncImageProvider<T> *AsyncImageSharedStore<T>::renderer(const T &parameters) const
+{
+    const qsizetype index = indexOf(parameters);
+    if (index < 0) {
+        return nullptr;
+    }
+    return m_entries.at(index).renderer;
+}
+
+/** @brief Subscribes a provider to given image parameters.
+ *
+ * @param provider The provider. Must not yet subscribe to these
+ * image parameters.
+ * @param parameters The image parameters.
+ *
+ * @returns <tt>true</tt> if the provider has become the renderer of these
+ * image parameters and has to start the rendering. <tt>false</tt> if the
+ * images are rendered by another provider. In this case, the most recent
+ * image (if any) has yet been delivered to the provider during this call.
+ *
+ * @post The provider will receive all further interlacing passes
+ * for these image parameters until it calls @ref unsubscribe(). */
+template<typename T>
+bool AsyncImageSharedStore<T>::subscribe(AsyncImageProvider<T> *provider, const T &parameters)
+{
+    qsizetype index = indexOf(parameters);
+    if (index < 0) {
+        Entry newEntry;
+        newEntry.parameters = parameters;
+        m_entries.append(newEntry);
+        index = m_entries.count() - 1;
+    }
+    Entry &entry = m_entries[index];
+    entry.subscribers.append(provider);
+    if (!entry.isFinal && (entry.renderer == nullptr)) {
+        entry.renderer = provider;
+        return true;
+    }
+    if (!entry.image.isNull()) {
+        const auto state = entry.isFinal //
+            ? AsyncImageRenderCallback::InterlacingState::Final
+            : AsyncImageRenderCallback::InterlacingState::Intermediate;
+        // Copy the data, because the delivery might change m_entries.
+        const QImage image = entry.image;
+        const QImage mask = entry.mask;
+        const NearestFeatureMap nearestFeatureMap = entry.nearestFeatureMap;
+        provider->processInterlacingPassResult(image, //
+                                               mask,
+                                               nearestFeatureMap,
+                                               QVariant::fromValue(parameters),
+                                               state);
+    }
+    return false;
+}
+
+/** @brief Unsubscribes a provider from given image parameters.
+ *
+ * @param provider The provider.
+ * @param parameters The image parameters.
+ *
+ * @post If no subscriber is left, the entry is removed. If the provider
+ * was the renderer and the final image is not yet available, another
+ * subscriber takes over the rendering. */
+template<typename T>
+void AsyncImageSharedStore<T>::unsubscribe(AsyncImageProvider<T> *provider, const T &parameters)
+{
+    const qsizetype index = indexOf(parameters);
+    if (index < 0) {
+        return;
+    }
+    Entry &entry = m_entries[index];
+    entry.subscribers.removeAll(provider);
+    if (entry.subscribers.isEmpty()) {
+        m_entries.removeAt(index);
+        return;
+    }
+    if (entry.renderer == provider) {
+        entry.renderer = nullptr;
+        if (!entry.isFinal) {
+            entry.renderer = entry.subscribers.constFirst();
+            entry.renderer->startSharedRendering();
+        }
+    }
+}
+
+/** @brief Delivers an interlacing pass to all other subscribers.
+ *
+ * @param source The provider that delivers the interlacing pass. It does
+ * not get the interlacing pass delivered back.
+ * @param parameters The image parameters.
+ * @param image The image.
+ * @param mask The alpha mask. Might be a null image.
+ * @param nearestFeatureMap The nearest feature map of the alpha mask.
+ * @param state The interlacing state.
+ *
+ * Intermediate images are only accepted from the renderer. Final images
+ * are accepted from all subscribers, for example if they have found the
+ * image in their own render cache. Once the final image is available,
+ * further deliveries are ignored. */
+template<typename T>
+void AsyncImageSharedStore<T>::publish(AsyncImageProvider<T> *source,
+                                       const T &parameters,
+                                       const QImage &image,
+                                       const QImage &mask,
+                                       const NearestFeatureMap &nearestFeatureMap,
+                                       const AsyncImageRenderCallback::InterlacingState state)
+{
+    const qsizetype index = indexOf(parameters);
+    if (index < 0) {
+        return;
+    }
+    Entry &entry = m_entries[index];
+    const bool isFinal = //
+        (state == AsyncImageRenderCallback::InterlacingState::Final);
+    const bool isAccepted = !entry.isFinal //
+        && entry.subscribers.contains(source) //
+        && (isFinal || (entry.renderer == source));
+    if (!isAccepted) {
+        return;
+    }
+    entry.image = image;
+    if (!mask.isNull()) {
+        entry.mask = mask;
+        entry.nearestFeatureMap = nearestFeatureMap;
+    }
+    if (isFinal) {
+        entry.isFinal = true;
+        entry.renderer = nullptr;
+    }
+    // Receivers might change their subscriptions while processing the
+    // delivery. Therefore, iterate over a copy and check each receiver
+    // again before delivering.
+    const QList<AsyncImageProvider<T> *> receivers = entry.subscribers;
+    const QVariant variantParameters = QVariant::fromValue(parameters);
+    for (AsyncImageProvider<T> *receiver : receivers) {
+        if (receiver == source) {
+            continue;
+        }
+        const qsizetype currentIndex = indexOf(parameters);
+        if (currentIndex < 0) {
+            return;
+        }
+        if (!m_entries.at(currentIndex).subscribers.contains(receiver)) {
+            continue;
+        }
+        receiver->processInterlacingPassResult(image, //
+                                               mask,
+                                               nearestFeatureMap,
+                                               variantParameters,
+                                               state);
+    }
+}
+
+} // namespace PerceptualColor
+
+#endif // PERCEPTUALCOLOR_ASYNCIMAGESHAREDSTORE_H
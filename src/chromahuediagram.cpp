@@ -21,14 +21,20 @@
 #include "helperimage.h"
 #include "lchvalues.h"
 #include "polarpointf.h"
+#include <optional>
 #include <qbrush.h>
 #include <qcolor.h>
 #include <qevent.h>
 #include <qimage.h>
+#include <qline.h>
+#include <qlist.h>
 #include <qnamespace.h>
 #include <qpainter.h>
 #include <qpen.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
+#include <qsize.h>
 #include <qwidget.h>
 
 namespace PerceptualColor
@@ -58,6 +64,10 @@ ChromaHueDiagram::ChromaHueDiagram(const PerceptualColor::LchSpace projectionSpa
     // Qt::FocusPolicy::TabFocus for QWidget::focusPolicy().
     setFocusPolicy(Qt::FocusPolicy::TabFocus);
 
+    d_pointer->m_chromaHueImage.setRenderCacheCapacity(renderCacheCapacity);
+    d_pointer->m_chromaHueImage.setRenderCacheMinimumEntryCount( //
+        renderCacheMinimumEntryCount);
+
     // Connections
     connect(&d_pointer->m_chromaHueImage, //
             &AsyncImageProvider<ChromaHueImageParameters>::interlacingPassCompleted, //
@@ -432,11 +442,13 @@ void ChromaHueDiagram::setCurrentColorLch(const GenericColor &newCurrentColorLch
     }
 
     const GenericColor oldColor = d_pointer->m_currentColorLch;
+    const QRegion oldHandleRegion = d_pointer->handleRegion();
 
     d_pointer->m_currentColorLch = newCurrentColorLch;
 
     // Update, if necessary, the diagram.
     if (d_pointer->m_currentColorLch.first != oldColor.first) {
+        const double oldLightness = d_pointer->m_chromaHueImageParameters.lightness;
         const auto temp = qBound<double>( //
             0, //
             d_pointer->m_currentColorLch.first, //
@@ -445,15 +457,53 @@ void ChromaHueDiagram::setCurrentColorLch(const GenericColor &newCurrentColorLch
         // This is meant to free memory in the cache if the widget is
         // not currently visible.
         d_pointer->m_chromaHueImage.setImageParameters(d_pointer->m_chromaHueImageParameters);
+        d_pointer->prefetchNeighbourSlices(oldLightness);
+        // Schedule a paint event for the whole widget:
+        update();
+    } else {
+        // The diagram itself has not changed. Schedule a paint event
+        // only for the old and the new handle position:
+        update(oldHandleRegion + d_pointer->handleRegion());
     }
 
-    // Schedule a paint event:
-    update();
-
     // Emit notify signal
     Q_EMIT currentColorLchChanged(newCurrentColorLch);
 }
 
+/** @brief Prefetches the lightness slices that will probably be
+ * needed next.
+ *
+ * Users often change the lightness in constant steps, for example by
+ * keyboard or by dragging a slider. The slices that continue the last
+ * step are rendered with low priority into the render cache
+ * of @ref m_chromaHueImage, so that they are available immediately when
+ * the user arrives there.
+ *
+ * @param oldLightness The lightness of @ref m_chromaHueImageParameters
+ * before the last change. */
+void ChromaHueDiagramPrivate::prefetchNeighbourSlices(const double oldLightness)
+{
+    if (!q_pointer->isVisible()) {
+        return;
+    }
+    const double step = m_chromaHueImageParameters.lightness - oldLightness;
+    QList<ChromaHueImageParameters> list;
+    ChromaHueImageParameters parameters = m_chromaHueImageParameters;
+    for (int i = 0; i < prefetchSliceCount; ++i) {
+        const double lightness = qBound<double>( //
+            0, //
+            parameters.lightness + step, //
+            m_lchValues.maximumLightness);
+        if (lightness == parameters.lightness) {
+            // Reached the end of the lightness range.
+            break;
+        }
+        parameters.lightness = lightness;
+        list.append(parameters);
+    }
+    m_chromaHueImage.prefetchAsync(list);
+}
+
 /** @brief The point that is the center of the diagram coordinate system.
  *
  * @returns The point that is the center of the diagram coordinate system,
@@ -533,6 +583,93 @@ QPointF ChromaHueDiagramPrivate::widgetCoordinatesFromCurrentColorLch() const
         diagramOffset() - currentColor.y() * scaleFactor);
 }
 
+/** @brief The handle on the color wheel.
+ *
+ * @returns The line of the handle on the color wheel for the hue
+ * of @ref ChromaHueDiagram::currentColorLch, measured in widget
+ * coordinates. This handle is only painted while
+ * @ref m_isMouseEventActive is <tt>true</tt>. */
+QLineF ChromaHueDiagramPrivate::wheelHandleLine() const
+{
+    // The radius of the outer border of the color wheel
+    const qreal radius = //
+        q_pointer->maximumWidgetSquareSize() / 2.0 - q_pointer->spaceForFocusIndicator();
+    // Get widget coordinate point for the handle
+    QPointF myHandleInner = PolarPointF(radius - q_pointer->gradientThickness(), //
+                                        m_currentColorLch.third)
+                                .toCartesian();
+    myHandleInner.ry() *= -1; // Transform to Widget coordinate points
+    myHandleInner += diagramCenter();
+    QPointF myHandleOuter = //
+        PolarPointF(radius, m_currentColorLch.third).toCartesian();
+    myHandleOuter.ry() *= -1; // Transform to Widget coordinate points
+    myHandleOuter += diagramCenter();
+    return QLineF(myHandleInner, myHandleOuter);
+}
+
+/** @brief The radial guide line from the diagram center to the handle.
+ *
+ * @returns The line from the diagram center to the outline of the
+ * circular handle of @ref ChromaHueDiagram::currentColorLch, measured
+ * in widget coordinates. If the handle is so close to the center that
+ * there is no space for a line, <tt>std::nullopt</tt> is returned. */
+std::optional<QLineF> ChromaHueDiagramPrivate::guideLine() const
+{
+    const QPointF handleCenter = widgetCoordinatesFromCurrentColorLch();
+    const auto offset = diagramOffset();
+    const QPointF diagramCartesianCoordinatesFromCurrentColorLch(
+        // x:
+        handleCenter.x() - offset,
+        // y:
+        (handleCenter.y() - offset) * (-1));
+    PolarPointF diagramPolarCoordinatesFromCurrentColorLch( //
+        diagramCartesianCoordinatesFromCurrentColorLch);
+    // lineRadius will be a point at the middle of the line thickness
+    // of the circular handle.
+    qreal lineRadius = //
+        diagramPolarCoordinatesFromCurrentColorLch.radius() - q_pointer->handleRadius();
+    if (lineRadius <= 0) {
+        return std::nullopt;
+    }
+    QPointF lineEndWidgetCoordinates = //
+        PolarPointF(
+            // radius:
+            lineRadius,
+            // angle:
+            diagramPolarCoordinatesFromCurrentColorLch.angleDegree() //
+            )
+            .toCartesian();
+    lineEndWidgetCoordinates.ry() *= (-1);
+    lineEndWidgetCoordinates += diagramCenter();
+    return QLineF(
+        // point 1 (center of the diagram):
+        diagramCenter(),
+        // point 2:
+        lineEndWidgetCoordinates);
+}
+
+/** @brief The region that is covered by the handles.
+ *
+ * @returns The region (in widget coordinates) that is covered by
+ * everything that depends on chroma and hue
+ * of @ref ChromaHueDiagram::currentColorLch: The circular handle, the
+ * radial guide line and, while @ref m_isMouseEventActive is
+ * <tt>true</tt>, the handle on the color wheel. */
+QRegion ChromaHueDiagramPrivate::handleRegion() const
+{
+    const qreal penWidth = q_pointer->handleOutlineThickness();
+    QRegion result = q_pointer->handleBoundingRect( //
+        widgetCoordinatesFromCurrentColorLch());
+    const std::optional<QLineF> myGuideLine = guideLine();
+    if (myGuideLine.has_value()) {
+        result += q_pointer->lineBoundingRect(myGuideLine.value(), penWidth);
+    }
+    if (m_isMouseEventActive) {
+        result += q_pointer->lineBoundingRect(wheelHandleLine(), penWidth);
+    }
+    return result;
+}
+
 /** @brief Converts widget pixel positions to Lab coordinates
  *
  * @param position The position of a pixel of the widget coordinate
@@ -701,8 +838,6 @@ bool ChromaHueDiagramPrivate::isWidgetPixelPositionWithinGamutCircle(const QPoin
  */
 void ChromaHueDiagram::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
-
     // We do not paint directly on the widget, but on a QImage buffer first:
     // Render anti-aliased looks better. But as Qt documentation says:
     //
@@ -721,15 +856,17 @@ void ChromaHueDiagram::paintEvent(QPaintEvent *event)
     //       use the platform independent QImage as paint device; i.e. using
     //       QImage will ensure that the result has an identical pixel
     //       representation on any platform.”
-    QImage buffer(maximumPhysicalSquareSize(), // width
-                  maximumPhysicalSquareSize(), // height
-                  QImage::Format_ARGB32_Premultiplied // format
-    );
-    buffer.fill(Qt::transparent);
-    buffer.setDevicePixelRatio(devicePixelRatioF());
+    //
+    // The buffer is reused between paint events, and only the region of
+    // the paint event is repainted. When only chroma or hue of the current
+    // color change, this is just the region of the old and the new handle.
+    QImage &buffer = reusablePaintBuffer( //
+        QSize(maximumPhysicalSquareSize(), maximumPhysicalSquareSize()),
+        devicePixelRatioF());
 
     // Other initialization
     QPainter bufferPainter(&buffer);
+    clearPaintBufferRegion(bufferPainter, event->region());
     QPen pen;
     const QBrush transparentBrush{Qt::transparent};
     // Set color of the handle: Black or white, depending on the lightness of
@@ -815,19 +952,6 @@ void ChromaHueDiagram::paintEvent(QPaintEvent *event)
     // Paint a handle on the color wheel (only if a mouse event is
     // currently active).
     if (d_pointer->m_isMouseEventActive) {
-        // The radius of the outer border of the color wheel
-        const qreal radius = //
-            maximumWidgetSquareSize() / 2.0 - spaceForFocusIndicator();
-        // Get widget coordinate point for the handle
-        QPointF myHandleInner = PolarPointF(radius - gradientThickness(), //
-                                            d_pointer->m_currentColorLch.third)
-                                    .toCartesian();
-        myHandleInner.ry() *= -1; // Transform to Widget coordinate points
-        myHandleInner += d_pointer->diagramCenter();
-        QPointF myHandleOuter = //
-            PolarPointF(radius, d_pointer->m_currentColorLch.third).toCartesian();
-        myHandleOuter.ry() *= -1; // Transform to Widget coordinate points
-        myHandleOuter += d_pointer->diagramCenter();
         // Draw the line
         pen = QPen();
         pen.setWidth(handleOutlineThickness());
@@ -844,7 +968,7 @@ void ChromaHueDiagram::paintEvent(QPaintEvent *event)
         pen.setColor(Qt::black);
         bufferPainter.setPen(pen);
         bufferPainter.setRenderHint(QPainter::Antialiasing, true);
-        bufferPainter.drawLine(myHandleInner, myHandleOuter);
+        bufferPainter.drawLine(d_pointer->wheelHandleLine());
     }
 
     // Paint the handle within the gamut
@@ -859,34 +983,9 @@ void ChromaHueDiagram::paintEvent(QPaintEvent *event)
                               handleRadius(), // x radius
                               handleRadius() // y radius
     );
-    const auto diagramOffset = d_pointer->diagramOffset();
-    const QPointF diagramCartesianCoordinatesFromCurrentColorLch(
-        // x:
-        widgetCoordinatesFromCurrentColorLch.x() - diagramOffset,
-        // y:
-        (widgetCoordinatesFromCurrentColorLch.y() - diagramOffset) * (-1));
-    PolarPointF diagramPolarCoordinatesFromCurrentColorLch( //
-        diagramCartesianCoordinatesFromCurrentColorLch);
-    // lineRadius will be a point at the middle of the line thickness
-    // of the circular handle.
-    qreal lineRadius = //
-        diagramPolarCoordinatesFromCurrentColorLch.radius() - handleRadius();
-    if (lineRadius > 0) {
-        QPointF lineEndWidgetCoordinates = //
-            PolarPointF(
-                // radius:
-                lineRadius,
-                // angle:
-                diagramPolarCoordinatesFromCurrentColorLch.angleDegree() //
-                )
-                .toCartesian();
-        lineEndWidgetCoordinates.ry() *= (-1);
-        lineEndWidgetCoordinates += d_pointer->diagramCenter();
-        bufferPainter.drawLine(
-            // point 1 (center of the diagram):
-            d_pointer->diagramCenter(),
-            // point 2:
-            lineEndWidgetCoordinates);
+    const std::optional<QLineF> guideLine = d_pointer->guideLine();
+    if (guideLine.has_value()) {
+        bufferPainter.drawLine(guideLine.value());
     }
 
     // Paint a focus indicator.
@@ -929,12 +1028,14 @@ void ChromaHueDiagram::paintEvent(QPaintEvent *event)
             // center:
             d_pointer->diagramCenter(),
             // x radius:
-            diagramOffset - handleOutlineThickness() / 2.0,
+            d_pointer->diagramOffset() - handleOutlineThickness() / 2.0,
             // y radius:
-            diagramOffset - handleOutlineThickness() / 2.0);
+            d_pointer->diagramOffset() - handleOutlineThickness() / 2.0);
     }
 
-    // Paint the buffer to the actual widget
+    // Paint the buffer to the actual widget. The widget painter is
+    // automatically clipped to the region of the paint event.
+    bufferPainter.end();
     QPainter widgetPainter(this);
     widgetPainter.setRenderHint(QPainter::Antialiasing, false);
     if (isEnabled()) {
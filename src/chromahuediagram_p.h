@@ -14,8 +14,11 @@
 #include "genericcolor.h"
 #include "lchvalues.h"
 #include "perceptualcolornamespace.h"
+#include <optional>
 #include <qglobal.h>
+#include <qline.h>
 #include <qpoint.h>
+#include <qregion.h>
 
 namespace PerceptualColor
 {
@@ -95,10 +98,14 @@ public:
     [[nodiscard]] QPointF diagramCenter() const;
     [[nodiscard]] qreal diagramOffset() const;
     [[nodiscard]] GenericColor fromWidgetPixelPositionToLab(const QPoint position) const;
+    [[nodiscard]] std::optional<QLineF> guideLine() const;
+    [[nodiscard]] QRegion handleRegion() const;
     [[nodiscard]] bool isWidgetPixelPositionWithinGamutCircle(const QPoint position) const;
     [[nodiscard]] bool isWidgetPixelPositionWithinMouseSensibleCircle(const QPoint widgetCoordinates) const;
+    void prefetchNeighbourSlices(const double oldLightness);
     void setColorFromWidgetPixelPosition(const QPoint position);
     [[nodiscard]] QPointF widgetCoordinatesFromCurrentColorLch() const;
+    [[nodiscard]] QLineF wheelHandleLine() const;
 
 private:
     Q_DISABLE_COPY(ChromaHueDiagramPrivate)
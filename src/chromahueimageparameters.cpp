@@ -15,7 +15,10 @@
 #include "interlacingpass.h"
 #include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <qdatastream.h>
 #include <qimage.h>
+#include <qiodevice.h>
 #include <qlist.h>
 #include <qmath.h>
 #include <qnamespace.h>
@@ -26,6 +29,7 @@
 #include <qsemaphore.h>
 #include <qsize.h>
 #include <qthreadpool.h>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -105,46 +109,81 @@ void ChromaHueImageParameters::renderByRow( //
     int firstRow,
     int lastRow)
 {
-    GenericColor lab;
-    lab.first = parameters.lightness;
-    QRgb tempColor;
     const auto threshold = //
         (chromaRange + 2 * scaleFactor) * (chromaRange + 2 * scaleFactor);
+    const float lightness = static_cast<float>(parameters.lightness);
+    // Buffers for the batch conversion of the pixels of a row. They are
+    // reused for all rows to avoid repeated allocations.
+    QList<int> columns;
+    QList<float> lightnessBuffer;
+    QList<float> aBuffer;
+    QList<float> bBuffer;
+    QList<QRgb> colorBuffer;
     for (int y = firstRow + currentPass.lineOffset; //
          y <= lastRow; //
          y += currentPass.lineFrequency) //
     {
-        lab.third = chromaRange //
+        const double b = chromaRange //
             - (y + shift) * scaleFactor;
         const auto rectangleHeight = // Make sure to stay within the image
             qMin(currentPass.rectangleSize.height(), //
                  lastRow + 1 - y);
+        columns.clear();
+        aBuffer.clear();
         for (int x = currentPass.columnOffset; //
              x < parameters.imageSizePhysical; //
              x += currentPass.columnFrequency //
         ) {
-            lab.second = (x + shift) * scaleFactor - chromaRange;
-            if (qPow(lab.second, 2) + qPow(lab.third, 2) <= threshold) {
-                tempColor = //
-                    (parameters.projectionSpace == LchSpace::Oklch) //
-                    ? AbsoluteColor::fastFromOklabToSRgbOrTransparent(lab)
-                    : AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(lab);
-                const auto rectangleWidth =
-                    // Make sure to stay within the image
-                    qMin(currentPass.rectangleSize.width(), //
-                         parameters.imageSizePhysical - x);
-                const QRect rect{x, y, rectangleWidth, rectangleHeight};
-                if (qAlpha(tempColor) != 0) {
-                    // The pixel is within the gamut!
-                    fillRect(bytesPtr, bytesPerLine, rect, tempColor);
-                } else {
-                    fillRect(bytesPtr, bytesPerLine, rect, qRgbTransparent);
-                }
+            const double a = (x + shift) * scaleFactor - chromaRange;
+            if (qPow(a, 2) + qPow(b, 2) <= threshold) {
+                columns.append(x);
+                aBuffer.append(static_cast<float>(a));
             }
         }
+        const auto count = columns.size();
+        const auto spanSize = static_cast<std::size_t>(count);
+        lightnessBuffer.fill(lightness, count);
+        bBuffer.fill(static_cast<float>(b), count);
+        colorBuffer.resize(count);
+        const std::span<const float> lightnessSpan(lightnessBuffer.constData(), spanSize);
+        const std::span<const float> aSpan(aBuffer.constData(), spanSize);
+        const std::span<const float> bSpan(bBuffer.constData(), spanSize);
+        const std::span<QRgb> colorSpan(colorBuffer.data(), spanSize);
+        if (parameters.projectionSpace == LchSpace::Oklch) {
+            AbsoluteColor::fastFromOklabToSRgbOrTransparent(lightnessSpan, aSpan, bSpan, colorSpan);
+        } else {
+            AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(lightnessSpan, aSpan, bSpan, colorSpan);
+        }
+        for (qsizetype i = 0; i < count; ++i) {
+            const int x = columns.at(i);
+            const auto rectangleWidth =
+                // Make sure to stay within the image
+                qMin(currentPass.rectangleSize.width(), //
+                     parameters.imageSizePhysical - x);
+            const QRect rect{x, y, rectangleWidth, rectangleHeight};
+            // Out-of-gamut pixels are qRgbTransparent.
+            fillRect(bytesPtr, bytesPerLine, rect, colorBuffer.at(i));
+        }
     }
 }
 
+/** @brief Key for @ref AsyncImageDiskCache.
+ *
+ * @returns A key that contains all data members. */
+QByteArray ChromaHueImageParameters::diskCacheKey() const
+{
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << QByteArrayLiteral("ChromaHueImageParameters") //
+           << borderPhysical //
+           << devicePixelRatioF //
+           << imageSizePhysical //
+           << lightness //
+           << static_cast<qint32>(projectionSpace);
+    return result;
+}
+
 /** @brief Render an image.
  *
  * The function will render the image with the given parameters,
@@ -358,28 +397,34 @@ void ChromaHueImageParameters::render(const QVariant &variantParameters, AsyncIm
     // inefficient, filtering out these artefacts beforehand would be complex.
     // Thus, for now, we leave the code as-is.
 
-    QList<QPoint> antiAliasCoordinates = findBoundary(myImage);
+    const BoundaryMask boundary = findBoundaryMask(myImage);
 
     // cppcheck-suppress knownConditionTrueFalse // false positive
     if (callbackObject.shouldAbort()) {
         return;
     }
 
-    const auto myColorFunction = [parameters,
-                                  shift,
-                                  scaleFactor,
-                                  chromaRange] //
-        (const double x, const double y) -> QRgb {
+    // Two separate lambdas (instead of one that checks the projection space
+    // for each data point) allow the compiler to inline the conversion
+    // into the anti-aliasing loop.
+    const double lightness = parameters.lightness;
+    const auto toLab = [lightness, shift, scaleFactor, chromaRange] //
+        (const double x, const double y) -> GenericColor {
         GenericColor myLab;
-        myLab.first = parameters.lightness;
+        myLab.first = lightness;
         myLab.third = chromaRange - (y + shift) * scaleFactor;
         myLab.second = (x + shift) * scaleFactor - chromaRange;
-        if (parameters.projectionSpace == LchSpace::Oklch) {
-            return AbsoluteColor::fastFromOklabToSRgbOrTransparent(myLab);
-        }
-        return AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(myLab);
+        return myLab;
     };
-    doAntialias(myImage, antiAliasCoordinates, myColorFunction);
+    if (parameters.projectionSpace == LchSpace::Oklch) {
+        doAntialias(myImage, boundary, [toLab](const double x, const double y) -> QRgb {
+            return AbsoluteColor::fastFromOklabToSRgbOrTransparent(toLab(x, y));
+        });
+    } else {
+        doAntialias(myImage, boundary, [toLab](const double x, const double y) -> QRgb {
+            return AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(toLab(x, y));
+        });
+    }
 
     if (callbackObject.shouldAbort()) {
         return;
@@ -6,6 +6,7 @@
 
 #include "interlacingpass.h"
 #include "perceptualcolornamespace.h"
+#include <qbytearray.h>
 #include <qglobal.h>
 #include <qmetatype.h>
 #include <qvariant.h>
@@ -87,6 +88,7 @@ public:
      */
     [[nodiscard]] bool operator!=(const ChromaHueImageParameters &other) const = default;
 
+    [[nodiscard]] QByteArray diskCacheKey() const;
     static void render(const QVariant &variantParameters, AsyncImageRenderCallback &callbackObject);
 
 private:
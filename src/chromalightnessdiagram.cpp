@@ -15,6 +15,7 @@
 #include "helper.h"
 #include "helperconstants.h"
 #include "helperimage.h"
+#include "helpermath.h"
 #include "initializetranslation.h"
 #include "lchvalues.h"
 #include <optional>
@@ -28,8 +29,11 @@
 #include <qnamespace.h>
 #include <qpainter.h>
 #include <qpen.h>
+#include <qpixmap.h>
 #include <qpoint.h>
 #include <qrect.h>
+#include <qregion.h>
+#include <qsize.h>
 #include <qsizepolicy.h>
 #include <qstyle.h>
 #include <qstylehints.h>
@@ -91,6 +95,9 @@ ChromaLightnessDiagram::ChromaLightnessDiagram(const PerceptualColor::LchSpace p
         projectionSpace;
     d_pointer->m_chromaLightnessImage.setImageParameters( //
         d_pointer->m_chromaLightnessImageParameters);
+    d_pointer->m_chromaLightnessImage.setRenderCacheCapacity(renderCacheCapacity);
+    d_pointer->m_chromaLightnessImage.setRenderCacheMinimumEntryCount( //
+        renderCacheMinimumEntryCount);
 
     // Connections
     connect(&d_pointer->m_chromaLightnessImage, //
@@ -466,7 +473,6 @@ void ChromaLightnessDiagram::mouseReleaseEvent(QMouseEvent *event)
  * @param event the paint event */
 void ChromaLightnessDiagram::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
     // We do not paint directly on the widget, but on a QImage buffer first:
     // Render anti-aliased looks better. But as Qt documentation says:
     //
@@ -485,10 +491,16 @@ void ChromaLightnessDiagram::paintEvent(QPaintEvent *event)
     //       use the platform independent QImage as paint device; i.e. using
     //       QImage will ensure that the result has an identical pixel
     //       representation on any platform.”
-    QImage paintBuffer(physicalPixelSize(), //
-                       QImage::Format_ARGB32_Premultiplied);
-    paintBuffer.fill(Qt::transparent);
+    //
+    // The buffer is reused between paint events, and only the region of
+    // the paint event is repainted. When only the current color changes,
+    // this is just the region of the old and the new handle.
+    //
+    // This widget paints in physical pixels, so the buffer has a device
+    // pixel ratio of 1.
+    QImage &paintBuffer = reusablePaintBuffer(physicalPixelSize(), 1);
     QPainter painter(&paintBuffer);
+    clearPaintBufferRegion(painter, physicalRegion(event->region()));
     QPen pen;
     painter.setRenderHint(QPainter::Antialiasing, false);
 
@@ -576,18 +588,6 @@ void ChromaLightnessDiagram::paintEvent(QPaintEvent *event)
     }
 
     // Paint the handle on-the-fly.
-    const int diagramHeight = d_pointer->calculateImageSizePhysical().height();
-    const auto maxL = d_pointer->m_lchValues.maximumLightness;
-    QPointF colorCoordinatePoint = QPointF(
-        // x:
-        d_pointer->m_currentColorLch.second * diagramHeight / maxL,
-        // y:
-        d_pointer->m_currentColorLch.first * diagramHeight / maxL * (-1) + diagramHeight);
-    colorCoordinatePoint += QPointF(
-        // horizontal offset:
-        d_pointer->leftBorderPhysical(),
-        // vertical offset:
-        d_pointer->defaultBorderPhysical());
     pen = QPen();
     pen.setWidthF(handleOutlineThickness() * devicePixelRatioF());
     pen.setColor(handleColorFromBackgroundLightness( //
@@ -596,24 +596,63 @@ void ChromaLightnessDiagram::paintEvent(QPaintEvent *event)
     painter.setPen(pen);
     painter.setBrush(Qt::NoBrush);
     painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.drawEllipse(colorCoordinatePoint, // center
+    painter.drawEllipse(d_pointer->handleCenterPhysical(), // center
                         handleRadius() * devicePixelRatioF(), // x radius
                         handleRadius() * devicePixelRatioF() // y radius
     );
 
-    // Paint the buffer to the actual widget
-    paintBuffer.setDevicePixelRatio(devicePixelRatioF());
+    // Paint the buffer to the actual widget. The widget painter is
+    // automatically clipped to the region of the paint event.
+    // The buffer is drawn into the corresponding rectangle in
+    // device-independent pixels, which maps it 1:1 to physical pixels.
+    painter.end();
+    const QRectF logicalRect(QPointF(0, 0), //
+                             QSizeF(paintBuffer.size()) / devicePixelRatioF());
     QPainter widgetPainter(this);
     widgetPainter.setRenderHint(QPainter::Antialiasing, true);
     if (isEnabled()) {
-        widgetPainter.drawImage(QPoint(0, 0), paintBuffer);
+        widgetPainter.drawImage(logicalRect, paintBuffer);
     } else {
-        widgetPainter.drawPixmap( //
-            QPoint(0, 0), //
-            disabledAppearance(QPixmap::fromImage(paintBuffer)));
+        const QPixmap disabledPixmap = //
+            disabledAppearance(QPixmap::fromImage(paintBuffer));
+        widgetPainter.drawPixmap(logicalRect, //
+                                 disabledPixmap,
+                                 QRectF(disabledPixmap.rect()));
     }
 }
 
+/** @brief The center of the handle.
+ *
+ * @returns The center of the handle for @ref m_currentColorLch, measured
+ * in <em>physical pixels</em> in widget coordinates. */
+QPointF ChromaLightnessDiagramPrivate::handleCenterPhysical() const
+{
+    const int diagramHeight = calculateImageSizePhysical().height();
+    const auto maxL = m_lchValues.maximumLightness;
+    QPointF colorCoordinatePoint = QPointF(
+        // x:
+        m_currentColorLch.second * diagramHeight / maxL,
+        // y:
+        m_currentColorLch.first * diagramHeight / maxL * (-1) + diagramHeight);
+    colorCoordinatePoint += QPointF(
+        // horizontal offset:
+        leftBorderPhysical(),
+        // vertical offset:
+        defaultBorderPhysical());
+    return colorCoordinatePoint;
+}
+
+/** @brief The region that is covered by the handle.
+ *
+ * @returns The rectangle that is covered by the handle
+ * for @ref m_currentColorLch, measured in <em>device-independent
+ * pixels</em> in widget coordinates. */
+QRect ChromaLightnessDiagramPrivate::handleWidgetRect() const
+{
+    return q_pointer->handleBoundingRect( //
+        handleCenterPhysical() / q_pointer->devicePixelRatioF());
+}
+
 /** @brief React on key press events.
  *
  * Reimplemented from base class.
@@ -730,6 +769,7 @@ void ChromaLightnessDiagram::setCurrentColorLch(const PerceptualColor::GenericCo
     }
 
     double oldHue = d_pointer->m_currentColorLch.third;
+    const QRect oldHandleRect = d_pointer->handleWidgetRect();
     d_pointer->m_currentColorLch = newCurrentColorLch;
     if (d_pointer->m_currentColorLch.third != oldHue) {
         // Update the diagram (only if the hue has changed):
@@ -737,12 +777,49 @@ void ChromaLightnessDiagram::setCurrentColorLch(const PerceptualColor::GenericCo
             d_pointer->m_currentColorLch.third;
         d_pointer->m_chromaLightnessImage.setImageParameters( //
             d_pointer->m_chromaLightnessImageParameters);
+        d_pointer->prefetchNeighbourSlices(oldHue);
         d_pointer->updateInfoButtonVisibility();
+        update(); // Schedule a paint event for the whole widget
+    } else {
+        // Only the handle has moved: Repaint only the old and the new
+        // handle position.
+        update(oldHandleRect);
+        update(d_pointer->handleWidgetRect());
     }
-    update(); // Schedule a paint event
     Q_EMIT currentColorLchChanged(newCurrentColorLch);
 }
 
+/** @brief Prefetches the hue slices that will probably be needed next.
+ *
+ * Users often change the hue in constant steps, for example by keyboard
+ * or by dragging the handle of the @ref ColorWheel of
+ * a @ref WheelColorPicker. The slices that continue the last step are
+ * rendered with low priority into the render cache
+ * of @ref m_chromaLightnessImage, so that they are available immediately
+ * when the user arrives there.
+ *
+ * @param oldHue The hue before the last change. */
+void ChromaLightnessDiagramPrivate::prefetchNeighbourSlices(const double oldHue)
+{
+    if (!q_pointer->isVisible()) {
+        return;
+    }
+    // Take the shorter way around the hue circle.
+    double step = m_chromaLightnessImageParameters.hue - oldHue;
+    if (step > 180) {
+        step -= 360;
+    } else if (step < -180) {
+        step += 360;
+    }
+    QList<ChromaLightnessImageParameters> list;
+    ChromaLightnessImageParameters parameters = m_chromaLightnessImageParameters;
+    for (int i = 0; i < prefetchSliceCount; ++i) {
+        parameters.hue = normalizedAngle360(parameters.hue + step);
+        list.append(parameters);
+    }
+    m_chromaLightnessImage.prefetchAsync(list);
+}
+
 /**
  * @brief Shows or hides @ref m_infoButton.
  *
@@ -841,163 +918,12 @@ GenericColor PerceptualColor::ChromaLightnessDiagram::currentColorLch() const
     return d_pointer->m_currentColorLch;
 }
 
-/** @brief An abstract Nearest-neighbor-search algorithm.
- *
- * There are many different solutions for
- * <a href="https://en.wikipedia.org/wiki/Nearest_neighbor_search">
- * Nearest-neighbor-searches</a>. This one is not naive, but still quite easy
- * to implement. It is based on <a href="https://stackoverflow.com/a/307523">
- * this Stackoverflow answer</a>.
- *
- * @param point The point to which the nearest neighbor is searched.
- * @param boundingBox The rectangle within which the algorithm searches
- *        for a nearest neighbor. All points outside this rectangle are
- *        ignored.
- * @param doesPointExist A callback function that must return <tt>true</tt>
- *        for points that are considered to exist, and <tt>false</tt> for
- *        points that are considered to no exist. This callback function will
- *        never be called with points outside the search rectangle.
- * @returns The nearest neighbor, if any. An empty value otherwise. If there
- *          are multiple non-transparent pixels at the same distance, it is
- *          indeterminate which one is returned.  Note that the point itself is
- *          considered to be itself its nearest neighbor if it is within the
- *          search rectangle and considered by the test function to exist. */
-std::optional<QPoint>
-ChromaLightnessDiagramPrivate::nearestNeighborSearch(const QPoint point, const QRect boundingBox, const std::function<bool(const QPoint)> &doesPointExist)
-{
-    if (!boundingBox.isValid()) {
-        return std::nullopt;
-    }
-    // A valid QRect is non-empty, as described by QRect documentation…
-
-    // Test for special case:
-    // originalPixelPosition itself is within the image and non-transparent
-    if (boundingBox.contains(point)) {
-        if (doesPointExist(point)) {
-            return point;
-        }
-    }
-
-    // We search the perimeter of a square that we keep moving out one pixel
-    // at a time from the original point (“offset”).
-
-    const auto hDistanceFromRect = distanceFromRange(boundingBox.left(), //
-                                                     point.x(),
-                                                     boundingBox.right());
-    const auto vDistanceFromRect = distanceFromRange(boundingBox.top(), //
-                                                     point.y(),
-                                                     boundingBox.bottom());
-    // As described at https://stackoverflow.com/a/307523:
-    // An offset of “0” means that only the original point itself is searched
-    // for. This is inefficient, because all eight search points will be
-    // identical for an offset of “0”. And because we test yet for the
-    // original point itself as a special case above, we can start here with
-    // an offset ≥ 0.
-    const auto initialOffset = qMax(1, //
-                                    qMax(hDistanceFromRect, vDistanceFromRect));
-    const auto hMaxDistance = qMax(qAbs(point.x() - boundingBox.left()), //
-                                   qAbs(point.x() - boundingBox.right()));
-    const auto vMaxDistance = qMax(qAbs(point.y() - boundingBox.top()), //
-                                   qAbs(point.y() - boundingBox.bottom()));
-    const auto maximumOffset = qMax(hMaxDistance, vMaxDistance);
-    std::optional<QPoint> nearestPointTillNow;
-    int nearestPointTillNowDistanceSquare = 0;
-    qreal nearestPointTillNowDistance = 0.0;
-    QPoint searchPoint;
-    auto searchPointOffsets = [](int i, int j) -> QList<QPoint> {
-        return QList<QPoint>({
-            QPoint(i, j), // right
-            QPoint(i, -j), // right
-            QPoint(-i, j), // left
-            QPoint(-i, -j), // left
-            QPoint(j, i), // bottom
-            QPoint(-j, i), // bottom
-            QPoint(j, -i), // top
-            QPoint(-j, -i) // top
-        });
-    };
-    int i;
-    int j;
-    // As described at https://stackoverflow.com/a/307523:
-    // The search starts at the four points that intersect the axes and moves
-    // one pixel at a time towards the corners. (We have have 8 moving search
-    // points). As soon as we locate an existing point, there is no need to
-    // continue towards the corners, as the remaining points are all further
-    // from the original point.
-    for (i = initialOffset; //
-         (i <= maximumOffset) && (!nearestPointTillNow.has_value()); //
-         ++i //
-    ) {
-        for (j = 0; (j <= i) && (!nearestPointTillNow.has_value()); ++j) {
-            const auto container = searchPointOffsets(i, j);
-            for (const QPoint &temp : std::as_const(container)) {
-                // NOTE A possible optimization might be to not always use all
-                // eight search points. Imagine you have an original point
-                // that is outside the image, at its left side. The search
-                // point on the left line of the search perimeter rectangle
-                // will always be out-of-boundary, so there is no need
-                // to calculate the search points, just to find out later
-                // that these points are outside the boundingBox. But
-                // this seems to be quite complex and the performance gain
-                // is probably minimal.
-                searchPoint = point + temp;
-                if (boundingBox.contains(searchPoint)) {
-                    if (doesPointExist(searchPoint)) {
-                        nearestPointTillNow = searchPoint;
-                        nearestPointTillNowDistanceSquare = //
-                            temp.x() * temp.x() + temp.y() * temp.y();
-                        nearestPointTillNowDistance = qSqrt( //
-                            nearestPointTillNowDistanceSquare);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    if (!nearestPointTillNow.has_value()) {
-        // There is not one single pixel that is valid in the
-        // whole boundingBox.
-        return nearestPointTillNow;
-    }
-
-    i += 1;
-    // After the initial search for the nearest-neighbor-point, we must
-    // continue to search the perimeter of wider squares until we reach an
-    // offset of “nearestPointTillNowDistance”. However, the search points
-    // no longer have to travel ("j") all the way to the corners: They can
-    // stop when they reach a pixel that is farther away from the original
-    // point than the current "nearest-neighbor-point" candidate."
-    for (; i < nearestPointTillNowDistance; ++i) {
-        qreal maximumJ = qSqrt(nearestPointTillNowDistanceSquare - i * i);
-        for (j = 0; j < maximumJ; ++j) {
-            const auto container = searchPointOffsets(i, j);
-            for (const QPoint &temp : std::as_const(container)) {
-                searchPoint = point + temp;
-                if (boundingBox.contains(searchPoint)) {
-                    if (doesPointExist(searchPoint)) {
-                        nearestPointTillNow = searchPoint;
-                        nearestPointTillNowDistanceSquare = //
-                            temp.x() * temp.x() + temp.y() * temp.y();
-                        nearestPointTillNowDistance = qSqrt( //
-                            nearestPointTillNowDistanceSquare);
-                        maximumJ = qSqrt( //
-                            nearestPointTillNowDistanceSquare - i * i);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    return nearestPointTillNow;
-}
-
 /** @brief Search the nearest in-gamut neighbor pixel.
  *
  * @param originalPixelPosition The pixel for which you search the nearest
  * neighbor, expressed in the coordinate system of the image. This pixel may
- * be inside or outside the image.
+ * be inside or outside the image. Pixels outside the image are moved to the
+ * nearest pixel within the image first.
  * @returns The nearest non-transparent pixel of @ref m_chromaLightnessImage,
  *          if any. An empty value otherwise. If there are multiple
  *          non-transparent pixels at the same distance, it is
@@ -1005,29 +931,21 @@ ChromaLightnessDiagramPrivate::nearestNeighborSearch(const QPoint point, const Q
  *          is considered to be itself its nearest neighbor if it is within
  *          the image and non-transparent.
  *
- * @note This function waits until a full-quality @ref m_chromaLightnessImage
- * is available, which might take some time.
- *
- * @todo NICETOHAVE A possible optimization
- * might be to search initially, after a new
- * image is available, entire columns, starting from the right, until we hit
- * the first column that has a non-transparent pixel. This information can be
- * used to reduce the search rectangle significantly.
- * Or we could use the gamut boundary, mayby still available from the boundary
- * anti-aliasing.
- */
+ * @note This function never waits for the rendering of
+ * @ref m_chromaLightnessImage. If the image is up-to-date, this is a single
+ * lookup in its @ref NearestFeatureMap. Otherwise, the result is calculated
+ * analytically by @ref ChromaLightnessImageParameters::nearestMaskPixel(),
+ * which gives the same result. */
 std::optional<QPoint> ChromaLightnessDiagramPrivate::nearestInGamutPixelPosition(const QPoint originalPixelPosition)
 {
-    m_chromaLightnessImage.refreshSync();
-    const auto upToDateMask = m_chromaLightnessImage.getMaskCache();
-
-    auto isOpaqueFunction = [&upToDateMask](const QPoint point) -> bool {
-        return (upToDateMask.pixelColor(point) == Qt::black);
-    };
-    return nearestNeighborSearch( //
-        originalPixelPosition, //
-        QRect(QPoint(0, 0), upToDateMask.size()), //
-        isOpaqueFunction);
+    if (m_chromaLightnessImage.isCacheUpToDate()) {
+        const auto map = m_chromaLightnessImage.getNearestFeatureMapCache();
+        if (!map.isNull()) {
+            return map.nearestFeature(originalPixelPosition);
+        }
+    }
+    return m_chromaLightnessImageParameters.nearestMaskPixel( //
+        originalPixelPosition);
 }
 
 /** @brief Find the nearest in-gamut pixel.
@@ -1040,8 +958,9 @@ std::optional<QPoint> ChromaLightnessDiagramPrivate::nearestInGamutPixelPosition
  *
  * @param lightness Lightness of the original color.
  *
- * @note This function waits until a full-quality @ref m_chromaLightnessImage
- * is available, which might take some time.
+ * @note This function does not wait for the rendering
+ * of @ref m_chromaLightnessImage, so it is fast enough for mouse
+ * interaction.
  *
  * @returns The nearest in-gamut pixel with the same hue as the original
  * color. */
@@ -14,16 +14,16 @@
 #include "lchvalues.h"
 #include "perceptualcolornamespace.h"
 #include <cmath>
-#include <functional>
 #include <limits>
 #include <optional>
 #include <qglobal.h>
 #include <qlabel.h>
 #include <qlayout.h>
+#include <qpoint.h>
 #include <qpointer.h>
+#include <qrect.h>
 #include <qsize.h>
 #include <qtoolbutton.h>
-class QRect;
 class QPoint;
 
 namespace PerceptualColor
@@ -110,13 +110,14 @@ public:
         return 0;
     }
     [[nodiscard]] GenericColor fromWidgetPixelPositionToLch(const QPoint widgetPixelPosition) const;
+    [[nodiscard]] QPointF handleCenterPhysical() const;
+    [[nodiscard]] QRect handleWidgetRect() const;
     [[nodiscard]] bool isWidgetPixelPositionInGamut(const QPoint widgetPixelPosition) const;
     [[nodiscard]] int leftBorderDeviceIndependent() const;
     [[nodiscard]] int leftBorderPhysical() const;
     [[nodiscard]] GenericColor nearestInGamutLchByAdjustingChromaLightness(const double chroma, const double lightness);
     [[nodiscard]] std::optional<QPoint> nearestInGamutPixelPosition(const QPoint originalPixelPosition);
-    [[nodiscard]] static std::optional<QPoint>
-    nearestNeighborSearch(const QPoint point, const QRect boundingBox, const std::function<bool(const QPoint)> &doesPointExist);
+    void prefetchNeighbourSlices(const double oldHue);
     void reloadIcons();
     void retranslateUi();
     void setCurrentColorFromWidgetPixelPosition(const QPoint widgetPixelPosition);
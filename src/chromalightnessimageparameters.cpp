@@ -7,14 +7,16 @@
 
 #include "absolutecolor.h"
 #include "asyncimagerendercallback.h"
-#include "colorspaceinfo.h"
 #include "genericcolor.h"
 #include "helper.h"
 #include "helperimage.h"
 #include "helpermath.h"
 #include "lchvalues.h"
+#include <array>
 #include <atomic>
-#include <functional>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <qimage.h>
 #include <qlist.h>
 #include <qnamespace.h>
@@ -23,18 +25,125 @@
 #include <qrunnable.h>
 #include <qsemaphore.h>
 #include <qthreadpool.h>
+#include <span>
 #include <type_traits>
 #include <utility>
 
 namespace PerceptualColor
 {
 
+/**
+ * @brief The pixels of a row whose center is within a chroma interval.
+ *
+ * @param interval The chroma interval.
+ * @param valuesPerPixel The chroma range covered by one pixel.
+ * @param width The image width.
+ *
+ * @returns The first and the last pixel within the row whose center is
+ * within the interval. If there is no such pixel, the first one is bigger
+ * than the last one.
+ */
+std::pair<int, int> ChromaLightnessImageParameters::maskSpan(const std::pair<double, double> &interval, const double valuesPerPixel, const int width)
+{
+    const int first = qMax( //
+        0,
+        static_cast<int>(std::ceil(interval.first / valuesPerPixel - 0.5)));
+    const int last = qMin( //
+        width - 1,
+        static_cast<int>(std::floor(interval.second / valuesPerPixel - 0.5)));
+    return {first, last};
+}
+
+/**
+ * @brief The nearest opaque pixel of the alpha mask.
+ *
+ * This is calculated analytically by @ref AbsoluteColor::inGamutChromaIntervals()
+ * for the rows of the image, starting with the row of the given point and
+ * going outwards until no nearer pixel is possible. There is no rendering
+ * and no waiting for a rendering. The result is the same as
+ * @ref NearestFeatureMap::nearestFeature() provides for the alpha mask
+ * that @ref render() would deliver.
+ *
+ * @param point The pixel for which you search the nearest opaque pixel.
+ * Points outside the image are moved to the nearest pixel within the
+ * image first.
+ *
+ * @returns The nearest opaque pixel, if any. An empty value otherwise.
+ * If there are multiple opaque pixels at the same distance, it is
+ * indeterminate which one is returned.
+ */
+std::optional<QPoint> ChromaLightnessImageParameters::nearestMaskPixel(const QPoint point) const
+{
+    const int width = imageSizePhysical.width();
+    const int height = imageSizePhysical.height();
+    if (width <= 0 || height <= 0) {
+        return std::nullopt;
+    }
+    const LchValues ranges = //
+        (projectionSpace == LchSpace::Oklch) //
+        ? oklchValues //
+        : cielchD50Values;
+    const double normalizedHue = normalizedAngle360(hue);
+    // The same scale as in renderByRow():
+    const double maximumLightness = ranges.maximumLightness;
+    const double valuesPerPixel = maximumLightness / height;
+    const double maximumChroma = width * valuesPerPixel;
+    const int x0 = qBound(0, point.x(), width - 1);
+    const int y0 = qBound(0, point.y(), height - 1);
+
+    std::optional<QPoint> result;
+    qint64 resultDistanceSquare = std::numeric_limits<qint64>::max();
+    const auto searchRow = [&](const int y) {
+        const qint64 dy = y - y0;
+        const auto intervals = AbsoluteColor::inGamutChromaIntervals( //
+            maximumLightness - (y + 0.5) * valuesPerPixel,
+            normalizedHue,
+            maximumChroma,
+            projectionSpace);
+        for (const auto &interval : intervals) {
+            const auto [first, last] = maskSpan(interval, valuesPerPixel, width);
+            if (first > last) {
+                continue;
+            }
+            const qint64 dx = qBound(first, x0, last) - x0;
+            const qint64 distanceSquare = dx * dx + dy * dy;
+            if (distanceSquare < resultDistanceSquare) {
+                resultDistanceSquare = distanceSquare;
+                result = QPoint(x0 + static_cast<int>(dx), y);
+            }
+        }
+    };
+    const int maximumOffset = qMax(y0, height - 1 - y0);
+    for (int offset = 0; offset <= maximumOffset; ++offset) {
+        if (qint64{offset} * offset >= resultDistanceSquare) {
+            // Rows that are farther away cannot provide a nearer pixel.
+            break;
+        }
+        if (y0 - offset >= 0) {
+            searchRow(y0 - offset);
+        }
+        if ((offset > 0) && (y0 + offset < height)) {
+            searchRow(y0 + offset);
+        }
+    }
+    return result;
+}
+
 /**
  * @brief Render some rows of the image directly to the buffer.
  *
+ * For each row, the in-gamut chroma intervals are calculated analytically
+ * by @ref AbsoluteColor::inGamutChromaIntervals(). The pixels whose center
+ * is within these intervals are filled span by span. The coverage of the
+ * pixels at the gamut boundary is calculated from the in-gamut intervals
+ * of some sub-rows, which provides anti-aliasing without a separate pass.
+ *
  * @param bytesPtr Pointer to the image data.
  * @param bytesPerLine Bytes per line of the image data (can be obtained by
  *        QImage)
+ * @param maskPtr Pointer to the data of the 1-bit mask, in the format
+ *        <tt>QImage::Format_MonoLSB</tt>, initialized to 0.
+ * @param maskBytesPerLine Bytes per line of the mask data.
  * @param parameters The parameters
  * @param firstRow Index of the first row to render. Must be a valid index.
  * @param lastRow Index of the last row to render. Must be a valid index.
@@ -50,6 +159,8 @@ namespace PerceptualColor
 void ChromaLightnessImageParameters::renderByRow( //
     uchar *const bytesPtr,
     const qsizetype bytesPerLine,
+    uchar *const maskPtr,
+    const qsizetype maskBytesPerLine,
     const ChromaLightnessImageParameters parameters, // clazy:exclude=function-args-by-ref
     const int firstRow,
     const int lastRow)
@@ -58,52 +169,159 @@ void ChromaLightnessImageParameters::renderByRow( //
         (parameters.projectionSpace == LchSpace::Oklch) //
         ? oklchValues //
         : cielchD50Values;
-    QRgb rgbColor;
-    GenericColor lch;
-    lch.third = normalizedAngle360(parameters.hue);
+    const double hue = normalizedAngle360(parameters.hue);
+    const int width = parameters.imageSizePhysical.width();
+    // Chroma (x axis) and lightness (y axis) use the same scale.
+    const double maximumLightness = ranges.maximumLightness;
+    const double valuesPerPixel = maximumLightness / parameters.imageSizePhysical.height();
+    const double maximumChroma = width * valuesPerPixel;
+
+    const auto clampedColor = [&parameters, hue](const double lightness, const double chroma) -> QRgb {
+        const GenericColor lch{lightness, chroma, hue};
+        return (parameters.projectionSpace == LchSpace::Oklch) //
+            ? AbsoluteColor::fastFromOklchToSRgbClamped(lch) //
+            : AbsoluteColor::fastFromCielchD50ToSRgbClamped(lch);
+    };
+
+    // The coverage of each pixel of the current row, in the range [0, 1].
+    QList<float> coverage(width);
+    const auto addCoverage = [&coverage, width](double left, double right, const float weight) {
+        left = qMax(left, 0.);
+        right = qMin(right, static_cast<double>(width));
+        if (!(right > left)) {
+            return;
+        }
+        const int first = static_cast<int>(left);
+        const int last = qMin(static_cast<int>(right), width - 1);
+        if (first == last) {
+            coverage[first] += weight * static_cast<float>(right - left);
+            return;
+        }
+        coverage[first] += weight * static_cast<float>(first + 1 - left);
+        for (int x = first + 1; x < last; ++x) {
+            coverage[x] += weight;
+        }
+        coverage[last] += weight * static_cast<float>(right - last);
+    };
+
+    // Each row is sampled at some equally spaced sub-rows. Along each
+    // sub-row, the coverage is exact, so only the vertical direction is
+    // approximated.
+    constexpr int subRowCount = 4;
+    constexpr float subRowWeight = 1.0f / subRowCount;
+    std::array<double, subRowCount> subRowLightness;
+    std::array<QList<std::pair<double, double>>, subRowCount> subRowIntervals;
+
+    // The pixels of a span are converted in chunks by the batch
+    // conversion functions.
+    constexpr int chunkSize = 32;
+    std::array<float, chunkSize> lightnessBuffer;
+    std::array<float, chunkSize> aBuffer;
+    std::array<float, chunkSize> bBuffer;
+    std::array<QRgb, chunkSize> colorBuffer;
 
-    // Out-of-gamut handling:
-    //
-    // The image maps chroma on the x-axis and lightness on the y-axis,
-    // drawn line by line from low chroma to high chroma at a fixed lightness.
-    // Once a pixel in a row is out-of-gamut, all subsequent
-    // pixels to the right are likely out-of-gamut as well. This suggests
-    // a possible optimization: break the loop early. However, this assumption
-    // is not universally valid, so we must explicitly mark ranges where
-    // optimization is unsafe.
-    //
-    // Test renderings at 5000-pixel lightness resolution revealed exceptions:
-    // - In CIELCH: hue 95.4518°–102.575° combined with lightness 93.64%–98.6%.
-    //   To ensure coverage, we expand this region by ~10%: hue 95°–103°,
-    //   lightness 93%–99%.
-    // - In OKLCH: hue 264.052°–264.208° combined with lightness 0.0028–0.4704.
-    //   Expanded by ~10%: hue 264.03°–264.23°, lightness 0.00–0.53.
-    //
-    // Within these unsafe ranges, early termination must be disabled to
-    // guarantee correctness.
-    const bool optimizationIsSafe = !ColorSpaceInfo::isUnusualShapeAtHue(parameters.projectionSpace, lch.third);
     for (int y = firstRow; y <= lastRow; ++y) {
         QRgb *line = //
             reinterpret_cast<QRgb *>(bytesPtr + y * bytesPerLine);
-        lch.first = ranges.maximumLightness - (y + 0.5) * ranges.maximumLightness / parameters.imageSizePhysical.height();
-        for (int x = 0; x < parameters.imageSizePhysical.width(); ++x) {
-            // Using the same scale as on the y axis. floating point
-            lch.second = (x + 0.5) * ranges.maximumLightness / parameters.imageSizePhysical.height();
-            const auto lab = AbsoluteColor::fromPolarToCartesian(lch);
-            if (parameters.projectionSpace == LchSpace::Oklch) {
-                rgbColor = AbsoluteColor::fastFromOklabToSRgbOrTransparent(lab);
-            } else {
-                rgbColor = //
-                    AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(lab);
+        uchar *maskLine = maskPtr + y * maskBytesPerLine;
+        const auto isInMask = [maskLine](const int x) -> bool {
+            return (maskLine[x >> 3] & (1 << (x & 7))) != 0;
+        };
+        const auto pixelColor = [&coverage](const int x, const QRgb color) -> QRgb {
+            const int alpha = qBound(0, qRound(coverage.at(x) * 255), 255);
+            if (alpha == 255) {
+                return color;
+            }
+            return qPremultiply(qRgba(qRed(color), qGreen(color), qBlue(color), alpha));
+        };
+
+        coverage.fill(0);
+        for (int i = 0; i < subRowCount; ++i) {
+            subRowLightness[i] = maximumLightness //
+                - (y + (i + 0.5) / subRowCount) * valuesPerPixel;
+            subRowIntervals[i] = AbsoluteColor::inGamutChromaIntervals( //
+                subRowLightness[i],
+                hue,
+                maximumChroma,
+                parameters.projectionSpace);
+            for (const auto &interval : std::as_const(subRowIntervals[i])) {
+                addCoverage(interval.first / valuesPerPixel, //
+                            interval.second / valuesPerPixel,
+                            subRowWeight);
             }
-            if (qAlpha(rgbColor) != 0) {
-                line[x] = rgbColor;
-            } else {
-                if (optimizationIsSafe || !ColorSpaceInfo::isUnusualShapeAtLightness(parameters.projectionSpace, lch.first)) {
-                    break;
+        }
+
+        // The spans of pixels whose center is in-gamut.
+        const double lightness = //
+            maximumLightness - (y + 0.5) * valuesPerPixel;
+        const auto intervals = AbsoluteColor::inGamutChromaIntervals( //
+            lightness,
+            hue,
+            maximumChroma,
+            parameters.projectionSpace);
+        GenericColor lch{lightness, 0, hue};
+        for (const auto &interval : intervals) {
+            const auto [spanFirst, spanLast] = //
+                maskSpan(interval, valuesPerPixel, width);
+            for (int chunkStart = spanFirst; chunkStart <= spanLast; chunkStart += chunkSize) {
+                const int count = qMin(chunkSize, spanLast - chunkStart + 1);
+                for (int i = 0; i < count; ++i) {
+                    lch.second = (chunkStart + i + 0.5) * valuesPerPixel;
+                    const auto lab = AbsoluteColor::fromPolarToCartesian(lch);
+                    lightnessBuffer[i] = static_cast<float>(lab.first);
+                    aBuffer[i] = static_cast<float>(lab.second);
+                    bBuffer[i] = static_cast<float>(lab.third);
+                }
+                const auto spanSize = static_cast<std::size_t>(count);
+                const std::span<const float> lightnessSpan(lightnessBuffer.data(), spanSize);
+                const std::span<const float> aSpan(aBuffer.data(), spanSize);
+                const std::span<const float> bSpan(bBuffer.data(), spanSize);
+                const std::span<QRgb> colorSpan(colorBuffer.data(), spanSize);
+                if (parameters.projectionSpace == LchSpace::Oklch) {
+                    AbsoluteColor::fastFromOklabToSRgbOrTransparent(lightnessSpan, aSpan, bSpan, colorSpan);
+                } else {
+                    AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent(lightnessSpan, aSpan, bSpan, colorSpan);
+                }
+                for (int i = 0; i < count; ++i) {
+                    const int x = chunkStart + i;
+                    QRgb color = colorBuffer[i];
+                    if (qAlpha(color) == 0) {
+                        // The float precision of the batch conversion
+                        // is lower than the precision of the interval.
+                        color = clampedColor(lightness, (x + 0.5) * valuesPerPixel);
+                    }
+                    line[x] = pixelColor(x, color);
+                    maskLine[x >> 3] |= static_cast<uchar>(1 << (x & 7));
                 }
             }
         }
+
+        // The boundary pixels whose center is out-of-gamut get the color of
+        // the nearest in-gamut sample.
+        for (int x = 0; x < width; ++x) {
+            if (coverage.at(x) <= 0 || isInMask(x)) {
+                continue;
+            }
+            const double chroma = (x + 0.5) * valuesPerPixel;
+            double nearestLightness = lightness;
+            double nearestChroma = chroma;
+            double nearestDistance = std::numeric_limits<double>::infinity();
+            for (int i = 0; i < subRowCount; ++i) {
+                const double verticalDistance = (i + 0.5) / subRowCount - 0.5;
+                for (const auto &interval : std::as_const(subRowIntervals[i])) {
+                    const double candidate = qBound(interval.first, chroma, interval.second);
+                    const double horizontalDistance = (candidate - chroma) / valuesPerPixel;
+                    const double distance = horizontalDistance * horizontalDistance //
+                        + verticalDistance * verticalDistance;
+                    if (distance < nearestDistance) {
+                        nearestDistance = distance;
+                        nearestLightness = subRowLightness[i];
+                        nearestChroma = candidate;
+                    }
+                }
+            }
+            line[x] = pixelColor(x, clampedColor(nearestLightness, nearestChroma));
+        }
     }
 }
 
@@ -112,6 +330,9 @@ void ChromaLightnessImageParameters::renderByRow( //
  * The function will render the image with the given parameters,
  * and deliver the result by means of <tt>callbackObject</tt>.
  *
+ * The gamut boundary is calculated analytically and anti-aliased while
+ * rendering, so the image is delivered in a single, final pass.
+ *
  * This function is thread-safe as long as each call of this function
  * uses different <tt>variantParameters</tt> and <tt>callbackObject</tt>.
  *
@@ -144,15 +365,24 @@ void ChromaLightnessImageParameters::render(const QVariant &variantParameters, A
 
     myImage.fill(Qt::transparent); // Initialize background color
 
+    // A 1-bit mask for the gamut, with the same color table as
+    // QImage::createAlphaMask() produces.
+    // transparent = white
+    // opaque = black
+    QImage myMask(myImage.size(), QImage::Format_MonoLSB);
+    myMask.setColorTable({qRgb(255, 255, 255), qRgb(0, 0, 0)});
+    myMask.fill(0);
+
     // Initialization
     const int imageHeight = parameters.imageSizePhysical.height();
     auto &poolReference = getLibraryQThreadPoolInstance();
     const auto threadCount = qMax(1, poolReference.maxThreadCount());
 
     // Paint the gamut.
-    const double normalizedHue = normalizedAngle360(parameters.hue);
     uchar *const bytesPtr = myImage.bits();
     const qsizetype bytesPerLine = myImage.bytesPerLine();
+    uchar *const maskPtr = myMask.bits();
+    const qsizetype maskBytesPerLine = myMask.bytesPerLine();
 
     {
         const auto segments = splitElements(imageHeight, threadCount);
@@ -166,11 +396,15 @@ void ChromaLightnessImageParameters::render(const QVariant &variantParameters, A
         for (const auto &segment : segments) {
             const auto myLambda = [bytesPtr, //
                                    bytesPerLine,
+                                   maskPtr,
+                                   maskBytesPerLine,
                                    parameters,
                                    segment,
                                    &semaphore]() {
                 renderByRow(bytesPtr, //
                             bytesPerLine,
+                            maskPtr,
+                            maskBytesPerLine,
                             parameters,
                             segment.first,
                             segment.second);
@@ -185,86 +419,10 @@ void ChromaLightnessImageParameters::render(const QVariant &variantParameters, A
         semaphore.acquire(segmentsCount); // Wait for all threads to finish.
     }
 
-    // A 1-bit mask for the gamut.
-    // transparent = white
-    // opaque = black
-    const auto myMask = myImage.createAlphaMask();
-
-    callbackObject.deliverInterlacingPass( //
-        myImage, //
-        myMask, //
-        QVariant::fromValue(parameters), //
-        AsyncImageRenderCallback::InterlacingState::Intermediate);
-
-    // From Qt Example’s documentation:
-    //
-    //     “If we discover […] that restart has been set
-    //      to true (by render()), we break out […] immediately […].
-    //      Similarly, if we discover that abort has been set
-    //      to true (by the […] destructor), we return from the
-    //      function immediately […].”
-    //
-    // Strategic Abort Handling for Enhanced UI Responsivity:
-    // We intentionally check for restart/abort only *after* the first
-    // interlacing pass. This guarantees that at least one image is
-    // rendered and shown in the widget, so the UI appears responsive
-    // even while the user is interacting (e.g. dragging the hue slider).
-    // If we allowed abort earlier, rapid user input could prevent any
-    // image from ever being displayed. While the resulting image may be
-    // slightly outdated, it maintains the perception of a fluid, reactive
-    // interface.
-    //
-    // After the first pass we may skip the remaining work (such as
-    // anti‑aliasing) while the user is still changing the slider, because
-    // those steps are comparatively expensive and not critical for
-    // immediate feedback. Once the user stops interacting, the remaining
-    // passes (including full anti‑aliasing) will be completed and the
-    // final image delivered.
-    if (callbackObject.shouldAbort()) {
-        return;
-    }
-
-    // Anti-aliasing
-    QList<QPoint> antiAliasCoordinates = findBoundary(myImage);
-
-    // cppcheck-suppress knownConditionTrueFalse // false positive
-    if (callbackObject.shouldAbort()) {
-        return;
-    }
-
-    std::function<QRgb(const double x, const double y)> myColorFunction;
-    if (parameters.projectionSpace == LchSpace::Oklch) {
-        myColorFunction = [normalizedHue, imageHeight] //
-            (const double colorFunctionX, const double colorFunctionY) -> QRgb {
-            GenericColor oklch;
-            oklch.third = normalizedHue;
-            constexpr double maxLight = oklchValues.maximumLightness;
-            oklch.first = //
-                maxLight - (colorFunctionY + 0.5) * maxLight / imageHeight;
-            oklch.second = (colorFunctionX + 0.5) * maxLight / imageHeight;
-            return AbsoluteColor::fastFromOklabToSRgbOrTransparent( //
-                AbsoluteColor::fromPolarToCartesian(oklch));
-        };
-    } else {
-        myColorFunction = [normalizedHue, imageHeight] //
-            (const double colorFunctionX, const double colorFunctionY) -> QRgb {
-            GenericColor myCielchD50;
-            myCielchD50.third = normalizedHue;
-            constexpr double maxLight = cielchD50Values.maximumLightness;
-            myCielchD50.first = //
-                maxLight - (colorFunctionY + 0.5) * maxLight / imageHeight;
-            myCielchD50.second = //
-                (colorFunctionX + 0.5) * maxLight / imageHeight;
-            return AbsoluteColor::fastFromCielabD50ToSRgbOrTransparent( //
-                AbsoluteColor::fromPolarToCartesian(myCielchD50));
-        };
-    }
-    doAntialias(myImage, antiAliasCoordinates, myColorFunction);
-
-    if (callbackObject.shouldAbort()) {
-        return;
-    }
-
+    // There is only one pass, so there is no need to check for
+    // callbackObject.shouldAbort(): At least one image has always to
+    // be delivered, so that the UI appears responsive even while the user
+    // is interacting (e.g. dragging the hue slider).
     callbackObject.deliverInterlacingPass( //
         myImage, //
         myMask, //
@@ -6,10 +6,13 @@
 
 #include "internalimportexport.h"
 #include "perceptualcolornamespace.h"
+#include <optional>
 #include <qglobal.h>
 #include <qmetatype.h>
+#include <qpoint.h>
 #include <qsize.h>
 #include <qvariant.h>
+#include <utility>
 
 namespace PerceptualColor
 {
@@ -54,6 +57,7 @@ public:
      */
     [[nodiscard]] bool operator!=(const ChromaLightnessImageParameters &other) const = default;
 
+    [[nodiscard]] std::optional<QPoint> nearestMaskPixel(const QPoint point) const;
     static void render(const QVariant &variantParameters, AsyncImageRenderCallback &callbackObject);
 
     /** @brief The LCH-hue.
@@ -85,8 +89,14 @@ private:
         return x + y * imageSizePhysical.width();
     }
 
-    static void
-    renderByRow(uchar *const bytesPtr, const qsizetype bytesPerLine, const ChromaLightnessImageParameters parameters, const int firstRow, const int lastRow);
+    [[nodiscard]] static std::pair<int, int> maskSpan(const std::pair<double, double> &interval, const double valuesPerPixel, const int width);
+    static void renderByRow(uchar *const bytesPtr,
+                            const qsizetype bytesPerLine,
+                            uchar *const maskPtr,
+                            const qsizetype maskBytesPerLine,
+                            const ChromaLightnessImageParameters parameters,
+                            const int firstRow,
+                            const int lastRow);
 };
 
 } // namespace PerceptualColor
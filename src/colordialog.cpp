@@ -19,6 +19,7 @@
 #include "initializetranslation.h"
 #include "lchvalues.h"
 #include "logging.h"
+#include "multimodelcolor.h"
 #include "multispinbox.h"
 #include "multispinboxsection.h"
 #include "perceptualcolornamespace.h"
@@ -239,7 +240,9 @@ void ColorDialogPrivate::retranslateUi()
     /*: @label:slider Accessible name for lightness slider. This is different
     from “brightness”/“value” and should therefore get a different
     translation. */
-    m_lchLightnessSelector->setAccessibleName(tr("Lightness"));
+    if (!m_lchLightnessSelector.isNull()) {
+        m_lchLightnessSelector->setAccessibleName(tr("Lightness"));
+    }
 
     /*: @info:tooltip Help text for CIELCH. “lightness” is different from
     “brightness”/“value” and should therefore get a different translation. */
@@ -389,20 +392,22 @@ void ColorDialogPrivate::retranslateUi()
     m_oklchSpinBoxGamutAction->setToolTip(gamutTooltip);
     m_oklchSpinBoxGamutAction->setShortcut(gamutShortcut);
 
-    /*: @item:inlistbox/plain
-    The swatch grid showing the basic colors like yellow,
-    orange, red… Same text as in QColorDialog */
-    m_swatchBookSelector->setItemText(0, tr("Basic colors"));
+    if (!m_swatchBookSelector.isNull()) {
+        /*: @item:inlistbox/plain
+        The swatch grid showing the basic colors like yellow,
+        orange, red… Same text as in QColorDialog */
+        m_swatchBookSelector->setItemText(0, tr("Basic colors"));
 
-    /*: @item:inlistbox/plain
-    The swatch grid showing the history of
-    previously selected colors. */
-    m_swatchBookSelector->setItemText(1, tr("History"));
+        /*: @item:inlistbox/plain
+        The swatch grid showing the history of
+        previously selected colors. */
+        m_swatchBookSelector->setItemText(1, tr("History"));
 
-    /*: @item:inlistbox/plain
-    The swatch grid showing custom colors, allowing users to add or remove
-    colors as desired. */
-    m_swatchBookSelector->setItemText(2, tr("Custom Colors"));
+        /*: @item:inlistbox/plain
+        The swatch grid showing custom colors, allowing users to add or remove
+        colors as desired. */
+        m_swatchBookSelector->setItemText(2, tr("Custom Colors"));
+    }
 
     // NOTE No need to call
     //
@@ -535,88 +540,13 @@ void ColorDialogPrivate::initialize()
     m_wcsBasicColors = wcsBasicColors();
     m_wcsBasicDefaultColor = m_wcsBasicColors.value(4, 2);
 
-    // create the graphical selectors
-    m_swatchBookBasicColors = new SwatchBook(m_wcsBasicColors, //
-                                             Qt::Orientation::Horizontal);
-    auto swatchBookBasicColorsLayout = new QGridLayout();
-    auto swatchBookBasicColorsLayoutWidget = new QWidget();
-    swatchBookBasicColorsLayoutWidget->setLayout(swatchBookBasicColorsLayout);
-    swatchBookBasicColorsLayoutWidget->setContentsMargins(0, 0, 0, 0);
-    swatchBookBasicColorsLayout->setContentsMargins(0, 0, 0, 0);
-    swatchBookBasicColorsLayout->addWidget(m_swatchBookBasicColors);
-    swatchBookBasicColorsLayout->setRowStretch(1, 1);
-    swatchBookBasicColorsLayout->setColumnStretch(1, 1);
-    m_swatchBookHistory = new SwatchBook(QColorArray2D(), //
-                                         Qt::Orientation::Vertical);
-    auto swatchBookHistoryLayout = new QGridLayout();
-    auto swatchBookHistoryLayoutWidget = new QWidget();
-    swatchBookHistoryLayoutWidget->setLayout(swatchBookHistoryLayout);
-    swatchBookHistoryLayoutWidget->setContentsMargins(0, 0, 0, 0);
-    swatchBookHistoryLayout->setContentsMargins(0, 0, 0, 0);
-    swatchBookHistoryLayout->addWidget(m_swatchBookHistory);
-    swatchBookHistoryLayout->setRowStretch(1, 1);
-    swatchBookHistoryLayout->setColumnStretch(1, 1);
-    loadHistoryFromSettingsToSwatchBook();
-    m_swatchBookCustomColors = new SwatchBook( //
-        QColorArray2D(), //
-        Qt::Orientation::Horizontal | Qt::Orientation::Vertical);
-    m_swatchBookCustomColors->setEditable(true);
-    auto swatchBookCustomColorsLayout = new QGridLayout();
-    auto swatchBookCustomColorsLayoutWidget = new QWidget();
-    swatchBookCustomColorsLayoutWidget->setLayout(swatchBookCustomColorsLayout);
-    swatchBookCustomColorsLayoutWidget->setContentsMargins(0, 0, 0, 0);
-    swatchBookCustomColorsLayout->setContentsMargins(0, 0, 0, 0);
-    swatchBookCustomColorsLayout->addWidget(m_swatchBookCustomColors);
-    swatchBookCustomColorsLayout->setRowStretch(1, 1);
-    swatchBookCustomColorsLayout->setColumnStretch(1, 1);
-    loadCustomColorsFromSettingsToSwatchBook();
-    connect(m_swatchBookCustomColors, // sender
-            &SwatchBook::swatchGridChanged, // signal
-            this, // receiver
-            [this](const QColorArray2D &newSwatches) {
-                m_settings->customColors.setValue(newSwatches.toQList());
-            });
-    m_swatchBookStack = new QStackedLayout();
-    m_swatchBookStack->addWidget(swatchBookBasicColorsLayoutWidget);
-    m_swatchBookStack->addWidget(swatchBookHistoryLayoutWidget);
-    m_swatchBookStack->addWidget(swatchBookCustomColorsLayoutWidget);
-    QHBoxLayout *swatchBookInnerLayout = new QHBoxLayout();
-    swatchBookInnerLayout->addLayout(m_swatchBookStack);
-    swatchBookInnerLayout->addStretch();
-    QVBoxLayout *swatchBookOuterLayout = new QVBoxLayout();
-    m_swatchBookSelector = new QComboBox();
-    m_swatchBookSelector->addItem(QString());
-    m_swatchBookSelector->addItem(QString());
-    m_swatchBookSelector->addItem(QString());
-    connect(m_swatchBookSelector, //
-            &QComboBox::currentIndexChanged,
-            this,
-            [this](int i) {
-                switch (i) {
-                case 0:
-                    m_swatchBookStack->setCurrentIndex(0);
-                    m_settings->swatchBookPage.setValue( //
-                        PerceptualSettings::SwatchBookPage::BasicColors);
-                    break;
-                case 1:
-                    m_swatchBookStack->setCurrentIndex(1);
-                    m_settings->swatchBookPage.setValue( //
-                        PerceptualSettings::SwatchBookPage::History);
-                    break;
-                case 2:
-                    m_swatchBookStack->setCurrentIndex(2);
-                    m_settings->swatchBookPage.setValue( //
-                        PerceptualSettings::SwatchBookPage::CustomColors);
-                    break;
-                default:
-                    break;
-                };
-            });
-    swatchBookOuterLayout->addWidget(m_swatchBookSelector);
-    swatchBookOuterLayout->addLayout(swatchBookInnerLayout);
-    swatchBookOuterLayout->addStretch();
+    // Create the wrapper widgets for the graphical selectors. Their content
+    // is only created when the page is actually needed, or in idle time
+    // after the dialog has been shown.
+    // See initializePage() for details.
     m_swatchBookWrapperWidget = new QWidget();
-    m_swatchBookWrapperWidget->setLayout(swatchBookOuterLayout);
+    m_hueFirstWrapperWidget = new QWidget();
+    m_lightnessFirstWrapperWidget = new QWidget();
     connect(&m_settings->history, //
             &Setting<PerceptualSettings::ColorList>::valueChanged,
             this,
@@ -625,28 +555,6 @@ void ColorDialogPrivate::initialize()
             &Setting<PerceptualSettings::ColorList>::valueChanged,
             this,
             &ColorDialogPrivate::loadCustomColorsFromSettingsToSwatchBook);
-    m_wheelColorPicker = new WheelColorPicker(m_projectionSpace);
-    m_hueFirstWrapperWidget = new QWidget;
-    QHBoxLayout *tempHueFirstLayout = new QHBoxLayout;
-    tempHueFirstLayout->addWidget(m_wheelColorPicker);
-    m_hueFirstWrapperWidget->setLayout(tempHueFirstLayout);
-
-    m_lchLightnessSelector = new GradientSlider(m_projectionSpace);
-    GenericColor blackLch;
-    blackLch.first = 0;
-    blackLch.second = 0;
-    blackLch.third = 0;
-    GenericColor whiteLch;
-    whiteLch.first = m_lchValues.maximumLightness;
-    whiteLch.second = 0;
-    whiteLch.third = 0;
-    m_lchLightnessSelector->setColors(blackLch, 1, whiteLch, 1);
-    m_chromaHueDiagram = new ChromaHueDiagram(m_projectionSpace);
-    QHBoxLayout *tempLightnesFirstLayout = new QHBoxLayout();
-    tempLightnesFirstLayout->addWidget(m_lchLightnessSelector);
-    tempLightnesFirstLayout->addWidget(m_chromaHueDiagram);
-    m_lightnessFirstWrapperWidget = new QWidget();
-    m_lightnessFirstWrapperWidget->setLayout(tempLightnesFirstLayout);
 
     initializePortalEyedropper();
 
@@ -714,6 +622,12 @@ void ColorDialogPrivate::initialize()
             &QTabWidget::currentChanged, //
             this, //
             &ColorDialogPrivate::saveCurrentTab);
+    connect(m_tabWidget, //
+            &QTabWidget::currentChanged, //
+            this, //
+            [this](int index) {
+                initializePage(m_tabWidget->widget(index));
+            });
 
     // Create the ColorPatch
     m_colorPatch = new ColorPatch();
@@ -822,27 +736,17 @@ void ColorDialogPrivate::initialize()
     tempMainLayout->addWidget(m_buttonBox);
     q_pointer->setLayout(tempMainLayout);
 
+    // Outdated widgets are updated when they become visible.
+    for (QWidget *widget : colorWidgets()) {
+        widget->installEventFilter(this);
+    }
+
     // initialize signal-slot-connections
     connect(m_colorPatch, // sender
             &ColorPatch::colorChanged, // signal
             this, // receiver
             &ColorDialogPrivate::readColorPatchValue // slot
     );
-    connect(m_swatchBookBasicColors, // sender
-            &SwatchBook::currentColorChanged, // signal
-            this, // receiver
-            &ColorDialogPrivate::readSwatchBookBasicColorsValue // slot
-    );
-    connect(m_swatchBookHistory, // sender
-            &SwatchBook::currentColorChanged, // signal
-            this, // receiver
-            &ColorDialogPrivate::readSwatchBookHistoryValue // slot
-    );
-    connect(m_swatchBookCustomColors, // sender
-            &SwatchBook::currentColorChanged, // signal
-            this, // receiver
-            &ColorDialogPrivate::readSwatchBookCustomColorsValue // slot
-    );
     connect(m_rgbSpinBox, // sender
             &MultiSpinBox::valuesChanged, // signal
             this, // receiver
@@ -933,21 +837,6 @@ void ColorDialogPrivate::initialize()
                 }
             } // slot
     );
-    connect(m_lchLightnessSelector, // sender
-            &GradientSlider::valueChanged, // signal
-            this, // receiver
-            &ColorDialogPrivate::readLightnessValue // slot
-    );
-    connect(m_wheelColorPicker, // sender
-            &WheelColorPicker::currentColorLchChanged, // signal
-            this, // receiver
-            &ColorDialogPrivate::readWheelColorPickerValues // slot
-    );
-    connect(m_chromaHueDiagram, // sender
-            &ChromaHueDiagram::currentColorLchChanged, // signal
-            this, // receiver
-            &ColorDialogPrivate::readChromaHueDiagramValue // slot
-    );
     connect(m_alphaGradientSlider, // sender
             &GradientSlider::valueChanged, // signal
             this, // receiver
@@ -1074,6 +963,274 @@ void ColorDialogPrivate::initialize()
             &ColorDialogPrivate::reloadIcons);
 }
 
+/** @brief Creates the content of a page of @ref m_tabWidget, if not yet
+ * done.
+ *
+ * The content of the graphical pages is not created in the constructor,
+ * but only when it is actually needed: When the page becomes the current
+ * page of @ref m_tabWidget, or in idle time after the dialog has been
+ * shown. This makes the dialog faster to open.
+ *
+ * @param page One of @ref m_swatchBookWrapperWidget,
+ * @ref m_hueFirstWrapperWidget or @ref m_lightnessFirstWrapperWidget.
+ * For other values, nothing happens.
+ *
+ * @sa @ref initializeNextPage() */
+void ColorDialogPrivate::initializePage(QWidget *page)
+{
+    if (page == nullptr) {
+        return;
+    }
+    if (page == m_swatchBookWrapperWidget) {
+        initializeSwatchBookPage();
+    } else if (page == m_hueFirstWrapperWidget) {
+        initializeHueFirstPage();
+    } else if (page == m_lightnessFirstWrapperWidget) {
+        initializeLightnessFirstPage();
+    }
+}
+
+/** @brief Creates the content of the next page that has not yet been
+ * created.
+ *
+ * Creates only one page at a time. If there are more pages left,
+ * schedules another call of this function for the next iteration of
+ * the event loop, so that the user interface stays responsive.
+ *
+ * @sa @ref initializePage() */
+void ColorDialogPrivate::initializeNextPage()
+{
+    if (m_swatchBookBasicColors.isNull()) {
+        initializeSwatchBookPage();
+    } else if (m_wheelColorPicker.isNull()) {
+        initializeHueFirstPage();
+    } else if (m_chromaHueDiagram.isNull()) {
+        initializeLightnessFirstPage();
+    }
+    const bool morePagesLeft = m_swatchBookBasicColors.isNull() //
+        || m_wheelColorPicker.isNull() //
+        || m_chromaHueDiagram.isNull();
+    if (morePagesLeft) {
+        QMetaObject::invokeMethod(this, //
+                                  &ColorDialogPrivate::initializeNextPage,
+                                  Qt::QueuedConnection);
+    }
+}
+
+/** @brief Integrates newly created widgets that show the current color.
+ *
+ * @param widgets Widgets of @ref colorWidgets() that have just been
+ * created.
+ *
+ * @post The widgets show the current color and are updated on future
+ * color changes. */
+void ColorDialogPrivate::initializeColorWidgets(const QList<QWidget *> &widgets)
+{
+    for (QWidget *widget : widgets) {
+        widget->installEventFilter(this);
+        m_outdatedWidgets.append(widget);
+        updateOutdatedWidget(widget);
+    }
+}
+
+/** @brief Creates the content of @ref m_swatchBookWrapperWidget, if not
+ * yet done.
+ *
+ * @sa @ref initializePage() */
+void ColorDialogPrivate::initializeSwatchBookPage()
+{
+    if (!m_swatchBookBasicColors.isNull()) {
+        return;
+    }
+
+    m_swatchBookBasicColors = new SwatchBook(m_wcsBasicColors, //
+                                             Qt::Orientation::Horizontal);
+    auto swatchBookBasicColorsLayout = new QGridLayout();
+    auto swatchBookBasicColorsLayoutWidget = new QWidget();
+    swatchBookBasicColorsLayoutWidget->setLayout(swatchBookBasicColorsLayout);
+    swatchBookBasicColorsLayoutWidget->setContentsMargins(0, 0, 0, 0);
+    swatchBookBasicColorsLayout->setContentsMargins(0, 0, 0, 0);
+    swatchBookBasicColorsLayout->addWidget(m_swatchBookBasicColors);
+    swatchBookBasicColorsLayout->setRowStretch(1, 1);
+    swatchBookBasicColorsLayout->setColumnStretch(1, 1);
+    m_swatchBookHistory = new SwatchBook(QColorArray2D(), //
+                                         Qt::Orientation::Vertical);
+    auto swatchBookHistoryLayout = new QGridLayout();
+    auto swatchBookHistoryLayoutWidget = new QWidget();
+    swatchBookHistoryLayoutWidget->setLayout(swatchBookHistoryLayout);
+    swatchBookHistoryLayoutWidget->setContentsMargins(0, 0, 0, 0);
+    swatchBookHistoryLayout->setContentsMargins(0, 0, 0, 0);
+    swatchBookHistoryLayout->addWidget(m_swatchBookHistory);
+    swatchBookHistoryLayout->setRowStretch(1, 1);
+    swatchBookHistoryLayout->setColumnStretch(1, 1);
+    loadHistoryFromSettingsToSwatchBook();
+    m_swatchBookCustomColors = new SwatchBook( //
+        QColorArray2D(), //
+        Qt::Orientation::Horizontal | Qt::Orientation::Vertical);
+    m_swatchBookCustomColors->setEditable(true);
+    auto swatchBookCustomColorsLayout = new QGridLayout();
+    auto swatchBookCustomColorsLayoutWidget = new QWidget();
+    swatchBookCustomColorsLayoutWidget->setLayout(swatchBookCustomColorsLayout);
+    swatchBookCustomColorsLayoutWidget->setContentsMargins(0, 0, 0, 0);
+    swatchBookCustomColorsLayout->setContentsMargins(0, 0, 0, 0);
+    swatchBookCustomColorsLayout->addWidget(m_swatchBookCustomColors);
+    swatchBookCustomColorsLayout->setRowStretch(1, 1);
+    swatchBookCustomColorsLayout->setColumnStretch(1, 1);
+    loadCustomColorsFromSettingsToSwatchBook();
+    connect(m_swatchBookCustomColors, // sender
+            &SwatchBook::swatchGridChanged, // signal
+            this, // receiver
+            [this](const QColorArray2D &newSwatches) {
+                m_settings->customColors.setValue(newSwatches.toQList());
+            });
+    m_swatchBookStack = new QStackedLayout();
+    m_swatchBookStack->addWidget(swatchBookBasicColorsLayoutWidget);
+    m_swatchBookStack->addWidget(swatchBookHistoryLayoutWidget);
+    m_swatchBookStack->addWidget(swatchBookCustomColorsLayoutWidget);
+    QHBoxLayout *swatchBookInnerLayout = new QHBoxLayout();
+    swatchBookInnerLayout->addLayout(m_swatchBookStack);
+    swatchBookInnerLayout->addStretch();
+    QVBoxLayout *swatchBookOuterLayout = new QVBoxLayout();
+    m_swatchBookSelector = new QComboBox();
+    m_swatchBookSelector->addItem(QString());
+    m_swatchBookSelector->addItem(QString());
+    m_swatchBookSelector->addItem(QString());
+    connect(m_swatchBookSelector, //
+            &QComboBox::currentIndexChanged,
+            this,
+            [this](int i) {
+                switch (i) {
+                case 0:
+                    m_swatchBookStack->setCurrentIndex(0);
+                    m_settings->swatchBookPage.setValue( //
+                        PerceptualSettings::SwatchBookPage::BasicColors);
+                    break;
+                case 1:
+                    m_swatchBookStack->setCurrentIndex(1);
+                    m_settings->swatchBookPage.setValue( //
+                        PerceptualSettings::SwatchBookPage::History);
+                    break;
+                case 2:
+                    m_swatchBookStack->setCurrentIndex(2);
+                    m_settings->swatchBookPage.setValue( //
+                        PerceptualSettings::SwatchBookPage::CustomColors);
+                    break;
+                default:
+                    break;
+                };
+            });
+    swatchBookOuterLayout->addWidget(m_swatchBookSelector);
+    swatchBookOuterLayout->addLayout(swatchBookInnerLayout);
+    swatchBookOuterLayout->addStretch();
+    m_swatchBookWrapperWidget->setLayout(swatchBookOuterLayout);
+    connect(m_swatchBookBasicColors, // sender
+            &SwatchBook::currentColorChanged, // signal
+            this, // receiver
+            &ColorDialogPrivate::readSwatchBookBasicColorsValue // slot
+    );
+    connect(m_swatchBookHistory, // sender
+            &SwatchBook::currentColorChanged, // signal
+            this, // receiver
+            &ColorDialogPrivate::readSwatchBookHistoryValue // slot
+    );
+    connect(m_swatchBookCustomColors, // sender
+            &SwatchBook::currentColorChanged, // signal
+            this, // receiver
+            &ColorDialogPrivate::readSwatchBookCustomColorsValue // slot
+    );
+
+    // Restore the swatch book that was used the last time.
+    switch (m_settings->swatchBookPage.value()) {
+    case PerceptualSettings::SwatchBookPage::BasicColors:
+    default:
+        m_settings->swatchBookPage.setValue( //
+            PerceptualSettings::SwatchBookPage::BasicColors);
+        m_swatchBookSelector->setCurrentIndex(0);
+        m_swatchBookStack->setCurrentIndex(0);
+        break;
+    case PerceptualSettings::SwatchBookPage::History:
+        m_settings->swatchBookPage.setValue( //
+            PerceptualSettings::SwatchBookPage::History);
+        m_swatchBookSelector->setCurrentIndex(1);
+        m_swatchBookStack->setCurrentIndex(1);
+        break;
+    case PerceptualSettings::SwatchBookPage::CustomColors:
+        m_settings->swatchBookPage.setValue( //
+            PerceptualSettings::SwatchBookPage::CustomColors);
+        m_swatchBookSelector->setCurrentIndex(2);
+        m_swatchBookStack->setCurrentIndex(2);
+        break;
+    }
+
+    initializeColorWidgets({m_swatchBookBasicColors, //
+                            m_swatchBookHistory,
+                            m_swatchBookCustomColors});
+    retranslateUi();
+}
+
+/** @brief Creates the content of @ref m_hueFirstWrapperWidget, if not
+ * yet done.
+ *
+ * @sa @ref initializePage() */
+void ColorDialogPrivate::initializeHueFirstPage()
+{
+    if (!m_wheelColorPicker.isNull()) {
+        return;
+    }
+
+    m_wheelColorPicker = new WheelColorPicker(m_projectionSpace);
+    QHBoxLayout *tempHueFirstLayout = new QHBoxLayout;
+    tempHueFirstLayout->addWidget(m_wheelColorPicker);
+    m_hueFirstWrapperWidget->setLayout(tempHueFirstLayout);
+    connect(m_wheelColorPicker, // sender
+            &WheelColorPicker::currentColorLchChanged, // signal
+            this, // receiver
+            &ColorDialogPrivate::readWheelColorPickerValues // slot
+    );
+
+    initializeColorWidgets({m_wheelColorPicker});
+}
+
+/** @brief Creates the content of @ref m_lightnessFirstWrapperWidget, if not
+ * yet done.
+ *
+ * @sa @ref initializePage() */
+void ColorDialogPrivate::initializeLightnessFirstPage()
+{
+    if (!m_chromaHueDiagram.isNull()) {
+        return;
+    }
+
+    m_lchLightnessSelector = new GradientSlider(m_projectionSpace);
+    GenericColor blackLch;
+    blackLch.first = 0;
+    blackLch.second = 0;
+    blackLch.third = 0;
+    GenericColor whiteLch;
+    whiteLch.first = m_lchValues.maximumLightness;
+    whiteLch.second = 0;
+    whiteLch.third = 0;
+    m_lchLightnessSelector->setColors(blackLch, 1, whiteLch, 1);
+    m_chromaHueDiagram = new ChromaHueDiagram(m_projectionSpace);
+    QHBoxLayout *tempLightnesFirstLayout = new QHBoxLayout();
+    tempLightnesFirstLayout->addWidget(m_lchLightnessSelector);
+    tempLightnesFirstLayout->addWidget(m_chromaHueDiagram);
+    m_lightnessFirstWrapperWidget->setLayout(tempLightnesFirstLayout);
+    connect(m_lchLightnessSelector, // sender
+            &GradientSlider::valueChanged, // signal
+            this, // receiver
+            &ColorDialogPrivate::readLightnessValue // slot
+    );
+    connect(m_chromaHueDiagram, // sender
+            &ChromaHueDiagram::currentColorLchChanged, // signal
+            this, // receiver
+            &ColorDialogPrivate::readChromaHueDiagramValue // slot
+    );
+
+    initializeColorWidgets({m_lchLightnessSelector, m_chromaHueDiagram});
+    retranslateUi();
+}
+
 /** @brief Constructor
  *
  *  @param parent pointer to the parent widget, if any
@@ -1282,7 +1439,7 @@ void ColorDialogPrivate::updateColorPatch()
 }
 
 /** @brief Overloaded function. */
-void ColorDialogPrivate::setCurrentOpaqueColor(const QHash<PerceptualColor::ColorModel, PerceptualColor::GenericColor> &abs, QWidget *const ignoreWidget)
+void ColorDialogPrivate::setCurrentOpaqueColor(const PerceptualColor::MultiModelColor &abs, QWidget *const ignoreWidget)
 {
     setCurrentOpaqueColor(abs, //
                           RgbColor::fromRgb1(abs.value(ColorModel::SRgb_1)), //
@@ -1293,7 +1450,7 @@ void ColorDialogPrivate::setCurrentOpaqueColor(const QHash<PerceptualColor::Colo
 void ColorDialogPrivate::setCurrentOpaqueColor(const PerceptualColor::RgbColor &rgb, QWidget *const ignoreWidget)
 {
     setCurrentOpaqueColor( //
-        AbsoluteColor::allConversions(ColorModel::SRgb_1, rgb.rgb_1),
+        MultiModelColor(ColorModel::SRgb_1, rgb.rgb_1),
         rgb,
         ignoreWidget);
 }
@@ -1310,12 +1467,15 @@ void ColorDialogPrivate::setCurrentOpaqueColor(const PerceptualColor::RgbColor &
  * @post If this function is called recursively, nothing happens. Else
  * the color is moved into the gamut, then @ref m_currentOpaqueColorAbs and
  * @ref m_currentOpaqueColorRgb are updated, and the corresponding widgets
- * are updated (except the widget specified to be ignored – if any).
+ * are updated (except the widget specified to be ignored – if any). While
+ * the dialog is visible, widgets that are hidden are not updated
+ * immediately, but only marked as outdated in @ref m_outdatedWidgets.
+ * They are updated once they become visible.
  *
  * @note Recursive functions calls are ignored. This is useful, because you
  * can connect signals from various widgets to this slot without having to
  * worry about infinite recursions. */
-void ColorDialogPrivate::setCurrentOpaqueColor(const QHash<PerceptualColor::ColorModel, PerceptualColor::GenericColor> &abs,
+void ColorDialogPrivate::setCurrentOpaqueColor(const PerceptualColor::MultiModelColor &abs,
                                                const PerceptualColor::RgbColor &rgb,
                                                QWidget *const ignoreWidget)
 {
@@ -1338,107 +1498,173 @@ void ColorDialogPrivate::setCurrentOpaqueColor(const QHash<PerceptualColor::Colo
     m_currentOpaqueColorAbs = abs;
     m_currentOpaqueColorRgb = rgb;
 
-    // Update basic colors swatch book
-    if (m_swatchBookBasicColors != ignoreWidget) {
-        m_swatchBookBasicColors->setCurrentColor( //
-            m_currentOpaqueColorRgb.rgbQColor);
+    // Update the widgets. While the dialog is hidden, we update all of
+    // them, so that the dialog is in a consistent state when it is shown.
+    // While the dialog is visible, widgets that are hidden (for example
+    // because they are on another tab) are only marked as outdated.
+    // This keeps interactive color changes (like dragging a handle with
+    // the mouse) fast.
+    const bool isDialogVisible = q_pointer->isVisible();
+    const QList<QWidget *> widgets = colorWidgets();
+    for (QWidget *widget : widgets) {
+        if (widget == ignoreWidget) {
+            // This widget is the source of the change, so it is up to date.
+            m_outdatedWidgets.removeAll(widget);
+        } else if (isDialogVisible && !widget->isVisible()) {
+            if (!m_outdatedWidgets.contains(widget)) {
+                m_outdatedWidgets.append(widget);
+            }
+        } else {
+            m_outdatedWidgets.removeAll(widget);
+            showCurrentColorIn(widget);
+        }
     }
 
-    // Update history swatch book
-    if (m_swatchBookHistory != ignoreWidget) {
-        m_swatchBookHistory->setCurrentColor(m_currentOpaqueColorRgb.rgbQColor);
+    // Emit signal currentColorChanged() only if necessary
+    if (q_pointer->currentColor() != oldQColor) {
+        Q_EMIT q_pointer->currentColorChanged(q_pointer->currentColor());
     }
 
-    // Update custom colors swatch book
-    if (m_swatchBookCustomColors != ignoreWidget) {
-        m_swatchBookCustomColors->setCurrentColor(m_currentOpaqueColorRgb.rgbQColor);
-    }
+    // End of this function. Unblock recursive
+    // function calls before returning.
+    m_isColorChangeInProgress = false;
+}
 
-    // Update RGB widget
-    if (m_rgbSpinBox != ignoreWidget) {
+/** @brief The child widgets that show the current color.
+ *
+ * @returns The child widgets that show the current color, in the order
+ * in which @ref setCurrentOpaqueColor() updates them.
+ *
+ * @sa @ref showCurrentColorIn() */
+QList<QWidget *> ColorDialogPrivate::colorWidgets() const
+{
+    QList<QWidget *> result{m_swatchBookBasicColors,
+                            m_swatchBookHistory,
+                            m_swatchBookCustomColors,
+                            m_rgbSpinBox,
+                            m_hslSpinBox,
+                            m_hwbSpinBox,
+                            m_hsvSpinBox,
+                            m_cielchD50SpinBox,
+                            m_oklchSpinBox,
+                            m_rgbLineEdit,
+                            m_lchLightnessSelector,
+                            m_chromaHueDiagram,
+                            m_wheelColorPicker,
+                            m_alphaGradientSlider,
+                            m_colorPatch};
+    result.removeAll(nullptr);
+    return result;
+}
+
+/** @brief Updates a child widget to the current color.
+ *
+ * @param widget One of the widgets of @ref colorWidgets(). For other
+ * widgets, nothing happens.
+ *
+ * @post The widget shows @ref m_currentOpaqueColorAbs
+ * and @ref m_currentOpaqueColorRgb.
+ *
+ * @note This function does not block signals of the widget. Call it only
+ * while @ref m_isColorChangeInProgress is <tt>true</tt>. */
+void ColorDialogPrivate::showCurrentColorIn(QWidget *widget)
+{
+    const auto projectionSpaceLch = [this]() {
+        return (m_projectionSpace == LchSpace::CielchD50) //
+            ? m_currentOpaqueColorAbs.value(ColorModel::CielchD50) //
+            : m_currentOpaqueColorAbs.value(ColorModel::OklchD65);
+    };
+    if (widget == m_swatchBookBasicColors) {
+        m_swatchBookBasicColors->setCurrentColor( //
+            m_currentOpaqueColorRgb.rgbQColor);
+    } else if (widget == m_swatchBookHistory) {
+        m_swatchBookHistory->setCurrentColor(m_currentOpaqueColorRgb.rgbQColor);
+    } else if (widget == m_swatchBookCustomColors) {
+        m_swatchBookCustomColors->setCurrentColor(m_currentOpaqueColorRgb.rgbQColor);
+    } else if (widget == m_rgbSpinBox) {
         m_rgbSpinBox->setValues( //
             m_currentOpaqueColorRgb.rgb_255.toQList3());
-    }
-
-    // Update HSL widget
-    if (m_hslSpinBox != ignoreWidget) {
+    } else if (widget == m_hslSpinBox) {
         m_hslSpinBox->setValues( //
             m_currentOpaqueColorRgb.hsl.toQList3());
-    }
-
-    // Update HWB widget
-    if (m_hwbSpinBox != ignoreWidget) {
+    } else if (widget == m_hwbSpinBox) {
         m_hwbSpinBox->setValues( //
             m_currentOpaqueColorRgb.hwb.toQList3());
-    }
-
-    // Update HSV widget
-    if (m_hsvSpinBox != ignoreWidget) {
+    } else if (widget == m_hsvSpinBox) {
         m_hsvSpinBox->setValues( //
             m_currentOpaqueColorRgb.hsv.toQList3());
-    }
-
-    // Update CIELCH-D50 widget
-    const GenericColor cielchD50 = m_currentOpaqueColorAbs.value(ColorModel::CielchD50);
-    if (m_cielchD50SpinBox != ignoreWidget) {
-        m_cielchD50SpinBox->setValues(cielchD50.toQList3());
-    }
-
-    // Update Oklch widget
-    const auto oklch = m_currentOpaqueColorAbs.value(ColorModel::OklchD65);
-    if (m_oklchSpinBox != ignoreWidget) {
-        m_oklchSpinBox->setValues(oklch.toQList3());
-    }
-
-    // Update RGB hex widget
-    if (m_rgbLineEdit != ignoreWidget) {
+    } else if (widget == m_cielchD50SpinBox) {
+        m_cielchD50SpinBox->setValues( //
+            m_currentOpaqueColorAbs.value(ColorModel::CielchD50).toQList3());
+    } else if (widget == m_oklchSpinBox) {
+        m_oklchSpinBox->setValues( //
+            m_currentOpaqueColorAbs.value(ColorModel::OklchD65).toQList3());
+    } else if (widget == m_rgbLineEdit) {
         m_rgbLineEdit->setText(m_currentOpaqueColorRgb.rgbHex6);
-    }
-
-    const GenericColor projectionSpaceLch = //
-        (m_projectionSpace == LchSpace::CielchD50) //
-        ? cielchD50 //
-        : oklch;
-
-    // Update lightness selector
-    if (m_lchLightnessSelector != ignoreWidget) {
+    } else if (widget == m_lchLightnessSelector) {
         m_lchLightnessSelector->setValue( //
-            projectionSpaceLch.first / m_lchValues.maximumLightness);
-    }
-
-    // Update chroma-hue diagram
-    if (m_chromaHueDiagram != ignoreWidget) {
-        m_chromaHueDiagram->setCurrentColorLch(projectionSpaceLch);
-    }
-
-    // Update wheel color picker
-    if (m_wheelColorPicker != ignoreWidget) {
-        m_wheelColorPicker->setCurrentColorLch(projectionSpaceLch);
-    }
-
-    // Update alpha gradient slider
-    if (m_alphaGradientSlider != ignoreWidget) {
+            projectionSpaceLch().first / m_lchValues.maximumLightness);
+    } else if (widget == m_chromaHueDiagram) {
+        m_chromaHueDiagram->setCurrentColorLch(projectionSpaceLch());
+    } else if (widget == m_wheelColorPicker) {
+        m_wheelColorPicker->setCurrentColorLch(projectionSpaceLch());
+    } else if (widget == m_alphaGradientSlider) {
+        const GenericColor lch = projectionSpaceLch();
         GenericColor tempColor;
-        tempColor.first = projectionSpaceLch.first;
-        tempColor.second = projectionSpaceLch.second;
-        tempColor.third = projectionSpaceLch.third;
+        tempColor.first = lch.first;
+        tempColor.second = lch.second;
+        tempColor.third = lch.third;
         m_alphaGradientSlider->setFirstColorLchA(tempColor, 0);
         m_alphaGradientSlider->setSecondColorLchA(tempColor, 1);
-    }
-
-    // Update widgets that take alpha information
-    if (m_colorPatch != ignoreWidget) {
+    } else if (widget == m_colorPatch) {
+        // Widgets that take alpha information
         updateColorPatch();
     }
+}
 
-    // Emit signal currentColorChanged() only if necessary
-    if (q_pointer->currentColor() != oldQColor) {
-        Q_EMIT q_pointer->currentColorChanged(q_pointer->currentColor());
+/** @brief Updates a widget if it is outdated.
+ *
+ * @param widget The widget
+ *
+ * @post If the widget is in @ref m_outdatedWidgets, it is updated to the
+ * current color and removed from @ref m_outdatedWidgets. Otherwise,
+ * nothing happens. */
+void ColorDialogPrivate::updateOutdatedWidget(QWidget *widget)
+{
+    if (!m_outdatedWidgets.contains(widget)) {
+        return;
     }
+    m_outdatedWidgets.removeAll(widget);
+    // Updating the widget emits signals of the widget that are connected
+    // back to setCurrentOpaqueColor(). Block these recursive calls, because
+    // the value of the widget might be rounded and should not become the
+    // current color of the dialog.
+    const bool wasColorChangeInProgress = m_isColorChangeInProgress;
+    m_isColorChangeInProgress = true;
+    showCurrentColorIn(widget);
+    m_isColorChangeInProgress = wasColorChangeInProgress;
+}
 
-    // End of this function. Unblock recursive
-    // function calls before returning.
-    m_isColorChangeInProgress = false;
+/** @brief Filters events of the widgets of @ref colorWidgets().
+ *
+ * Reimplemented from base class.
+ *
+ * Outdated widgets are updated when they become visible.
+ *
+ * @param watched Pointer to the object for which we are filtering events
+ * @param event The event that we are filtering
+ *
+ * @returns <tt>false</tt>, so that the event is never discarded.
+ *
+ * @sa @ref m_outdatedWidgets */
+bool ColorDialogPrivate::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Show) {
+        // The widgets of colorWidgets() are the only ones that have
+        // this event filter installed.
+        updateOutdatedWidget(static_cast<QWidget *>(watched));
+    }
+    return QObject::eventFilter(watched, event);
 }
 
 /** @brief Reads the value from the lightness selector in the dialog and
@@ -1457,7 +1683,7 @@ void ColorDialogPrivate::readLightnessValue()
             AbsoluteColor::reduceChromaToFitIntoGamut(cielchD50, //
                                                       LchSpace::CielchD50));
         setCurrentOpaqueColor( //
-            AbsoluteColor::allConversions(ColorModel::CielchD50, cielchD50), //
+            MultiModelColor(ColorModel::CielchD50, cielchD50), //
             m_lchLightnessSelector);
 
     } else {
@@ -1467,7 +1693,7 @@ void ColorDialogPrivate::readLightnessValue()
         oklch = GenericColor( //
             AbsoluteColor::reduceChromaToFitIntoGamut(oklch, LchSpace::Oklch));
         setCurrentOpaqueColor( //
-            AbsoluteColor::allConversions(ColorModel::OklchD65, oklch), //
+            MultiModelColor(ColorModel::OklchD65, oklch), //
             m_lchLightnessSelector);
     }
 }
@@ -1604,7 +1830,7 @@ void ColorDialogPrivate::readWheelColorPickerValues()
     }
     const auto lch = GenericColor(m_wheelColorPicker->currentColorLch());
     setCurrentOpaqueColor( //
-        AbsoluteColor::allConversions(m_projectionSpaceModel, lch),
+        MultiModelColor(m_projectionSpaceModel, lch),
         m_wheelColorPicker);
 }
 
@@ -1618,7 +1844,7 @@ void ColorDialogPrivate::readChromaHueDiagramValue()
     }
     const auto lch = GenericColor(m_chromaHueDiagram->currentColorLch());
     setCurrentOpaqueColor( //
-        AbsoluteColor::allConversions(m_projectionSpaceModel, lch),
+        MultiModelColor(m_projectionSpaceModel, lch),
         m_chromaHueDiagram);
 }
 
@@ -1699,7 +1925,7 @@ void ColorDialogPrivate::readLchNumericValues()
     const auto myColor = GenericColor( //
         AbsoluteColor::reduceChromaToFitIntoGamut(lchValues, LchSpace::CielchD50));
     setCurrentOpaqueColor( //
-        AbsoluteColor::allConversions(ColorModel::CielchD50, myColor),
+        MultiModelColor(ColorModel::CielchD50, myColor),
         // widget that will ignored during updating:
         m_cielchD50SpinBox);
 }
@@ -1728,7 +1954,7 @@ void ColorDialogPrivate::readOklchNumericValues()
         AbsoluteColor::reduceChromaToFitIntoGamut(originalOklch, //
                                                   LchSpace::Oklch));
     const auto inGamutColor = //
-        AbsoluteColor::allConversions(ColorModel::OklchD65, inGamutOklch);
+        MultiModelColor(ColorModel::OklchD65, inGamutOklch);
     setCurrentOpaqueColor(inGamutColor,
                           // widget that will ignored during updating:
                           m_oklchSpinBox);
@@ -2289,7 +2515,10 @@ void ColorDialogPrivate::applyLayoutDimensions()
         // Now we calculate the space we need for displaying the
         // graphical selectors and the numerical selector at their
         // preferred size in an expanded layout.
-        // Start with the size of the graphical selectors.
+        // Start with the size of the graphical selectors. Their size hint
+        // is only meaningful when their content has been created.
+        initializeHueFirstPage();
+        initializeLightnessFirstPage();
         widthThreeshold = qMax( //
             m_wheelColorPicker->sizeHint().width(), //
             m_lightnessFirstWrapperWidget->sizeHint().width());
@@ -2361,21 +2590,25 @@ void ColorDialog::changeEvent(QEvent *eventParameter)
         //      propagate the event to all toplevel widgets […].
         // Retranslate this widget itself:
         d_pointer->retranslateUi();
-        // Retranslate all child widgets that actually need to be retranslated:
-        {
-            QEvent eventForSwatchBookBasicColors(QEvent::LanguageChange);
-            QApplication::sendEvent(d_pointer->m_swatchBookBasicColors, //
-                                    &eventForSwatchBookBasicColors);
-        }
-        {
-            QEvent eventForSwatchBookHistory(QEvent::LanguageChange);
-            QApplication::sendEvent(d_pointer->m_swatchBookHistory, //
-                                    &eventForSwatchBookHistory);
-        }
-        {
-            QEvent eventForSwatchBookCustomColors(QEvent::LanguageChange);
-            QApplication::sendEvent(d_pointer->m_swatchBookCustomColors, //
-                                    &eventForSwatchBookCustomColors);
+        // Retranslate all child widgets that actually need to be retranslated.
+        // Pages that have not been created yet will be translated correctly
+        // at creation time.
+        if (!d_pointer->m_swatchBookBasicColors.isNull()) {
+            {
+                QEvent eventForSwatchBookBasicColors(QEvent::LanguageChange);
+                QApplication::sendEvent(d_pointer->m_swatchBookBasicColors, //
+                                        &eventForSwatchBookBasicColors);
+            }
+            {
+                QEvent eventForSwatchBookHistory(QEvent::LanguageChange);
+                QApplication::sendEvent(d_pointer->m_swatchBookHistory, //
+                                        &eventForSwatchBookHistory);
+            }
+            {
+                QEvent eventForSwatchBookCustomColors(QEvent::LanguageChange);
+                QApplication::sendEvent(d_pointer->m_swatchBookCustomColors, //
+                                        &eventForSwatchBookCustomColors);
+            }
         }
         {
             QEvent eventForButtonOk(QEvent::LanguageChange);
@@ -2387,7 +2620,7 @@ void ColorDialog::changeEvent(QEvent *eventParameter)
             QApplication::sendEvent(d_pointer->m_buttonOK, //
                                     &eventForButtonCancel);
         }
-        {
+        if (!d_pointer->m_wheelColorPicker.isNull()) {
             QEvent eventForWheelColorPicker(QEvent::LanguageChange);
             QApplication::sendEvent(d_pointer->m_wheelColorPicker, //
                                     &eventForWheelColorPicker);
@@ -2411,7 +2644,9 @@ void ColorDialog::changeEvent(QEvent *eventParameter)
  * @internal
  *
  * On the first show event, make @ref ColorDialogPrivate::m_tabWidget use
- * the current tab corresponding to @ref ColorDialogPrivate::m_settings. */
+ * the current tab corresponding to @ref ColorDialogPrivate::m_settings,
+ * create the content of this tab and schedule the creation of the content
+ * of the other tabs. */
 void ColorDialog::showEvent(QShowEvent *eventParameter)
 {
     if (!d_pointer->everShown) {
@@ -2431,27 +2666,12 @@ void ColorDialog::showEvent(QShowEvent *eventParameter)
         // is saved whenever the user has first seen it.
         d_pointer->saveCurrentTab();
 
-        switch (d_pointer->m_settings->swatchBookPage.value()) {
-        case PerceptualSettings::SwatchBookPage::BasicColors:
-        default:
-            d_pointer->m_settings->swatchBookPage.setValue( //
-                PerceptualSettings::SwatchBookPage::BasicColors);
-            d_pointer->m_swatchBookSelector->setCurrentIndex(0);
-            d_pointer->m_swatchBookStack->setCurrentIndex(0);
-            break;
-        case PerceptualSettings::SwatchBookPage::History:
-            d_pointer->m_settings->swatchBookPage.setValue( //
-                PerceptualSettings::SwatchBookPage::History);
-            d_pointer->m_swatchBookSelector->setCurrentIndex(1);
-            d_pointer->m_swatchBookStack->setCurrentIndex(1);
-            break;
-        case PerceptualSettings::SwatchBookPage::CustomColors:
-            d_pointer->m_settings->swatchBookPage.setValue( //
-                PerceptualSettings::SwatchBookPage::CustomColors);
-            d_pointer->m_swatchBookSelector->setCurrentIndex(2);
-            d_pointer->m_swatchBookStack->setCurrentIndex(2);
-            break;
-        }
+        // Create the content of the current page immediately, and the
+        // content of the other pages later when the event loop is idle.
+        d_pointer->initializePage(d_pointer->m_tabWidget->currentWidget());
+        QMetaObject::invokeMethod(d_pointer.get(), //
+                                  &ColorDialogPrivate::initializeNextPage,
+                                  Qt::QueuedConnection);
 
         d_pointer->everShown = true;
     }
@@ -2486,6 +2706,10 @@ void ColorDialogPrivate::saveCurrentTab()
  * @ref m_swatchBookHistory. */
 void ColorDialogPrivate::loadHistoryFromSettingsToSwatchBook()
 {
+    if (m_swatchBookHistory.isNull()) {
+        // Will be loaded when the swatch book page is created.
+        return;
+    }
     const QColorArray2D historyArray(historyHSwatchCount, //
                                      historyVSwatchCount, //
                                      m_settings->history.value());
@@ -2496,6 +2720,10 @@ void ColorDialogPrivate::loadHistoryFromSettingsToSwatchBook()
  * @ref m_swatchBookCustomColors. */
 void ColorDialogPrivate::loadCustomColorsFromSettingsToSwatchBook()
 {
+    if (m_swatchBookCustomColors.isNull()) {
+        // Will be loaded when the swatch book page is created.
+        return;
+    }
     const QColorArray2D customColorsArray(customColorsHSwatchCount, //
                                           customColorsVSwatchCount, //
                                           m_settings->customColors.value());
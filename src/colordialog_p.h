@@ -12,6 +12,7 @@
 #include "helper.h"
 #include "languagechangeeventfilter.h"
 #include "lchvalues.h"
+#include "multimodelcolor.h"
 #include "perceptualcolornamespace.h"
 #include "rgbcolor.h"
 #include <optional>
@@ -21,6 +22,7 @@
 #include <qglobal.h>
 #include <qhash.h>
 #include <qicon.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qpointer.h>
 #include <qstring.h>
@@ -30,6 +32,7 @@ class QAction;
 class QComboBox;
 class QDialogButtonBox;
 class QDoubleSpinBox;
+class QEvent;
 class QGroupBox;
 class QHBoxLayout;
 class QLabel;
@@ -135,7 +138,7 @@ public:
      *
      * @sa @ref ColorDialog::currentColor()
      * @sa @ref m_currentOpaqueColorRgb */
-    QHash<ColorModel, GenericColor> m_currentOpaqueColorAbs;
+    MultiModelColor m_currentOpaqueColorAbs;
     /** @brief Current color without alpha information
      *
      * Holds the color in the RGB color model and derived color models.
@@ -162,7 +165,10 @@ public:
     /** @brief Shortcut to show the tab with @ref m_hueFirstWrapperWidget. */
     QPointer<QShortcut> m_hueFirstTabShortcut;
     /** @brief Pointer to the QWidget wrapper that contains
-     * @ref m_wheelColorPicker. */
+     * @ref m_wheelColorPicker.
+     *
+     * The content is created lazily.
+     * See @ref initializePage() for details. */
     QPointer<QWidget> m_hueFirstWrapperWidget;
     /** @brief Holds whether currently a color change is ongoing, or not.
      *
@@ -172,6 +178,18 @@ public:
     bool m_isColorChangeInProgress = false;
     /** @brief An event filter used for some child widgets. */
     LanguageChangeEventFilter m_languageChangeEventFilter;
+    /** @brief Child widgets that do not yet show the current color.
+     *
+     * While the dialog is visible, @ref setCurrentOpaqueColor() updates
+     * only the child widgets that are currently visible. Child widgets
+     * that are hidden (for example because they are on a tab that is
+     * not the current tab) are only added to this list. They are updated
+     * when they become visible. Like this, several color changes that
+     * happen while a widget is hidden result in a single update.
+     *
+     * @sa @ref colorWidgets()
+     * @sa @ref updateOutdatedWidget() */
+    QList<QWidget *> m_outdatedWidgets;
     /** @brief Internal storage for property
      * @ref ColorDialog::layoutDimensions */
     PerceptualColor::ColorDialog::DialogLayoutDimensions m_layoutDimensions =
@@ -191,7 +209,10 @@ public:
     /** @brief Shortcut to show the tab with @ref m_lightnessFirstWrapperWidget. */
     QPointer<QShortcut> m_lightnessFirstTabShortcut;
     /** @brief Pointer to the QWidget wrapper that contains
-     * @ref m_lchLightnessSelector and @ref m_chromaHueDiagram. */
+     * @ref m_lchLightnessSelector and @ref m_chromaHueDiagram.
+     *
+     * The content is created lazily.
+     * See @ref initializePage() for details. */
     QPointer<QWidget> m_lightnessFirstWrapperWidget;
     /** @brief Pointer to the @ref GradientSlider for LCH lightness. */
     QPointer<GradientSlider> m_lchLightnessSelector;
@@ -253,7 +274,10 @@ public:
     /** @brief Shortcut to show the tab with @ref m_swatchBookWrapperWidget. */
     QPointer<QShortcut> m_swatchBookTabShortcut;
     /** @brief Pointer to the QWidget wrapper that contains
-     * the swatch books. */
+     * the swatch books.
+     *
+     * The content is created lazily.
+     * See @ref initializePage() for details. */
     QPointer<QWidget> m_swatchBookWrapperWidget;
     /** @brief Holds the receiver object (if any) to be disconnected
      *  automatically after closing the dialog.
@@ -328,15 +352,26 @@ public:
     static constexpr quint8 okdecimals = decimals + 2;
 
     void applyLayoutDimensions();
+    [[nodiscard]] QList<QWidget *> colorWidgets() const;
     [[nodiscard]] QColor defaultColor() const;
     static QIcon getGamutIcon();
     void initialize();
+    void initializeColorWidgets(const QList<QWidget *> &widgets);
+    void initializeHueFirstPage();
+    void initializeLightnessFirstPage();
     [[nodiscard]] QWidget *initializeNumericPage();
+    void initializePage(QWidget *page);
     void initializePortalEyedropper();
+    void initializeSwatchBookPage();
     void loadCustomColorsFromSettingsToSwatchBook();
     void loadHistoryFromSettingsToSwatchBook();
+    void showCurrentColorIn(QWidget *widget);
+    void updateOutdatedWidget(QWidget *widget);
+
+    virtual bool eventFilter(QObject *watched, QEvent *event) override;
 
 public Q_SLOTS:
+    void initializeNextPage();
     void readChromaHueDiagramValue();
     void readColorPatchValue();
     void readHslNumericValues();
@@ -354,9 +389,9 @@ public Q_SLOTS:
     void reloadIcons();
     void retranslateUi();
     void saveCurrentTab();
-    void setCurrentOpaqueColor(const QHash<PerceptualColor::ColorModel, PerceptualColor::GenericColor> &abs, QWidget *const ignoreWidget);
+    void setCurrentOpaqueColor(const PerceptualColor::MultiModelColor &abs, QWidget *const ignoreWidget);
     void setCurrentOpaqueColor(const PerceptualColor::RgbColor &rgb, QWidget *const ignoreWidget);
-    void setCurrentOpaqueColor(const QHash<PerceptualColor::ColorModel, PerceptualColor::GenericColor> &abs,
+    void setCurrentOpaqueColor(const PerceptualColor::MultiModelColor &abs,
                                const PerceptualColor::RgbColor &rgb,
                                QWidget *const ignoreWidget);
     void updateColorPatch();
@@ -9,8 +9,10 @@
 #include "genericcolor.h"
 #include "helperconstants.h"
 #include <algorithm>
+#include <iterator>
 #include <qcolor.h>
 #include <qlist.h>
+#include <qrgb.h>
 #include <utility>
 
 namespace PerceptualColor
@@ -110,7 +112,7 @@ ColorSpaceInfo::ColorSpaceInfo()
     for (int value = 0; value <= 255; ++value) {
         // This will create six duplicate values (at the borders between
         // the six value groups). These will be filtered out later
-        // automatically, because std::map does not allow duplicates.
+        // in initializeChromaticityBoundary().
 
         // Red = 255
         chromaticityBoundaryQColor.append(QColor(255, value, 0)); // Vary green
@@ -127,6 +129,10 @@ ColorSpaceInfo::ColorSpaceInfo()
 
     m_profileMaximumCielchD50Chroma = 0;
     m_profileMaximumOklchChroma = 0;
+    QList<std::pair<double, QRgb>> colorsByCielchD50Hue;
+    colorsByCielchD50Hue.reserve(chromaticityBoundaryQColor.size());
+    QList<std::pair<double, QRgb>> colorsByOklabHue;
+    colorsByOklabHue.reserve(chromaticityBoundaryQColor.size());
     for (auto &color : chromaticityBoundaryQColor) {
         const auto rgb_1 = GenericColor( //
             static_cast<double>(color.redF()), //
@@ -142,29 +148,15 @@ ColorSpaceInfo::ColorSpaceInfo()
         m_profileMaximumCielchD50Chroma = qMax( //
             m_profileMaximumCielchD50Chroma, //
             cielchD50.second);
-        m_chromaticityBoundaryByCielchD50Hue360[cielchD50.third] = color;
+        colorsByCielchD50Hue.append({cielchD50.third, color.rgb()});
 
         m_profileMaximumOklchChroma = qMax( //
             m_profileMaximumOklchChroma, //
             oklch.second);
-        m_chromaticityBoundaryByOklabHue360[oklch.third] = color;
+        colorsByOklabHue.append({oklch.third, color.rgb()});
     }
-
-    auto addDuplicates = [](auto &boundaryMap) {
-        const auto firstKey = boundaryMap.begin()->first;
-        const auto firstValue = boundaryMap.begin()->second;
-        const auto lastKey = boundaryMap.rbegin()->first;
-        const auto lastValue = boundaryMap.rbegin()->second;
-        // In our circle, we create duplicates for the lowest and highest
-        // angles beyond the [0, 360] boundary on the opposite side of the
-        // circle. For example, the lowest original key is 2° and its duplicate
-        // is placed at 362°, while the highest original key might be 357°,
-        // with its duplicate at -3°.
-        boundaryMap[firstKey + 360] = firstValue;
-        boundaryMap[lastKey - 360] = lastValue;
-    };
-    addDuplicates(m_chromaticityBoundaryByCielchD50Hue360);
-    addDuplicates(m_chromaticityBoundaryByOklabHue360);
+    initializeChromaticityBoundary(m_chromaticityBoundaryByCielchD50Hue360, colorsByCielchD50Hue);
+    initializeChromaticityBoundary(m_chromaticityBoundaryByOklabHue360, colorsByOklabHue);
 
     m_profileMaximumCielchD50Chroma = std::min<double>( //
         m_profileMaximumCielchD50Chroma, //
@@ -204,56 +196,145 @@ QColor ColorSpaceInfo::maxChromaColorByCielchD50Hue360(double hue360)
 }
 
 /**
- * @brief Returns the most chromatic color for the given hue.
+ * @brief Initializes a @ref ChromaticityBoundary.
  *
- * @param hue360 Oklab hue in the range [0, 360]
- * @param type The type of Lch color space.
- *
- * @returns the most chromatic color for the given hue in the sRGB gamut.
+ * @param boundary The object to initialize.
+ * @param colorsByHue All RGB colors located on the chromaticity boundary,
+ *        together with their hue. Might contain duplicates. The list is
+ *        sorted in-place.
  */
-QColor ColorSpaceInfo::maxChromaColorByHue360(double hue360, PerceptualColor::LchSpace type)
+void ColorSpaceInfo::initializeChromaticityBoundary(ChromaticityBoundary &boundary, QList<std::pair<double, QRgb>> &colorsByHue)
 {
-    const auto &table = (type == LchSpace::CielchD50) //
-        ? instance().m_chromaticityBoundaryByCielchD50Hue360 //
-        : instance().m_chromaticityBoundaryByOklabHue360;
+    std::stable_sort(colorsByHue.begin(), //
+                     colorsByHue.end(),
+                     [](const auto &first, const auto &second) {
+                         return first.first < second.first;
+                     });
+    boundary.hues.clear();
+    boundary.rgb.clear();
+    boundary.hues.reserve(colorsByHue.size() + 2);
+    boundary.rgb.reserve(colorsByHue.size() + 2);
+    for (const auto &[hue, rgb] : std::as_const(colorsByHue)) {
+        if (!boundary.hues.isEmpty() && boundary.hues.constLast() == hue) {
+            // Duplicate hue. The last one wins.
+            boundary.rgb.last() = rgb;
+        } else {
+            boundary.hues.append(hue);
+            boundary.rgb.append(rgb);
+        }
+    }
 
-    // begin() points to the actual first key-value pair.
-    // end() points to a virtual key-value pair after the last actual
-    // key-value pair. Dereferencing is not allowed.
+    // In our circle, we create duplicates for the lowest and highest
+    // angles beyond the [0, 360] boundary on the opposite side of the
+    // circle. For example, the lowest original key is 2° and its duplicate
+    // is placed at 362°, while the highest original key might be 357°,
+    // with its duplicate at -3°.
+    const auto firstHue = boundary.hues.constFirst();
+    const auto firstRgb = boundary.rgb.constFirst();
+    const auto lastHue = boundary.hues.constLast();
+    const auto lastRgb = boundary.rgb.constLast();
+    boundary.hues.prepend(lastHue - 360);
+    boundary.rgb.prepend(lastRgb);
+    boundary.hues.append(firstHue + 360);
+    boundary.rgb.append(firstRgb);
+
+    constexpr int tableSize = 360 * quantizedHueResolution + 1;
+    boundary.rgbByQuantizedHue.resize(tableSize);
+    for (int i = 0; i < tableSize; ++i) {
+        boundary.rgbByQuantizedHue[i] = closestBoundaryRgb( //
+            boundary,
+            static_cast<double>(i) / quantizedHueResolution);
+    }
+}
+
+/**
+ * @brief Returns the boundary color with the closest hue.
+ *
+ * @param boundary The chromaticity boundary.
+ * @param hue360 hue in the range [0, 360]
+ *
+ * @returns the boundary color with the closest hue. If two colors are
+ * equally close, the one with the lower hue.
+ */
+QRgb ColorSpaceInfo::closestBoundaryRgb(const ChromaticityBoundary &boundary, double hue360)
+{
+    const auto &hues = boundary.hues;
 
     // lower_bound: Returns an iterator pointing to the first element that
     // is not less than (i.e. greater or equal to) key.
-    auto greaterOrEqual = //
-        table.lower_bound(hue360);
+    const auto greaterOrEqual = std::lower_bound(hues.cbegin(), hues.cend(), hue360);
 
-    if (greaterOrEqual == table.begin()) {
+    if (greaterOrEqual == hues.cbegin()) {
         // All available keys are greater than the search key. So the key
-        // at the begin is the closest match:
-        return greaterOrEqual->second; // "second" returns the value of
-                                       // the key-value pair.
-        // NOTE If the map is empty, begin() == end(), so we would get a
-        // crash. Therefore, we have to make sure that the map is initialized
+        // at the begin is the closest match.
+        // NOTE If the list is empty, begin() == end(), so we would get a
+        // crash. Therefore, we have to make sure that the list is initialized
         // in the constructor.
+        return boundary.rgb.constFirst();
     }
 
-    auto lower = --greaterOrEqual; // Move to the lower key
+    const auto lower = greaterOrEqual - 1; // Move to the lower key
+    const auto lowerIndex = std::distance(hues.cbegin(), lower);
 
-    if (greaterOrEqual == table.end()) {
-        // We are at the end of the map. greaterOrEqual is not a valid
-        // key-value pair. Return the value of the previous key-value pair.
-        return lower->second;
+    if (greaterOrEqual == hues.cend()) {
+        // We are at the end of the list. greaterOrEqual is not a valid
+        // element. Return the value of the previous element.
+        return boundary.rgb.at(lowerIndex);
     }
 
     // Compare distances to find the closest key
-    const auto distanceToLower = qAbs(hue360 - lower->first);
-    const auto distanceToHigher = qAbs(hue360 - greaterOrEqual->first);
+    const auto distanceToLower = qAbs(hue360 - *lower);
+    const auto distanceToHigher = qAbs(hue360 - *greaterOrEqual);
     if (distanceToLower <= distanceToHigher) {
-        return lower->second;
+        return boundary.rgb.at(lowerIndex);
     } else {
-        return greaterOrEqual->second;
+        return boundary.rgb.at(lowerIndex + 1);
     }
 }
 
+/**
+ * @brief Returns the most chromatic color for the given hue.
+ *
+ * @param hue360 Oklab hue in the range [0, 360]
+ * @param type The type of Lch color space.
+ *
+ * @returns the most chromatic color for the given hue in the sRGB gamut.
+ *
+ * @sa @ref maxChromaRgbByHue360
+ */
+QColor ColorSpaceInfo::maxChromaColorByHue360(double hue360, PerceptualColor::LchSpace type)
+{
+    const auto &boundary = (type == LchSpace::CielchD50) //
+        ? instance().m_chromaticityBoundaryByCielchD50Hue360 //
+        : instance().m_chromaticityBoundaryByOklabHue360;
+    return QColor(closestBoundaryRgb(boundary, hue360));
+}
+
+/**
+ * @brief Returns the most chromatic color for the given hue.
+ *
+ * Fast variant of @ref maxChromaColorByHue360 for per-pixel use: It does
+ * not search, but reads from a table with uniformly sampled hues
+ * (@ref quantizedHueResolution samples per degree). Therefore, the
+ * result might differ from @ref maxChromaColorByHue360 for hues that lie
+ * close to the middle between two boundary colors.
+ *
+ * @param hue360 hue in the range [0, 360]
+ * @param type The type of Lch color space.
+ *
+ * @returns the most chromatic color for the given hue in the sRGB gamut.
+ */
+QRgb ColorSpaceInfo::maxChromaRgbByHue360(double hue360, PerceptualColor::LchSpace type)
+{
+    const auto &table = (type == LchSpace::CielchD50) //
+        ? instance().m_chromaticityBoundaryByCielchD50Hue360.rgbByQuantizedHue //
+        : instance().m_chromaticityBoundaryByOklabHue360.rgbByQuantizedHue;
+    // Negated comparison to catch also NaN.
+    const double clampedHue = !(hue360 > 0) ? 0 : qMin(hue360, 360.0);
+    const auto index = qRound(clampedHue * quantizedHueResolution);
+    return table.at(index);
+}
+
 /**
  * @brief The darkest in-gamut point on the L* axis.
  *
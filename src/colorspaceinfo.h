@@ -7,9 +7,11 @@
 #include "helpermath.h"
 #include "lchvalues.h"
 #include "perceptualcolornamespace.h"
-#include <map>
 #include <qcolor.h>
 #include <qglobal.h>
+#include <qlist.h>
+#include <qrgb.h>
+#include <utility>
 
 namespace PerceptualColor
 {
@@ -26,6 +28,7 @@ public:
     [[nodiscard]] static double cielabD50WhitepointL();
     [[nodiscard]] static QColor maxChromaColorByCielchD50Hue360(double hue360);
     [[nodiscard]] static QColor maxChromaColorByOklabHue360(double hue360);
+    [[nodiscard]] static QRgb maxChromaRgbByHue360(double hue360, PerceptualColor::LchSpace type);
     [[nodiscard]] static double maxCielchD50Chroma();
     [[nodiscard]] static double maxOklchChroma();
     [[nodiscard]] static double oklabBlackpointL();
@@ -119,39 +122,55 @@ private:
     [[nodiscard]] static QColor maxChromaColorByHue360(double hue360, PerceptualColor::LchSpace type);
 
     /**
-     * @brief All RGB colors located on the chromaticity boundary, ordered by
-     * CielchD50 hue.
-     *
-     * The chromaticity boundary consists of the spectral locus and the purple
-     * line.
-     *
-     * This dataset includes all integer RGB values (i.e., values representable
-     * with three one-byte channels) that lie on the chromaticity boundary.
-     * To ensure smooth cyclic transitions, the dataset includes duplicates
-     * of the lowest and highest hues positioned outside the [0, 360] boundary.
-     * For instance, the lowest original angle of 2° has a duplicate at 362°,
-     * and the highest original angle of 357° has a duplicate at -3°.
+     * @brief Resolution of @ref ChromaticityBoundary::rgbByQuantizedHue
      *
-     * The hue is normalized to the range [0, 360].
+     * Number of samples per degree.
      */
-    std::map<double, QColor> m_chromaticityBoundaryByCielchD50Hue360;
+    static constexpr int quantizedHueResolution = 16;
+
     /**
      * @brief All RGB colors located on the chromaticity boundary, ordered by
-     * Oklab hue.
+     * hue.
      *
      * The chromaticity boundary consists of the spectral locus and the purple
      * line.
-     *
-     * This dataset includes all integer RGB values (i.e., values representable
-     * with three one-byte channels) that lie on the chromaticity boundary.
-     * To ensure smooth cyclic transitions, the dataset includes duplicates
-     * of the lowest and highest hues positioned outside the [0, 360] boundary.
-     * For instance, the lowest original angle of 2° has a duplicate at 362°,
-     * and the highest original angle of 357° has a duplicate at -3°.
-     *
-     * The hue is normalized to the range [0, 360].
      */
-    std::map<double, QColor> m_chromaticityBoundaryByOklabHue360;
+    struct ChromaticityBoundary {
+    public:
+        /**
+         * @brief Hues of the colors in @ref rgb, sorted in ascending order.
+         *
+         * This dataset includes the hues of all integer RGB values (i.e.,
+         * values representable with three one-byte channels) that lie on
+         * the chromaticity boundary. To ensure smooth cyclic transitions,
+         * the dataset includes duplicates of the lowest and highest hues
+         * positioned outside the [0, 360] boundary. For instance, the lowest
+         * original angle of 2° has a duplicate at 362°, and the highest
+         * original angle of 357° has a duplicate at -3°.
+         *
+         * The hue is normalized to the range [0, 360].
+         */
+        QList<double> hues;
+        /** @brief The colors corresponding to @ref hues. */
+        QList<QRgb> rgb;
+        /**
+         * @brief The most chromatic color for uniformly sampled hues.
+         *
+         * Index <em>i</em> corresponds to the hue
+         * <em>i</em> / @ref quantizedHueResolution and contains the
+         * closest match in @ref rgb. The table covers the range [0, 360]
+         * including both limits.
+         */
+        QList<QRgb> rgbByQuantizedHue;
+    };
+
+    [[nodiscard]] static QRgb closestBoundaryRgb(const ChromaticityBoundary &boundary, double hue360);
+    static void initializeChromaticityBoundary(ChromaticityBoundary &boundary, QList<std::pair<double, QRgb>> &colorsByHue);
+
+    /** @brief The chromaticity boundary, ordered by CielchD50 hue. */
+    ChromaticityBoundary m_chromaticityBoundaryByCielchD50Hue360;
+    /** @brief The chromaticity boundary, ordered by Oklab hue. */
+    ChromaticityBoundary m_chromaticityBoundaryByOklabHue360;
 
     /** @brief The darkest in-gamut point on the L* axis.
      *
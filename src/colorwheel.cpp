@@ -21,11 +21,14 @@
 #include <numbers>
 #include <qevent.h>
 #include <qimage.h>
+#include <qline.h>
 #include <qnamespace.h>
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qpen.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qsize.h>
 #include <qwidget.h>
 
 namespace PerceptualColor
@@ -306,7 +309,6 @@ void ColorWheel::keyPressEvent(QKeyEvent *event)
  */
 void ColorWheel::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
     // We do not paint directly on the widget, but on a QImage buffer first:
     // Render anti-aliased looks better. But as Qt documentation says:
     //
@@ -325,13 +327,15 @@ void ColorWheel::paintEvent(QPaintEvent *event)
     //       use the platform independent QImage as paint device; i.e. using
     //       QImage will ensure that the result has an identical pixel
     //       representation on any platform.”
-    QImage paintBuffer(maximumPhysicalSquareSize(), // width
-                       maximumPhysicalSquareSize(), // height
-                       QImage::Format_ARGB32_Premultiplied // format
-    );
-    paintBuffer.fill(Qt::transparent);
-    paintBuffer.setDevicePixelRatio(devicePixelRatioF());
+    //
+    // The buffer is reused between paint events, and only the region of
+    // the paint event is repainted. When only the hue changes, this is
+    // just the region of the old and the new handle.
+    QImage &paintBuffer = reusablePaintBuffer( //
+        QSize(maximumPhysicalSquareSize(), maximumPhysicalSquareSize()),
+        devicePixelRatioF());
     QPainter bufferPainter(&paintBuffer);
+    clearPaintBufferRegion(bufferPainter, event->region());
 
     // Paint the color wheel
     const double wheelCenter = maximumWidgetSquareSize() / 2.;
@@ -354,18 +358,6 @@ void ColorWheel::paintEvent(QPaintEvent *event)
     }
 
     // Paint the handle
-    const qreal wheelOuterRadius = //
-        maximumWidgetSquareSize() / 2.0 - spaceForFocusIndicator();
-    // Get widget coordinates for the handle
-    QPointF myHandleInner = d_pointer->fromWheelToWidgetCoordinates(
-        // Inner point at the wheel:
-        PolarPointF(wheelOuterRadius - gradientThickness(), // x
-                    d_pointer->m_hue // y
-                    ));
-    QPointF myHandleOuter = d_pointer->fromWheelToWidgetCoordinates(
-        // Outer point at the wheel:
-        PolarPointF(wheelOuterRadius, d_pointer->m_hue));
-    // Draw the line
     QPen pen;
     pen.setWidth(handleOutlineThickness());
     pen.setCapStyle(Qt::FlatCap);
@@ -381,7 +373,7 @@ void ColorWheel::paintEvent(QPaintEvent *event)
     pen.setColor(Qt::black);
     bufferPainter.setPen(pen);
     bufferPainter.setRenderHint(QPainter::Antialiasing, true);
-    bufferPainter.drawLine(myHandleInner, myHandleOuter);
+    bufferPainter.drawLine(d_pointer->handleLine());
 
     // Paint a focus indicator if the widget has the focus
     if (hasFocus()) {
@@ -400,7 +392,9 @@ void ColorWheel::paintEvent(QPaintEvent *event)
             center - handleOutlineThickness() / 2.0);
     }
 
-    // Paint the buffer to the actual widget
+    // Paint the buffer to the actual widget. The widget painter is
+    // automatically clipped to the region of the paint event.
+    bufferPainter.end();
     QPainter widgetPainter(this);
     widgetPainter.setRenderHint(QPainter::Antialiasing, false);
     if (isEnabled()) {
@@ -441,9 +435,16 @@ qreal ColorWheel::hue() const
 void ColorWheel::setHue(const qreal newHue)
 {
     if (d_pointer->m_hue != newHue) {
+        const QRect oldHandleRect = lineBoundingRect( //
+            d_pointer->handleLine(),
+            handleOutlineThickness());
         d_pointer->m_hue = newHue;
         Q_EMIT hueChanged(d_pointer->m_hue);
-        update();
+        // The wheel itself has not changed. Schedule a paint event
+        // only for the old and the new handle position:
+        update(oldHandleRect);
+        update(lineBoundingRect(d_pointer->handleLine(), //
+                                handleOutlineThickness()));
     }
 }
 
@@ -457,6 +458,26 @@ void ColorWheelPrivate::setHueNormalized(const qreal newHue)
     q_pointer->setHue(temp);
 }
 
+/** @brief The handle.
+ *
+ * @returns The line of the handle for the current
+ * @ref ColorWheel::hue, measured in widget coordinates. */
+QLineF ColorWheelPrivate::handleLine() const
+{
+    const qreal wheelOuterRadius = //
+        q_pointer->maximumWidgetSquareSize() / 2.0 - q_pointer->spaceForFocusIndicator();
+    // Get widget coordinates for the handle
+    const QPointF myHandleInner = fromWheelToWidgetCoordinates(
+        // Inner point at the wheel:
+        PolarPointF(wheelOuterRadius - q_pointer->gradientThickness(), // x
+                    m_hue // y
+                    ));
+    const QPointF myHandleOuter = fromWheelToWidgetCoordinates(
+        // Outer point at the wheel:
+        PolarPointF(wheelOuterRadius, m_hue));
+    return QLineF(myHandleInner, myHandleOuter);
+}
+
 /** @brief Recommended size for the widget.
  *
  * Reimplemented from base class.
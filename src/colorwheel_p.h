@@ -12,6 +12,7 @@
 #include "perceptualcolornamespace.h"
 #include "polarpointf.h"
 #include <qglobal.h>
+#include <qline.h>
 #include <qpoint.h>
 
 namespace PerceptualColor
@@ -57,6 +58,7 @@ public:
     [[nodiscard]] int border() const;
     [[nodiscard]] QPointF fromWheelToWidgetCoordinates(const PolarPointF wheelCoordinates) const;
     [[nodiscard]] PolarPointF fromWidgetPixelPositionToWheelCoordinates(const QPoint position) const;
+    [[nodiscard]] QLineF handleLine() const;
     [[nodiscard]] qreal innerDiameter() const;
     void setHueNormalized(const qreal newHue);
 
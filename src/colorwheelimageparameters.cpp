@@ -12,6 +12,8 @@
 #include "helpermath.h"
 #include "polarpointf.h"
 #include <qbrush.h>
+#include <qdatastream.h>
+#include <qiodevice.h>
 #include <qmath.h>
 #include <qnamespace.h>
 #include <qpainter.h>
@@ -63,15 +65,25 @@ void ColorWheelImageParameters::renderByRow( //
             const PolarPointF polarCoordinates = //
                 PolarPointF(QPointF(x - center, center - y));
             const auto hue = polarCoordinates.angleDegree();
-            const auto rgbColor = //
-                (parameters.projectionSpace == LchSpace::CielchD50) //
-                ? ColorSpaceInfo::maxChromaColorByCielchD50Hue360(hue)
-                : ColorSpaceInfo::maxChromaColorByOklabHue360(hue);
-            line[x] = rgbColor.rgb();
+            line[x] = ColorSpaceInfo::maxChromaRgbByHue360(hue, parameters.projectionSpace);
         }
     }
 }
 
+/** @brief Key for @ref AsyncImageDiskCache.
+ *
+ * @returns A key that contains all data members. */
+QByteArray ColorWheelImageParameters::diskCacheKey() const
+{
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << QByteArrayLiteral("ColorWheelImageParameters") //
+           << imageSizePhysical //
+           << static_cast<qint32>(projectionSpace);
+    return result;
+}
+
 /** @brief Render an image.
  *
  * The function will render the image with the given parameters,
@@ -6,6 +6,7 @@
 
 #include "asyncimageprovider.h"
 #include "perceptualcolornamespace.h"
+#include <qbytearray.h>
 #include <qglobal.h>
 #include <qimage.h>
 
@@ -63,6 +64,8 @@ public:
      */
     [[nodiscard]] bool operator!=(const ColorWheelImageParameters &other) const = default; // clazy:exclude=function-args-by-value
 
+    [[nodiscard]] QByteArray diskCacheKey() const;
+
     /**
      * @brief The image size (actual width and height measured in pixel).
      */
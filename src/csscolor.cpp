@@ -709,7 +709,8 @@ std::optional<QRgb> CssColor::parseNamedColor(const QString &namedColor)
  *
  * This function is meant for exporting colors to CSS code.
  *
- * @param input A hash table with color values.
+ * @param input The color. Values in the various color models are
+ * calculated on demand.
  * @param opacity1 The opacity of the color in the range [0, 1].
  * @param significantFigures The requested number of significant figures.
  *
@@ -728,7 +729,7 @@ std::optional<QRgb> CssColor::parseNamedColor(const QString &namedColor)
  * or fully transparent. Fully opaque colors do not need to specify the
  * alpha value in CSS explicitly, because CSS defaults to “fully opaque” if
  * no alpha value is given. */
-QStringList CssColor::generateCss(const QHash<ColorModel, GenericColor> &input, const double opacity1, const int significantFigures)
+QStringList CssColor::generateCss(const MultiModelColor &input, const double opacity1, const int significantFigures)
 {
     QStringList result;
 
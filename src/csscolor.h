@@ -6,10 +6,10 @@
 
 #include "genericcolor.h"
 #include "internalimportexport.h"
+#include "multimodelcolor.h"
 #include "perceptualcolornamespace.h"
 #include <optional>
 #include <qcontainerfwd.h>
-#include <qhash.h>
 #include <qrgb.h>
 #include <qstring.h>
 #include <qtmetamacros.h>
@@ -73,7 +73,7 @@ public:
     };
 
     [[nodiscard]] static CssColorValue parse(const QString &string);
-    [[nodiscard]] static QStringList generateCss(const QHash<ColorModel, GenericColor> &input, const double opacity1, const int significantFigures);
+    [[nodiscard]] static QStringList generateCss(const MultiModelColor &input, const double opacity1, const int significantFigures);
 
 private:
     /** @brief Syntaxes of the CSS Color 4 color functions. */
@@ -17,9 +17,13 @@
 #include <qevent.h>
 #include <qguiapplication.h>
 #include <qimage.h>
+#include <qline.h>
 #include <qpainter.h>
 #include <qpen.h>
 #include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
+#include <qsize.h>
 #include <qsizepolicy.h>
 #include <qtransform.h>
 #include <qwidget.h>
@@ -110,6 +114,8 @@ void GradientSliderPrivate::initialize(Qt::Orientation orientation)
     constexpr GenericColor first{75, 65, 90};
     constexpr GenericColor second{50, 75, 45};
     q_pointer->setColors(first, 1, second, 1);
+    m_gradientImage.setRenderCacheCapacity(renderCacheCapacity);
+    m_gradientImage.setRenderCacheMinimumEntryCount(renderCacheMinimumEntryCount);
 
     // Connections
     q_pointer->connect( //
@@ -296,8 +302,12 @@ void GradientSlider::setValue(qreal newValue)
 {
     qreal temp = qBound<qreal>(0, newValue, 1);
     if (d_pointer->m_value != temp) {
+        const QRect oldHandleRect = d_pointer->handleWidgetRect();
         d_pointer->m_value = temp;
-        update();
+        // The gradient itself has not changed. Schedule a paint event
+        // only for the old and the new handle position:
+        update(oldHandleRect);
+        update(d_pointer->handleWidgetRect());
         Q_EMIT valueChanged(temp);
     }
 }
@@ -552,7 +562,6 @@ qreal GradientSliderPrivate::fromWidgetPixelPositionToValue(QPoint pixelPosition
  * @param event the paint event */
 void GradientSlider::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event)
     // We do not paint directly on the widget, but on a QImage buffer first:
     // Render anti-aliased looks better. But as Qt documentation says:
     //
@@ -571,7 +580,10 @@ void GradientSlider::paintEvent(QPaintEvent *event)
     //       use the platform independent QImage as paint device; i.e. using
     //       QImage will ensure that the result has an identical pixel
     //       representation on any platform.”
-    QImage paintBuffer;
+    //
+    // The buffer is reused between paint events, and only the region of
+    // the paint event is repainted. When only the value changes, this is
+    // just the region of the old and the new handle.
 
     // Render the gradient itself.
 
@@ -598,13 +610,21 @@ void GradientSlider::paintEvent(QPaintEvent *event)
     // Always refresh the image, as other parameters (e.g., colors) may have
     // changed without triggering a recomputation.
     d_pointer->m_gradientImage.refreshAsync();
-    paintBuffer = d_pointer->m_gradientImage.getCache();
-    if (paintBuffer.isNull()) {
+    const QImage gradient = d_pointer->m_gradientImage.getCache();
+    if (gradient.isNull()) {
         return;
     }
+    // Copy the gradient into the buffer instead of painting directly on a
+    // shallow copy of the cache, which would trigger a deep copy of the
+    // whole image on every paint event.
+    QImage &paintBuffer = reusablePaintBuffer(gradient.size(), devicePixelRatioF());
+    QPainter bufferPainter(&paintBuffer);
+    const QTransform transform = d_pointer->toWidgetTransform();
+    clearPaintBufferRegion(bufferPainter, //
+                           transform.inverted().map(event->region()));
+    bufferPainter.drawImage(QPoint(0, 0), gradient);
 
     // Draw slider handle
-    QPainter bufferPainter(&paintBuffer);
     // We use antialiasing. As our current handle is just a horizontal or
     // vertical line, it might be slightly sharper without antialiasing.
     // But all other widgets of this library WILL USE antialiasing because
@@ -617,9 +637,7 @@ void GradientSlider::paintEvent(QPaintEvent *event)
     // additionally the position is more exact!
     bufferPainter.setRenderHint(QPainter::Antialiasing, true);
     QPen pen;
-    const qreal handleCoordinatePoint = d_pointer->physicalPixelLength() //
-        / devicePixelRatioF() //
-        * d_pointer->m_value;
+    const qreal handleCoordinatePoint = d_pointer->handleCoordinatePoint();
     if (hasFocus()) {
         pen.setWidthF(handleOutlineThickness() * 3);
         pen.setColor(focusIndicatorColor());
@@ -640,42 +658,83 @@ void GradientSlider::paintEvent(QPaintEvent *event)
     bufferPainter.drawLine(QPointF(handleCoordinatePoint, 0), //
                            QPointF(handleCoordinatePoint, gradientThickness()));
 
-    // Paint the buffer to the actual widget
+    // Paint the buffer to the actual widget. The widget painter is
+    // automatically clipped to the region of the paint event.
+    bufferPainter.end();
+    QPainter widgetPainter(this);
+    widgetPainter.setTransform(transform);
+    if (isEnabled()) {
+        widgetPainter.drawImage(QPoint(0, 0), paintBuffer);
+    } else {
+        widgetPainter.drawPixmap( //
+            QPoint(0, 0), //
+            disabledAppearance(QPixmap::fromImage(paintBuffer)));
+    }
+}
+
+/** @brief Transformation from the default form to widget coordinates.
+ *
+ * The @ref m_gradientImage contains the gradient always
+ * in a default form, independent of the actual orientation
+ * of this widget and independent of its actual layout direction:
+ * In the default form, the first color is always on the left, and the
+ * second color is always on the right. To paint it, we have to
+ * rotate it if our actual orientation is vertical. And we have to
+ * mirror it when our actual layout direction is RTL.
+ *
+ * @returns The transformation from coordinates of the default form to
+ * widget coordinates, both measured in
+ * <em>device-independent pixels</em>. */
+QTransform GradientSliderPrivate::toWidgetTransform() const
+{
     QTransform transform;
-    // The m_gradientImageProvider contains the gradient always
-    // in a default form, independent of the actual orientation
-    // of this widget and independent of its actual layout direction:
-    // In the default form, the first color is always on the left, and the
-    // second color is always on the right. To paint it, we have to
-    // rotate it if our actual orientation is vertical. And we have to
-    // mirror it when our actual layout direction is RTL.
-    if (d_pointer->m_orientation == Qt::Orientation::Vertical) {
-        if (layoutDirection() == Qt::LayoutDirection::RightToLeft) {
+    const QSize widgetSize = q_pointer->size();
+    if (m_orientation == Qt::Orientation::Vertical) {
+        if (q_pointer->layoutDirection() == Qt::LayoutDirection::RightToLeft) {
             // Even on vertical gradients, we mirror the image, so that
             // the well-aligned edge of the transparency background is
             // always aligned according to the writing direction.
             transform.scale(-1, 1);
             transform.rotate(270);
-            transform.translate(size().height() * (-1), size().width() * (-1));
+            transform.translate(widgetSize.height() * (-1), widgetSize.width() * (-1));
         } else {
             transform.rotate(270);
-            transform.translate(size().height() * (-1), 0);
+            transform.translate(widgetSize.height() * (-1), 0);
         }
     } else {
-        if (layoutDirection() == Qt::LayoutDirection::RightToLeft) {
+        if (q_pointer->layoutDirection() == Qt::LayoutDirection::RightToLeft) {
             transform.scale(-1, 1);
-            transform.translate(size().width() * (-1), 0);
+            transform.translate(widgetSize.width() * (-1), 0);
         }
     }
-    QPainter widgetPainter(this);
-    widgetPainter.setTransform(transform);
-    if (isEnabled()) {
-        widgetPainter.drawImage(QPoint(0, 0), paintBuffer);
-    } else {
-        widgetPainter.drawPixmap( //
-            QPoint(0, 0), //
-            disabledAppearance(QPixmap::fromImage(paintBuffer)));
-    }
+    return transform;
+}
+
+/** @brief Position of the handle.
+ *
+ * @returns The position of the handle along the gradient in the default
+ * form (see @ref toWidgetTransform()), measured in
+ * <em>device-independent pixels</em>. */
+qreal GradientSliderPrivate::handleCoordinatePoint() const
+{
+    return physicalPixelLength() / q_pointer->devicePixelRatioF() * m_value;
+}
+
+/** @brief The region that is covered by the handle.
+ *
+ * @returns The rectangle that is covered by the handle (including a
+ * possible focus indicator) for the current @ref GradientSlider::value,
+ * measured in widget coordinates. */
+QRect GradientSliderPrivate::handleWidgetRect() const
+{
+    const qreal position = handleCoordinatePoint();
+    const QLineF handleLine(QPointF(position, 0), //
+                            QPointF(position, q_pointer->gradientThickness()));
+    // The focus indicator is the widest line that is painted.
+    const QRect defaultFormRect = q_pointer->lineBoundingRect( //
+        handleLine,
+        q_pointer->handleOutlineThickness() * 3);
+    return toWidgetTransform().mapRect(defaultFormRect);
 }
 
 } // namespace PerceptualColor
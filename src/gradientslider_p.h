@@ -14,6 +14,8 @@
 #include "perceptualcolornamespace.h"
 #include <qglobal.h>
 #include <qnamespace.h>
+#include <qrect.h>
+#include <qtransform.h>
 class QPoint;
 
 namespace PerceptualColor
@@ -32,10 +34,13 @@ public:
 
     // Methods
     [[nodiscard]] qreal fromWidgetPixelPositionToValue(QPoint pixelPosition);
+    [[nodiscard]] QRect handleWidgetRect() const;
+    [[nodiscard]] qreal handleCoordinatePoint() const;
     void initialize(Qt::Orientation orientation);
     void setOrientationWithoutSignalAndForceNewSizePolicy(Qt::Orientation newOrientation);
     [[nodiscard]] int physicalPixelLength() const;
     [[nodiscard]] int physicalPixelThickness() const;
+    [[nodiscard]] QTransform toWidgetTransform() const;
 
     // Data members
 
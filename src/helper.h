@@ -22,6 +22,7 @@
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qpair.h>
+#include <qrgba64.h>
 #include <qstring.h>
 #include <qstringliteral.h>
 #include <qthread.h>
@@ -255,6 +256,16 @@ private:
  * this type, once you have a QApplication object. */
 using QColorArray2D = Array2D<QColor>;
 
+/**
+ * @internal
+ *
+ * @brief Swatches organized in a grid, as packed values.
+ *
+ * Other than @ref QColorArray2D, this needs no <tt>QColor</tt> objects.
+ * An empty swatch is represented by a fully transparent value (all
+ * bits 0). */
+using QRgba64Array2D = Array2D<QRgba64>;
+
 QColor toOpaque(const QColor &color);
 
 QColorArray2D toOpaque(const QColorArray2D &array);
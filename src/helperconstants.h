@@ -113,6 +113,48 @@ inline constexpr int singleStepHue = 360 / 100;
  */
 inline constexpr quint8 pageStepFactor = 10;
 
+/** @internal
+ *
+ * @brief Capacity of the render cache of interactive widgets.
+ *
+ * Measured in bytes.
+ *
+ * Users often go back and forth over the same values, for example when
+ * dragging the lightness slider. The render cache of the
+ * @ref AsyncImageProvider makes these revisits instantaneous. The value
+ * is a compromise between the number of cached images and the memory
+ * usage: A @ref ColorDialog has several of these widgets.
+ *
+ * This is only a lower limit. On large or high-DPI screens, a single
+ * image might be larger than this value. Therefore, the capacity grows
+ * with the image size, see @ref renderCacheMinimumEntryCount.
+ *
+ * @sa @ref AsyncImageProvider::setRenderCacheCapacity() */
+inline constexpr qsizetype renderCacheCapacity = 16 * 1024 * 1024;
+
+/** @internal
+ *
+ * @brief Minimum number of images that the render cache of interactive
+ * widgets can hold, regardless of their size.
+ *
+ * Room for the current image, the images of the prefetched neighbouring
+ * slices, and the previous image.
+ *
+ * @sa @ref renderCacheCapacity
+ * @sa @ref prefetchSliceCount
+ * @sa @ref AsyncImageProvider::setRenderCacheMinimumEntryCount() */
+inline constexpr qsizetype renderCacheMinimumEntryCount = 4;
+
+/** @internal
+ *
+ * @brief Number of neighbouring slices that interactive widgets prefetch.
+ *
+ * When the user changes the lightness or the hue, the widgets
+ * prefetch this number of slices in the direction of the change.
+ *
+ * @sa @ref AsyncImageProvider::prefetchAsync() */
+inline constexpr int prefetchSliceCount = 2;
+
 /** @internal
  *
  * @brief Invisible marker for rich text
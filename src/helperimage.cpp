@@ -5,6 +5,7 @@
 #include "helperimage.h"
 
 #include "helper.h"
+#include <algorithm>
 #include <qcolor.h>
 #include <qimage.h>
 #include <qpoint.h>
@@ -18,163 +19,239 @@
 namespace PerceptualColor
 {
 
+/**
+ * @internal
+ *
+ * @brief Helper function for @ref findBoundaryMask().
+ *
+ * Not available outside this translation unit.
+ *
+ * @param image The image to be searched. Must have a 32-bit format with
+ *        alpha channel.
+ * @param maskPtr Pointer to the mask data, as in @ref BoundaryMask::mask.
+ * @param firstRow Index of the first row to process. Must be a valid index.
+ * @param lastRow Index of the last row to process. Must be a valid index.
+ *
+ * @note This function writes only the rows of the mask that it processes.
+ * Therefore, it is thread-safe as long as the row ranges do not overlap.
+ */
+static void findBoundaryHelper(const QImage &image, quint8 *const maskPtr, const int firstRow, const int lastRow)
+{
+    const int width = image.width();
+    const int height = image.height();
+    for (int y = firstRow; y <= lastRow; ++y) {
+        // The neighbor rows are nullptr when they are out of range.
+        const QRgb *const previousLine = (y > 0) //
+            ? reinterpret_cast<const QRgb *>(image.constScanLine(y - 1))
+            : nullptr;
+        const QRgb *const line = //
+            reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        const QRgb *const nextLine = (y < height - 1) //
+            ? reinterpret_cast<const QRgb *>(image.constScanLine(y + 1))
+            : nullptr;
+        quint8 *const maskLine = maskPtr + static_cast<qsizetype>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            // A pixel is on the boundary if at least one of its 8 neighbors
+            // is on the other side: a gamut body pixel with a neighboring
+            // background pixel, or a background pixel with a neighboring
+            // gamut body pixel.
+            // NOTE: The background color may occasionally appear within
+            // the gamut body, but such instances are rare and therefore
+            // not computationally expensive to handle. In these cases,
+            // anti-aliasing has no effect, making it inconsequential to
+            // the final image.
+            const bool isOpaque = qAlpha(line[x]) != 0;
+            const int xFirst = qMax(x - 1, 0);
+            const int xLast = qMin(x + 1, width - 1);
+            bool isBoundary = false;
+            for (const QRgb *const neighborLine : {previousLine, line, nextLine}) {
+                if (neighborLine == nullptr) {
+                    continue; // Out of range
+                }
+                for (int neighborX = xFirst; neighborX <= xLast; ++neighborX) {
+                    // The pixel itself never differs from itself, so there
+                    // is no need to skip it.
+                    if ((qAlpha(neighborLine[neighborX]) != 0) != isOpaque) {
+                        isBoundary = true;
+                        break;
+                    }
+                }
+                if (isBoundary) {
+                    break;
+                }
+            }
+            maskLine[x] = isBoundary ? 1 : 0;
+        }
+    }
+}
+
 /**
  * @internal
  *
  * @brief Find boundaries between fully opaque and fully transparent pixels.
  *
+ * Reads the alpha channel directly from the scan lines and works in
+ * linear time. The rows are processed in parallel by means of
+ * @ref getLibraryQThreadPoolInstance().
+ *
  * @param image The image to be searched.
  *
  * @note There is no API guarantee regarding the handling of partially
- * transparent pixels — they may be treated as fully opaque or
+ * transparent pixels — they may be treated as fully opaque or
  * fully transparent.
  *
- * @returns A list of all coordinate points on both sides of the boundary.
+ * @returns A mask of all pixels on both sides of the boundary.
  *
  * @note This function is thread-safe as long as there is no more than one
  * thread of this function operating on the same data on the same time.
+ *
+ * @sa @ref findBoundary()
+ */
+BoundaryMask findBoundaryMask(const QImage &image)
+{
+    BoundaryMask result;
+    if (image.isNull()) {
+        return result;
+    }
+    result.width = image.width();
+    result.height = image.height();
+    result.mask.resize(static_cast<qsizetype>(result.width) * result.height);
+
+    // Make sure we can read the alpha channel directly from 32-bit data.
+    const bool hasSuitableFormat = //
+        (image.format() == QImage::Format_ARGB32_Premultiplied) //
+        || (image.format() == QImage::Format_ARGB32);
+    const QImage convertedImage = hasSuitableFormat //
+        ? image //
+        : image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    // Detach before the threads start, so they all write to the same data.
+    quint8 *const maskPtr = result.mask.data();
+    auto &poolReference = getLibraryQThreadPoolInstance();
+    const int threadCount = qMax(1, poolReference.maxThreadCount());
+    const auto segments = splitElements(result.height, threadCount);
+    // The narrowing static_cast<int>() is okay because segments.size() is a
+    // result of threadCount, which is also int.
+    static_assert( //
+        std::is_same_v<std::remove_cv_t<decltype(threadCount)>, int>);
+    const int segmentsCount = static_cast<int>(segments.size());
+    QSemaphore semaphore(0);
+    for (const auto &segment : segments) {
+        const auto myLambda = [&convertedImage, maskPtr, segment, &semaphore]() {
+            findBoundaryHelper(convertedImage, maskPtr, segment.first, segment.second);
+            semaphore.release();
+        };
+        const auto myRunnablePtr = QRunnable::create(myLambda);
+        poolReference.start(myRunnablePtr, imageThreadPriority);
+    }
+    // Intentionally acquiring segments.size() and not treadCount, because
+    // they might differ and segments.size() is mandatory for thread
+    // execution.
+    semaphore.acquire(segmentsCount); // Wait for all threads to finish.
+    return result;
+}
+
+/**
+ * @internal
+ *
+ * @brief Find boundaries between fully opaque and fully transparent pixels.
+ *
+ * @param image The image to be searched.
+ *
+ * @note There is no API guarantee regarding the handling of partially
+ * transparent pixels — they may be treated as fully opaque or
+ * fully transparent.
+ *
+ * @returns A list of all coordinate points on both sides of the boundary,
+ * in row order.
+ *
+ * @note This function is thread-safe as long as there is no more than one
+ * thread of this function operating on the same data on the same time.
+ *
+ * @sa @ref findBoundaryMask() avoids building a list.
  */
 QList<QPoint> findBoundary(const QImage &image)
 {
-    QList<QPoint> coordinates;
-    int width = image.width();
-    int height = image.height();
+    return findBoundaryMask(image).coordinates();
+}
+
+/**
+ * @brief The coordinates of all boundary pixels.
+ *
+ * @returns The coordinates of all boundary pixels, in row order.
+ */
+QList<QPoint> BoundaryMask::coordinates() const
+{
+    QList<QPoint> result;
+    result.reserve(count());
     for (int y = 0; y < height; ++y) {
+        const quint8 *const maskLine = //
+            mask.constData() + static_cast<qsizetype>(y) * width;
         for (int x = 0; x < width; ++x) {
-            if (image.pixelColor(x, y).alpha() != 0) { // gamut body
-                // We process only the pixels of the gamut body. A gamut body
-                // pixel is added if at least one of its neighbors is a
-                // background pixel, along with all neighboring background
-                // pixels. This eliminates the need for a second pass to test
-                // background pixels.
-                // NOTE: The background color may occasionally appear within
-                // the gamut body, but such instances are rare and therefore
-                // not computationally expensive to handle. In these cases,
-                // anti-aliasing has no effect, making it inconsequential to
-                // the final image.
-                bool hasTransparentNeighbor = false;
-                // Check 8 neighbors
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        if (dx == 0 && dy == 0) {
-                            continue; // Skip the pixel itself
-                        }
-                        const auto xOutOfRange = //
-                            ((x + dx < 0) || (x + dx >= image.width()));
-                        const auto yOutOfRange = //
-                            ((y + dy < 0) || (y + dy >= image.height()));
-                        if (xOutOfRange || yOutOfRange) {
-                            // Out of range
-                            continue;
-                        }
-                        const auto myPixelColor = //
-                            image.pixelColor(x + dx, y + dy);
-                        if (myPixelColor.alpha() == 0) {
-                            hasTransparentNeighbor = true;
-                            const QPoint myNeighbor = QPoint(x + dx, y + dy);
-                            if (!coordinates.contains(myNeighbor)) {
-                                // Add transparent pixel
-                                coordinates.append(myNeighbor);
-                            }
-                        }
-                    }
-                }
-                if (hasTransparentNeighbor) {
-                    const auto gamutPixel = QPoint(x, y);
-                    if (!coordinates.contains(gamutPixel)) {
-                        // Add the gamut body pixel itself
-                        coordinates.append(gamutPixel);
-                    }
-                }
+            if (maskLine[x] != 0) {
+                result.append(QPoint(x, y));
             }
         }
     }
-    return coordinates;
+    return result;
 }
 
+/**
+ * @brief The number of boundary pixels.
+ *
+ * @returns The number of boundary pixels.
+ */
+qsizetype BoundaryMask::count() const
+{
+    return std::count_if(mask.cbegin(), mask.cend(), [](const quint8 value) {
+        return value != 0;
+    });
+}
+
+/**
+ * @brief Whether a pixel is a boundary pixel.
+ *
+ * @param x The x coordinate of the pixel.
+ * @param y The y coordinate of the pixel.
+ *
+ * @returns <tt>true</tt> if the pixel is a boundary pixel. <tt>false</tt>
+ * otherwise, and also if the coordinates are out of range.
+ */
+bool BoundaryMask::isBoundary(const int x, const int y) const
+{
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return false;
+    }
+    return mask.at(static_cast<qsizetype>(y) * width + x) != 0;
+}
+
+
 /**
  * @internal
  *
- * @brief Helper function for @ref doAntialias().
+ * @brief Calculates anti-alias for gamut diagrams.
  *
- * Not available outside this translation unit.
+ * Overload for <tt>std::function</tt>. Prefer the template overload
+ * @ref doAntialias(QImage &, const QList<QPoint> &, const ColorFunctor &, const AntialiasMode),
+ * which can inline the color function.
  *
- * @param bytesPtr A reference to the bytes of the image provides as
- *        QImage::Format_ARGB32_Premultiplied
- * @param bytesPerLine The number of bytes in a single row of pixels in the
- *        image.
+ * @param image A reference to he image that should be modified.
  * @param antiAliasCoordinates A list of pixels for which anti-aliasing should
  *        be done.
  * @param colorFunction A pointer to a function that returns the opaque color
  *        for the given coordinates, or a transparent color if out-of-gamut.
+ * @param mode The sampling strategy.
  */
-static void doAntialiasHelper(uchar *const bytesPtr,
-                              const qsizetype bytesPerLine,
-                              const QList<QPoint> &antiAliasCoordinates,
-                              const std::function<QRgb(const double x, const double y)> &colorFunction)
+void doAntialias(QImage &image,
+                 const QList<QPoint> &antiAliasCoordinates,
+                 const std::function<QRgb(const double x, const double y)> &colorFunction,
+                 const AntialiasMode mode)
 {
-    QList<QColor> opaqueColors;
-    for (const QPoint point : antiAliasCoordinates) {
-        // Iterating over a square grid of data points within the given pixel.
-        // The side length of the square contains exactly “sideLength” data
-        // points. Its square represents the total number of data points,
-        // referred to here as “totalDataPoints”. The“ sideLength” is chosen so
-        // that the total number of data points is 256, corresponding to the
-        // number of possible alpha values in typical 4-byte colors
-        // (RGB+Alpha), which is sufficient for this case."
-        constexpr int sideLength = 16;
-        constexpr int totalDataPoints = sideLength * sideLength;
-        opaqueColors.clear();
-        opaqueColors.reserve(totalDataPoints);
-        constexpr double stepWidth = 1.0 / sideLength;
-        {
-            const double x = point.x() - 0.5 + stepWidth / 2;
-            const double y = point.y() - 0.5 + stepWidth / 2;
-            for (int i = 0; i < sideLength; ++i) {
-                for (int j = 0; j < sideLength; ++j) {
-                    const QRgb tempColor = colorFunction(x + i * stepWidth, //
-                                                         y + j * stepWidth);
-                    if (qAlpha(tempColor) != 0) {
-                        opaqueColors.append(tempColor);
-                    }
-                }
-            }
-        }
-        if (opaqueColors.size() > 0) {
-            const float countF = //
-                static_cast<float>(opaqueColors.size());
-            QRgb &pixelRef = *( //
-                reinterpret_cast<QRgb *>(bytesPtr + point.y() * bytesPerLine) //
-                + point.x());
-            QRgb opaqueColor = pixelRef;
-            if (qAlpha(opaqueColor) == 0) {
-                // If the pixel is transparent, the center of the pixel is
-                // out-of-gamut, and no actual color is available. For
-                // anti-aliasing, we need an actual color, so we calculate the
-                // mean color of all other data points within the pixel that
-                // actually are in-gamut.
-                float r = 0;
-                float g = 0;
-                float b = 0;
-                for (const QColor &myColor : opaqueColors) {
-                    r += myColor.redF();
-                    g += myColor.greenF();
-                    b += myColor.blueF();
-                }
-                r /= countF;
-                g /= countF;
-                b /= countF;
-                opaqueColor = qRgb(qRound(r * 255), //
-                                   qRound(g * 255), //
-                                   qRound(b * 255));
-            }
-            pixelRef = qPremultiply( //
-                qRgba(qRed(opaqueColor), //
-                      qGreen(opaqueColor), //
-                      qBlue(opaqueColor), //
-                      qRound(countF / totalDataPoints * 255)));
-        }
-    }
+    doAntialias<std::function<QRgb(const double x, const double y)>>( //
+        image,
+        antiAliasCoordinates,
+        colorFunction,
+        mode);
 }
 
 /**
@@ -182,59 +259,26 @@ static void doAntialiasHelper(uchar *const bytesPtr,
  *
  * @brief Calculates anti-alias for gamut diagrams.
  *
- * Gamut images generated by this library typically exhibit sharp boundaries,
- * where a pixel is either within the gamut (opaque color) or outside it
- * (transparent color). The determination is based on the coordinates at the
- * center of the pixel's square surface.
- *
- * This function is designed to perform anti-aliasing by smoothing the sharp
- * gamut boundaries. To use this function, first obtain a list of candidate
- * pixels for anti-aliasing. These are the pixels surrounding the sharp gamut
- * border, which can be identified using @ref findBoundary(). This function
- * then calculates, within the 1 px × 1 px area of each candidate pixel,
- * multiple data points at a significantly higher resolution than the single
- * data point in the original image. By analyzing this detailed data, the
- * function applies anti-aliasing to smooth the boundary.
- *
- * @note Since this operation is computationally intensive, it is recommended
- * to apply it only to the pixels returned by @ref findBoundary(), rather than
- * the entire image.
+ * Overload for <tt>std::function</tt>. Prefer the template overload
+ * @ref doAntialias(QImage &, const BoundaryMask &, const ColorFunctor &, const AntialiasMode),
+ * which can inline the color function.
  *
  * @param image A reference to he image that should be modified.
- *        Only <tt>QImage::Format_ARGB32_Premultiplied</tt> is supported.
- * @param antiAliasCoordinates A list of pixels for which anti-aliasing should
- *        be done.
+ * @param boundary The pixels for which anti-aliasing should be done.
  * @param colorFunction A pointer to a function that returns the opaque color
  *        for the given coordinates, or a transparent color if out-of-gamut.
+ * @param mode The sampling strategy.
  */
-void doAntialias(QImage &image, const QList<QPoint> &antiAliasCoordinates, const std::function<QRgb(const double x, const double y)> &colorFunction)
+void doAntialias(QImage &image,
+                 const BoundaryMask &boundary,
+                 const std::function<QRgb(const double x, const double y)> &colorFunction,
+                 const AntialiasMode mode)
 {
-    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
-        return;
-    }
-    uchar *const bytesPtr = image.bits();
-    const qsizetype bytesPerLine = image.bytesPerLine();
-    auto &poolReference = getLibraryQThreadPoolInstance();
-    const int threadCount = qMax(1, poolReference.maxThreadCount());
-    const auto parts = splitList(antiAliasCoordinates, threadCount);
-    // The narrowing static_cast<int>() is okay because parts.size() is a
-    // result of threadCount, which is also int.
-    static_assert( //
-        std::is_same_v<std::remove_cv_t<decltype(threadCount)>, int>);
-    const int partsCount = static_cast<int>(parts.size());
-    QSemaphore semaphore(0);
-    for (const auto &part : parts) {
-        const auto myLambda = [bytesPtr, bytesPerLine, part, colorFunction, &semaphore]() {
-            doAntialiasHelper(bytesPtr, bytesPerLine, part, colorFunction);
-            semaphore.release();
-        };
-        const auto myRunnablePtr = QRunnable::create(myLambda);
-        poolReference.start(myRunnablePtr, imageThreadPriority);
-    }
-    // Intentionally acquiring parts.size() and not treadCount, because
-    // they might differ and parts.size() is mandatory for thread
-    // execution.
-    semaphore.acquire(partsCount); // Wait for all threads to finish.
+    doAntialias<std::function<QRgb(const double x, const double y)>>( //
+        image,
+        boundary,
+        colorFunction,
+        mode);
 }
 
 /**
@@ -4,15 +4,24 @@
 #ifndef PERCEPTUALCOLOR_HELPERIMAGE_H
 #define PERCEPTUALCOLOR_HELPERIMAGE_H
 
+#include "helper.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <functional>
+#include <optional>
 #include <qglobal.h>
+#include <qimage.h>
 #include <qlist.h>
+#include <qpoint.h>
+#include <qrect.h>
 #include <qrgb.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
 #include <qthread.h>
-class QImage;
-class QPoint;
-class QRect;
-class QThreadPool;
+#include <qthreadpool.h>
+#include <type_traits>
+#include <utility>
 
 /** @internal
  *
@@ -23,15 +32,74 @@ class QThreadPool;
 namespace PerceptualColor
 {
 
+/**
+ * @internal
+ *
+ * @brief Pixels on both sides of the boundary between fully opaque and
+ * fully transparent pixels.
+ *
+ * Result of @ref findBoundaryMask(). One byte per pixel, in row-major order.
+ * A value other than 0 marks a boundary pixel.
+ */
+struct BoundaryMask {
+public:
+    /** @brief Width of the image, measured in pixels. */
+    int width = 0;
+    /** @brief Height of the image, measured in pixels. */
+    int height = 0;
+    /** @brief The mask data, with <tt>width × height</tt> elements in
+     * row-major order. */
+    QList<quint8> mask;
+    [[nodiscard]] QList<QPoint> coordinates() const;
+    [[nodiscard]] qsizetype count() const;
+    [[nodiscard]] bool isBoundary(const int x, const int y) const;
+};
+
+/**
+ * @internal
+ *
+ * @brief Sampling strategies for @ref doAntialias().
+ */
+enum class AntialiasMode {
+    Uniform, /**< Evaluates a uniform grid of 16 × 16 data points
+        for each pixel. */
+    Adaptive /**< Divides each pixel into 4 × 4 cells and evaluates first
+        only the corners of the cells. Where the corners are consistent
+        with a single, locally straight boundary, this boundary is located
+        by bisection (where it crosses the perimeter of the pixel, and
+        where it deviates most from the straight line), approximated by a
+        parabola, and the coverage is calculated analytically from it: The
+        data points of @ref Uniform are classified by their side of the
+        boundary, without evaluating them. Otherwise, only cells whose corners disagree about being
+        in-gamut or out-of-gamut are refined to the resolution of
+        @ref Uniform. Where the boundary is locally straight, the alpha
+        value is identical to @ref Uniform (except for data points that are
+        closer than 1/256 pixel to the boundary), but far fewer data points
+        are needed.
+        @note A feature that is thinner than a cell (a quarter pixel) and
+        does not contain any corner, like a thin sliver or a sharp tip, is
+        missed entirely, while @ref Uniform might still catch it. For the
+        smooth gamut boundaries in this library, this is not visible, but
+        use @ref Uniform if the color function might have such features. */
+};
+
 QColor disabledAppearance(const QColor normalColor);
 
 QPixmap disabledAppearance(const QPixmap &normalPixmap);
 
-void doAntialias(QImage &image, const QList<QPoint> &antiAliasCoordinates, const std::function<QRgb(const double x, const double y)> &colorFunction);
+void doAntialias(QImage &image,
+                 const QList<QPoint> &antiAliasCoordinates,
+                 const std::function<QRgb(const double x, const double y)> &colorFunction,
+                 const AntialiasMode mode = AntialiasMode::Adaptive);
+void doAntialias(QImage &image,
+                 const BoundaryMask &boundary,
+                 const std::function<QRgb(const double x, const double y)> &colorFunction,
+                 const AntialiasMode mode = AntialiasMode::Adaptive);
 
 void fillRect(uchar *const bytesPtr, const qsizetype bytesPerLine, const QRect rectangle, const QRgb color);
 
 [[nodiscard]] QList<QPoint> findBoundary(const QImage &image);
+[[nodiscard]] BoundaryMask findBoundaryMask(const QImage &image);
 
 QThreadPool &getLibraryQThreadPoolInstance();
 
@@ -50,6 +118,536 @@ inline constexpr QThread::Priority imageThreadPriority = QThread::Priority::LowP
  */
 inline constexpr QRgb qRgbTransparent = 0;
 
+/**
+ * @internal
+ *
+ * @brief Analytic coverage of a pixel that is crossed by a locally
+ * straight boundary.
+ *
+ * Helper function for @ref antialiasPixel().
+ *
+ * @param corners The data points at the corners of the 4 × 4 cells of the
+ *        pixel. Index: <tt>[x][y]</tt>.
+ * @param cornerX The x coordinate of <tt>corners[0][0]</tt>.
+ * @param cornerY The y coordinate of <tt>corners[0][0]</tt>.
+ * @param colorFunction A functor that returns the opaque color for the
+ *        given coordinates, or a transparent color if out-of-gamut.
+ *
+ * @returns If the corners are consistent with a single, locally straight
+ * boundary, the number of data points of @ref AntialiasMode::Uniform that
+ * are on the in-gamut side of this boundary. <tt>std::nullopt</tt>
+ * otherwise.
+ */
+template<typename ColorFunctor>
+std::optional<int> straightEdgeCoverage(const std::array<std::array<QRgb, 5>, 5> &corners,
+                                        const double cornerX,
+                                        const double cornerY,
+                                        const ColorFunctor &colorFunction)
+{
+    constexpr double coarseStepWidth = 0.25;
+    constexpr int sideLength = 16;
+    constexpr double stepWidth = 1.0 / sideLength;
+    // Bisection steps along a segment of coarseStepWidth. After 6 steps,
+    // the boundary is known with a precision of 1/256 pixel.
+    constexpr int bisectionSteps = 6;
+    // Corners closer to the boundary than this do not take part in the
+    // consistency check, because they are within the precision of the
+    // bisection.
+    constexpr double tolerance = 1.0 / 128;
+    // Maximum deviation of the boundary from a straight line within the
+    // pixel. Above, the boundary is not considered locally straight.
+    constexpr double maximumSagitta = 1.0 / 32;
+    // Chords that are shorter than this cut only a corner of the pixel,
+    // so the boundary is treated as straight.
+    constexpr double minimumCurvedChordLength = 0.5;
+    // The corners along the perimeter of the pixel, in cyclic order.
+    constexpr std::array<std::pair<int, int>, 16> perimeter{{{0, 0}, {1, 0}, {2, 0}, {3, 0}, //
+                                                             {4, 0}, {4, 1}, {4, 2}, {4, 3}, //
+                                                             {4, 4}, {3, 4}, {2, 4}, {1, 4}, //
+                                                             {0, 4}, {0, 3}, {0, 2}, {0, 1}}};
+    const auto isInGamut = [](const QRgb color) {
+        return qAlpha(color) != 0;
+    };
+    const auto cornerPoint = [cornerX, cornerY](const std::pair<int, int> index) {
+        return QPointF(cornerX + index.first * coarseStepWidth, //
+                       cornerY + index.second * coarseStepWidth);
+    };
+
+    // A straight boundary crosses the perimeter exactly twice.
+    std::array<QPointF, 2> crossings;
+    int crossingCount = 0;
+    for (std::size_t k = 0; k < perimeter.size(); ++k) {
+        const auto a = perimeter.at(k);
+        const auto b = perimeter.at((k + 1) % perimeter.size());
+        const bool isAInGamut = isInGamut(corners[a.first][a.second]);
+        if (isAInGamut == isInGamut(corners[b.first][b.second])) {
+            continue;
+        }
+        if (crossingCount >= static_cast<int>(crossings.size())) {
+            return std::nullopt;
+        }
+        QPointF inGamutPoint = cornerPoint(isAInGamut ? a : b);
+        QPointF outOfGamutPoint = cornerPoint(isAInGamut ? b : a);
+        for (int step = 0; step < bisectionSteps; ++step) {
+            const QPointF middle = (inGamutPoint + outOfGamutPoint) / 2;
+            if (isInGamut(colorFunction(middle.x(), middle.y()))) {
+                inGamutPoint = middle;
+            } else {
+                outOfGamutPoint = middle;
+            }
+        }
+        crossings[crossingCount] = (inGamutPoint + outOfGamutPoint) / 2;
+        ++crossingCount;
+    }
+    if (crossingCount != static_cast<int>(crossings.size())) {
+        return std::nullopt;
+    }
+    const QPointF direction = crossings[1] - crossings[0];
+    const double length = std::hypot(direction.x(), direction.y());
+    if (length < tolerance) {
+        return std::nullopt;
+    }
+    // Signed distance from the boundary.
+    const auto distance = [&crossings, direction, length](const double x, const double y) {
+        return (direction.x() * (y - crossings[0].y()) //
+                - direction.y() * (x - crossings[0].x()))
+            / length;
+    };
+
+    // All corners must be on the correct side of the boundary. Otherwise,
+    // the boundary is not straight enough.
+    int inGamutSide = 0; // Sign of the distance of in-gamut points.
+    for (int i = 0; i < static_cast<int>(corners.size()); ++i) {
+        for (int j = 0; j < static_cast<int>(corners.size()); ++j) {
+            const QPointF point = cornerPoint({i, j});
+            const double cornerDistance = distance(point.x(), point.y());
+            if (qAbs(cornerDistance) < tolerance) {
+                continue;
+            }
+            const int side = (cornerDistance > 0) ? 1 : -1;
+            const int expectedSide = isInGamut(corners[i][j]) ? side : -side;
+            if (inGamutSide == 0) {
+                inGamutSide = expectedSide;
+            } else if (inGamutSide != expectedSide) {
+                return std::nullopt;
+            }
+        }
+    }
+    if (inGamutSide == 0) {
+        return std::nullopt;
+    }
+
+    // The boundary is usually slightly curved. Measure the deviation from
+    // the straight line at the middle of the chord, and approximate the
+    // boundary by a parabola through both crossings and this point. For
+    // short chords, that cut only a corner of the pixel, the deviation is
+    // negligible, but extrapolating the parabola would be unstable.
+    double sagitta = 0;
+    if (length >= minimumCurvedChordLength) {
+        const QPointF normal(-direction.y() / length, direction.x() / length);
+        const QPointF middle = (crossings[0] + crossings[1]) / 2;
+        const bool isMiddleInGamut = isInGamut(colorFunction(middle.x(), middle.y()));
+        // Search towards the side that the middle does not belong to.
+        const double searchSign = isMiddleInGamut ? -inGamutSide : inGamutSide;
+        QPointF sameSidePoint = middle;
+        QPointF otherSidePoint = middle + normal * (searchSign * maximumSagitta);
+        if (isInGamut(colorFunction(otherSidePoint.x(), otherSidePoint.y())) == isMiddleInGamut) {
+            // Too curvy.
+            return std::nullopt;
+        }
+        for (int step = 0; step < bisectionSteps; ++step) {
+            const QPointF point = (sameSidePoint + otherSidePoint) / 2;
+            if (isInGamut(colorFunction(point.x(), point.y())) == isMiddleInGamut) {
+                sameSidePoint = point;
+            } else {
+                otherSidePoint = point;
+            }
+        }
+        const QPointF apex = (sameSidePoint + otherSidePoint) / 2;
+        sagitta = distance(apex.x(), apex.y());
+    }
+    const double squaredLength = length * length;
+
+    int coverage = 0;
+    for (int i = 0; i < sideLength; ++i) {
+        for (int j = 0; j < sideLength; ++j) {
+            const double x = cornerX + (i + 0.5) * stepWidth;
+            const double y = cornerY + (j + 0.5) * stepWidth;
+            // Position along the chord: 0 at the first crossing, 1 at
+            // the second crossing.
+            const double t = (direction.x() * (x - crossings[0].x()) //
+                              + direction.y() * (y - crossings[0].y()))
+                / squaredLength;
+            const double dataPointDistance = distance(x, y) - sagitta * 4 * t * (1 - t);
+            if (dataPointDistance * inGamutSide > 0) {
+                ++coverage;
+            }
+        }
+    }
+    return coverage;
+}
+
+/**
+ * @internal
+ *
+ * @brief Anti-aliasing of a single pixel.
+ *
+ * Helper function for @ref doAntialias().
+ *
+ * @param bytesPtr A reference to the bytes of the image provides as
+ *        QImage::Format_ARGB32_Premultiplied
+ * @param bytesPerLine The number of bytes in a single row of pixels in the
+ *        image.
+ * @param point The pixel for which anti-aliasing should be done.
+ * @param colorFunction A functor that returns the opaque color for the
+ *        given coordinates, or a transparent color if out-of-gamut. It is
+ *        called concurrently from multiple threads.
+ * @param mode The sampling strategy.
+ */
+template<typename ColorFunctor>
+void antialiasPixel(uchar *const bytesPtr,
+                    const qsizetype bytesPerLine,
+                    const QPoint point,
+                    const ColorFunctor &colorFunction,
+                    const AntialiasMode mode)
+{
+    // Iterating over a square grid of data points within the given pixel.
+    // The side length of the square contains exactly “sideLength” data
+    // points. Its square represents the total number of data points,
+    // referred to here as “totalDataPoints”. The“ sideLength” is chosen so
+    // that the total number of data points is 256, corresponding to the
+    // number of possible alpha values in typical 4-byte colors
+    // (RGB+Alpha), which is sufficient for this case."
+    constexpr int sideLength = 16;
+    constexpr int totalDataPoints = sideLength * sideLength;
+    constexpr double stepWidth = 1.0 / sideLength;
+    const double x = point.x() - 0.5 + stepWidth / 2;
+    const double y = point.y() - 0.5 + stepWidth / 2;
+
+    // Sums of the in-gamut data points. The data points are opaque, so
+    // there is no difference between premultiplied and non-premultiplied
+    // channels.
+    int redSum = 0;
+    int greenSum = 0;
+    int blueSum = 0;
+    int colorCount = 0;
+    const auto addColor = [&redSum, &greenSum, &blueSum, &colorCount]( //
+                              const QRgb color,
+                              const int weight) {
+        if (qAlpha(color) != 0) {
+            redSum += qRed(color) * weight;
+            greenSum += qGreen(color) * weight;
+            blueSum += qBlue(color) * weight;
+            colorCount += weight;
+        }
+    };
+    // Number of in-gamut data points on the grid of AntialiasMode::Uniform.
+    int count = 0;
+    const auto addDataPoint = [&addColor, &count](const QRgb color, const int weight) {
+        addColor(color, weight);
+        if (qAlpha(color) != 0) {
+            count += weight;
+        }
+    };
+
+    switch (mode) {
+    case AntialiasMode::Uniform:
+        for (int i = 0; i < sideLength; ++i) {
+            for (int j = 0; j < sideLength; ++j) {
+                addDataPoint(colorFunction(x + i * stepWidth, //
+                                           y + j * stepWidth),
+                             1);
+            }
+        }
+        break;
+    case AntialiasMode::Adaptive: {
+        // Divide the pixel into coarseSideLength × coarseSideLength cells,
+        // each of which contains fineSideLength × fineSideLength data points
+        // of the full resolution grid. Evaluate first only the corners of
+        // the cells. If they are consistent with a straight boundary, the
+        // coverage is calculated analytically from this boundary.
+        // Otherwise: A straight boundary that crosses a cell always
+        // separates at least one of its corners from the others. So if all
+        // four corners agree, we assume that the boundary does not cross
+        // the cell, and that all its data points agree with the corners.
+        // This assumption fails for features that fit between the corners,
+        // like thin slivers; see AntialiasMode::Adaptive. Only the other
+        // cells are refined to the full resolution.
+        constexpr int coarseSideLength = 4;
+        constexpr int fineSideLength = sideLength / coarseSideLength;
+        static_assert(coarseSideLength * fineSideLength == sideLength);
+        constexpr double coarseStepWidth = 1.0 / coarseSideLength;
+        constexpr int cornerSideLength = coarseSideLength + 1;
+        const double cornerX = point.x() - 0.5;
+        const double cornerY = point.y() - 0.5;
+        std::array<std::array<QRgb, cornerSideLength>, cornerSideLength> corners;
+        for (int i = 0; i < cornerSideLength; ++i) {
+            for (int j = 0; j < cornerSideLength; ++j) {
+                corners[i][j] = colorFunction(cornerX + i * coarseStepWidth, //
+                                              cornerY + j * coarseStepWidth);
+            }
+        }
+        const auto edgeCoverage = straightEdgeCoverage(corners, //
+                                                       cornerX,
+                                                       cornerY,
+                                                       colorFunction);
+        if (edgeCoverage.has_value()) {
+            for (const auto &column : corners) {
+                for (const QRgb color : column) {
+                    addColor(color, 1);
+                }
+            }
+            count = edgeCoverage.value();
+            break;
+        }
+        for (int i = 0; i < coarseSideLength; ++i) {
+            for (int j = 0; j < coarseSideLength; ++j) {
+                const std::array<QRgb, 4> cellCorners{corners[i][j], //
+                                                      corners[i + 1][j],
+                                                      corners[i][j + 1],
+                                                      corners[i + 1][j + 1]};
+                const auto isInGamut = [](const QRgb color) {
+                    return qAlpha(color) != 0;
+                };
+                if (std::all_of(cellCorners.cbegin(), cellCorners.cend(), isInGamut)) {
+                    // The four corners together represent all data points
+                    // of the cell.
+                    constexpr int weight = fineSideLength * fineSideLength / 4;
+                    for (const QRgb color : cellCorners) {
+                        addDataPoint(color, weight);
+                    }
+                    continue;
+                }
+                if (std::none_of(cellCorners.cbegin(), cellCorners.cend(), isInGamut)) {
+                    continue;
+                }
+                for (int fi = 0; fi < fineSideLength; ++fi) {
+                    for (int fj = 0; fj < fineSideLength; ++fj) {
+                        addDataPoint(colorFunction(x + (i * fineSideLength + fi) * stepWidth, //
+                                                   y + (j * fineSideLength + fj) * stepWidth),
+                                     1);
+                    }
+                }
+            }
+        }
+        break;
+    }
+    }
+
+    if ((count > 0) && (colorCount > 0)) {
+        QRgb &pixelRef = *( //
+            reinterpret_cast<QRgb *>(bytesPtr + point.y() * bytesPerLine) //
+            + point.x());
+        QRgb opaqueColor = pixelRef;
+        if (qAlpha(opaqueColor) == 0) {
+            // If the pixel is transparent, the center of the pixel is
+            // out-of-gamut, and no actual color is available. For
+            // anti-aliasing, we need an actual color, so we calculate the
+            // mean color of all other data points within the pixel that
+            // actually are in-gamut.
+            const float countF = static_cast<float>(colorCount);
+            opaqueColor = qRgb(qRound(static_cast<float>(redSum) / countF), //
+                               qRound(static_cast<float>(greenSum) / countF), //
+                               qRound(static_cast<float>(blueSum) / countF));
+        }
+        pixelRef = qPremultiply( //
+            qRgba(qRed(opaqueColor), //
+                  qGreen(opaqueColor), //
+                  qBlue(opaqueColor), //
+                  qRound(static_cast<float>(count) / totalDataPoints * 255)));
+    }
+}
+
+/**
+ * @internal
+ *
+ * @brief Helper function for @ref doAntialias().
+ *
+ * @param bytesPtr A reference to the bytes of the image provides as
+ *        QImage::Format_ARGB32_Premultiplied
+ * @param bytesPerLine The number of bytes in a single row of pixels in the
+ *        image.
+ * @param antiAliasCoordinates A list of pixels for which anti-aliasing should
+ *        be done.
+ * @param colorFunction A functor that returns the opaque color for the
+ *        given coordinates, or a transparent color if out-of-gamut. It is
+ *        called concurrently from multiple threads.
+ * @param mode The sampling strategy.
+ */
+template<typename ColorFunctor>
+void doAntialiasHelper(uchar *const bytesPtr,
+                       const qsizetype bytesPerLine,
+                       const QList<QPoint> &antiAliasCoordinates,
+                       const ColorFunctor &colorFunction,
+                       const AntialiasMode mode)
+{
+    for (const QPoint point : antiAliasCoordinates) {
+        antialiasPixel(bytesPtr, bytesPerLine, point, colorFunction, mode);
+    }
+}
+
+/**
+ * @internal
+ *
+ * @brief Helper function for @ref doAntialias().
+ *
+ * @param bytesPtr A reference to the bytes of the image provides as
+ *        QImage::Format_ARGB32_Premultiplied
+ * @param bytesPerLine The number of bytes in a single row of pixels in the
+ *        image.
+ * @param boundary The pixels for which anti-aliasing should be done.
+ * @param firstRow Index of the first row to process. Must be a valid index.
+ * @param lastRow Index of the last row to process. Must be a valid index.
+ * @param colorFunction A functor that returns the opaque color for the
+ *        given coordinates, or a transparent color if out-of-gamut. It is
+ *        called concurrently from multiple threads.
+ * @param mode The sampling strategy.
+ */
+template<typename ColorFunctor>
+void doAntialiasMaskHelper(uchar *const bytesPtr,
+                           const qsizetype bytesPerLine,
+                           const BoundaryMask &boundary,
+                           const int firstRow,
+                           const int lastRow,
+                           const ColorFunctor &colorFunction,
+                           const AntialiasMode mode)
+{
+    for (int y = firstRow; y <= lastRow; ++y) {
+        const quint8 *const maskLine = //
+            boundary.mask.constData() + static_cast<qsizetype>(y) * boundary.width;
+        for (int x = 0; x < boundary.width; ++x) {
+            if (maskLine[x] != 0) {
+                antialiasPixel(bytesPtr, bytesPerLine, QPoint(x, y), colorFunction, mode);
+            }
+        }
+    }
+}
+
+/**
+ * @internal
+ *
+ * @brief Calculates anti-alias for gamut diagrams.
+ *
+ * Gamut images generated by this library typically exhibit sharp boundaries,
+ * where a pixel is either within the gamut (opaque color) or outside it
+ * (transparent color). The determination is based on the coordinates at the
+ * center of the pixel's square surface.
+ *
+ * This function is designed to perform anti-aliasing by smoothing the sharp
+ * gamut boundaries. To use this function, first obtain a list of candidate
+ * pixels for anti-aliasing. These are the pixels surrounding the sharp gamut
+ * border, which can be identified using @ref findBoundary(). This function
+ * then calculates, within the 1 px × 1 px area of each candidate pixel,
+ * multiple data points at a significantly higher resolution than the single
+ * data point in the original image. By analyzing this detailed data, the
+ * function applies anti-aliasing to smooth the boundary.
+ *
+ * @note Since this operation is computationally intensive, it is recommended
+ * to apply it only to the pixels returned by @ref findBoundary(), rather than
+ * the entire image.
+ *
+ * The color function is a template parameter, so that the compiler can
+ * inline it into the innermost sampling loop. Pass lambdas directly rather
+ * than wrapping them in <tt>std::function</tt>.
+ *
+ * @param image A reference to he image that should be modified.
+ *        Only <tt>QImage::Format_ARGB32_Premultiplied</tt> is supported.
+ * @param antiAliasCoordinates A list of pixels for which anti-aliasing should
+ *        be done.
+ * @param colorFunction A functor that returns the opaque color for the
+ *        given coordinates, or a transparent color if out-of-gamut. It is
+ *        called concurrently from multiple threads.
+ * @param mode The sampling strategy.
+ */
+template<typename ColorFunctor>
+void doAntialias(QImage &image,
+                 const QList<QPoint> &antiAliasCoordinates,
+                 const ColorFunctor &colorFunction,
+                 const AntialiasMode mode = AntialiasMode::Adaptive)
+{
+    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
+        return;
+    }
+    uchar *const bytesPtr = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    auto &poolReference = getLibraryQThreadPoolInstance();
+    const int threadCount = qMax(1, poolReference.maxThreadCount());
+    const auto parts = splitList(antiAliasCoordinates, threadCount);
+    // The narrowing static_cast<int>() is okay because parts.size() is a
+    // result of threadCount, which is also int.
+    static_assert( //
+        std::is_same_v<std::remove_cv_t<decltype(threadCount)>, int>);
+    const int partsCount = static_cast<int>(parts.size());
+    QSemaphore semaphore(0);
+    for (const auto &part : parts) {
+        const auto myLambda = [bytesPtr, bytesPerLine, part, &colorFunction, mode, &semaphore]() {
+            doAntialiasHelper(bytesPtr, bytesPerLine, part, colorFunction, mode);
+            semaphore.release();
+        };
+        const auto myRunnablePtr = QRunnable::create(myLambda);
+        poolReference.start(myRunnablePtr, imageThreadPriority);
+    }
+    // Intentionally acquiring parts.size() and not treadCount, because
+    // they might differ and parts.size() is mandatory for thread
+    // execution.
+    semaphore.acquire(partsCount); // Wait for all threads to finish.
+}
+
+/**
+ * @internal
+ *
+ * @brief Calculates anti-alias for gamut diagrams.
+ *
+ * Overload of @ref doAntialias(QImage &, const QList<QPoint> &, const ColorFunctor &, const AntialiasMode)
+ * that takes the result of @ref findBoundaryMask() directly, without
+ * building a list of coordinates.
+ *
+ * @param image A reference to he image that should be modified.
+ *        Only <tt>QImage::Format_ARGB32_Premultiplied</tt> is supported.
+ * @param boundary The pixels for which anti-aliasing should be done. Must
+ *        have the same size as the image; otherwise, nothing is done.
+ * @param colorFunction A functor that returns the opaque color for the
+ *        given coordinates, or a transparent color if out-of-gamut. It is
+ *        called concurrently from multiple threads.
+ * @param mode The sampling strategy.
+ */
+template<typename ColorFunctor>
+void doAntialias(QImage &image,
+                 const BoundaryMask &boundary,
+                 const ColorFunctor &colorFunction,
+                 const AntialiasMode mode = AntialiasMode::Adaptive)
+{
+    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
+        return;
+    }
+    if ((boundary.width != image.width()) || (boundary.height != image.height())) {
+        return;
+    }
+    uchar *const bytesPtr = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    auto &poolReference = getLibraryQThreadPoolInstance();
+    const int threadCount = qMax(1, poolReference.maxThreadCount());
+    const auto segments = splitElements(boundary.height, threadCount);
+    // The narrowing static_cast<int>() is okay because segments.size() is a
+    // result of threadCount, which is also int.
+    static_assert( //
+        std::is_same_v<std::remove_cv_t<decltype(threadCount)>, int>);
+    const int segmentsCount = static_cast<int>(segments.size());
+    QSemaphore semaphore(0);
+    for (const auto &segment : segments) {
+        const auto myLambda = [bytesPtr, bytesPerLine, &boundary, segment, &colorFunction, mode, &semaphore]() {
+            doAntialiasMaskHelper(bytesPtr, bytesPerLine, boundary, segment.first, segment.second, colorFunction, mode);
+            semaphore.release();
+        };
+        const auto myRunnablePtr = QRunnable::create(myLambda);
+        poolReference.start(myRunnablePtr, imageThreadPriority);
+    }
+    // Intentionally acquiring segments.size() and not treadCount, because
+    // they might differ and segments.size() is mandatory for thread
+    // execution.
+    semaphore.acquire(segmentsCount); // Wait for all threads to finish.
+}
+
 } // namespace PerceptualColor
 
 #endif // PERCEPTUALCOLOR_HELPERIMAGE_H
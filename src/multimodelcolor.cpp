@@ -0,0 +1,118 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// Own header
+#include "multimodelcolor.h"
+
+#include "absolutecolor.h"
+#include <optional>
+#include <type_traits>
+
+namespace PerceptualColor
+{
+
+static_assert(std::is_trivially_copyable_v<MultiModelColor>);
+
+/** @brief Constructor.
+ *
+ * @param model The color model in which the color is defined.
+ * @param value The value in this color model.
+ *
+ * @post The values in all color models that can be reached by
+ * @ref AbsoluteColor::convert() are available. */
+MultiModelColor::MultiModelColor(const ColorModel model, const GenericColor &value)
+    : m_sourceModel(model)
+{
+    Q_ASSERT(static_cast<std::size_t>(model) < slotCount);
+    for (std::size_t i = 0; i < slotCount; ++i) {
+        const auto converted = AbsoluteColor::convert(model, //
+                                                      value,
+                                                      static_cast<ColorModel>(i));
+        if (converted.has_value()) {
+            m_isAvailable[i] = true;
+            m_values[i] = converted.value();
+        }
+    }
+}
+
+/** @brief Index of the slot for a color model.
+ *
+ * @param model The color model.
+ *
+ * @returns Index of the slot for a color model. */
+std::size_t MultiModelColor::slot(const ColorModel model)
+{
+    const auto index = static_cast<std::size_t>(model);
+    Q_ASSERT(index < slotCount);
+    return index;
+}
+
+/** @brief Whether a value is available in a color model.
+ *
+ * @param model The color model.
+ *
+ * @returns <tt>true</tt> if a value is available in the given color
+ * model, <tt>false</tt> otherwise. */
+bool MultiModelColor::contains(const ColorModel model) const
+{
+    return m_isAvailable[slot(model)];
+}
+
+/** @brief The value in a color model.
+ *
+ * @param model The color model.
+ *
+ * @returns The value in the given color model. If no value is available
+ * in this color model, a default-constructed @ref GenericColor is
+ * returned, like <tt>QHash::value()</tt> does. */
+GenericColor MultiModelColor::value(const ColorModel model) const
+{
+    const auto index = slot(model);
+    if (m_isAvailable[index]) {
+        return m_values[index];
+    }
+    return GenericColor();
+}
+
+/** @brief Equal operator
+ *
+ * Two objects are equal if they have the same values in both source
+ * color models.
+ *
+ * @param other The object to compare with.
+ *
+ * @returns <tt>true</tt> if equal, <tt>false</tt> otherwise. */
+bool MultiModelColor::operator==(const MultiModelColor &other) const
+{
+    if (m_sourceModel == ColorModel::Invalid || other.m_sourceModel == ColorModel::Invalid) {
+        return m_sourceModel == other.m_sourceModel;
+    }
+    for (const auto model : {m_sourceModel, other.m_sourceModel}) {
+        if (contains(model) != other.contains(model)) {
+            return false;
+        }
+        if (value(model) != other.value(model)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @internal
+ *
+ * @brief Adds QDebug() support for data type
+ * @ref PerceptualColor::MultiModelColor
+ *
+ * @param dbg Existing debug object
+ * @param value Value to stream into the debug object
+ * @returns Debug object with value streamed in */
+QDebug operator<<(QDebug dbg, const PerceptualColor::MultiModelColor &value)
+{
+    dbg.nospace() //
+        << "MultiModelColor(" //
+        << value.sourceModel() << ", " //
+        << value.value(value.sourceModel()) << ")";
+    return dbg.maybeSpace();
+}
+
+} // namespace PerceptualColor
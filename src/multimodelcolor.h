@@ -0,0 +1,105 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#ifndef PERCEPTUALCOLOR_MULTIMODELCOLOR_H
+#define PERCEPTUALCOLOR_MULTIMODELCOLOR_H
+
+#include "genericcolor.h"
+#include "perceptualcolornamespace.h"
+#include <array>
+#include <cstddef>
+#include <qdebug.h>
+#include <qglobal.h>
+#include <qmetatype.h>
+
+namespace PerceptualColor
+{
+
+/** @internal
+ *
+ * @brief A color together with its values in all available
+ * @ref ColorModel.
+ *
+ * The color is defined by a value in a source color model. The constructor
+ * calculates the values in all other color models with
+ * @ref AbsoluteColor::convert() and stores them in a fixed slot per
+ * @ref ColorModel. This type does not allocate memory and is trivially
+ * copyable, so it is cheap to pass by value, also to other threads. As
+ * the <tt>const</tt> functions do not modify the object, several threads
+ * can read the same object at the same time.
+ *
+ * @note The values are calculated eagerly, not on first access: A lazy
+ * cache would be modified by <tt>const</tt> functions, which would require
+ * atomic slot states, and atomics are not trivially copyable. The
+ * conversions are cheap compared to the code that typically uses
+ * this type.
+ *
+ * This data type can be passed to QDebug thanks to
+ * @ref operator<<(QDebug dbg, const PerceptualColor::MultiModelColor &value)
+ *
+ * @sa @ref AbsoluteColor::allConversions() */
+class MultiModelColor
+{
+public:
+    /** @brief Constructor for an empty object.
+     *
+     * No value is available in any color model. */
+    constexpr MultiModelColor() noexcept = default;
+    MultiModelColor(const ColorModel model, const GenericColor &value);
+
+    [[nodiscard]] bool contains(const ColorModel model) const;
+    [[nodiscard]] GenericColor value(const ColorModel model) const;
+
+    [[nodiscard]] bool operator==(const MultiModelColor &other) const;
+    /** @brief Unequal operator
+     *
+     * @param other The object to compare with.
+     *
+     * @returns Logical opposite of @ref operator==. */
+    [[nodiscard]] bool operator!=(const MultiModelColor &other) const
+    {
+        return !(*this == other);
+    }
+
+    /** @brief The color model in which the color has been defined.
+     *
+     * @returns The color model in which the color has been defined, or
+     * @ref ColorModel::Invalid for empty objects. */
+    [[nodiscard]] constexpr ColorModel sourceModel() const noexcept
+    {
+        return m_sourceModel;
+    }
+
+private:
+    /** @internal @brief Only for unit tests. */
+    friend class TestMultiModelColor;
+
+    /** @brief Number of slots, which is the number of @ref ColorModel
+     * values.
+     *
+     * @note <tt>ColorModel::XyzD65_1</tt> is the last value of the
+     * enum. */
+    static constexpr std::size_t slotCount = //
+        static_cast<std::size_t>(ColorModel::XyzD65_1) + 1;
+
+    [[nodiscard]] static std::size_t slot(const ColorModel model);
+
+    /** @brief The color model in which the color has been defined. */
+    ColorModel m_sourceModel = ColorModel::Invalid;
+    /** @brief Whether a value is available in each slot of
+     * @ref m_values. */
+    std::array<bool, slotCount> m_isAvailable{};
+    /** @brief The values, indexed by @ref ColorModel.
+     *
+     * A slot is only valid if the corresponding entry in
+     * @ref m_isAvailable is <tt>true</tt>. */
+    std::array<GenericColor, slotCount> m_values{};
+};
+
+QDebug operator<<(QDebug dbg, const PerceptualColor::MultiModelColor &value);
+
+} // namespace PerceptualColor
+
+Q_DECLARE_METATYPE(PerceptualColor::MultiModelColor)
+
+#endif // PERCEPTUALCOLOR_MULTIMODELCOLOR_H
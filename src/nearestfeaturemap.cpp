@@ -0,0 +1,181 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// Own header
+#include "nearestfeaturemap.h"
+
+#include <algorithm>
+#include <limits>
+#include <qcolor.h>
+#include <qimage.h>
+
+namespace PerceptualColor
+{
+/** @brief Calculates the map for a given alpha mask.
+ *
+ * This is the exact Euclidean feature transform of
+ * <a href="https://doi.org/10.4086/toc.2012.v008a019">Felzenszwalb and
+ * Huttenlocher</a>. It needs two passes with linear time: First, the
+ * nearest opaque pixel within the same column is searched for each
+ * pixel. Second, the lower envelope of the resulting parabolas is
+ * calculated for each line.
+ *
+ * @param mask A 1-bit alpha mask where white represents transparency and
+ * black represents opacity, like @ref AsyncImageRenderCallback uses it.
+ *
+ * @returns The corresponding map. If the mask is a null image, a null map
+ * is returned. */
+NearestFeatureMap NearestFeatureMap::fromMask(const QImage &mask)
+{
+    NearestFeatureMap result;
+    if (mask.isNull()) {
+        return result;
+    }
+    const QImage monoMask = mask.convertToFormat(QImage::Format_MonoLSB);
+    const int width = monoMask.width();
+    const int height = monoMask.height();
+    const uchar opaqueIndex = //
+        (monoMask.color(0) == qRgb(0, 0, 0)) ? 0 : 1;
+    const auto isOpaque = [&monoMask, opaqueIndex](const int x, const int y) {
+        const uchar *const line = monoMask.constScanLine(y);
+        return ((line[x >> 3] >> (x & 7)) & 1) == opaqueIndex;
+    };
+
+    // First pass: Nearest opaque line within the same column. The lines
+    // are processed in memory order to stay cache-friendly.
+    QList<qint32> columnFeature(static_cast<qsizetype>(width) * height, -1);
+    QList<qint32> lastOpaqueLine(width, -1);
+    for (int y = 0; y < height; ++y) {
+        qint32 *const featureLine = columnFeature.data() + static_cast<qsizetype>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            if (isOpaque(x, y)) {
+                lastOpaqueLine[x] = y;
+            }
+            featureLine[x] = lastOpaqueLine.at(x);
+        }
+    }
+    lastOpaqueLine.fill(-1);
+    for (int y = height - 1; y >= 0; --y) {
+        qint32 *const featureLine = columnFeature.data() + static_cast<qsizetype>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            if (featureLine[x] == y) {
+                lastOpaqueLine[x] = y;
+                continue;
+            }
+            const qint32 below = lastOpaqueLine.at(x);
+            if (below < 0) {
+                continue;
+            }
+            if ((featureLine[x] < 0) || (below - y < y - featureLine[x])) {
+                featureLine[x] = below;
+            }
+        }
+    }
+
+    // Second pass: Lower envelope of the parabolas of each line.
+    result.m_size = QSize(width, height);
+    result.m_nearestFeature.resize(columnFeature.size());
+    // The vertices of the parabolas that form the lower envelope:
+    QList<int> vertices(width);
+    // The boundaries between the parabolas of the lower envelope:
+    QList<double> boundaries(width + 1);
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    for (int y = 0; y < height; ++y) {
+        const qint32 *const featureLine = //
+            columnFeature.constData() + static_cast<qsizetype>(y) * width;
+        // Height of the parabola with the vertex in column x, plus x².
+        const auto offset = [featureLine, y](const int x) -> double {
+            const qint64 dy = y - featureLine[x];
+            return static_cast<double>(dy * dy + qint64{x} * x);
+        };
+        int k = -1; // Index of the rightmost parabola in the lower envelope
+        for (int q = 0; q < width; ++q) {
+            if (featureLine[q] < 0) {
+                // No opaque pixel in this column.
+                continue;
+            }
+            double intersection = -infinity;
+            while (k >= 0) {
+                const int v = vertices.at(k);
+                intersection = (offset(q) - offset(v)) / (2.0 * (q - v));
+                if (intersection > boundaries.at(k)) {
+                    break;
+                }
+                --k;
+            }
+            ++k;
+            vertices[k] = q;
+            boundaries[k] = (k == 0) ? -infinity : intersection;
+            boundaries[k + 1] = infinity;
+        }
+        qint32 *const resultLine = //
+            result.m_nearestFeature.data() + static_cast<qsizetype>(y) * width;
+        if (k < 0) {
+            // No opaque pixel in the whole mask.
+            std::fill(resultLine, resultLine + width, -1);
+            continue;
+        }
+        int j = 0;
+        for (int x = 0; x < width; ++x) {
+            while (boundaries.at(j + 1) < x) {
+                ++j;
+            }
+            const int v = vertices.at(j);
+            resultLine[x] = featureLine[v] * width + v;
+        }
+    }
+    return result;
+}
+
+/** @brief If this map is a null map.
+ *
+ * @returns <tt>true</tt> if this map has been default-constructed or
+ * calculated from a null mask. <tt>false</tt> otherwise. */
+bool NearestFeatureMap::isNull() const
+{
+    return m_nearestFeature.isEmpty();
+}
+
+/** @brief The nearest opaque pixel.
+ *
+ * @param point The pixel for which you search the nearest opaque pixel.
+ * Points outside the map are moved to the nearest pixel within the map
+ * first.
+ *
+ * @returns The nearest opaque pixel, if any. An empty value otherwise.
+ * Note that an opaque point is considered to be itself its nearest
+ * opaque pixel. If there are multiple opaque pixels at the same distance,
+ * it is indeterminate which one is returned. */
+std::optional<QPoint> NearestFeatureMap::nearestFeature(const QPoint point) const
+{
+    if (isNull()) {
+        return std::nullopt;
+    }
+    const int width = m_size.width();
+    const int x = qBound(0, point.x(), width - 1);
+    const int y = qBound(0, point.y(), m_size.height() - 1);
+    const qint32 index = m_nearestFeature.at(static_cast<qsizetype>(y) * width + x);
+    if (index < 0) {
+        return std::nullopt;
+    }
+    return QPoint(index % width, index / width);
+}
+
+/** @brief Size of the mask from which this map has been calculated.
+ *
+ * @returns The size of the mask from which this map has been calculated,
+ * or an invalid size for null maps. */
+QSize NearestFeatureMap::size() const
+{
+    return m_size;
+}
+
+/** @brief Memory usage of the map.
+ *
+ * @returns The memory usage of the map data, measured in bytes. */
+qsizetype NearestFeatureMap::sizeInBytes() const
+{
+    return m_nearestFeature.size() * static_cast<qsizetype>(sizeof(qint32));
+}
+
+} // namespace PerceptualColor
@@ -0,0 +1,67 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+#ifndef PERCEPTUALCOLOR_NEARESTFEATUREMAP_H
+#define PERCEPTUALCOLOR_NEARESTFEATUREMAP_H
+
+#include <optional>
+#include <qglobal.h>
+#include <qlist.h>
+#include <qmetatype.h>
+#include <qpoint.h>
+#include <qsize.h>
+
+class QImage;
+
+namespace PerceptualColor
+{
+/** @internal
+ *
+ * @brief Nearest opaque pixel for each pixel of an alpha mask.
+ *
+ * This is a
+ * <a href="https://en.wikipedia.org/wiki/Distance_transform">feature
+ * transform</a> of an alpha mask as delivered by
+ * @ref AsyncImageRenderCallback::deliverInterlacingPass(): For each pixel,
+ * it stores the position of the nearest opaque pixel (measured in
+ * Euclidean distance). It is calculated once, and after that, each query
+ * is a single array read.
+ *
+ * This type is declared as type to Qt’s type system via
+ * <tt>Q_DECLARE_METATYPE</tt>. Depending on your use case (for
+ * example if you want to use for <em>queued</em> signal-slot connections),
+ * you might consider calling <tt>qRegisterMetaType()</tt> for
+ * this type, once you have a QApplication object. */
+class NearestFeatureMap
+{
+public:
+    /** @brief Default constructor.
+     *
+     * Constructs a null map. */
+    NearestFeatureMap() = default;
+
+    [[nodiscard]] static NearestFeatureMap fromMask(const QImage &mask);
+    [[nodiscard]] bool isNull() const;
+    [[nodiscard]] std::optional<QPoint> nearestFeature(const QPoint point) const;
+    [[nodiscard]] QSize size() const;
+    [[nodiscard]] qsizetype sizeInBytes() const;
+
+private:
+    /** @internal @brief Only for unit tests. */
+    friend class TestNearestFeatureMap;
+
+    /** @brief Internal storage for @ref size(). */
+    QSize m_size;
+    /** @brief The nearest opaque pixel of each pixel.
+     *
+     * The pixels are stored line by line. Each value is the index of the
+     * nearest opaque pixel within this very same list, or <tt>-1</tt> if
+     * the mask has no opaque pixel at all. */
+    QList<qint32> m_nearestFeature;
+};
+
+} // namespace PerceptualColor
+
+Q_DECLARE_METATYPE(PerceptualColor::NearestFeatureMap)
+
+#endif // PERCEPTUALCOLOR_NEARESTFEATUREMAP_H
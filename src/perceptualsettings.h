@@ -31,6 +31,10 @@ public:
      *
      * Has serialization support as required by <tt>QSettings</tt>
      * thanks to <tt>QList</tt>.
+     *
+     * @note @ref Setting stores lists element by element and writes
+     * only the elements that have changed. Adding a color to the
+     * @ref history touches a single element key.
      */
     using ColorList = QList<QColor>;
 
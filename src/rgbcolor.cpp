@@ -5,9 +5,12 @@
 #include "rgbcolor.h"
 
 #include "helperconversion.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <qchar.h>
 #include <qglobal.h>
-#include <qstringliteral.h>
+#include <qnamespace.h>
 #include <type_traits>
 
 namespace PerceptualColor
@@ -17,7 +20,45 @@ RgbColor::RgbColor()
 {
 }
 
+/** @brief Upper-case hexadecimal digits, indexed by their value. */
+static constexpr char16_t hexDigits[] = u"0123456789ABCDEF";
+
+/** @brief RGB representation with 6 hexadecimal digits.
+ *
+ * We cannot rely on the convenient <tt>QColor::name()</tt> because this
+ * function seems to use <tt>floor()</tt> instead of <tt>round()</tt>, which
+ * does not make sense for us, and it would be inconsistent with other code
+ * in our library. Therefore, we round explicitly.
+ *
+ * The digits are taken from a lookup table and written directly into the
+ * string buffer. The result is never localized.
+ *
+ * @param rgb255 The color. Range: [0, 255]. Out-of-range values are
+ * bound to the range.
+ * @returns The color in the format <tt>\#RRGGBB</tt> with upper-case
+ * digits. */
+static QString hex6FromRgb255(const GenericColor &rgb255)
+{
+    const std::array<int, 3> channels{qBound(0, qRound(rgb255.first), 255), //
+                                      qBound(0, qRound(rgb255.second), 255), //
+                                      qBound(0, qRound(rgb255.third), 255)};
+    QString result(7, Qt::Uninitialized);
+    QChar *data = result.data();
+    data[0] = QChar::fromLatin1('#');
+    for (std::size_t i = 0; i < channels.size(); ++i) {
+        data[1 + 2 * i] = QChar(hexDigits[channels.at(i) / 16]);
+        data[2 + 2 * i] = QChar(hexDigits[channels.at(i) % 16]);
+    }
+    return result;
+}
+
 /** @brief Set all member variables.
+ *
+ * HSL, HSV and HWB are derived in a single pass from the RGB channels:
+ * Minimum, maximum and hue are calculated only once and shared by all
+ * three models. This avoids the <tt>QColor</tt> accessors, which each
+ * would do their own conversion, and gives a higher precision than the
+ * 16-bit storage of <tt>QColor</tt>.
  *
  * @param color The new color as <tt>QColor</tt> object. Might be of any
  * <tt>QColor::Spec</tt>.
@@ -26,43 +67,15 @@ RgbColor::RgbColor()
  */
 void RgbColor::fillAll(QColor color, std::optional<double> hue)
 {
-    rgb_1 = GenericColor( //
-        qBound<double>(0., static_cast<double>(color.redF()), 1.), //
-        qBound<double>(0., static_cast<double>(color.greenF()), 1.), //
-        qBound<double>(0., static_cast<double>(color.blueF()), 1.));
-
-    rgb_255 = GenericColor( //
-        qBound<double>(0., static_cast<double>(color.redF() * 255), 255.), //
-        qBound<double>(0., static_cast<double>(color.greenF() * 255), 255.), //
-        qBound<double>(0., static_cast<double>(color.blueF() * 255), 255.));
-
-    // rgbHex6
-    // We cannot rely on the convenient QColor.name() because this function
-    // seems to use floor() instead of round(), which does not make sense for
-    // us, and it would be inconsistent with other code in our
-    // library. Therefore, we have to round explicitly.
-    // This format string provides intentionally a non-localized format,
-    // using QString::arg() which does not localize if the corresponding
-    // placeholder (%1, %2 …) is not followed by an "L", which it isn’t
-    // in this code.
-    rgbHex6 = //
-        QStringLiteral(u"#%1%2%3")
-            .arg(qBound(0, qRound(rgb_255.first), 255), // The number itself
-                 2, // The minimal field width (2 digits)
-                 16, // The base of the number representation (16, hexadecimal)
-                 QChar::fromLatin1('0') // The fill character (leading zero)
-                 )
-            .arg(qBound(0, qRound(rgb_255.second), 255), // The number itself
-                 2, // The minimal field width (2 digits)
-                 16, // The base of the number representation (16, hexadecimal)
-                 QChar::fromLatin1('0') // The fill character (leading zero)
-                 )
-            .arg(qBound(0, qRound(rgb_255.third), 255), // The number itself
-                 2, // The minimal field width (2 digits)
-                 16, // The base of the number representation (16, hexadecimal)
-                 QChar::fromLatin1('0') // The fill character (leading zero)
-                 )
-            .toUpper(); // Convert to upper case
+    const double red = qBound(0., static_cast<double>(color.redF()), 1.);
+    const double green = qBound(0., static_cast<double>(color.greenF()), 1.);
+    const double blue = qBound(0., static_cast<double>(color.blueF()), 1.);
+
+    rgb_1 = GenericColor(red, green, blue);
+
+    rgb_255 = GenericColor(red * 255, green * 255, blue * 255);
+
+    rgbHex6 = hex6FromRgb255(rgb_255);
 
     // rgbQColor
     rgbQColor = color.toRgb();
@@ -70,36 +83,51 @@ void RgbColor::fillAll(QColor color, std::optional<double> hue)
         rgbQColor.setAlphaF(1);
     }
 
-    // The hue is identical for HSL, HSV and HWB.
-    const double hueDegree = hue.value_or( //
-        qBound(0., rgbQColor.hueF() * 360, 360.));
+    const double maximum = std::max({red, green, blue});
+    const double minimum = std::min({red, green, blue});
+    const double chroma = maximum - minimum;
+
+    // The hue is identical for HSL, HSV and HWB. On the gray axis, the
+    // hue is meaningless, so we use 0° as standard value.
+    double calculatedHue = 0;
+    if (!hue.has_value() && chroma > 0) {
+        if (maximum == red) {
+            calculatedHue = 60 * ((green - blue) / chroma);
+        } else if (maximum == green) {
+            calculatedHue = 60 * ((blue - red) / chroma + 2);
+        } else {
+            calculatedHue = 60 * ((red - green) / chroma + 4);
+        }
+        if (calculatedHue < 0) {
+            calculatedHue += 360;
+        }
+    }
+    const double hueDegree = hue.value_or(qBound(0., calculatedHue, 360.));
 
     // HSL
-    const double hslSaturationPercentage = //
-        qBound(0., static_cast<double>(color.hslSaturationF()) * 100, 100.);
-    const double hslLightnessPercentage = //
-        qBound(0., static_cast<double>(color.lightnessF()) * 100, 100.);
+    const double lightness = (maximum + minimum) / 2;
+    const double hslDenominator = 1 - qAbs(2 * lightness - 1);
+    const double hslSaturation = (hslDenominator > 0) //
+        ? chroma / hslDenominator
+        : 0; // Black or white
     hsl = GenericColor(hueDegree, //
-                       hslSaturationPercentage, //
-                       hslLightnessPercentage);
+                       qBound(0., hslSaturation * 100, 100.), //
+                       qBound(0., lightness * 100, 100.));
 
     // HSV
-    const double hsvSaturationPercentage = //
-        qBound(0.0, static_cast<double>(color.hsvSaturationF()) * 100, 100.0);
-    const double hsvValuePercentage = //
-        qBound<double>(0.0, static_cast<double>(color.valueF()) * 100, 100.0);
+    const double hsvSaturation = (maximum > 0) //
+        ? chroma / maximum
+        : 0; // Black
     hsv = GenericColor(hueDegree, //
-                       hsvSaturationPercentage, //
-                       hsvValuePercentage);
+                       qBound(0., hsvSaturation * 100, 100.), //
+                       qBound(0., maximum * 100, 100.));
 
     // HWB
-    const double hwbWhitenessPercentage = //
-        qBound(0.0, (1 - color.hsvSaturationF()) * color.valueF() * 100, 100.0);
-    const double hwbBlacknessPercentage = //
-        qBound(0.0, (1 - color.valueF()) * 100, 100.0);
+    // The whiteness (1 - HSV saturation) × HSV value simplifies to the
+    // minimum, and the blackness 1 - HSV value to 1 - maximum.
     hwb = GenericColor(hueDegree, //
-                       hwbWhitenessPercentage, //
-                       hwbBlacknessPercentage);
+                       qBound(0., minimum * 100, 100.), //
+                       qBound(0., (1 - maximum) * 100, 100.));
 }
 
 /** @brief Static convenience function that returns a @ref RgbColor
@@ -164,6 +192,26 @@ RgbColor RgbColor::fromRgbQColor(const QColor &color)
     return result;
 }
 
+/** @brief Static convenience function that returns a list of
+ * @ref RgbColor constructed from the given colors.
+ *
+ * Batch variant of @ref fromRgbQColor(), intended for converting
+ * whole palettes at once.
+ *
+ * @param colors Original colors. The opacity (alpha channel) is ignored.
+ *
+ * @returns A list of @ref RgbColor objects representing these colors,
+ * in the same order. */
+QList<RgbColor> RgbColor::fromRgbQColors(const QList<QColor> &colors)
+{
+    QList<RgbColor> result;
+    result.reserve(colors.count());
+    for (const QColor &color : colors) {
+        result.append(fromRgbQColor(color));
+    }
+    return result;
+}
+
 /** @brief Static convenience function that returns a @ref RgbColor
  * constructed from the given color.
  *
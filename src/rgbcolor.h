@@ -8,6 +8,7 @@
 #include <optional>
 #include <qcolor.h>
 #include <qdebug.h>
+#include <qlist.h>
 #include <qstring.h>
 
 namespace PerceptualColor
@@ -46,9 +47,6 @@ namespace PerceptualColor
  * @ref operator<<(QDebug dbg, const PerceptualColor::RgbColor &value)
  *
  * @sa @ref AbsoluteColor
- *
- * @todo NICETOHAVE Implement our own conversions from RGB to HSL etc. to
- * get higher precsion than we currently get by relying on QColor.
  */
 class RgbColor
 {
@@ -59,6 +57,7 @@ public:
     [[nodiscard]] static RgbColor fromRgb1(const GenericColor &color, std::optional<double> hue = std::optional<double>());
     [[nodiscard]] static RgbColor fromRgb255(const GenericColor &color, std::optional<double> hue = std::optional<double>());
     [[nodiscard]] static RgbColor fromRgbQColor(const QColor &color);
+    [[nodiscard]] static QList<RgbColor> fromRgbQColors(const QList<QColor> &colors);
 
     /** @brief Constructor for an uninitialized object.
      *
@@ -0,0 +1,36 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+// Own headers
+// First the interface, which forces the header to be self-contained.
+#include "setdiskcachedirectory.h"
+
+#include "asyncimagediskcache.h"
+#include <qstring.h>
+
+namespace PerceptualColor
+{
+
+/** @brief Enables the persistent cache of rendered images.
+ *
+ * Some images, like the color wheel, are expensive to render but rarely
+ * change between two application starts. When the disk cache is enabled,
+ * these images are stored on the disk and loaded at the next application
+ * start, so that the widgets are fully rendered faster.
+ *
+ * The disk cache is disabled by default.
+ *
+ * It is safe to call this function multiple times, also from different
+ * threads. It only affects widgets that are created afterwards.
+ *
+ * @param directory The directory in which the images are stored. It is
+ * created if necessary. A good choice is a subdirectory of
+ * <tt>QStandardPaths::writableLocation(QStandardPaths::CacheLocation)</tt>.
+ * The library manages the content of this directory; do not store
+ * anything else in it. An empty string disables the disk cache. */
+void setDiskCacheDirectory(const QString &directory)
+{
+    AsyncImageDiskCache::setDirectory(directory);
+}
+
+} // namespace PerceptualColor
@@ -0,0 +1,24 @@
+﻿// SPDX-FileCopyrightText: Lukas Sommer <sommerluk@gmail.com>
+// SPDX-License-Identifier: BSD-2-Clause OR MIT
+
+/**
+ * @file
+ *
+ * This file provides support for the persistent image cache.
+ */
+
+#ifndef PERCEPTUALCOLOR_SETDISKCACHEDIRECTORY_H
+#define PERCEPTUALCOLOR_SETDISKCACHEDIRECTORY_H
+
+#include "importexport.h"
+
+class QString;
+
+namespace PerceptualColor
+{
+
+void PERCEPTUALCOLOR_IMPORTEXPORT setDiskCacheDirectory(const QString &directory);
+
+} // namespace PerceptualColor
+
+#endif // PERCEPTUALCOLOR_SETDISKCACHEDIRECTORY_H
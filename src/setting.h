@@ -6,19 +6,40 @@
 
 #include "settingbase.h"
 #include "settings.h"
+#include <initializer_list>
 #include <qbytearray.h>
 #include <qglobal.h>
+#include <qlist.h>
 #include <qmetaobject.h>
 #include <qmetatype.h>
+#include <qsettings.h>
 #include <qstring.h>
+#include <qstringliteral.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
+#include <type_traits>
 
 class QObject;
 
 namespace PerceptualColor
 {
 
+/** @internal
+ *
+ * @brief If a type is a <tt>QList</tt>.
+ *
+ * @tparam T The type to test. */
+template<typename T>
+inline constexpr bool isQList = false;
+
+/** @internal
+ *
+ * @brief If a type is a <tt>QList</tt>.
+ *
+ * @tparam U Element type of the list. */
+template<typename U>
+inline constexpr bool isQList<QList<U>> = true;
+
 /** @internal
  *
  * @brief A single setting within @ref Settings.
@@ -28,7 +49,25 @@ namespace PerceptualColor
  *           @ref PerceptualSettings::ColorList and many build-in types
  *           qualify. However, enum types only qualify if both, they are
  *           declared with <tt>Q_ENUM</tt> <em>and</em> their underlying type
- *           is <tt>int</tt>. */
+ *           is <tt>int</tt>.
+ *
+ * <tt>QList</tt> types are not stored as a single value, but element by
+ * element in a sub-group of the key: <tt>size</tt> holds the number of
+ * elements, <tt>first</tt> the smallest used element number, and each
+ * element has its own numbered key. Elements are numbered from the end
+ * of the list, so list index <tt>i</tt> is stored under the number
+ * <tt>first + size - 1 - i</tt>. Thanks to this, @ref setValue() can
+ * compare the new list with the old one and write only the elements
+ * that actually changed. Prepending an element and dropping the last one
+ * (which is what a history does) touches only one element key, no matter
+ * how long the list is. A list that an older version has stored as a
+ * single value is still read, and converted to the new format on the
+ * next write.
+ *
+ * @note <tt>QSettings</tt> with the INI format still rewrites the whole
+ * file when it synchronizes. What is saved is the serialization of
+ * unchanged elements and, when several processes share the file, the
+ * risk that two writers overwrite each other’s unrelated elements. */
 template<typename T>
 class Setting : public SettingBase
 {
@@ -49,13 +88,31 @@ private:
     /** @brief If the type is an enum type or not. */
     static constexpr bool m_isEnum = std::is_enum_v<T>;
 
+    /** @brief If the type is a <tt>QList</tt> type or not.
+     *
+     * List types are stored element by element. See @ref Setting for
+     * details. */
+    static constexpr bool m_isList = isQList<T>;
+
+    /** @brief For list types: The smallest element number that is
+     * currently used in @ref underlyingQSettings().
+     *
+     * Might be negative after elements have been appended. */
+    qsizetype m_listFirst = 0;
+
+    /** @brief For list types: If @ref underlyingQSettings() contains the
+     * list still in the legacy format as a single value. */
+    bool m_isLegacyList = false;
+
     /** @brief Meta data for enum types. */
     QMetaEnum m_qMetaEnum;
 
     /** @brief Internal storage for the value. */
     T m_value = T();
 
+    [[nodiscard]] QString listElementKey(qsizetype number) const;
     void updateFromQSettings();
+    void writeListToQSettings(const T &oldValue, const T &newValue);
 
     /** @internal @brief Only for unit tests. */
     friend class TestSetting;
@@ -151,7 +208,30 @@ void Setting<T>::updateFromQSettings()
     // Get new value.
     const QVariant newValueVariant = underlyingQSettings()->value(m_key);
     T newValue;
-    if constexpr (m_isEnum) {
+    if constexpr (m_isList) {
+        QSettings *const qSettings = underlyingQSettings();
+        const QString sizeKey = m_key + QStringLiteral("/size");
+        if (qSettings->contains(sizeKey)) {
+            const qsizetype size = qMax<qsizetype>( //
+                0,
+                qSettings->value(sizeKey).toLongLong());
+            const qsizetype first = //
+                qSettings->value(m_key + QStringLiteral("/first")).toLongLong();
+            const qsizetype top = first + size - 1;
+            newValue.reserve(size);
+            for (qsizetype i = 0; i < size; ++i) {
+                newValue.append( //
+                    qSettings->value(listElementKey(top - i)) //
+                        .template value<typename T::value_type>());
+            }
+            m_listFirst = first;
+            m_isLegacyList = false;
+        } else {
+            newValue = newValueVariant.value<T>();
+            m_listFirst = 0;
+            m_isLegacyList = qSettings->contains(m_key);
+        }
+    } else if constexpr (m_isEnum) {
         const QByteArray byteArray = newValueVariant.toString().toUtf8();
         const int enumInteger = //
             byteArray.isEmpty() //
@@ -184,8 +264,11 @@ template<typename T>
 void Setting<T>::setValue(const T &newValue)
 {
     if (newValue != m_value) {
+        const T oldValue = m_value;
         m_value = newValue;
-        if constexpr (m_isEnum) {
+        if constexpr (m_isList) {
+            writeListToQSettings(oldValue, m_value);
+        } else if constexpr (m_isEnum) {
             const auto newValueAsIntegral = static_cast<quint64>(newValue);
             const QString string = QString::fromUtf8( //
                 m_qMetaEnum.valueToKeys(newValueAsIntegral));
@@ -198,6 +281,105 @@ void Setting<T>::setValue(const T &newValue)
     }
 }
 
+/** @brief The key of a single list element.
+ *
+ * @param number The element number (not the list index).
+ *
+ * @returns The key of a single list element within
+ * @ref underlyingQSettings(). See @ref Setting for details. */
+template<typename T>
+QString Setting<T>::listElementKey(qsizetype number) const
+{
+    return m_key + QStringLiteral("/") + QString::number(number);
+}
+
+/** @brief Writes a list to @ref underlyingQSettings(), touching only
+ * keys whose content actually changes.
+ *
+ * Element numbers are counted from the end of the list (see
+ * @ref Setting). If elements are prepended or removed at the front, the
+ * whole numbering range is shifted by one, so that the unchanged
+ * elements keep their keys. This function tries the shifts −1, 0 and +1
+ * and uses the one that needs the fewest key changes.
+ *
+ * @param oldValue The list as it is currently stored.
+ * @param newValue The list that should be stored. */
+template<typename T>
+void Setting<T>::writeListToQSettings(const T &oldValue, const T &newValue)
+{
+    QSettings *const qSettings = underlyingQSettings();
+    const QString sizeKey = m_key + QStringLiteral("/size");
+    const QString firstKey = m_key + QStringLiteral("/first");
+
+    qsizetype oldSize = oldValue.size();
+    qsizetype oldFirst = m_listFirst;
+    if (m_isLegacyList) {
+        // Removes also all sub-keys, so start from scratch.
+        qSettings->remove(m_key);
+        oldSize = 0;
+        oldFirst = 0;
+        m_isLegacyList = false;
+    }
+    const qsizetype oldTop = oldFirst + oldSize - 1;
+    const qsizetype newSize = newValue.size();
+
+    // With a given shift, list index i is stored under the number
+    // oldTop + shift - i. It keeps its key if the old list had the same
+    // element at index i - shift.
+    const auto isUnchanged = [&](qsizetype i, qsizetype shift) {
+        const qsizetype oldIndex = i - shift;
+        return (oldIndex >= 0) //
+            && (oldIndex < oldSize) //
+            && (oldValue.at(oldIndex) == newValue.at(i));
+    };
+
+    // An empty old list has nothing to keep: Start numbering at 0.
+    qsizetype bestShift = 0;
+    qsizetype bestFirst = 0;
+    qsizetype bestCost = -1;
+    const auto shifts = (oldSize > 0) //
+        ? std::initializer_list<qsizetype>{0, 1, -1}
+        : std::initializer_list<qsizetype>{};
+    for (const qsizetype shift : shifts) {
+        const qsizetype first = oldTop + shift - newSize + 1;
+        const qsizetype top = first + newSize - 1;
+        qsizetype cost = 0;
+        for (qsizetype i = 0; i < newSize; ++i) {
+            if (!isUnchanged(i, shift)) {
+                ++cost;
+            }
+        }
+        // Old keys outside the new range have to be removed.
+        cost += qMax<qsizetype>(0, first - oldFirst);
+        cost += qMax<qsizetype>(0, oldTop - top);
+        if ((bestCost < 0) || (cost < bestCost)) {
+            bestShift = shift;
+            bestFirst = first;
+            bestCost = cost;
+        }
+    }
+    const qsizetype newTop = bestFirst + newSize - 1;
+
+    for (qsizetype number = oldFirst; number <= oldTop; ++number) {
+        if ((number < bestFirst) || (number > newTop)) {
+            qSettings->remove(listElementKey(number));
+        }
+    }
+    for (qsizetype i = 0; i < newSize; ++i) {
+        if (!isUnchanged(i, bestShift)) {
+            qSettings->setValue(listElementKey(newTop - i), //
+                                QVariant::fromValue(newValue.at(i)));
+        }
+    }
+    if ((bestFirst != oldFirst) || !qSettings->contains(firstKey)) {
+        qSettings->setValue(firstKey, static_cast<qlonglong>(bestFirst));
+    }
+    if ((newSize != oldSize) || !qSettings->contains(sizeKey)) {
+        qSettings->setValue(sizeKey, static_cast<qlonglong>(newSize));
+    }
+    m_listFirst = bestFirst;
+}
+
 } // namespace PerceptualColor
 
 #endif // PERCEPTUALCOLOR_SETTING_H
@@ -27,9 +27,11 @@
 #include <qcoreevent.h>
 #include <qevent.h>
 #include <qfontmetrics.h>
+#include <qhash.h>
 #include <qicon.h>
 #include <qline.h>
 #include <qlist.h>
+#include <qmath.h>
 #include <qmargins.h>
 #include <qmenu.h>
 #include <qmetatype.h>
@@ -37,8 +39,13 @@
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qpen.h>
+#include <qpixmap.h>
 #include <qpoint.h>
+#include <qpointer.h>
+#include <qregion.h>
 #include <qrect.h>
+#include <qrgba64.h>
+#include <qscrollbar.h>
 #include <qsizepolicy.h>
 #include <qstringliteral.h>
 #include <qstyle.h>
@@ -112,6 +119,9 @@ void SwatchBookPrivate::retranslateUi()
     rendering.) */
     m_addMarkAvailableInCurrentFont = validateWithFont(tr("+"));
 
+    // The “add” mark is part of the pre-rendered color patches.
+    invalidateSwatchPixmap(false);
+
     // Schedule a paint event to make the changes visible.
     q_pointer->update();
 }
@@ -145,7 +155,7 @@ void SwatchBook::mousePressEvent(QMouseEvent *event)
     // and we have valid indexes.
 
     const bool swatchIsEmpty = //
-        !d_pointer->m_swatchGrid.value(logicalColumn, logicalRow).isValid();
+        !d_pointer->swatch(logicalColumn, logicalRow).isValid();
 
     if (event->button() == Qt::MouseButton::RightButton) {
         if (d_pointer->m_isEditable && (!swatchIsEmpty)) {
@@ -160,13 +170,13 @@ void SwatchBook::mousePressEvent(QMouseEvent *event)
                     &QAction::triggered, //
                     this, //
                     [this, logicalColumn, logicalRow]() {
-                        d_pointer->m_swatchGrid.setValue(logicalColumn, //
-                                                         logicalRow, //
-                                                         QColor());
+                        d_pointer->setSwatch(logicalColumn, //
+                                             logicalRow, //
+                                             QColor());
                         // If the deleted swatch was the currently selected
                         // swatch, the selection mark needs an update:
                         d_pointer->selectSwatchFromCurrentColor();
-                        Q_EMIT swatchGridChanged(d_pointer->m_swatchGrid);
+                        Q_EMIT swatchGridChanged(d_pointer->unpackedSwatchGrid());
                     });
             menu->popup(mapToGlobal(event->pos())); // Display asynchronously
             return;
@@ -176,12 +186,12 @@ void SwatchBook::mousePressEvent(QMouseEvent *event)
 
     if (event->button() == Qt::MouseButton::LeftButton) {
         if (d_pointer->m_isEditable && swatchIsEmpty) {
-            d_pointer->m_swatchGrid.setValue(logicalColumn, //
-                                             logicalRow, //
-                                             d_pointer->m_currentColor);
+            d_pointer->setSwatch(logicalColumn, //
+                                 logicalRow, //
+                                 d_pointer->m_currentColor);
             d_pointer->selectSwatchByLogicalCoordinates(logicalColumn, //
                                                         logicalRow);
-            Q_EMIT swatchGridChanged(d_pointer->m_swatchGrid);
+            Q_EMIT swatchGridChanged(d_pointer->unpackedSwatchGrid());
         } else {
             d_pointer->selectSwatchByLogicalCoordinates(logicalColumn, //
                                                         logicalRow);
@@ -222,6 +232,18 @@ SwatchBook::SwatchBook(const PerceptualColor::QColorArray2D &swatchGrid, Qt::Ori
     d_pointer->retranslateUi();
 
     setSwatchGrid(swatchGrid);
+
+    // Created only after the initial swatch grid has been set, because
+    // updating the scroll bar would polish the widget prematurely. The
+    // scroll bar gets its geometry with the first resize event.
+    d_pointer->m_scrollBar = new QScrollBar(Qt::Orientation::Vertical, this);
+    // Keyboard navigation is done by the swatch book itself.
+    d_pointer->m_scrollBar->setFocusPolicy(Qt::FocusPolicy::NoFocus);
+    d_pointer->m_scrollBar->hide();
+    connect(d_pointer->m_scrollBar, //
+            &QScrollBar::valueChanged, //
+            this, //
+            [this]() { update(); });
 }
 
 /** @brief Destructor */
@@ -270,7 +292,15 @@ QSize SwatchBook::minimumSizeHint() const
     ensurePolished();
     QStyleOptionFrame myOption;
     d_pointer->initStyleOption(&myOption);
-    const auto contentSize = d_pointer->colorPatchesSizeWithMargin();
+    auto contentSize = d_pointer->colorPatchesSizeWithMargin();
+    const qsizetype hiddenRowCount = //
+        d_pointer->m_swatchGrid.jCount() - d_pointer->m_maximumVisibleRowCount;
+    if ((d_pointer->m_maximumVisibleRowCount > 0) && (hiddenRowCount > 0)) {
+        const int rowHeight = d_pointer->patchSizeOuter().height() //
+            + d_pointer->verticalPatchSpacing();
+        contentSize.rheight() -= static_cast<int>(hiddenRowCount) * rowHeight;
+        contentSize.rwidth() += d_pointer->scrollBarExtent();
+    }
     const auto styleSize = style()->sizeFromContents(QStyle::CT_LineEdit, //
                                                      &myOption,
                                                      contentSize,
@@ -318,45 +348,170 @@ void SwatchBook::setCurrentColor(const QColor &newCurrentColor)
 // and its getters are in the header)
 QColorArray2D SwatchBook::swatchGrid() const
 {
-    return d_pointer->m_swatchGrid;
+    return d_pointer->unpackedSwatchGrid();
 }
 
 /** @brief Setter for the @ref swatchGrid property.
  *
  * @pre The colors are fully opaque (alpha = 100%).
  *
- * @param newSwatchGrid the new value */
+ * @param newSwatchGrid the new value
+ *
+ * @note The colors are stored internally as packed values with 16 bit per
+ * channel. Therefore, the getter returns the colors converted to
+ * <tt>QColor::Spec::Rgb</tt> and fully opaque.
+ *
+ * @sa @ref setPackedSwatchGrid() */
 void SwatchBook::setSwatchGrid(const PerceptualColor::QColorArray2D &newSwatchGrid)
 {
-    QColorArray2D newOpaqueSwatchGrid = newSwatchGrid;
-    for (int i = 0; i < newOpaqueSwatchGrid.iCount(); ++i) {
-        for (int j = 0; j < newOpaqueSwatchGrid.jCount(); ++j) {
-            QColor temp = newOpaqueSwatchGrid.value(i, j);
-            if (temp.isValid() && (temp.alphaF() != 1)) {
-                temp.setAlphaF(1);
-                newOpaqueSwatchGrid.setValue(i, j, temp);
+    QRgba64Array2D newPackedSwatchGrid( //
+        newSwatchGrid.iCount(),
+        newSwatchGrid.jCount());
+    for (qsizetype i = 0; i < newSwatchGrid.iCount(); ++i) {
+        for (qsizetype j = 0; j < newSwatchGrid.jCount(); ++j) {
+            newPackedSwatchGrid.setValue( //
+                i,
+                j,
+                SwatchBookPrivate::packSwatch(newSwatchGrid.value(i, j)));
+        }
+    }
+    setPackedSwatchGrid(newPackedSwatchGrid);
+}
+
+/** @brief The swatches as packed values.
+ *
+ * This is the internal storage of the @ref swatchGrid property, so this
+ * getter is cheap and does not create any <tt>QColor</tt> objects.
+ *
+ * @returns The @ref swatchGrid property as packed values. Empty swatches
+ * are fully transparent (all bits 0), all other swatches are fully opaque.
+ *
+ * @sa @ref setPackedSwatchGrid() */
+QRgba64Array2D SwatchBook::packedSwatchGrid() const
+{
+    return d_pointer->m_swatchGrid;
+}
+
+/** @brief Sets the swatches from packed values.
+ *
+ * Equivalent to @ref setSwatchGrid(), but without any <tt>QColor</tt>
+ * objects. This is meant for large palettes.
+ *
+ * @param newSwatchGrid The new value for the @ref swatchGrid property.
+ * Values with an alpha of <tt>0</tt> mean empty swatches. All other
+ * values are treated as fully opaque colors in the current color engine’s
+ * working gamut.
+ *
+ * @sa @ref packedSwatchGrid() */
+void SwatchBook::setPackedSwatchGrid(const PerceptualColor::QRgba64Array2D &newSwatchGrid)
+{
+    QRgba64Array2D newPackedSwatchGrid = newSwatchGrid;
+    for (qsizetype i = 0; i < newPackedSwatchGrid.iCount(); ++i) {
+        for (qsizetype j = 0; j < newPackedSwatchGrid.jCount(); ++j) {
+            QRgba64 swatch = newPackedSwatchGrid.value(i, j);
+            if (swatch.alpha() == 0) {
+                swatch = QRgba64::fromRgba64(0);
+            } else {
+                swatch.setAlpha(0xffff);
             }
+            newPackedSwatchGrid.setValue(i, j, swatch);
         }
     }
 
-    if (newOpaqueSwatchGrid == d_pointer->m_swatchGrid) {
+    if (newPackedSwatchGrid == d_pointer->m_swatchGrid) {
         return;
     }
 
-    d_pointer->m_swatchGrid = newOpaqueSwatchGrid;
+    d_pointer->m_swatchGrid = newPackedSwatchGrid;
+    d_pointer->m_swatchIndex.reset();
+    d_pointer->invalidateSwatchPixmap(true);
 
     d_pointer->selectSwatchFromCurrentColor();
 
-    Q_EMIT swatchGridChanged(newOpaqueSwatchGrid);
+    Q_EMIT swatchGridChanged(d_pointer->unpackedSwatchGrid());
 
     // As of Qt documentation:
     //     “Notifies the layout system that this widget has changed and may
     //      need to change geometry.”
     updateGeometry();
 
+    d_pointer->updateScrollBar();
+
     update();
 }
 
+/** @brief Packs a color for storage in @ref m_swatchGrid.
+ *
+ * @param color The color. An invalid color means an empty swatch.
+ *
+ * @returns The color as fully opaque packed value, or a fully
+ * transparent value (all bits 0) if the color is invalid. */
+QRgba64 SwatchBookPrivate::packSwatch(const QColor &color)
+{
+    if (!color.isValid()) {
+        return QRgba64::fromRgba64(0);
+    }
+    QRgba64 result = toRgbExact(color).rgba64();
+    result.setAlpha(0xffff);
+    return result;
+}
+
+/** @brief Unpacks a value from @ref m_swatchGrid.
+ *
+ * @param swatch The packed value.
+ *
+ * @returns The color with <tt>QColor::Spec::Rgb</tt>, or an invalid color
+ * if the swatch is empty. */
+QColor SwatchBookPrivate::unpackSwatch(const QRgba64 swatch)
+{
+    if (swatch.alpha() == 0) {
+        return QColor();
+    }
+    return QColor::fromRgba64(swatch);
+}
+
+/** @brief The color of a swatch.
+ *
+ * @param column Index of the column in @ref m_swatchGrid.
+ * @param row Index of the row in @ref m_swatchGrid.
+ *
+ * @returns The color of the swatch, or an invalid color if the swatch is
+ * empty or the indices are out of range. */
+QColor SwatchBookPrivate::swatch(const qsizetype column, const qsizetype row) const
+{
+    return unpackSwatch(m_swatchGrid.value(column, row));
+}
+
+/** @brief Sets the color of a single swatch.
+ *
+ * Invalidates the caches that depend on @ref m_swatchGrid and schedules
+ * a paint event. Does not emit any signal.
+ *
+ * @param column Index of the column in @ref m_swatchGrid.
+ * @param row Index of the row in @ref m_swatchGrid.
+ * @param color The new color. An invalid color means an empty swatch. */
+void SwatchBookPrivate::setSwatch(const qsizetype column, const qsizetype row, const QColor &color)
+{
+    m_swatchGrid.setValue(column, row, packSwatch(color));
+    m_swatchIndex.reset();
+    invalidateSwatchPixmap(true);
+    q_pointer->update();
+}
+
+/** @brief The swatches of @ref m_swatchGrid as <tt>QColor</tt>.
+ *
+ * @returns The swatches of @ref m_swatchGrid as <tt>QColor</tt>. */
+QColorArray2D SwatchBookPrivate::unpackedSwatchGrid() const
+{
+    QColorArray2D result(m_swatchGrid.iCount(), m_swatchGrid.jCount());
+    for (qsizetype i = 0; i < m_swatchGrid.iCount(); ++i) {
+        for (qsizetype j = 0; j < m_swatchGrid.jCount(); ++j) {
+            result.setValue(i, j, unpackSwatch(m_swatchGrid.value(i, j)));
+        }
+    }
+    return result;
+}
+
 /** @brief Selects a swatch from the book.
  *
  * @pre Both parameters must be valid indexes within @ref m_swatchGrid.
@@ -378,10 +533,11 @@ void SwatchBook::setSwatchGrid(const PerceptualColor::QColorArray2D &newSwatchGr
  * @post If the specified swatch is empty, no action is taken. Otherwise, the
  *       swatch is selected, the selection mark becomes visible, and
  *       @ref SwatchBook::currentColor is updated to reflect the selected color.
+ *       If the widget is scrolling, the swatch is scrolled into view.
  */
 void SwatchBookPrivate::selectSwatchByLogicalCoordinates(qsizetype newCurrentColumn, qsizetype newCurrentRow)
 {
-    const QColor newColor = m_swatchGrid.value(newCurrentColumn, newCurrentRow);
+    const QColor newColor = swatch(newCurrentColumn, newCurrentRow);
     if (newColor.isValid()) {
         m_selectedColumn = newCurrentColumn;
         m_selectedRow = newCurrentRow;
@@ -389,10 +545,140 @@ void SwatchBookPrivate::selectSwatchByLogicalCoordinates(qsizetype newCurrentCol
             m_currentColor = newColor;
             Q_EMIT q_pointer->currentColorChanged(newColor);
         }
+        ensureSwatchVisible(newCurrentColumn, newCurrentRow);
         q_pointer->update();
     }
 }
 
+/** @brief Scrolls a swatch into view.
+ *
+ * If the widget is scrolling (see @ref maximumScrollValue()), this
+ * function adjusts @ref m_scrollBar so that the given swatch becomes
+ * visible within @ref viewportRect(). Otherwise, nothing happens.
+ *
+ * @param column Index of the column in @ref m_swatchGrid.
+ * @param row Index of the row in @ref m_swatchGrid. */
+void SwatchBookPrivate::ensureSwatchVisible(const qsizetype column, const qsizetype row)
+{
+    updateScrollBar();
+    if (maximumScrollValue() <= 0) {
+        return;
+    }
+    QStyleOptionFrame myFrameStyleOption;
+    initStyleOption(&myFrameStyleOption);
+    const QRect rect = patchRect(contentOffset(myFrameStyleOption), column, row);
+    const QRect viewport = viewportRect();
+    const int spacing = verticalPatchSpacing();
+    int newValue = scrollValue();
+    if (rect.top() - spacing < viewport.top()) {
+        newValue -= viewport.top() - (rect.top() - spacing);
+    } else if (rect.bottom() + spacing > viewport.bottom()) {
+        newValue += (rect.bottom() + spacing) - viewport.bottom();
+    }
+    m_scrollBar->setValue(newValue);
+}
+
+/** @brief The inside of the frame.
+ *
+ * @returns The rectangle of the widget without the frame, in logical
+ * pixels relative to the widget.
+ *
+ * @sa @ref viewportRect() */
+QRect SwatchBookPrivate::frameInnerRect() const
+{
+    QStyleOptionFrame myFrameStyleOption;
+    initStyleOption(&myFrameStyleOption);
+    const int lineWidth = qMax(myFrameStyleOption.lineWidth, 0);
+    return q_pointer->rect().marginsRemoved( //
+        QMargins(lineWidth, lineWidth, lineWidth, lineWidth));
+}
+
+/** @brief The part of the widget that can show color patches.
+ *
+ * @returns The inside of the frame, without the space of @ref m_scrollBar
+ * if the widget is scrolling. In logical pixels relative to the widget.
+ *
+ * @sa @ref frameInnerRect() */
+QRect SwatchBookPrivate::viewportRect() const
+{
+    QRect result = frameInnerRect();
+    if (maximumScrollValue() > 0) {
+        if (q_pointer->layoutDirection() == Qt::LayoutDirection::LeftToRight) {
+            result.setRight(result.right() - scrollBarExtent());
+        } else {
+            result.setLeft(result.left() + scrollBarExtent());
+        }
+    }
+    return result;
+}
+
+/** @brief Width of @ref m_scrollBar.
+ *
+ * @returns Width of @ref m_scrollBar, measured in device-independent
+ * pixels. The value depends on the current <tt>QStyle</tt>. */
+int SwatchBookPrivate::scrollBarExtent() const
+{
+    return q_pointer->style()->pixelMetric( //
+        QStyle::PM_ScrollBarExtent,
+        nullptr,
+        q_pointer.toPointerToConstObject());
+}
+
+/** @brief How far the content can be scrolled.
+ *
+ * @returns The height of the color patches (including margins) that does
+ * not fit into the frame, measured in device-independent pixels. If
+ * everything fits, this is <tt>0</tt>, and the widget is not scrolling. */
+int SwatchBookPrivate::maximumScrollValue() const
+{
+    const int availableHeight = frameInnerRect().height();
+    return qMax(colorPatchesSizeWithMargin().height() - availableHeight, 0);
+}
+
+/** @brief The current vertical scroll position.
+ *
+ * @returns The value of @ref m_scrollBar, bound to the range from
+ * <tt>0</tt> to @ref maximumScrollValue(). Measured in device-independent
+ * pixels. */
+int SwatchBookPrivate::scrollValue() const
+{
+    const int maximum = maximumScrollValue();
+    if ((maximum <= 0) || (m_scrollBar == nullptr)) {
+        return 0;
+    }
+    return qBound(0, m_scrollBar->value(), maximum);
+}
+
+/** @brief Updates geometry, range and visibility of @ref m_scrollBar.
+ *
+ * Meant to be called after anything that might change the size of
+ * the widget or the content. Schedules a paint event. */
+void SwatchBookPrivate::updateScrollBar()
+{
+    if (m_scrollBar == nullptr) {
+        return;
+    }
+    const int maximum = maximumScrollValue();
+    if (maximum <= 0) {
+        m_scrollBar->hide();
+        m_scrollBar->setRange(0, 0);
+    } else {
+        const QRect inner = frameInnerRect();
+        const int extent = scrollBarExtent();
+        const int x = //
+            (q_pointer->layoutDirection() == Qt::LayoutDirection::LeftToRight) //
+            ? inner.right() + 1 - extent //
+            : inner.left();
+        m_scrollBar->setGeometry(x, inner.top(), extent, inner.height());
+        m_scrollBar->setRange(0, maximum);
+        m_scrollBar->setPageStep(inner.height());
+        m_scrollBar->setSingleStep( //
+            patchSizeOuter().height() + verticalPatchSpacing());
+        m_scrollBar->show();
+    }
+    q_pointer->update();
+}
+
 /** @brief Selects a swatch from the grid.
  *
  * @post If the currently selected swatch corresponds to
@@ -412,32 +698,36 @@ void SwatchBookPrivate::selectSwatchFromCurrentColor()
     }
 
     if ((m_selectedColumn >= 0) && (m_selectedRow >= 0)) {
-        if (m_swatchGrid.value(m_selectedColumn, m_selectedRow) == m_currentColor) {
+        if (swatch(m_selectedColumn, m_selectedRow) == m_currentColor) {
             return;
         }
     }
 
-    bool colorFound = false;
     const qsizetype myColumnCount = m_swatchGrid.iCount();
-    const qsizetype myRowCount = m_swatchGrid.jCount();
-    int columnIndex = 0;
-    int rowIndex = 0;
-    for (columnIndex = 0; //
-         columnIndex < myColumnCount; //
-         ++columnIndex) {
-        for (rowIndex = 0; rowIndex < myRowCount; ++rowIndex) {
-            if (m_swatchGrid.value(columnIndex, rowIndex) == m_currentColor) {
-                colorFound = true;
-                break;
+    if (!m_swatchIndex.has_value()) {
+        // Build the index in the same order in which a linear search
+        // would find the swatches: column by column.
+        QHash<quint64, qsizetype> index;
+        for (qsizetype columnIndex = 0; columnIndex < myColumnCount; ++columnIndex) {
+            for (qsizetype rowIndex = 0; rowIndex < m_swatchGrid.jCount(); ++rowIndex) {
+                const QRgba64 packed = m_swatchGrid.value(columnIndex, rowIndex);
+                if ((packed.alpha() != 0) && !index.contains(packed)) {
+                    index.insert(packed, columnIndex + rowIndex * myColumnCount);
+                }
             }
         }
-        if (colorFound) {
-            break;
-        }
+        m_swatchIndex = index;
     }
-    if (colorFound) {
-        m_selectedColumn = columnIndex;
-        m_selectedRow = rowIndex;
+
+    // Swatches are always fully opaque. A current color with another
+    // opacity never matches a swatch.
+    const QRgba64 packedCurrentColor = m_currentColor.rgba64();
+    const qsizetype position = (packedCurrentColor.alpha() == 0xffff) //
+        ? m_swatchIndex->value(packedCurrentColor, -1) //
+        : -1;
+    if (position >= 0) {
+        m_selectedColumn = position % myColumnCount;
+        m_selectedRow = position / myColumnCount;
     } else {
         m_selectedColumn = -1;
         m_selectedRow = -1;
@@ -589,6 +879,15 @@ QPoint SwatchBookPrivate::contentOffset(const QStyleOptionFrame &styleOptionFram
     frameOffset.rx() -= swatchbookContentSize.width() / 2.;
     frameOffset.ry() -= swatchbookContentSize.height() / 2.;
 
+    // If the content does not fit, it starts at the top of the viewport,
+    // moved by the scroll position.
+    if (maximumScrollValue() > 0) {
+        const QRectF viewport = viewportRect();
+        frameOffset.rx() = viewport.center().x() //
+            - swatchbookContentSize.width() / 2.;
+        frameOffset.ry() = viewport.top() - scrollValue();
+    }
+
     return (frameOffset + innerMarginOffset).toPoint();
 }
 
@@ -610,6 +909,10 @@ std::pair<qsizetype, qsizetype> SwatchBookPrivate::logicalColumnRowFromPosition(
 {
     constexpr std::pair<qsizetype, qsizetype> invalid(-1, -1);
 
+    if ((maximumScrollValue() > 0) && !viewportRect().contains(position)) {
+        return invalid; // Position on a patch that is scrolled out of view
+    }
+
     const QSize myColorPatchSize = patchSizeOuter();
     const int myPatchWidth = myColorPatchSize.width();
     const int myPatchHeight = myColorPatchSize.height();
@@ -658,6 +961,97 @@ std::pair<qsizetype, qsizetype> SwatchBookPrivate::logicalColumnRowFromPosition(
     return std::pair<qsizetype, qsizetype>(columnIndex, rowIndex);
 }
 
+/** @brief The rectangle of a color patch.
+ *
+ * This is the inverse of @ref logicalColumnRowFromPosition() and takes
+ * constant time.
+ *
+ * @param offset The offset as provided by @ref contentOffset()
+ * @param column The logical column in @ref m_swatchGrid.
+ * @param row The row in @ref m_swatchGrid.
+ *
+ * @returns The rectangle of the color patch (outer limit) in logical
+ * pixels relative to the widget. In right-to-left layouts, the columns
+ * are mirrored. */
+QRect SwatchBookPrivate::patchRect(const QPoint offset, const qsizetype column, const qsizetype row) const
+{
+    const qsizetype visualColumn = //
+        (q_pointer->layoutDirection() == Qt::LayoutDirection::LeftToRight) //
+        ? column //
+        : m_swatchGrid.iCount() - 1 - column;
+    const QSize size = patchSizeOuter();
+    return QRect( //
+        offset.x() //
+            + static_cast<int>(visualColumn) * (size.width() + horizontalPatchSpacing()),
+        offset.y() //
+            + static_cast<int>(row) * (size.height() + verticalPatchSpacing()),
+        size.width(),
+        size.height());
+}
+
+/** @brief The rows that intersect with a given rectangle.
+ *
+ * This takes constant time, independent of the number of rows.
+ *
+ * @param offset The offset as provided by @ref contentOffset()
+ * @param rect A rectangle in logical pixels relative to the widget.
+ *
+ * @returns The first and the last row in @ref m_swatchGrid that
+ * intersect with the given rectangle. If no row intersects, the last
+ * row is smaller than the first row. */
+std::pair<qsizetype, qsizetype> SwatchBookPrivate::rowRangeInRect(const QPoint offset, const QRect &rect) const
+{
+    constexpr std::pair<qsizetype, qsizetype> none(0, -1);
+    const int rowHeight = patchSizeOuter().height() + verticalPatchSpacing();
+    if ((rowHeight <= 0) || (m_swatchGrid.jCount() <= 0) || rect.isEmpty()) {
+        return none;
+    }
+    const int top = qMax(rect.top() - offset.y(), 0);
+    const int bottom = rect.bottom() - offset.y();
+    if (bottom < 0) {
+        return none;
+    }
+    const qsizetype lastRow = m_swatchGrid.jCount() - 1;
+    return std::pair<qsizetype, qsizetype>( //
+        qMin<qsizetype>(top / rowHeight, lastRow + 1),
+        qMin<qsizetype>(bottom / rowHeight, lastRow));
+}
+
+/** @brief The part of the widget that is currently visible.
+ *
+ * @returns The bounding rectangle of the visible part of the widget, in
+ * logical pixels relative to the widget. While the widget is not visible
+ * at all, this is the whole rectangle of the widget. If the widget is
+ * scrolling, this is limited to the @ref viewportRect(). Also, if parts
+ * of the widget are clipped away by its parents, they are excluded. */
+QRect SwatchBookPrivate::visibleRect() const
+{
+    QRect result = q_pointer->visibleRegion().boundingRect();
+    if (result.isEmpty()) {
+        result = q_pointer->rect();
+    }
+    if (maximumScrollValue() > 0) {
+        result &= viewportRect();
+    }
+    return result;
+}
+
+/** @brief Number of rows to move on <tt>Qt::Key_PageUp</tt> and
+ * <tt>Qt::Key_PageDown</tt>.
+ *
+ * @returns The number of visible rows minus one, but at least 0. If the
+ * widget is fully visible, this moves to the first or last row. If the
+ * widget is scrolling, this moves by one page. */
+qsizetype SwatchBookPrivate::pageStep() const
+{
+    QStyleOptionFrame myFrameStyleOption;
+    initStyleOption(&myFrameStyleOption);
+    const auto [firstRow, lastRow] = rowRangeInRect( //
+        contentOffset(myFrameStyleOption),
+        visibleRect());
+    return qMax<qsizetype>(lastRow - firstRow, 0);
+}
+
 /** @brief The size of the color patches.
  *
  * This is the bounding box around the outer limit.
@@ -893,6 +1287,125 @@ void SwatchBookPrivate::drawMark(const QPoint offset,
     widgetPainter->restore(); // restore from initial save() function.
 }
 
+/** @brief The colors of @ref m_swatchGrid in their disabled appearance.
+ *
+ * The result is calculated only once and then cached until
+ * @ref invalidateSwatchPixmap() is called.
+ *
+ * @returns The colors of @ref m_swatchGrid in their disabled appearance,
+ * as provided by @ref disabledAppearance(const QColor normalColor). Unlike
+ * in @ref m_swatchGrid, the values might be partially transparent, and
+ * empty swatches are not marked specially. */
+const SwatchBookPrivate::PackedSwatchGrid &SwatchBookPrivate::disabledSwatchGrid()
+{
+    if (!m_disabledSwatchGrid.has_value()) {
+        PackedSwatchGrid result = m_swatchGrid;
+        for (qsizetype i = 0; i < result.iCount(); ++i) {
+            for (qsizetype j = 0; j < result.jCount(); ++j) {
+                const QColor color = unpackSwatch(result.value(i, j));
+                if (color.isValid()) {
+                    result.setValue(i, j, disabledAppearance(color).rgba64());
+                }
+            }
+        }
+        m_disabledSwatchGrid = result;
+    }
+    return m_disabledSwatchGrid.value();
+}
+
+/** @brief Invalidates the cache of @ref swatchPixmap().
+ *
+ * @param resetDisabledColors If <tt>true</tt>, also the cache of
+ * @ref disabledSwatchGrid() is invalidated.
+ *
+ * This does not schedule a paint event. */
+void SwatchBookPrivate::invalidateSwatchPixmap(const bool resetDisabledColors)
+{
+    m_swatchPixmap = QPixmap();
+    if (resetDisabledColors) {
+        m_disabledSwatchGrid.reset();
+    }
+}
+
+/** @brief The color patches, pre-rendered on a transparent pixmap.
+ *
+ * Meant for @ref SwatchBook::paintEvent()
+ *
+ * The pixmap covers the visible part of the widget, as provided by
+ * @ref visibleRect(), and has the device pixel ratio of the widget. It
+ * contains the color patches and, for empty patches of editable
+ * swatch books, the “add” mark. It does not contain the frame nor the
+ * selection mark. Only rows that are actually visible are rendered, so
+ * the cost does not depend on the size of the palette when the widget
+ * is scrolling.
+ *
+ * The result is cached. It is rendered again only if the visible part,
+ * the scroll position, the device pixel ratio, the enabled state or the
+ * layout direction of the widget have changed since the last call, or after
+ * @ref invalidateSwatchPixmap() has been called. The covered part is
+ * available at <tt>m_swatchPixmapKey.rect</tt>.
+ *
+ * @param styleOptionFrame The options that will be used to paint the frame.
+ *
+ * @returns The color patches, pre-rendered on a transparent pixmap. */
+const QPixmap &SwatchBookPrivate::swatchPixmap(const QStyleOptionFrame &styleOptionFrame)
+{
+    SwatchPixmapKey key;
+    key.rect = visibleRect();
+    key.devicePixelRatio = q_pointer->devicePixelRatioF();
+    key.isEnabled = q_pointer->isEnabled();
+    key.layoutDirection = q_pointer->layoutDirection();
+    key.scrollValue = scrollValue();
+    if (!m_swatchPixmap.isNull() && (key == m_swatchPixmapKey)) {
+        return m_swatchPixmap;
+    }
+
+    m_swatchPixmapKey = key;
+    const QSize physicalSize( //
+        qCeil(key.rect.width() * key.devicePixelRatio),
+        qCeil(key.rect.height() * key.devicePixelRatio));
+    m_swatchPixmap = QPixmap(physicalSize);
+    if (m_swatchPixmap.isNull()) {
+        return m_swatchPixmap;
+    }
+    m_swatchPixmap.setDevicePixelRatio(key.devicePixelRatio);
+    m_swatchPixmap.fill(Qt::transparent);
+
+    QPainter pixmapPainter(&m_swatchPixmap);
+    pixmapPainter.setRenderHint(QPainter::Antialiasing);
+    // Use the coordinate system of the widget.
+    pixmapPainter.translate(-key.rect.topLeft());
+    const PackedSwatchGrid &colors = key.isEnabled //
+        ? m_swatchGrid //
+        : disabledSwatchGrid();
+    const QPoint myOffset = contentOffset(styleOptionFrame);
+    const int myCornerRadius = cornerRadius();
+    const auto [firstRow, lastRow] = rowRangeInRect(myOffset, key.rect);
+    for (qsizetype row = firstRow; row <= lastRow; ++row) {
+        for (qsizetype columnIndex = 0; columnIndex < m_swatchGrid.iCount(); ++columnIndex) {
+            if (m_swatchGrid.value(columnIndex, row).alpha() != 0) {
+                pixmapPainter.setBrush( //
+                    QColor::fromRgba64(colors.value(columnIndex, row)));
+                pixmapPainter.setPen(Qt::NoPen);
+                pixmapPainter.drawRoundedRect( //
+                    patchRect(myOffset, columnIndex, row),
+                    myCornerRadius,
+                    myCornerRadius);
+            } else {
+                if (m_isEditable) {
+                    drawMark(myOffset, //
+                             &pixmapPainter, //
+                             QColor(), //
+                             SwatchBookPrivate::Mark::Add, //
+                             row, //
+                             columnIndex);
+                }
+            }
+        }
+    }
+    return m_swatchPixmap;
+}
+
 /** @brief Paint the widget.
  *
  * Reimplemented from base class.
@@ -914,6 +1427,10 @@ void SwatchBookPrivate::drawMark(const QPoint offset,
  * Wayland setups where scale factors can differ between screens and change
  * dynamically as windows move. To ensure consistent sizing across all scale
  * factors, pixel alignment is deliberately avoided in this function.
+ *
+ * @note The color patches are not painted directly, but taken from the
+ * cache provided by @ref SwatchBookPrivate::swatchPixmap(). Only the frame
+ * and the selection mark are painted on each paint event.
  */
 void SwatchBook::paintEvent(QPaintEvent *event)
 {
@@ -924,8 +1441,6 @@ void SwatchBook::paintEvent(QPaintEvent *event)
     widgetPainter.setRenderHint(QPainter::Antialiasing);
     QStyleOptionFrame frameStyleOption;
     d_pointer->initStyleOption(&frameStyleOption);
-    const int patchWidthOuter = d_pointer->patchSizeOuter().width();
-    const int patchHeightOuter = d_pointer->patchSizeOuter().height();
 
     // Draw the background
     {
@@ -949,51 +1464,9 @@ void SwatchBook::paintEvent(QPaintEvent *event)
     }
 
     // Draw the color patches
-    const QPoint myOffset = d_pointer->contentOffset(frameStyleOption);
-    const qsizetype columnCount = d_pointer->m_swatchGrid.iCount();
-    const int myCornerRadius = d_pointer->cornerRadius();
-    qsizetype visualColumn;
-    for (int columnIndex = 0; columnIndex < columnCount; ++columnIndex) {
-        for (int row = 0; //
-             row < d_pointer->m_swatchGrid.jCount(); //
-             ++row //
-        ) {
-            const auto swatchColor = //
-                d_pointer->m_swatchGrid.value(columnIndex, row);
-            if (swatchColor.isValid()) {
-                if (isEnabled()) {
-                    widgetPainter.setBrush(swatchColor);
-                } else {
-                    widgetPainter.setBrush(disabledAppearance(swatchColor));
-                }
-                widgetPainter.setPen(Qt::NoPen);
-                if (layoutDirection() == Qt::LayoutDirection::LeftToRight) {
-                    visualColumn = columnIndex;
-                } else {
-                    visualColumn = columnCount - 1 - columnIndex;
-                }
-                widgetPainter.drawRoundedRect( //
-                    myOffset.x() //
-                        + (static_cast<int>(visualColumn) //
-                           * (patchWidthOuter + d_pointer->horizontalPatchSpacing())),
-                    myOffset.y() //
-                        + row * (patchHeightOuter + d_pointer->verticalPatchSpacing()),
-                    patchWidthOuter,
-                    patchHeightOuter,
-                    myCornerRadius,
-                    myCornerRadius);
-            } else {
-                if (d_pointer->m_isEditable) {
-                    d_pointer->drawMark(myOffset, //
-                                        &widgetPainter, //
-                                        QColor(), //
-                                        SwatchBookPrivate::Mark::Add, //
-                                        row, //
-                                        columnIndex);
-                }
-            }
-        }
-    }
+    const QPixmap &swatchPixmap = d_pointer->swatchPixmap(frameStyleOption);
+    widgetPainter.drawPixmap(d_pointer->m_swatchPixmapKey.rect.topLeft(), //
+                             swatchPixmap);
 
     // If there is no selection mark to draw, nothing more to do: Return!
     if (d_pointer->m_selectedColumn < 0 || d_pointer->m_selectedRow < 0) {
@@ -1001,7 +1474,11 @@ void SwatchBook::paintEvent(QPaintEvent *event)
     }
 
     // Draw the selection mark (if any)
-    const auto selectedColor = d_pointer->m_swatchGrid.value( //
+    // Do not draw over the frame or the scroll bar when the mark is
+    // scrolled out of view:
+    widgetPainter.setClipRect(d_pointer->m_swatchPixmapKey.rect);
+    const QPoint myOffset = d_pointer->contentOffset(frameStyleOption);
+    const auto selectedColor = d_pointer->swatch( //
         d_pointer->m_selectedColumn,
         d_pointer->m_selectedRow);
     const auto rgb_1 = GenericColor( //
@@ -1067,11 +1544,11 @@ void SwatchBook::keyPressEvent(QKeyEvent *event)
             : -1;
         break;
     case Qt::Key_PageUp:
-        steps = d_pointer->m_swatchGrid.jCount() - 1;
+        steps = d_pointer->pageStep();
         shiftRow = -1;
         break;
     case Qt::Key_PageDown:
-        steps = d_pointer->m_swatchGrid.jCount() - 1;
+        steps = d_pointer->pageStep();
         shiftRow = 1;
         break;
     case Qt::Key_Home:
@@ -1103,9 +1580,9 @@ void SwatchBook::keyPressEvent(QKeyEvent *event)
     // If currently no color of the swatch book is selected, select the
     // first color as default, then return.
     if ((d_pointer->m_selectedColumn < 0) || (d_pointer->m_selectedRow < 0)) {
-        for (int j = 0; j < d_pointer->m_swatchGrid.iCount(); ++j) {
-            for (int i = 0; i < d_pointer->m_swatchGrid.jCount(); ++i) {
-                if (d_pointer->m_swatchGrid.value(i, j).isValid()) {
+        for (qsizetype j = 0; j < d_pointer->m_swatchGrid.jCount(); ++j) {
+            for (qsizetype i = 0; i < d_pointer->m_swatchGrid.iCount(); ++i) {
+                if (d_pointer->swatch(i, j).isValid()) {
                     d_pointer->selectSwatchByLogicalCoordinates(i, j);
                     return;
                 }
@@ -1130,8 +1607,8 @@ void SwatchBook::keyPressEvent(QKeyEvent *event)
                                               tempLogicalRow);
         if (isTempLogicalPositionInRange) {
             const auto swatch = //
-                d_pointer->m_swatchGrid.value(tempLogicalColumn, //
-                                              tempLogicalRow);
+                d_pointer->swatch(tempLogicalColumn, //
+                                  tempLogicalRow);
             if (swatch.isValid()) {
                 newLogicalColumn = tempLogicalColumn;
                 newLogicalRow = tempLogicalRow;
@@ -1145,7 +1622,9 @@ void SwatchBook::keyPressEvent(QKeyEvent *event)
 
 /** @brief Handle state changes.
  *
- * Implements reaction on <tt>QEvent::LanguageChange</tt>.
+ * Implements reaction on <tt>QEvent::LanguageChange</tt>. Invalidates the
+ * pre-rendered color patches on style, palette, icon theme and font
+ * changes.
  *
  * Reimplemented from base class.
  *
@@ -1164,6 +1643,24 @@ void SwatchBook::changeEvent(QEvent *event)
         d_pointer->retranslateUi();
     }
 
+    if ((type == QEvent::StyleChange) //
+        || (type == QEvent::PaletteChange) //
+        || (type == QEvent::ThemeChange)) {
+        // Both, the disabled appearance of the colors and the appearance
+        // of the marks, might depend on the style, the palette and the
+        // icon theme.
+        d_pointer->invalidateSwatchPixmap(true);
+    } else if (type == QEvent::FontChange) {
+        d_pointer->invalidateSwatchPixmap(false);
+    }
+
+    if ((type == QEvent::StyleChange) //
+        || (type == QEvent::FontChange) //
+        || (type == QEvent::LayoutDirectionChange)) {
+        // Patch sizes, frame width and scroll bar position might change.
+        d_pointer->updateScrollBar();
+    }
+
     AbstractDiagram::changeEvent(event);
 }
 
@@ -1195,12 +1692,67 @@ bool SwatchBook::isEditable() const
     return d_pointer->m_isEditable;
 }
 
+// No documentation here (documentation of properties
+// and its getters are in the header)
+qsizetype SwatchBook::maximumVisibleRowCount() const
+{
+    return d_pointer->m_maximumVisibleRowCount;
+}
+
+/** @brief Setter for the @ref maximumVisibleRowCount property.
+ *
+ * @param newMaximumVisibleRowCount the new value. Negative values are
+ * treated as <tt>0</tt>. */
+void SwatchBook::setMaximumVisibleRowCount(const qsizetype newMaximumVisibleRowCount)
+{
+    const qsizetype temp = qMax<qsizetype>(newMaximumVisibleRowCount, 0);
+    if (temp == d_pointer->m_maximumVisibleRowCount) {
+        return;
+    }
+    d_pointer->m_maximumVisibleRowCount = temp;
+    Q_EMIT maximumVisibleRowCountChanged(temp);
+    // As of Qt documentation:
+    //     “Notifies the layout system that this widget has changed and may
+    //      need to change geometry.”
+    updateGeometry();
+}
+
+/** @brief React on a resize event.
+ *
+ * Reimplemented from base class.
+ *
+ * @param event The corresponding resize event */
+void SwatchBook::resizeEvent(QResizeEvent *event)
+{
+    Q_UNUSED(event)
+    d_pointer->updateScrollBar();
+}
+
+/** @brief React on a mouse wheel event.
+ *
+ * Reimplemented from base class.
+ *
+ * If the widget is scrolling, the event is forwarded to the scroll bar.
+ * Otherwise, it is ignored, so that the parent widget can handle it.
+ *
+ * @param event The corresponding wheel event */
+void SwatchBook::wheelEvent(QWheelEvent *event)
+{
+    if (d_pointer->maximumScrollValue() > 0) {
+        d_pointer->updateScrollBar();
+        QCoreApplication::sendEvent(d_pointer->m_scrollBar, event);
+        return;
+    }
+    event->ignore();
+}
+
 /** @brief Setter for the @ref editable property.
  *
  * @param newEditable the new value */
 void SwatchBook::setEditable(const bool newEditable)
 {
     d_pointer->m_isEditable = newEditable;
+    d_pointer->invalidateSwatchPixmap(false);
     update(); // Schedule a paint event to make the changes visible.
     Q_EMIT editableChanged(newEditable);
 }
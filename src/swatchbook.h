@@ -17,6 +17,8 @@ class QEvent;
 class QKeyEvent;
 class QMouseEvent;
 class QPaintEvent;
+class QResizeEvent;
+class QWheelEvent;
 class QWidget;
 
 namespace PerceptualColor
@@ -86,6 +88,24 @@ class PERCEPTUALCOLOR_INTERNAL_IMPORTEXPORT SwatchBook : public AbstractDiagram
      */
     Q_PROPERTY(bool editable READ isEditable WRITE setEditable NOTIFY editableChanged)
 
+    /** @brief The maximum number of rows that the size hints provide
+     * space for.
+     *
+     * If the @ref swatchGrid has more rows than this, @ref sizeHint() and
+     * @ref minimumSizeHint() cover only this number of rows, and a vertical
+     * scroll bar within the frame allows to reach the other rows. The
+     * scroll bar also appears if the widget gets less height than
+     * necessary for all rows for another reason. Only the visible rows
+     * are rendered, so large palettes are cheap to display.
+     *
+     * The default value is <tt>0</tt>, which means that the size hints
+     * provide space for all rows.
+     *
+     * @sa @ref maximumVisibleRowCount() const
+     * @sa @ref setMaximumVisibleRowCount()
+     * @sa @ref maximumVisibleRowCountChanged() */
+    Q_PROPERTY(qsizetype maximumVisibleRowCount READ maximumVisibleRowCount WRITE setMaximumVisibleRowCount NOTIFY maximumVisibleRowCountChanged)
+
     /** @brief The swatchGrid that is displayed in the swatch book.
      *
      * The colors are in the current color engine’s working gamut. The first
@@ -96,7 +116,9 @@ class PERCEPTUALCOLOR_INTERNAL_IMPORTEXPORT SwatchBook : public AbstractDiagram
      *
      * @sa @ref swatchGrid() const
      * @sa @ref setSwatchGrid()
-     * @sa @ref swatchGridChanged() */
+     * @sa @ref swatchGridChanged()
+     * @sa @ref packedSwatchGrid() and @ref setPackedSwatchGrid() provide
+     *     access without <tt>QColor</tt> objects. */
     Q_PROPERTY(QColorArray2D swatchGrid READ swatchGrid WRITE setSwatchGrid NOTIFY swatchGridChanged)
 
 public:
@@ -108,7 +130,12 @@ public:
     /** @brief Getter for property @ref editable
      *  @returns the property @ref editable */
     [[nodiscard]] bool isEditable() const;
+    /** @brief Getter for property @ref maximumVisibleRowCount
+     *  @returns the property @ref maximumVisibleRowCount */
+    [[nodiscard]] qsizetype maximumVisibleRowCount() const;
     [[nodiscard]] virtual QSize minimumSizeHint() const override;
+    [[nodiscard]] QRgba64Array2D packedSwatchGrid() const;
+    void setPackedSwatchGrid(const PerceptualColor::QRgba64Array2D &newSwatchGrid);
     /** @brief Getter for property @ref swatchGrid
      *  @returns the property @ref swatchGrid */
     [[nodiscard]] QColorArray2D swatchGrid() const;
@@ -117,6 +144,7 @@ public:
 public Q_SLOTS:
     void setCurrentColor(const QColor &newCurrentColor);
     void setEditable(const bool newEditable);
+    void setMaximumVisibleRowCount(const qsizetype newMaximumVisibleRowCount);
     void setSwatchGrid(const PerceptualColor::QColorArray2D &newSwatchGrid);
 
 Q_SIGNALS:
@@ -128,6 +156,10 @@ Q_SIGNALS:
      *
      * @param newEditable the new @ref editable */
     void editableChanged(const bool newEditable);
+    /** @brief Notify signal for property @ref maximumVisibleRowCount.
+     *
+     * @param newMaximumVisibleRowCount the new @ref maximumVisibleRowCount */
+    void maximumVisibleRowCountChanged(const qsizetype newMaximumVisibleRowCount);
     /** @brief Notify signal for property @ref swatchGrid.
      *
      * @param newSwatchGrid the new @ref swatchGrid */
@@ -138,6 +170,8 @@ protected:
     virtual void keyPressEvent(QKeyEvent *event) override;
     virtual void mousePressEvent(QMouseEvent *event) override;
     virtual void paintEvent(QPaintEvent *event) override;
+    virtual void resizeEvent(QResizeEvent *event) override;
+    virtual void wheelEvent(QWheelEvent *event) override;
 
 private:
     Q_DISABLE_COPY(SwatchBook)
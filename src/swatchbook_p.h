@@ -9,11 +9,18 @@
 
 #include "constpropagatingrawpointer.h"
 #include "helper.h"
+#include <optional>
 #include <qcolor.h>
 #include <qglobal.h>
+#include <qhash.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpixmap.h>
 #include <qpoint.h>
+#include <qpointer.h>
+#include <qrect.h>
+#include <qrgba64.h>
+#include <qscrollbar.h>
 #include <qsize.h>
 #include <qstring.h>
 #include <qstyleoption.h>
@@ -45,28 +52,82 @@ public:
             patch, a new color is added to this patch. */
     };
 
+    /** @brief Compact storage for the swatches of the grid.
+     *
+     * Each swatch is stored as a packed <tt>QRgba64</tt>, which takes
+     * 8 bytes instead of the 16 bytes of a <tt>QColor</tt>, but is still
+     * lossless for colors with <tt>QColor::Spec::Rgb</tt>. Empty swatches
+     * are stored as fully transparent value (all bits 0). This works
+     * because all swatches are fully opaque anyway.
+     *
+     * @sa @ref packSwatch()
+     * @sa @ref unpackSwatch() */
+    using PackedSwatchGrid = QRgba64Array2D;
+
+    /** @brief Parameters that determine the content of
+     * @ref m_swatchPixmap. */
+    struct SwatchPixmapKey {
+    public:
+        /** @brief The part of the widget that is covered by the pixmap,
+         * in device-independent pixels. */
+        QRect rect;
+        /** @brief Device pixel ratio of the widget. */
+        qreal devicePixelRatio = 0;
+        /** @brief Whether the widget is enabled. */
+        bool isEnabled = false;
+        /** @brief Layout direction of the widget. */
+        Qt::LayoutDirection layoutDirection = Qt::LayoutDirection::LeftToRight;
+        /** @brief Value of @ref scrollValue(). */
+        int scrollValue = 0;
+        /** @brief Equal operator
+         *
+         * @param other The object to compare with.
+         *
+         * @returns <tt>true</tt> if equal, <tt>false</tt> otherwise. */
+        [[nodiscard]] bool operator==(const SwatchPixmapKey &other) const = default;
+    };
+
     explicit SwatchBookPrivate(SwatchBook *backLink, Qt::Orientations wideSpacing);
     virtual ~SwatchBookPrivate() noexcept override;
 
     [[nodiscard]] QSize colorPatchesSizeWithMargin() const;
     [[nodiscard]] int cornerRadius() const;
+    [[nodiscard]] const PackedSwatchGrid &disabledSwatchGrid();
     void drawMark(const QPoint offset,
                   QPainter *widgetPainter,
                   const QColor color,
                   const SwatchBookPrivate::Mark markSymbol,
                   const qsizetype row,
                   const qsizetype column) const;
+    void ensureSwatchVisible(const qsizetype column, const qsizetype row);
     [[nodiscard]] int horizontalPatchSpacing() const;
     void initStyleOption(QStyleOptionFrame *option) const;
+    [[nodiscard]] QRect frameInnerRect() const;
+    void invalidateSwatchPixmap(const bool resetDisabledColors);
     [[nodiscard]] std::pair<qsizetype, qsizetype> logicalColumnRowFromPosition(const QPoint position) const;
+    [[nodiscard]] int maximumScrollValue() const;
     [[nodiscard]] int normalPatchSpacing() const;
+    [[nodiscard]] static QRgba64 packSwatch(const QColor &color);
+    [[nodiscard]] qsizetype pageStep() const;
+    [[nodiscard]] QRect patchRect(const QPoint offset, const qsizetype column, const qsizetype row) const;
     [[nodiscard]] QPoint contentOffset(const QStyleOptionFrame &styleOptionFrame) const;
     [[nodiscard]] QSize patchSizeInner() const;
     [[nodiscard]] QSize patchSizeOuter() const;
     void retranslateUi();
+    [[nodiscard]] std::pair<qsizetype, qsizetype> rowRangeInRect(const QPoint offset, const QRect &rect) const;
+    [[nodiscard]] int scrollBarExtent() const;
+    [[nodiscard]] int scrollValue() const;
     void selectSwatchByLogicalCoordinates(qsizetype newCurrentColumn, qsizetype newCurrentRow);
     void selectSwatchFromCurrentColor();
+    void setSwatch(const qsizetype column, const qsizetype row, const QColor &color);
+    [[nodiscard]] QColor swatch(const qsizetype column, const qsizetype row) const;
+    [[nodiscard]] const QPixmap &swatchPixmap(const QStyleOptionFrame &styleOptionFrame);
+    [[nodiscard]] static QColor unpackSwatch(const QRgba64 swatch);
+    [[nodiscard]] QColorArray2D unpackedSwatchGrid() const;
+    void updateScrollBar();
     [[nodiscard]] int verticalPatchSpacing() const;
+    [[nodiscard]] QRect viewportRect() const;
+    [[nodiscard]] QRect visibleRect() const;
     [[nodiscard]] int widePatchSpacing() const;
 
     /** @brief The add mark to use, or an empty string if no
@@ -86,9 +147,24 @@ public:
      * should be for the property @ref SwatchBook::currentColor, so no
      * need to initialize here explicitly. */
     QColor m_currentColor;
+    /** @brief Cache for @ref disabledSwatchGrid().
+     *
+     * Empty if not yet calculated. */
+    std::optional<PackedSwatchGrid> m_disabledSwatchGrid;
 
     /** @brief Internal storage for property @ref SwatchBook::editable */
     bool m_isEditable = false;
+    /** @brief Internal storage for property
+     * @ref SwatchBook::maximumVisibleRowCount */
+    qsizetype m_maximumVisibleRowCount = 0;
+    /** @brief Vertical scroll bar within the frame.
+     *
+     * Hidden while all rows fit into the widget. Its value might be out
+     * of date until @ref updateScrollBar() is called; use
+     * @ref scrollValue() instead.
+     *
+     * @sa @ref updateScrollBar() */
+    QPointer<QScrollBar> m_scrollBar;
     /** @brief Selected column.
      *
      * If one of the swatches in the book is selected, this is
@@ -132,8 +208,26 @@ public:
      *
      * The value is set by @ref retranslateUi(). */
     QString m_selectionMarkAvailableInCurrentFont;
-    /** @brief Internal storage for property @ref SwatchBook::swatchGrid */
-    QColorArray2D m_swatchGrid;
+    /** @brief Cache for @ref swatchPixmap().
+     *
+     * A null pixmap if the cache is invalid. */
+    QPixmap m_swatchPixmap;
+    /** @brief The parameters with which @ref m_swatchPixmap has been
+     * rendered. */
+    SwatchPixmapKey m_swatchPixmapKey;
+    /** @brief Internal storage for property @ref SwatchBook::swatchGrid
+     *
+     * @sa @ref swatch()
+     * @sa @ref setSwatch() */
+    PackedSwatchGrid m_swatchGrid;
+    /** @brief Index of the first swatch (in the search order of
+     * @ref selectSwatchFromCurrentColor()) for each color in
+     * @ref m_swatchGrid.
+     *
+     * The key is the packed color as <tt>quint64</tt>, the value is the
+     * index <tt>column + row * columnCount</tt>. Empty if not yet
+     * calculated. */
+    std::optional<QHash<quint64, qsizetype>> m_swatchIndex;
     /** @brief List of axis where @ref widePatchSpacing should be used. */
     const Qt::Orientations m_wideSpacing;
 